@@ -308,9 +308,13 @@ int main( int argc, char* argv[] )
       {
         tree_mode = NORMAL;
       }
+      else if ( strcmp( line->words[1], "pruned" ) == 0 )
+      {
+        tree_mode = PRUNED;
+      }
       else
       {
-        printf( "ERROR in param file \"%s\" on line %"PRId32" : unknown tree mode option (use normal/light).\n",
+        printf( "ERROR in param file \"%s\" on line %"PRId32" : unknown tree mode option (use normal/pruned/light).\n",
                param_file_name, cur_line );
         exit( EXIT_FAILURE );
       }
@@ -110,6 +110,8 @@ int main( int argc, char* argv[] )
   int32_t num_gener = 0;
   int32_t nb_gener  = 1000;
   
+  int16_t nb_threads = 0;
+  
   #ifndef __NO_X
     bool show_display_on_startup = true;
   #endif
@@ -118,10 +120,11 @@ int main( int argc, char* argv[] )
   // -------------------------------------------------------------------------
   // 2) Define allowed options
   // -------------------------------------------------------------------------
-  const char * options_list = "hn:r:tvVwx";
+  const char * options_list = "hn:p:r:tvVwx";
   static struct option long_options_list[] = {
     { "help",     no_argument,        NULL, 'h' },
     { "nbgener",  required_argument,  NULL, 'n' }, // Number of generations to be run
+    { "parallel", required_argument,  NULL, 'p' }, // Number of threads to be used
     { "resume",   required_argument,  NULL, 'r' }, // Resume from generation X
     { "text",     no_argument,        NULL, 't' }, // Use text files instead of gzipped binary files
     { "verbose",  no_argument,        NULL, 'v' }, // Be verbose
@@ -162,6 +165,24 @@ int main( int argc, char* argv[] )
         
         break;
       }
+      case 'p' :
+      {
+        if ( strcmp( optarg, "" ) == 0 )
+        {
+          printf( "%s: error: Option -p or --parallel : missing argument.\n", argv[0] );
+          exit( EXIT_FAILURE );
+        }
+        
+        nb_threads = atoi( optarg );
+        
+        if ( nb_threads < 1 )
+        {
+          printf( "%s: error: Option -p or --parallel : the number of threads must be positive.\n", argv[0] );
+          exit( EXIT_FAILURE );
+        }
+        
+        break;
+      }
       case 'r' :
       {
         if ( strcmp( optarg, "" ) == 0 )
@@ -223,6 +244,12 @@ int main( int argc, char* argv[] )
     ae_exp_manager* exp_manager = new ae_exp_manager();
   #endif
   
+  // Threads are set first for the population to be loaded concurrently
+  if ( nb_threads > 0 )
+  {
+    exp_manager->set_nb_threads( nb_threads );
+  }
+  
   exp_manager->load( num_gener, false, verbose );
   exp_manager->set_nb_gener( nb_gener );
   
@@ -313,12 +340,13 @@ void print_help( char* prog_path )
   printf( "\n" );
 	printf( "Usage : %s -h or --help\n", prog_name );
 	printf( "   or : %s -V or --version\n", prog_name );
-	printf( "   or : %s [-r GENER] [-n NB_GENER] [-tvwx]\n", prog_name );
+	printf( "   or : %s [-r GENER] [-n NB_GENER] [-p NB_THREADS] [-tvwx]\n", prog_name );
 	printf( "\nOptions\n" );
 	printf( "  -h, --help\n\tprint this help, then exit\n\n" );
 	printf( "  -V, --version\n\tprint version number, then exit\n\n" );
   printf( "  -r, --resume GENER\n\tspecify generation to resume simulation at (default 0)\n\n" );
   printf( "  -n, --nbgener NB_GENER\n\tspecify number of generations to be run (default 1000)\n\n" );
+  printf( "  -p, --parallel NB_THREADS\n\trun the replications on NB_THREADS threads.\n\tThe results do not depend on NB_THREADS (-p 1 and -p 8 give the same\n\tresults). A run without this option follows the historical serial\n\trandom stream, which differs from that of -p 1 (unless aevol was\n\tconfigured with --enable-distributed-prng)\n\n" );
   printf( "  -t, --text\n\tuse text files instead of binary files when possible\n\n" );
 	printf( "  -v, --verbose\n\tbe verbose\n\n" );
   printf( "  -w, --wait\n\tpause after loading\n\n" );
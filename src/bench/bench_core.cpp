@@ -0,0 +1,517 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+
+//
+// This program times the core routines of the evolutionary loop on
+// reproducible workloads (genomes and fuzzy sets drawn from a given seed)
+// and writes the results in JSON, for them to be compared across versions.
+//
+// Each routine is called nb_repeats times, the mean and the shortest time
+// per call are reported. The experiment built from the parameter file given
+// with -f (as aevol_create would do) provides the genome the expression and
+// alignment routines work on: that of its first individual, which bears
+// genes, unlike a uniformly random genome. It also provides the population
+// of the save and load benchmarks, which are skipped without -f (the genome
+// is then a random one).
+//
+// Example :
+//
+//    aevol_bench_core -f ../../tests/basic.simple -l 50000 -n 20 -o bench_core.json
+//
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_macros.h>
+#include <ae_enums.h>
+#include <ae_align.h>
+#include <ae_exp_manager.h>
+#include <ae_fuzzy_set.h>
+#include <ae_genetic_unit.h>
+#include <ae_individual.h>
+#include <ae_jumping_mt.h>
+#include <ae_params_mut.h>
+#include <ae_population.h>
+#include <ae_vis_a_vis.h>
+#include <param_loader.h>
+
+
+
+
+// Outcome of one benchmark
+struct bench_result
+{
+  const char* name;
+  int32_t     nb_repeats;
+  double      mean_time;  // Mean time per call (in seconds)
+  double      min_time;   // Shortest time of a call (in seconds)
+  int64_t     nb_items;   // Number of items produced by the last call (promoters, proteins...)
+};
+
+
+void print_help( char* prog_name );
+bench_result time_calls( const char* name, int32_t nb_repeats,
+                         std::function<void(void)> prepare, std::function<int64_t(void)> call );
+void fill_fuzzy_set( ae_fuzzy_set* fuzzy_set, ae_jumping_mt* prng, int32_t nb_triangles );
+void write_results( FILE* output, std::vector<bench_result>& results, int32_t length, int32_t nb_repeats, uint32_t seed );
+
+
+
+int main( int argc, char* argv[] )
+{
+  // Initialize command-line option variables with default values
+  char*    param_file_name  = NULL;
+  char*    output_file_name = NULL;
+  int32_t  length           = -1;     // Default: that of the genome of the experiment, or 50000
+  int32_t  nb_repeats       = 20;
+  uint32_t seed             = 1;
+  
+  // Define allowed options
+  const char * options_list = "hf:l:n:o:s:";
+  static struct option long_options_list[] = {
+    { "help",    0, NULL, 'h' },
+    { "file",    1, NULL, 'f' },
+    { "length",  1, NULL, 'l' },
+    { "repeats", 1, NULL, 'n' },
+    { "output",  1, NULL, 'o' },
+    { "seed",    1, NULL, 's' },
+    { 0, 0, 0, 0 }
+  };
+
+  // Get actual values of the command-line options
+  int option;
+  while ( ( option = getopt_long(argc, argv, options_list, long_options_list, NULL) ) != -1 )
+  {
+    switch ( option )
+    {
+      case 'h' :
+        print_help( argv[0] );
+        exit( EXIT_SUCCESS );
+        break;
+      case 'f' :
+        param_file_name = optarg;
+        break;
+      case 'l' :
+        length = atol( optarg );
+        break;
+      case 'n' :
+        nb_repeats = atol( optarg );
+        break;
+      case 'o' :
+        output_file_name = optarg;
+        break;
+      case 's' :
+        seed = atol( optarg );
+        break;
+      default :
+        print_help( argv[0] );
+        exit( EXIT_FAILURE );
+    }
+  }
+  
+  std::vector<bench_result> results;
+  ae_jumping_mt* prng = new ae_jumping_mt( seed );
+  
+  
+  // =================================================================
+  //                   Experiment (if a file was given)
+  // =================================================================
+  ae_exp_manager* exp_manager = NULL;
+  ae_dna*         model_dna   = NULL;
+  if ( param_file_name != NULL )
+  {
+    param_loader* my_param_loader = new param_loader( param_file_name );
+    exp_manager = new ae_exp_manager();
+    std::function<std::list<char*>(void)> empty;
+    my_param_loader->load( exp_manager, false, empty );
+    delete my_param_loader;
+    
+    model_dna = exp_manager->get_pop()->get_indivs()->get_first()->get_obj()->get_genetic_unit( 0 )->get_dna();
+    if ( length == -1 ) length = model_dna->get_length();
+  }
+  else if ( length == -1 )
+  {
+    length = 50000;
+  }
+  
+  if ( length < PROM_SIZE + TERM_SIZE || nb_repeats < 1 )
+  {
+    printf( "%s: error: the length must be at least %" PRId8 " and the number of repeats at least 1.\n",
+            argv[0], PROM_SIZE + TERM_SIZE );
+    exit( EXIT_FAILURE );
+  }
+  
+  
+  // =================================================================
+  //                        Expression of a genome
+  // =================================================================
+  // The genome of the experiment, repeated or cut to length, or else a random one
+  char* genome = new char[length + 1];
+  for ( int32_t i = 0 ; i < length ; i++ )
+  {
+    if ( model_dna != NULL )
+    {
+      genome[i] = model_dna->get_data()[i % model_dna->get_length()];
+    }
+    else
+    {
+      genome[i] = '0' + prng->random( NB_BASE );
+    }
+  }
+  genome[length] = '\0';
+  
+  ae_params_mut params_mut;
+  ae_individual* indiv = new ae_individual( NULL, NULL, NULL, &params_mut, 1.0, 10, 2 * length, false, 0, 0 );
+  indiv->add_GU( genome, length ); // genome now belongs to indiv
+  ae_genetic_unit* gen_unit = indiv->get_genetic_unit( 0 );
+  
+  auto nb_rnas = [&]( void ) -> int64_t
+  {
+    return gen_unit->get_rna_list()[LEADING]->get_nb_elts() + gen_unit->get_rna_list()[LAGGING]->get_nb_elts();
+  };
+  auto nb_proteins = [&]( void ) -> int64_t
+  {
+    return gen_unit->get_protein_list()[LEADING]->get_nb_elts() + gen_unit->get_protein_list()[LAGGING]->get_nb_elts();
+  };
+  
+  results.push_back( time_calls( "locate_promoters", nb_repeats,
+    [&]( void ) { gen_unit->reset_expression(); },
+    [&]( void ) { gen_unit->locate_promoters(); return nb_rnas(); } ) );
+  
+  results.push_back( time_calls( "do_transcription", nb_repeats,
+    [&]( void ) { gen_unit->reset_expression(); gen_unit->locate_promoters(); },
+    [&]( void ) { gen_unit->do_transcription(); return nb_rnas(); } ) );
+  
+  results.push_back( time_calls( "do_translation", nb_repeats,
+    [&]( void ) { gen_unit->reset_expression(); gen_unit->locate_promoters(); gen_unit->do_transcription(); },
+    [&]( void ) { gen_unit->do_translation(); return nb_proteins(); } ) );
+  
+  
+  // =================================================================
+  //                             Alignments
+  // =================================================================
+  // As in ae_dna::do_rearrangements_with_align, with the default parameters.
+  // Seeds drawn at random seldom align: the pairs of homologous seeds lie at
+  // the same position in the genome and in a copy of it bearing 1% of point
+  // mutations (as the two copies of a duplicated segment), and mostly align.
+  const int32_t nb_alignments = 1000;
+  int32_t* random_seeds     = new int32_t[2 * nb_alignments];
+  int32_t* homologous_seeds = new int32_t[2 * nb_alignments];
+  for ( int32_t i = 0 ; i < 2 * nb_alignments ; i++ )
+  {
+    random_seeds[i] = prng->random( length );
+  }
+  for ( int32_t i = 0 ; i < nb_alignments ; i++ )
+  {
+    homologous_seeds[2*i] = homologous_seeds[2*i+1] = prng->random( length );
+  }
+  
+  char* mutated_genome = new char[length + 1];
+  memcpy( mutated_genome, gen_unit->get_dna()->get_data(), length + 1 );
+  for ( int32_t i = 0 ; i < length ; i++ )
+  {
+    if ( prng->random() < 0.01 )
+    {
+      mutated_genome[i] = '0' + ( mutated_genome[i] - '0' + 1 + prng->random( NB_BASE - 1 ) ) % NB_BASE;
+    }
+  }
+  ae_individual* mutated_indiv = new ae_individual( NULL, NULL, NULL, &params_mut, 1.0, 10, 2 * length, false, 0, 0 );
+  mutated_indiv->add_GU( mutated_genome, length ); // mutated_genome now belongs to mutated_indiv
+  
+  auto search_alignments = [&]( ae_dna* dna_1, ae_dna* dna_2, int32_t* seeds ) -> int64_t
+  {
+    int64_t nb_found = 0;
+    for ( int32_t i = 0 ; i < nb_alignments ; i++ )
+    {
+      ae_vis_a_vis* alignment = ae_align::search_alignment_direct( dna_1, seeds[2*i], dna_2, seeds[2*i+1],
+                                                                   params_mut.get_align_sigm_mean() );
+      if ( alignment != NULL )
+      {
+        nb_found++;
+        delete alignment;
+      }
+    }
+    return nb_found;
+  };
+  
+  ae_dna* dna         = gen_unit->get_dna();
+  ae_dna* mutated_dna = mutated_indiv->get_genetic_unit( 0 )->get_dna();
+  
+  results.push_back( time_calls( "search_alignment_direct", nb_repeats,
+    [&]( void ) {},
+    [&]( void ) { return search_alignments( dna, dna, random_seeds ); } ) );
+  
+  results.push_back( time_calls( "search_alignment_direct_homologous", nb_repeats,
+    [&]( void ) {},
+    [&]( void ) { return search_alignments( dna, mutated_dna, homologous_seeds ); } ) );
+  
+  delete [] random_seeds;
+  delete [] homologous_seeds;
+  delete mutated_indiv;
+  delete indiv;
+  
+  
+  // =================================================================
+  //                            Fuzzy sets
+  // =================================================================
+  // Sets made of as many triangles as the phenotype of an individual bearing
+  // a few hundred genes
+  const int32_t nb_triangles = 200;
+  ae_fuzzy_set* fuzzy_set   = NULL;
+  ae_fuzzy_set* other_set   = new ae_fuzzy_set();
+  ae_fuzzy_set* copied_set  = NULL;
+  double*       triangles   = new double[3 * nb_triangles];
+  fill_fuzzy_set( other_set, prng, nb_triangles );
+  for ( int32_t i = 0 ; i < 3 * nb_triangles ; i += 3 )
+  {
+    triangles[i]   = prng->random();
+    triangles[i+1] = prng->random() * 0.05;
+    triangles[i+2] = 2 * prng->random() - 1;
+  }
+  
+  results.push_back( time_calls( "ae_fuzzy_set::add_triangle", 100 * nb_repeats,
+    [&]( void ) { delete fuzzy_set; fuzzy_set = new ae_fuzzy_set(); },
+    [&]( void ) -> int64_t
+    {
+      for ( int32_t i = 0 ; i < 3 * nb_triangles ; i += 3 )
+      {
+        fuzzy_set->add_triangle( triangles[i], triangles[i+1], triangles[i+2] );
+      }
+      return nb_triangles;
+    } ) );
+  
+  results.push_back( time_calls( "ae_fuzzy_set::sub", 100 * nb_repeats,
+    [&]( void ) { delete copied_set; copied_set = new ae_fuzzy_set( *fuzzy_set ); },
+    [&]( void ) { copied_set->sub( other_set ); return (int64_t) nb_triangles; } ) );
+  
+  results.push_back( time_calls( "ae_fuzzy_set::get_geometric_area", 100 * nb_repeats,
+    [&]( void ) {},
+    [&]( void ) { volatile double area = copied_set->get_geometric_area(); (void) area; return (int64_t) nb_triangles; } ) );
+  
+  delete fuzzy_set;
+  delete other_set;
+  delete copied_set;
+  delete [] triangles;
+  
+  
+  // =================================================================
+  //                        Multinomial drawing
+  // =================================================================
+  // Reproduction probabilities of a large population
+  const int32_t nb_colors = 10000;
+  double*  probs    = new double[nb_colors];
+  int32_t* drawings = new int32_t[nb_colors];
+  double   sum      = 0;
+  for ( int32_t i = 0 ; i < nb_colors ; i++ )
+  {
+    probs[i] = prng->random();
+    sum += probs[i];
+  }
+  for ( int32_t i = 0 ; i < nb_colors ; i++ )
+  {
+    probs[i] /= sum;
+  }
+  
+  results.push_back( time_calls( "multinomial_drawing", 10 * nb_repeats,
+    [&]( void ) {},
+    [&]( void ) { prng->multinomial_drawing( drawings, probs, nb_colors, nb_colors ); return (int64_t) nb_colors; } ) );
+  
+  delete [] probs;
+  delete [] drawings;
+  delete prng;
+  
+  
+  // =================================================================
+  //                    Population backup and restore
+  // =================================================================
+  if ( exp_manager != NULL )
+  {
+    char backup_file_name[] = "/tmp/aevol_bench_XXXXXX";
+    int backup_fd = mkstemp( backup_file_name );
+    if ( backup_fd == -1 )
+    {
+      printf( "%s: error: could not create a temporary file.\n", argv[0] );
+      exit( EXIT_FAILURE );
+    }
+    close( backup_fd );
+    
+    ae_population* pop = exp_manager->get_pop();
+    
+    results.push_back( time_calls( "ae_population::save", nb_repeats,
+      [&]( void ) {},
+      [&]( void ) -> int64_t
+      {
+        gzFile backup_file = gzopen( backup_file_name, "w" );
+        pop->save( backup_file );
+        gzclose( backup_file );
+        return pop->get_nb_indivs();
+      } ) );
+    
+    results.push_back( time_calls( "ae_population::load", nb_repeats,
+      [&]( void ) {},
+      [&]( void ) -> int64_t
+      {
+        ae_population* loaded_pop = new ae_population( exp_manager );
+        gzFile backup_file = gzopen( backup_file_name, "r" );
+        loaded_pop->load( backup_file, false );
+        gzclose( backup_file );
+        int64_t nb_indivs = loaded_pop->get_nb_indivs();
+        delete loaded_pop;
+        return nb_indivs;
+      } ) );
+    
+    remove( backup_file_name );
+    delete exp_manager;
+  }
+  
+  
+  // =================================================================
+  //                          Write the results
+  // =================================================================
+  FILE* output = stdout;
+  if ( output_file_name != NULL )
+  {
+    output = fopen( output_file_name, "w" );
+    if ( output == NULL )
+    {
+      printf( "%s: error: could not open file %s.\n", argv[0], output_file_name );
+      exit( EXIT_FAILURE );
+    }
+  }
+  
+  write_results( output, results, length, nb_repeats, seed );
+  
+  if ( output != stdout )
+  {
+    fclose( output );
+  }
+  
+  return EXIT_SUCCESS;
+}
+
+
+/*!
+  Call prepare then call nb_repeats times, only the latter being timed
+*/
+bench_result time_calls( const char* name, int32_t nb_repeats,
+                         std::function<void(void)> prepare, std::function<int64_t(void)> call )
+{
+  bench_result result;
+  result.name       = name;
+  result.nb_repeats = nb_repeats;
+  result.mean_time  = 0;
+  result.min_time   = -1;
+  
+  for ( int32_t i = 0 ; i < nb_repeats ; i++ )
+  {
+    prepare();
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    result.nb_items = call();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    
+    result.mean_time += elapsed.count();
+    if ( result.min_time < 0 || elapsed.count() < result.min_time )
+    {
+      result.min_time = elapsed.count();
+    }
+  }
+  
+  result.mean_time /= nb_repeats;
+  
+  return result;
+}
+
+/*!
+  Add nb_triangles random triangles to fuzzy_set
+*/
+void fill_fuzzy_set( ae_fuzzy_set* fuzzy_set, ae_jumping_mt* prng, int32_t nb_triangles )
+{
+  for ( int32_t i = 0 ; i < nb_triangles ; i++ )
+  {
+    double mean   = prng->random();
+    double width  = prng->random() * 0.05;
+    double height = 2 * prng->random() - 1;
+    fuzzy_set->add_triangle( mean, width, height );
+  }
+}
+
+void write_results( FILE* output, std::vector<bench_result>& results, int32_t length, int32_t nb_repeats, uint32_t seed )
+{
+  fprintf( output, "{\n" );
+  fprintf( output, "  \"version\": \"%s\",\n", VERSION );
+  fprintf( output, "  \"genome_length\": %" PRId32 ",\n", length );
+  fprintf( output, "  \"repeats\": %" PRId32 ",\n", nb_repeats );
+  fprintf( output, "  \"seed\": %" PRIu32 ",\n", seed );
+  fprintf( output, "  \"benchmarks\": [\n" );
+  
+  for ( size_t i = 0 ; i < results.size() ; i++ )
+  {
+    fprintf( output, "    { \"name\": \"%s\", \"calls\": %" PRId32 ", \"mean_seconds\": %.9f, \"min_seconds\": %.9f, \"items\": %" PRId64 " }%s\n",
+             results[i].name, results[i].nb_repeats, results[i].mean_time, results[i].min_time, results[i].nb_items,
+             ( i + 1 < results.size() ) ? "," : "" );
+  }
+  
+  fprintf( output, "  ]\n" );
+  fprintf( output, "}\n" );
+}
+
+
+void print_help( char* prog_name )
+{
+  printf( "\n\
+Usage : aevol_bench_core -h\n\
+or :    aevol_bench_core [-f param_file] [-l length] [-n nb_repeats] [-o output_file] [-s seed]\n\
+\t-h : display this screen\n\
+\t-f param_file : parameter file of the experiment whose genome is expressed and whose\n\
+\t                population is saved and loaded (without it, the genome is random\n\
+\t                and the population benchmarks are skipped)\n\
+\t-l length : length of the genome, that of the experiment being repeated or cut\n\
+\t            (default: that of the experiment, or 50000)\n\
+\t-n nb_repeats : number of times the genome-wide routines are called (default: 20)\n\
+\t-o output_file : file the JSON results are written to (default: standard output)\n\
+\t-s seed : seed used to draw the workloads (default: 1)\n" );
+}
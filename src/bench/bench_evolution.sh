@@ -0,0 +1,76 @@
+#!/bin/bash
+
+# Time a few generations of the experiments described by the tests/*.simple
+# parameter files at several genome and population sizes and write the
+# results in JSON, for them to be compared across versions.
+#
+# Usage : bench_evolution.sh [-b bin_dir] [-t tests_dir] [-n nb_gener] [-o output_file]
+
+BIN_DIR=../
+TESTS_DIR=../../tests
+NB_GENER=50
+OUTPUT=/dev/stdout
+
+GENOME_LENGTHS="5000 20000"
+POP_SIZES="100 400"    # Must be squares (the space and secretion setups are grids)
+
+while getopts "b:t:n:o:h" opt; do
+  case $opt in
+    b) BIN_DIR=$OPTARG ;;
+    t) TESTS_DIR=$OPTARG ;;
+    n) NB_GENER=$OPTARG ;;
+    o) OUTPUT=$OPTARG ;;
+    *) echo "Usage : $0 [-b bin_dir] [-t tests_dir] [-n nb_gener] [-o output_file]"; exit 1 ;;
+  esac
+done
+
+BIN_DIR=`cd ${BIN_DIR} && pwd`
+TESTS_DIR=`cd ${TESTS_DIR} && pwd`
+
+CREATE=${BIN_DIR}/aevol_create
+RUN=`find ${BIN_DIR} -maxdepth 1 -name "aevol_run*" -perm -u+x -type f -print -quit`
+if [ ! -x "${CREATE}" ] || [ "x${RUN}" = "x" ]; then
+  echo "aevol_create or aevol_run not found in ${BIN_DIR}"
+  exit 1
+fi
+
+WORK_DIR=`mktemp -d /tmp/aevol_bench_XXXXXX`
+trap "rm -rf ${WORK_DIR}" EXIT
+
+RUNS=""
+for SETUP in basic space secretion; do
+  for LENGTH in ${GENOME_LENGTHS}; do
+    for POP_SIZE in ${POP_SIZES}; do
+      SIDE=`awk "BEGIN { print int( sqrt( ${POP_SIZE} ) ) }"`
+      DIR=${WORK_DIR}/${SETUP}_${LENGTH}_${POP_SIZE}
+      mkdir -p ${DIR}
+      sed -e "s/^INIT_POP_SIZE .*/INIT_POP_SIZE ${POP_SIZE}/" \
+          -e "s/^CHROMOSOME_INITIAL_LENGTH .*/CHROMOSOME_INITIAL_LENGTH ${LENGTH}/" \
+          -e "s/^POP_STRUCTURE .*/POP_STRUCTURE grid ${SIDE} ${SIDE}/" \
+          ${TESTS_DIR}/${SETUP}.simple > ${DIR}/param.in
+      
+      cd ${DIR}
+      ${CREATE} -f param.in > /dev/null || exit 1
+      START=`date +%s.%N`
+      ${RUN} -r 0 -n ${NB_GENER} > /dev/null || exit 1
+      END=`date +%s.%N`
+      cd - > /dev/null
+      
+      ELAPSED=`awk "BEGIN { printf \"%.3f\", ${END} - ${START} }"`
+      RUNS="${RUNS}${RUNS:+,
+}    { \"setup\": \"${SETUP}\", \"genome_length\": ${LENGTH}, \"pop_size\": ${POP_SIZE}, \"seconds\": ${ELAPSED} }"
+    done
+  done
+done
+
+COMMIT=`git -C ${TESTS_DIR} rev-parse --short HEAD 2> /dev/null || echo unknown`
+
+cat > ${OUTPUT} <<END
+{
+  "commit": "${COMMIT}",
+  "generations": ${NB_GENER},
+  "runs": [
+${RUNS}
+  ]
+}
+END
@@ -0,0 +1,289 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+
+//
+// This program compares the word-parallel promoter search used by
+// ae_genetic_unit::locate_promoters (see ae_motif_scanner) with the
+// base-by-base search it replaces, on random circular sequences.
+//
+// Both searches must find the same promoters (same positions, same
+// distances, same order), the program fails otherwise.
+//
+// Example :
+//
+//    aevol_bench_promoters -l 1000000 -n 20
+//
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <chrono>
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_macros.h>
+#include <ae_enums.h>
+#include <ae_utils.h>
+#include <ae_jumping_mt.h>
+#include <ae_motif_scanner.h>
+#include <ae_string.h>
+
+
+
+
+void print_help( char* prog_name );
+int32_t scalar_search( const char* seq, int32_t len, int32_t* pos, int8_t* dist );
+int32_t scanner_search( const char* seq, int32_t len, int32_t* pos, int8_t* dist );
+double time_search( int32_t (*search)( const char*, int32_t, int32_t*, int8_t* ),
+                    const char* seq, int32_t len, int32_t* pos, int8_t* dist, int32_t nb_repeats, int32_t& nb_found );
+
+
+
+int main( int argc, char* argv[] )
+{
+  // Initialize command-line option variables with default values
+  int32_t  length     = 100000;
+  int32_t  nb_repeats = 20;
+  uint32_t seed       = 1;
+  
+  // Define allowed options
+  const char * options_list = "hl:n:s:";
+  static struct option long_options_list[] = {
+    { "help",    0, NULL, 'h' },
+    { "length",  1, NULL, 'l' },
+    { "repeats", 1, NULL, 'n' },
+    { "seed",    1, NULL, 's' },
+    { 0, 0, 0, 0 }
+  };
+
+  // Get actual values of the command-line options
+  int option;
+  while ( ( option = getopt_long(argc, argv, options_list, long_options_list, NULL) ) != -1 )
+  {
+    switch ( option )
+    {
+      case 'h' :
+        print_help( argv[0] );
+        exit( EXIT_SUCCESS );
+        break;
+      case 'l' :
+        length = atol( optarg );
+        break;
+      case 'n' :
+        nb_repeats = atol( optarg );
+        break;
+      case 's' :
+        seed = atol( optarg );
+        break;
+      default :
+        print_help( argv[0] );
+        exit( EXIT_FAILURE );
+    }
+  }
+  
+  if ( length < PROM_SIZE || nb_repeats < 1 )
+  {
+    printf( "%s: error: the length must be at least %" PRId8 " and the number of repeats at least 1.\n", argv[0], PROM_SIZE );
+    exit( EXIT_FAILURE );
+  }
+  
+  // Draw a random sequence
+  ae_jumping_mt* prng = new ae_jumping_mt( seed );
+  char* seq = new char[length + 1];
+  for ( int32_t i = 0 ; i < length ; i++ )
+  {
+    seq[i] = '0' + prng->random( NB_BASE );
+  }
+  seq[length] = '\0';
+  delete prng;
+  
+  // There can be at most one promoter per position and strand
+  int32_t* scalar_pos   = new int32_t[2 * length];
+  int8_t*  scalar_dist  = new int8_t[2 * length];
+  int32_t* scanner_pos  = new int32_t[2 * length];
+  int8_t*  scanner_dist = new int8_t[2 * length];
+  int32_t  scalar_nb_found, scanner_nb_found;
+  
+  double scalar_time  = time_search( scalar_search, seq, length, scalar_pos, scalar_dist, nb_repeats, scalar_nb_found );
+  double scanner_time = time_search( scanner_search, seq, length, scanner_pos, scanner_dist, nb_repeats, scanner_nb_found );
+  
+  // Check that both searches agree
+  bool identical = ( scalar_nb_found == scanner_nb_found );
+  for ( int32_t i = 0 ; identical && i < scalar_nb_found ; i++ )
+  {
+    identical = ( scalar_pos[i] == scanner_pos[i] && scalar_dist[i] == scanner_dist[i] );
+  }
+  
+  printf( "sequence length      : %" PRId32 " bp (seed %" PRIu32 ", %" PRId32 " repeats)\n", length, seed, nb_repeats );
+  printf( "promoters found      : %" PRId32 "\n", scalar_nb_found );
+  printf( "base-by-base search  : %12.3f us per search, %8.3f ns per bp\n", scalar_time * 1e6, scalar_time * 1e9 / length );
+  printf( "word-parallel search : %12.3f us per search, %8.3f ns per bp\n", scanner_time * 1e6, scanner_time * 1e9 / length );
+  printf( "speedup              : %12.2f\n", scalar_time / scanner_time );
+  
+  delete [] seq;
+  delete [] scalar_pos;
+  delete [] scalar_dist;
+  delete [] scanner_pos;
+  delete [] scanner_dist;
+  
+  if ( ! identical )
+  {
+    printf( "%s: error: the two searches found different promoters.\n", argv[0] );
+    exit( EXIT_FAILURE );
+  }
+  
+  return EXIT_SUCCESS;
+}
+
+
+/*!
+  Base-by-base search, as ae_genetic_unit::locate_promoters used to do it.
+  
+  Promoters are stored in the order locate_promoters adds them to its lists:
+  leading strand first, in increasing order of position, then lagging strand
+  in decreasing order of position (lagging positions are stored as -pos-1).
+*/
+int32_t scalar_search( const char* seq, int32_t len, int32_t* pos, int8_t* dist )
+{
+  int32_t nb_lagging = 0;
+  int32_t nb_found   = 0;
+  int32_t* lagging_pos  = pos + len;
+  int8_t*  lagging_dist = dist + len;
+  
+  for ( int32_t i = 0 ; i < len ; i++ )
+  {
+    int8_t d = 0;
+    for ( int8_t j = 0 ; j < PROM_SIZE && d <= PROM_MAX_DIFF ; j++ )
+    {
+      if ( seq[ae_utils::mod( i + j, len )] != PROM_SEQ[j] ) d++;
+    }
+    if ( d <= PROM_MAX_DIFF )
+    {
+      pos[nb_found] = i;
+      dist[nb_found++] = d;
+    }
+    
+    int32_t p = len - i - 1;
+    d = 0;
+    for ( int8_t j = 0 ; j < PROM_SIZE && d <= PROM_MAX_DIFF ; j++ )
+    {
+      if ( seq[ae_utils::mod( p - j, len )] == PROM_SEQ[j] ) d++;
+    }
+    if ( d <= PROM_MAX_DIFF )
+    {
+      lagging_pos[nb_lagging] = -p - 1;
+      lagging_dist[nb_lagging++] = d;
+    }
+  }
+  
+  for ( int32_t i = 0 ; i < nb_lagging ; i++ )
+  {
+    pos[nb_found] = lagging_pos[i];
+    dist[nb_found++] = lagging_dist[i];
+  }
+  
+  return nb_found;
+}
+
+/*!
+  Word-parallel search, as done by ae_genetic_unit::locate_promoters
+  (same output as scalar_search)
+  
+  The time taken to pack the sequence is included although ae_string keeps
+  genomes packed as they mutate.
+*/
+int32_t scanner_search( const char* seq, int32_t len, int32_t* pos, int8_t* dist )
+{
+  ae_string        packed( seq, len );
+  ae_motif_scanner scanner( &packed );
+  int8_t   block_dist[64];
+  uint64_t found;
+  int32_t  nb_found = 0;
+  
+  for ( int32_t first = 0 ; first < len ; first += 64 )
+  {
+    for ( found = scanner.scan_promoters( LEADING, first, block_dist ) ; found != 0 ; found &= found - 1 )
+    {
+      int8_t j = __builtin_ctzll( found );
+      pos[nb_found] = first + j;
+      dist[nb_found++] = block_dist[j];
+    }
+  }
+  
+  for ( int32_t first = ( ( len - 1 ) / 64 ) * 64 ; first >= 0 ; first -= 64 )
+  {
+    found = scanner.scan_promoters( LAGGING, first, block_dist );
+    while ( found != 0 )
+    {
+      int8_t j = 63 - __builtin_clzll( found );
+      found &= ~( UINT64_C(1) << j );
+      pos[nb_found] = -( first + j ) - 1;
+      dist[nb_found++] = block_dist[j];
+    }
+  }
+  
+  return nb_found;
+}
+
+/*!
+  Return the mean time (in seconds) taken by one search
+*/
+double time_search( int32_t (*search)( const char*, int32_t, int32_t*, int8_t* ),
+                    const char* seq, int32_t len, int32_t* pos, int8_t* dist, int32_t nb_repeats, int32_t& nb_found )
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  
+  for ( int32_t i = 0 ; i < nb_repeats ; i++ )
+  {
+    nb_found = search( seq, len, pos, dist );
+  }
+  
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / nb_repeats;
+}
+
+
+void print_help( char* prog_name )
+{
+  printf( "\n\
+Usage : aevol_bench_promoters -h\n\
+or :    aevol_bench_promoters [-l length] [-n nb_repeats] [-s seed]\n\
+\t-h : display this screen\n\
+\t-l length : length of the random sequence (default: 100000)\n\
+\t-n nb_repeats : number of times each search is repeated (default: 20)\n\
+\t-s seed : seed used to draw the random sequence (default: 1)\n" );
+}
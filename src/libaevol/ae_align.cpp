@@ -30,6 +30,7 @@
 // =================================================================
 //                              Libraries
 // =================================================================
+#include <string.h>
 
 
 
@@ -39,6 +40,7 @@
 #include <ae_align.h>
 #include <ae_utils.h>
 #include <ae_individual.h>
+#include <ae_profiler.h>
 
 
 
@@ -65,6 +67,8 @@
 //int16_t ae_align::align_match_bonus;
 //int16_t ae_align::align_mismatch_cost;
 
+thread_local ae_align::align_buffers ae_align::_buffers;
+
 // =================================================================
 //                             Constructors
 // =================================================================
@@ -79,238 +83,259 @@
 ae_vis_a_vis* ae_align::search_alignment_direct( const ae_dna* chrom_1, const int32_t seed_1,
                                                  const ae_dna* chrom_2, const int32_t seed_2, const int16_t needed_score )
 {
-  ae_vis_a_vis * best_alignment = NULL;
+  return search_alignment( chrom_1, seed_1, chrom_2, seed_2, DIRECT, needed_score );
+}
+
+
+ae_vis_a_vis* ae_align::search_alignment_indirect( const ae_dna* chrom_1, const int32_t seed_1,
+                                                   const ae_dna* chrom_2, const int32_t seed_2, const int16_t needed_score )
+{
+  return search_alignment( chrom_1, seed_1, chrom_2, seed_2, INDIRECT, needed_score );
+}
+
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+/*!
+  Look for an alignment of score at least needed_score between the working
+  zones of chrom_1 and chrom_2 centered on seed_1 and seed_2.
+  
+  The 2 * align_max_shift + 1 diagonals of the band around (seed_1, seed_2)
+  are parsed in the following order: diagonal d starts k_1 = max( S - d, 0 )
+  bases before the working zone of chrom_1 and k_2 = max( d - S, 0 ) bases
+  before that of chrom_2 (S being align_max_shift), and goes on until both
+  working zones have been passed. Along a diagonal, the score is increased by
+  align_match_bonus on each match and decreased by align_mismatch_cost on each
+  mismatch, and it restarts from 0 (from the current position) whenever it
+  drops to 0 or below. The alignment returned is the first one to reach
+  needed_score on the first diagonal where this happens, as if the diagonals
+  were parsed one after the other.
+  
+  In the INDIRECT sense, chrom_2 is read backwards from seed_2 + h_len and
+  the nucleotide facing a breakpoint at position i is that at position i-1
+  (see ae_vis_a_vis). The bases read this way are complemented so that both
+  senses look for identical bases.
+  
+  The bases of both working zones (extended by the band) are first copied,
+  in the order they are read, to buffers that need no wrapping. All the
+  diagonals are then parsed at once, 8 of them per vector. The diagonals
+  that start before the working zone of chrom_1 (d <= S) read consecutive
+  bases of chrom_1 against the same base of chrom_2, the others read the same
+  base of chrom_1 against consecutive bases of chrom_2 (that are hence copied
+  in reverse order).
+*/
+ae_vis_a_vis* ae_align::search_alignment( const ae_dna* chrom_1, const int32_t seed_1,
+                                          const ae_dna* chrom_2, const int32_t seed_2,
+                                          ae_sense sense, const int16_t needed_score )
+{
+  PROFILE_SCOPE( ALIGNMENTS );
+  PROFILE_COUNT( ALIGNMENTS_ATTEMPTED, 1 );
+  
+  int16_t max_shift = chrom_1->get_indiv()->get_align_max_shift();
+  int16_t h_len_1   = chrom_1->get_indiv()->get_align_w_zone_h_len();
+  int16_t h_len_2   = chrom_2->get_indiv()->get_align_w_zone_h_len();
   
-  int16_t nb_diags = 2 * chrom_1->get_indiv()->get_align_max_shift() + 1;
-  ae_vis_a_vis * cur_vav = NULL;
+  // First base of the working zones, in the sense they are read
+  int32_t w_zone_1_first = seed_1 - h_len_1;
+  int32_t w_zone_2_first = ( sense == DIRECT ) ? seed_2 - h_len_2 : seed_2 + h_len_2;
   
-  // TODO : As ae_vis_a_vis now contains its score, we should adapt the code to make it more integrated
-  int16_t cur_score;
+  // Number of vectors of diagonals d <= S and d > S
+  int32_t nb_vec_1  = ( max_shift + ALIGN_NB_LANES ) / ALIGN_NB_LANES;
+  int32_t nb_vec_2  = ( max_shift + ALIGN_NB_LANES - 1 ) / ALIGN_NB_LANES;
+  int32_t nb_vecs   = nb_vec_1 + nb_vec_2;
   
+  // Length of the longest diagonal (diagonals 0 and 2S)
+  int32_t max_length = 2 * ae_utils::max( h_len_1, h_len_2 ) + max_shift + 1;
+  assert( max_length + ALIGN_NB_LANES * nb_vecs <= INT16_MAX );
   
-  // Zone 1 (Indice on the chromosome)
-  int32_t w_zone_1_first  = seed_1 - chrom_1->get_indiv()->get_align_w_zone_h_len();       // First base in working zone 1
-  int32_t w_zone_1_last   = seed_1 + chrom_1->get_indiv()->get_align_w_zone_h_len();       // Last  base in working zone 1
-  int32_t x_zone_1_first  = w_zone_1_first - chrom_1->get_indiv()->get_align_max_shift();  // First base in extended zone 1
-  //~ int32_t x_zone_1_last   = w_zone_1_last  + align_max_shift;  // Last  base in extended zone 1
+  align_buffers& buf = _buffers;
+  buf.reserve( max_length + ALIGN_NB_LANES * nb_vec_1, max_length + ALIGN_NB_LANES * nb_vec_2, nb_vecs );
   
-  // Zone 2 (Indice on the chromosome)
-  int32_t w_zone_2_first  = seed_2 - chrom_2->get_indiv()->get_align_w_zone_h_len();       // First base in working zone 2
-  int32_t w_zone_2_last   = seed_2 + chrom_2->get_indiv()->get_align_w_zone_h_len();       // Last  base in working zone 2
-  //~ int32_t x_zone_2_first  = w_zone_2_first - align_max_shift;  // First base in extended zone 2
-  //~ int32_t x_zone_2_last   = w_zone_2_last  + align_max_shift;  // Last base in extended zone 2
   
-  int32_t w_zone_2_shifted_first = w_zone_2_first + chrom_2->get_indiv()->get_align_max_shift(); // This doesn't represent any point of interest
-                                                                                              // in the sequence but will spare some calculation
+  // -------------------------------------------------------- Linearize the zones
+  // seq_1[j]     : base j - S of the working zone of chrom_1
+  // seq_2[t]     : base t of the working zone of chrom_2 (as read)
+  // rev_seq_2[j] : base max_length - 2 - j of the working zone of chrom_2 (as read)
+  const char* data_1  = chrom_1->get_data();
+  const char* data_2  = chrom_2->get_data();
+  int32_t     len_1   = chrom_1->get_length();
+  int32_t     len_2   = chrom_2->get_length();
+  int32_t     nb_seq_1      = max_length + ALIGN_NB_LANES * nb_vec_1;
+  int32_t     nb_rev_seq_2  = max_length + ALIGN_NB_LANES * nb_vec_2;
   
+  int32_t pos = ae_utils::mod( w_zone_1_first - max_shift, len_1 );
+  for ( int32_t j = 0 ; j < nb_seq_1 ; j++ )
+  {
+    buf.seq_1[j] = data_1[pos];
+    if ( ++pos == len_1 ) pos = 0;
+  }
   
-  // Parse diagonals
-  for ( int16_t cur_diag = 0 ; cur_diag < nb_diags ; cur_diag++ )
+  if ( sense == DIRECT )
   {
-    // Initialize cur_vav according to the diagonal we are on
-    if ( cur_diag < chrom_1->get_indiv()->get_align_max_shift() )
+    pos = ae_utils::mod( w_zone_2_first, len_2 );
+    for ( int32_t t = 0 ; t < max_length ; t++ )
     {
-      cur_vav = new ae_vis_a_vis( chrom_1, chrom_2, x_zone_1_first + cur_diag, w_zone_2_first, DIRECT );
+      buf.seq_2[t] = data_2[pos];
+      if ( ++pos == len_2 ) pos = 0;
     }
-    else if ( cur_diag > chrom_1->get_indiv()->get_align_max_shift() )
+    
+    pos = ae_utils::mod( w_zone_2_first + max_length - 2, len_2 );
+    for ( int32_t j = 0 ; j < nb_rev_seq_2 ; j++ )
     {
-      cur_vav = new ae_vis_a_vis( chrom_1, chrom_2, w_zone_1_first, w_zone_2_shifted_first - cur_diag, DIRECT );
+      buf.rev_seq_2[j] = data_2[pos];
+      if ( --pos < 0 ) pos = len_2 - 1;
     }
-    else // Central diagonal
+  }
+  else // ( sense == INDIRECT )
+  {
+    // Base t of the zone faces breakpoint w_zone_2_first - t, i.e. nucleotide w_zone_2_first - t - 1
+    pos = ae_utils::mod( w_zone_2_first - 1, len_2 );
+    for ( int32_t t = 0 ; t < max_length ; t++ )
     {
-      cur_vav = new ae_vis_a_vis( chrom_1, chrom_2, w_zone_1_first, w_zone_2_first, DIRECT );
+      buf.seq_2[t] = data_2[pos] ^ 1; // Complementary base
+      if ( --pos < 0 ) pos = len_2 - 1;
     }
     
-    // A sequence against itself is not an alignment
-    if ( chrom_1 == chrom_2 && ae_utils::mod(cur_vav->_i_1, chrom_1->get_length()) == ae_utils::mod(cur_vav->_i_2, chrom_2->get_length()) )
+    pos = ae_utils::mod( w_zone_2_first - 1 - ( max_length - 2 ), len_2 );
+    for ( int32_t j = 0 ; j < nb_rev_seq_2 ; j++ )
     {
-      delete cur_vav;
-      continue;
+      buf.rev_seq_2[j] = data_2[pos] ^ 1;
+      if ( ++pos == len_2 ) pos = 0;
     }
-    
-    cur_score = 0;
-    
-    // Parse current diagonal
-    while ( cur_vav->_i_1 <= w_zone_1_last || cur_vav->_i_2 <= w_zone_2_last )
+  }
+  
+  
+  // --------------------------------------------------- Initialize the diagonals
+  // Lane i of vector v is diagonal 8v + i if v < nb_vec_1, diagonal S + 1 + 8(v - nb_vec_1) + i otherwise.
+  // Lanes that do not correspond to any diagonal are given a length of 0 (as the
+  // diagonals on which chrom_1 would face itself, which are not alignments).
+  for ( int32_t v = 0 ; v < nb_vecs ; v++ )
+  {
+    for ( int8_t i = 0 ; i < ALIGN_NB_LANES ; i++ )
     {
-      // Re-initialize score and potential alignment starting point if score <= 0
-      if ( cur_score <= 0 )
-      {
-        cur_score = 0;
-        if ( best_alignment != NULL )
-        {
-          best_alignment->copy( cur_vav );
-        }
-        else
-        {
-          best_alignment = new ae_vis_a_vis( *cur_vav );
-        }
-      }
+      int32_t diag  = ( v < nb_vec_1 ) ? ALIGN_NB_LANES * v + i : max_shift + 1 + ALIGN_NB_LANES * ( v - nb_vec_1 ) + i;
+      int32_t k_1   = ae_utils::max( max_shift - diag, 0 );
+      int32_t k_2   = ae_utils::max( diag - max_shift, 0 );
+      int16_t length = ae_utils::max( 2 * h_len_1 + k_1, 2 * h_len_2 + k_2 ) + 1;
       
-      // Update Score
-      if ( cur_vav->match() )
+      if ( ( v < nb_vec_1 ) ? ( diag > max_shift ) : ( diag > 2 * max_shift ) )
       {
-        cur_score += chrom_1->get_indiv()->get_align_match_bonus();
-        
-        // Check whether score is high enough to rearrange
-        if ( cur_score >= needed_score )
-        {
-          delete cur_vav;
-          best_alignment->check_indices();
-          
-          best_alignment->_score = cur_score;
-          return best_alignment;
-        }
+        length = 0;
       }
-      else
+      else if ( sense == DIRECT && chrom_1 == chrom_2 &&
+                ae_utils::mod( w_zone_1_first - k_1, len_1 ) == ae_utils::mod( w_zone_2_first - k_2, len_2 ) )
       {
-        cur_score -= chrom_1->get_indiv()->get_align_mismatch_cost();
+        length = 0;
       }
       
-      // Step forward
-      cur_vav->step_fwd();
+      buf.length[v][i]  = length;
     }
     
-    delete cur_vav;
-  }
-  
-  
-  if ( best_alignment != NULL )
-  {
-    delete best_alignment;
+    buf.score[v] = ae_align_lanes{};
+    buf.start[v] = ae_align_lanes{};
+    buf.found[v] = ae_align_lanes{};
   }
   
-  return NULL; // Didn't find any alignment with sufficient score.
-}
-
-
-ae_vis_a_vis* ae_align::search_alignment_indirect( const ae_dna* chrom_1, const int32_t seed_1,
-                                                   const ae_dna* chrom_2, const int32_t seed_2, const int16_t needed_score )
-{
-  ae_vis_a_vis * best_alignment = NULL;
-  
-  int16_t nb_diags = 2 * chrom_1->get_indiv()->get_align_max_shift() + 1;
-  int16_t cur_score;
-  ae_vis_a_vis * cur_vav = NULL;
-  
-  // Zone 1 (Indice on the chromosome)
-  int32_t w_zone_1_first  = seed_1 - chrom_1->get_indiv()->get_align_w_zone_h_len();       // First base in working zone 1
-  int32_t w_zone_1_last   = seed_1 + chrom_1->get_indiv()->get_align_w_zone_h_len();       // Last  base in working zone 1
-  int32_t x_zone_1_first  = w_zone_1_first - chrom_1->get_indiv()->get_align_max_shift();  // First base in extended zone 1
-  //~ int32_t x_zone_1_last   = w_zone_1_last  + align_max_shift;  // Last  base in extended zone 1
-  
-  // Zone 2 (Indice on the chromosome)
-  // ********** WARNING **********
-  // Because we are reading backwards, every read is shifted by -1.
-  //
-  //    0 1 2 3 4 5 6 7 8 9
-  //    |_|_|_|_|_|_|_|_|_|_|   On this sequence, if you consider index 5, the nucleotide you need to consider 
-  //                            for a backards read is seq[4], NOT seq[5].
-  //
-  // This is managed by class ae_vis_a_vis.
-  //
-  //    a b c d e f g h i j       Creating a new ae_vis_a_vis( F, 5, LAGGING );
-  //    |_|_|_|_|_|_|_|_|_|_|     and then asking: my_vis_a_vis->match() will compare seq1[F] and seq2[4]
-  //    | | | | | | | | | | |     (i.e. its "real" vis_a_vis).
-  //      9 8 7 6 5 4 3 2 1 0     my_vis_a_vis->match() returns true if (seq1[F] == complementary( seq2[4] ))
-  //
-  // In this example and with a align_w_zone_h_len of 2 and a max_shift of 1, the working_zone and extended_zone will be defined by
-  // w_zone_1_first = d   // (f-2)
-  // w_zone_1_last  = h   // (f+2)
-  // x_zone_1_first = c   // (f-2-1)
-  // w_zone_2_first = 7   // The "real" vis_a_vis for d (5+2)
-  // w_zone_2_last  = 3   // The "real" vis_a_vis for h (5-2)
-  // w_zone_2_shifted_first = 4 // (5-1).
-  //
-  // It is worth noting that the working zone is defined as follows:
-  //
-  //    d e f g h       Hence, while 'd' and 'h' do correspond to the zone's first and last nucleotides' indices, 
-  //    |_|_|_|_|_|     '7' and '3' are indeed shifted and it seems they don't correspond to anything.
-  //    | | | | | |     I should have coded the limits (i.e. 'd' and 'i' + '7' and '2') in the first place...
-  //      6 5 4 3 2
-  //
-  int32_t w_zone_2_first  = seed_2 + chrom_2->get_indiv()->get_align_w_zone_h_len();       // First base in working zone 2
-  int32_t w_zone_2_last   = seed_2 - chrom_2->get_indiv()->get_align_w_zone_h_len();       // Last  base in working zone 2
-  //~ int32_t x_zone_2_first  = w_zone_2_first + align_max_shift;  // First base in extended zone 2
-  //~ int32_t x_zone_2_last   = w_zone_2_last  - align_max_shift;  // Last  base in extended zone 2
   
-  int32_t w_zone_2_shifted_first = w_zone_2_first - chrom_2->get_indiv()->get_align_max_shift(); // This doesn't represent any interesting point
-                                                                                              // in the sequence but will spare some calculation
+  // ----------------------------------------------------- Parse the diagonals
+  ae_align_lanes bonus  = ae_align_lanes{} + chrom_1->get_indiv()->get_align_match_bonus();
+  ae_align_lanes cost   = ae_align_lanes{} + chrom_1->get_indiv()->get_align_mismatch_cost();
+  ae_align_lanes needed = ae_align_lanes{} + needed_score;
+  bool found_any = false;
   
-  
-  // Parse diagonals
-  for ( int16_t cur_diag = 0 ; cur_diag < nb_diags ; cur_diag++ )
+  for ( int32_t t = 0 ; t < max_length ; t++ )
   {
-    // Initialize cur_vav according to the diagonal we are on
-    if ( cur_diag < chrom_1->get_indiv()->get_align_max_shift() )
-    {
-      cur_vav = new ae_vis_a_vis( chrom_1, chrom_2, x_zone_1_first + cur_diag, w_zone_2_first, INDIRECT );
-    }
-    else if ( cur_diag > chrom_1->get_indiv()->get_align_max_shift() )
-    {
-      cur_vav = new ae_vis_a_vis( chrom_1, chrom_2, w_zone_1_first, w_zone_2_shifted_first + cur_diag, INDIRECT );
-    }
-    else // Central diagonal
-    {
-      cur_vav = new ae_vis_a_vis( chrom_1, chrom_2, w_zone_1_first, w_zone_2_first, INDIRECT );
-    }
-    
-    cur_score = 0;
+    ae_align_lanes cur_t = ae_align_lanes{} + (int16_t) t;
+    ae_align_lanes found_now = ae_align_lanes{};
     
-    
-    // Parse diagonal
-    while ( cur_vav->_i_1 <= w_zone_1_last || cur_vav->_i_2 >= w_zone_2_last )
+    for ( int32_t v = 0 ; v < nb_vecs ; v++ )
     {
-      // Re-initialize score and potential alignment starting point if score <= 0
-      if ( cur_score <= 0 )
-      {
-        cur_score = 0;
-        if ( best_alignment != NULL )
-        {
-          best_alignment->copy( cur_vav );
-        }
-        else
-        {
-          best_alignment = new ae_vis_a_vis( *cur_vav );
-        }
-      }
-      
-      // Update Score
-      if ( cur_vav->match() )
+      ae_align_lanes base_1, base_2;
+      if ( v < nb_vec_1 )
       {
-        cur_score += chrom_1->get_indiv()->get_align_match_bonus();
-        
-        // Check whether score is high enough to rearrange
-        if ( cur_score >= needed_score )
-        {
-          delete cur_vav;
-          best_alignment->check_indices();
-          
-          best_alignment->_score = cur_score;
-          return best_alignment;
-        }
+        memcpy( &base_1, &buf.seq_1[ALIGN_NB_LANES * v + t], sizeof(base_1) );
+        base_2 = ae_align_lanes{} + buf.seq_2[t];
       }
       else
       {
-        cur_score -= chrom_1->get_indiv()->get_align_mismatch_cost();
+        base_1 = ae_align_lanes{} + buf.seq_1[max_shift + t];
+        memcpy( &base_2, &buf.rev_seq_2[max_length - 1 + ALIGN_NB_LANES * ( v - nb_vec_1 ) - t], sizeof(base_2) );
       }
       
-      // Step forward
-      cur_vav->step_fwd();
+      ae_align_lanes match  = ( base_1 == base_2 );
+      ae_align_lanes active = ( cur_t < buf.length[v] ) & ~buf.found[v];
+      
+      // Restart the score (and the alignment) where it is not positive
+      ae_align_lanes restart = ( buf.score[v] <= 0 ) & active;
+      buf.score[v] &= ~restart;
+      buf.start[v] = ( buf.start[v] & ~restart ) | ( cur_t & restart );
+      
+      buf.score[v] += ( ( match & bonus ) - ( ~match & cost ) ) & active;
+      
+      ae_align_lanes found = active & match & ( buf.score[v] >= needed );
+      buf.found[v] |= found;
+      found_now |= found;
     }
     
-    delete cur_vav;
+    for ( int8_t i = 0 ; i < ALIGN_NB_LANES ; i++ )
+    {
+      found_any = found_any || found_now[i];
+    }
+    
+    // Once an alignment has been found, stop as soon as it is known that no
+    // diagonal parsed before its own can yield one
+    if ( found_any && first_found_is_final( buf, nb_vecs, t ) ) break;
+  }
+  
+  if ( ! found_any ) return NULL; // Didn't find any alignment with sufficient score.
+  
+  
+  // ------------------------------------------------ Build the first alignment
+  int32_t v, i;
+  for ( v = 0 ; v < nb_vecs ; v++ )
+  {
+    for ( i = 0 ; i < ALIGN_NB_LANES && ! buf.found[v][i] ; i++ );
+    if ( i < ALIGN_NB_LANES ) break;
   }
   
+  int32_t diag  = ( v < nb_vec_1 ) ? ALIGN_NB_LANES * v + i : max_shift + 1 + ALIGN_NB_LANES * ( v - nb_vec_1 ) + i;
+  int32_t k_1   = ae_utils::max( max_shift - diag, 0 );
+  int32_t k_2   = ae_utils::max( diag - max_shift, 0 );
+  int32_t start = buf.start[v][i];
   
-  if ( best_alignment != NULL )
+  ae_vis_a_vis* alignment;
+  if ( sense == DIRECT )
+  {
+    alignment = new ae_vis_a_vis( chrom_1, chrom_2, w_zone_1_first - k_1 + start, w_zone_2_first - k_2 + start, DIRECT );
+  }
+  else
   {
-    delete best_alignment;
+    alignment = new ae_vis_a_vis( chrom_1, chrom_2, w_zone_1_first - k_1 + start, w_zone_2_first + k_2 - start, INDIRECT );
   }
+  alignment->check_indices();
+  alignment->_score = buf.score[v][i];
   
-  return NULL; // Didn't find any alignment with sufficient score.
+  PROFILE_COUNT( ALIGNMENTS_FOUND, 1 );
+  return alignment;
 }
 
-// =================================================================
-//                           Protected Methods
-// =================================================================
+/*!
+  Whether the first diagonal (see search_alignment) on which an alignment has
+  been found is preceded only by diagonals that have been parsed to their end
+  after step t, i.e. whether this alignment is the one to be returned
+*/
+bool ae_align::first_found_is_final( const align_buffers& buf, int32_t nb_vecs, int32_t t )
+{
+  // Lanes are in the same order as the diagonals
+  for ( int32_t v = 0 ; v < nb_vecs ; v++ )
+  {
+    for ( int8_t i = 0 ; i < ALIGN_NB_LANES ; i++ )
+    {
+      if ( buf.found[v][i] ) return true;
+      if ( buf.length[v][i] > t + 1 ) return false;
+    }
+  }
+  
+  return false;
+}
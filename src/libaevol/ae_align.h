@@ -33,6 +33,7 @@
 //                              Libraries
 // =================================================================
 #include <inttypes.h>
+#include <vector>
 
 
 
@@ -50,6 +51,10 @@
 // =================================================================
 class ae_dna;
 
+// Diagonals scored at once by the alignment search (int16_t lanes of a 128-bit vector)
+#define ALIGN_NB_LANES  8
+typedef int16_t ae_align_lanes __attribute__ ((vector_size (ALIGN_NB_LANES * sizeof(int16_t))));
+
 
 
 
@@ -122,13 +127,35 @@ class ae_align : public ae_object
     };
 
 
+    // =================================================================
+    //                           Protected Types
+    // =================================================================
+    // Per-thread scratch space of search_alignment, only ever grown
+    struct align_buffers
+    {
+      std::vector<int16_t>        seq_1;      // Extended working zone of chrom_1, linearized
+      std::vector<int16_t>        seq_2;      // Extended working zone of chrom_2, linearized (in the sense it is read)
+      std::vector<int16_t>        rev_seq_2;  // Same as seq_2 in reverse order
+      std::vector<ae_align_lanes> length;     // Number of steps of each diagonal (0 for the ignored ones)
+      std::vector<ae_align_lanes> score;      // Current score on each diagonal
+      std::vector<ae_align_lanes> start;      // Step at which the current potential alignment started
+      std::vector<ae_align_lanes> found;      // Whether an alignment has been found on each diagonal
+      
+      inline void reserve( int32_t seq_1_size, int32_t seq_2_size, int32_t nb_vecs );
+    };
+
     // =================================================================
     //                           Protected Methods
     // =================================================================
+    static ae_vis_a_vis* search_alignment( const ae_dna* chrom_1, const int32_t seed_1,
+                                           const ae_dna* chrom_2, const int32_t seed_2,
+                                           ae_sense sense, const int16_t needed_score );
+    static bool first_found_is_final( const align_buffers& buf, int32_t nb_vecs, int32_t t );
 
     // =================================================================
     //                          Protected Attributes
     // =================================================================
+    static thread_local align_buffers _buffers;
 };
 
 
@@ -139,6 +166,22 @@ class ae_align : public ae_object
 // =====================================================================
 //                       Inline functions' definition
 // =====================================================================
+inline void ae_align::align_buffers::reserve( int32_t seq_1_size, int32_t seq_2_size, int32_t nb_vecs )
+{
+  if ( (int32_t) seq_1.size() < seq_1_size ) seq_1.resize( seq_1_size );
+  if ( (int32_t) seq_2.size() < seq_2_size )
+  {
+    seq_2.resize( seq_2_size );
+    rev_seq_2.resize( seq_2_size );
+  }
+  if ( (int32_t) length.size() < nb_vecs )
+  {
+    length.resize( nb_vecs );
+    score.resize( nb_vecs );
+    start.resize( nb_vecs );
+    found.resize( nb_vecs );
+  }
+}
 
 
 #endif // __AE_ALIGN_H__
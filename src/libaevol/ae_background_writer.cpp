@@ -0,0 +1,346 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <set>
+#include <string>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_background_writer.h>
+#include <ae_block_backup.h>
+
+
+
+
+//##############################################################################
+//                                                                             #
+//                         Class ae_background_writer                          #
+//                                                                             #
+//##############################################################################
+
+// =================================================================
+//                    Definition of static attributes
+// =================================================================
+
+// =================================================================
+//                             Constructors
+// =================================================================
+ae_background_writer::ae_background_writer( int16_t nb_threads /*= 1*/, int32_t queue_size /*= BACKGROUND_WRITER_QUEUE_SIZE*/ )
+{
+  _queue_size   = ( queue_size > 0 ) ? queue_size : 1;
+  _thread_pool  = new ae_thread_pool( nb_threads );
+  _stop       = false;
+  _worker     = std::thread( &ae_background_writer::work, this );
+}
+
+// =================================================================
+//                             Destructors
+// =================================================================
+ae_background_writer::~ae_background_writer( void )
+{
+  // Files that were opened but never committed are written anyway
+  commit();
+  wait();
+  
+  {
+    std::unique_lock<std::mutex> lock( _mutex );
+    _stop = true;
+  }
+  _batch_available.notify_all();
+  
+  _worker.join();
+  
+  delete _thread_pool;
+}
+
+// =================================================================
+//                            Public Methods
+// =================================================================
+/*!
+  Open file_name for writing (as a block backup if indexed)
+
+  The returned gzFile must be closed with gzclose before the next commit.
+*/
+gzFile ae_background_writer::open( const char* file_name, bool indexed /*= false*/ )
+{
+  pending_file file;
+  file.raw          = open_snapshot( file_name );
+  file.name         = strdup( file_name );
+  file.entry_starts = indexed ? new std::vector<int64_t>() : NULL;
+  
+  gzFile gz_file = NULL;
+  if ( file.raw != NULL )
+  {
+    // Transparent (uncompressed) writing into a descriptor of our own, since gzclose closes it
+    gz_file = gzdopen( dup( fileno( file.raw ) ), "wT" );
+  }
+  
+  if ( gz_file == NULL )
+  {
+    printf( "%s:%d: error: could not open file %s" BACKGROUND_WRITER_SNAPSHOT_SUFFIX "\n", __FILE__, __LINE__, file_name );
+    exit( EXIT_FAILURE );
+  }
+  
+  file.gz_file = gz_file;
+  _open_files.push_back( file );
+  
+  return gz_file;
+}
+
+/*!
+  Positions (in the uncompressed content) at which the entries of file start
+
+  file must have been opened as indexed and not be closed yet.
+*/
+std::vector<int64_t>* ae_background_writer::get_entry_starts( gzFile file )
+{
+  for ( size_t i = 0 ; i < _open_files.size() ; i++ )
+  {
+    if ( _open_files[i].gz_file == file )
+    {
+      assert( _open_files[i].entry_starts != NULL );
+      return _open_files[i].entry_starts;
+    }
+  }
+  
+  printf( "%s:%d: error: file was not opened by this writer\n", __FILE__, __LINE__ );
+  exit( EXIT_FAILURE );
+}
+
+/*!
+  Hand the files opened since the last commit over to the writer thread
+
+  If num_gener is not -1, LAST_GENER_FNAME will be updated with it once these
+  files (and all those committed before) are written.
+  Block while there already are as many pending batches as the queue can hold.
+*/
+void ae_background_writer::commit( int32_t num_gener /*= -1*/ )
+{
+  if ( _open_files.empty() && num_gener == -1 ) return;
+  
+  batch* new_batch = new batch;
+  new_batch->files.swap( _open_files );
+  new_batch->num_gener = num_gener;
+  
+  {
+    std::unique_lock<std::mutex> lock( _mutex );
+    while ( (int32_t) _queue.size() >= _queue_size )
+    {
+      _batch_done.wait( lock );
+    }
+    _queue.push_back( new_batch );
+  }
+  _batch_available.notify_one();
+}
+
+/*!
+  Wait until every committed file is written
+*/
+void ae_background_writer::wait( void )
+{
+  std::unique_lock<std::mutex> lock( _mutex );
+  while ( ! _queue.empty() )
+  {
+    _batch_done.wait( lock );
+  }
+}
+
+/*!
+  Write num_gener into LAST_GENER_FNAME
+
+  The new content is written aside and renamed, so that the file is never seen
+  empty or truncated. Both the file and the renaming are flushed to the disk.
+*/
+void ae_background_writer::write_last_gener_file( int32_t num_gener )
+{
+  FILE* last_gener_file = fopen( LAST_GENER_FNAME".tmp", "w" );
+  if ( last_gener_file != NULL )
+  {
+    fprintf( last_gener_file, "%"PRId32"\n", num_gener );
+    fflush( last_gener_file );
+    fsync( fileno( last_gener_file ) );
+    fclose( last_gener_file );
+    
+    rename( LAST_GENER_FNAME".tmp", LAST_GENER_FNAME );
+    sync_to_disk( "." );
+  }
+  else
+  {
+    printf( "Error : could not open file "LAST_GENER_FNAME"\n" );
+  }
+}
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+/*!
+  Create the file holding the uncompressed content of file_name until it is written
+
+  It lies next to file_name (as file_name.tmp), on the same file system,
+  rather than in the system's temporary directory which is often small.
+  It is unlinked right away: it disappears once closed (or if the run
+  crashes), and pending files sharing a name do not clash.
+*/
+FILE* ae_background_writer::open_snapshot( const char* file_name )
+{
+  char* snapshot_name = new char[strlen( file_name ) + strlen( BACKGROUND_WRITER_SNAPSHOT_SUFFIX ) + 1];
+  sprintf( snapshot_name, "%s" BACKGROUND_WRITER_SNAPSHOT_SUFFIX, file_name );
+  
+  FILE* snapshot = fopen( snapshot_name, "w+" );
+  if ( snapshot != NULL ) unlink( snapshot_name );
+  
+  delete [] snapshot_name;
+  return snapshot;
+}
+
+/*!
+  Flush the content of path (a file or a directory) to the disk
+*/
+void ae_background_writer::sync_to_disk( const char* path )
+{
+  int fd = ::open( path, O_RDONLY );
+  if ( fd == -1 || fsync( fd ) != 0 )
+  {
+    printf( "%s:%d: warning: could not flush %s to the disk\n", __FILE__, __LINE__, path );
+  }
+  if ( fd != -1 ) close( fd );
+}
+
+void ae_background_writer::work( void )
+{
+  while ( true )
+  {
+    batch* to_write;
+    {
+      std::unique_lock<std::mutex> lock( _mutex );
+      while ( ! _stop && _queue.empty() )
+      {
+        _batch_available.wait( lock );
+      }
+      if ( _queue.empty() ) return;
+      
+      // The batch stays in the queue until it is written (see wait)
+      to_write = _queue.front();
+    }
+    
+    write_batch( to_write );
+    delete to_write;
+    
+    {
+      std::unique_lock<std::mutex> lock( _mutex );
+      _queue.pop_front();
+    }
+    _batch_done.notify_all();
+  }
+}
+
+/*!
+  Write the files of to_write, then update LAST_GENER_FNAME if required
+
+  Each file is compressed into file_name.part, flushed to the disk and renamed
+  over file_name, like LAST_GENER_FNAME: a previous version of the file is
+  never seen truncated. The directories the files are in are then flushed too
+  before LAST_GENER_FNAME is updated: after a crash, the generation it refers
+  to can always be resumed.
+*/
+void ae_background_writer::write_batch( batch* to_write )
+{
+  char* buffer = new char[BACKGROUND_WRITER_BUFFER_SIZE];
+  std::set<std::string> directories;
+  
+  for ( size_t i = 0 ; i < to_write->files.size() ; i++ )
+  {
+    pending_file& file = to_write->files[i];
+    
+    const char* slash = strrchr( file.name, '/' );
+    directories.insert( ( slash == NULL ) ? std::string( "." ) :
+                        ( slash == file.name ) ? std::string( "/" ) : std::string( file.name, slash - file.name ) );
+    
+    std::string partial_name = std::string( file.name ) + BACKGROUND_WRITER_PARTIAL_SUFFIX;
+    
+    if ( file.entry_starts != NULL )
+    {
+      ae_block_backup::write( partial_name.c_str(), file.raw, *file.entry_starts, _thread_pool );
+      delete file.entry_starts;
+    }
+    else
+    {
+      gzFile gz_file = gzopen( partial_name.c_str(), "w" );
+      if ( gz_file == Z_NULL )
+      {
+        printf( "%s:%d: error: could not open file %s\n", __FILE__, __LINE__, partial_name.c_str() );
+        exit( EXIT_FAILURE );
+      }
+      
+      rewind( file.raw );
+      size_t nb_read;
+      while ( ( nb_read = fread( buffer, 1, BACKGROUND_WRITER_BUFFER_SIZE, file.raw ) ) > 0 )
+      {
+        gzwrite( gz_file, buffer, nb_read );
+      }
+      
+      if ( gzclose( gz_file ) != Z_OK )
+      {
+        printf( "%s:%d: error: could not write file %s\n", __FILE__, __LINE__, partial_name.c_str() );
+        exit( EXIT_FAILURE );
+      }
+    }
+    
+    sync_to_disk( partial_name.c_str() );
+    if ( rename( partial_name.c_str(), file.name ) != 0 )
+    {
+      printf( "%s:%d: error: could not rename %s into %s\n", __FILE__, __LINE__, partial_name.c_str(), file.name );
+      exit( EXIT_FAILURE );
+    }
+    
+    fclose( file.raw );
+    free( file.name );
+  }
+  
+  delete [] buffer;
+  
+  for ( std::set<std::string>::iterator dir = directories.begin() ; dir != directories.end() ; dir++ )
+  {
+    sync_to_disk( dir->c_str() );
+  }
+  
+  if ( to_write->num_gener != -1 )
+  {
+    write_last_gener_file( to_write->num_gener );
+  }
+}
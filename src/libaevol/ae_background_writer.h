@@ -0,0 +1,200 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+/*!
+  \class ae_background_writer
+  
+  \brief Compresses and writes output files on a thread of its own
+  
+  open( file_name ) returns a gzFile that merely stores what is written to it
+  (uncompressed) in a temporary file next to file_name, which is cheap. Once these files have
+  been closed, commit() hands them over to the writer thread, which compresses
+  them while the simulation goes on. Each one is written under a temporary
+  name and renamed over file_name once complete and flushed to the disk.
+  
+  Files opened as indexed are written as block backups (see ae_block_backup),
+  on a pool of nb_threads threads, whose entries start at the positions stored
+  in get_entry_starts( file ) before the file is closed.
+  
+  Committed batches are written in order. A batch may end by updating the
+  LAST_GENER_FNAME file, which hence only ever refers to a generation whose
+  files are complete and flushed to the disk. At most queue_size batches may
+  be pending: commit() blocks while the queue is full.
+*/
+
+
+#ifndef __AE_BACKGROUND_WRITER_H__
+#define __AE_BACKGROUND_WRITER_H__
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <zlib.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_macros.h>
+#include <ae_object.h>
+#include <ae_thread_pool.h>
+
+
+
+
+// =================================================================
+//                          Class declarations
+// =================================================================
+
+
+
+
+
+
+class ae_background_writer : public ae_object
+{
+  public :
+    // =================================================================
+    //                             Constructors
+    // =================================================================
+    ae_background_writer( int16_t nb_threads = 1, int32_t queue_size = BACKGROUND_WRITER_QUEUE_SIZE );
+
+    // =================================================================
+    //                             Destructors
+    // =================================================================
+    virtual ~ae_background_writer( void );
+
+    // =================================================================
+    //                        Accessors: getters
+    // =================================================================
+
+    // =================================================================
+    //                        Accessors: setters
+    // =================================================================
+
+    // =================================================================
+    //                              Operators
+    // =================================================================
+
+    // =================================================================
+    //                            Public Methods
+    // =================================================================
+    gzFile open( const char* file_name, bool indexed = false );
+    std::vector<int64_t>* get_entry_starts( gzFile file );
+    void   commit( int32_t num_gener = -1 );
+    void   wait( void );
+    
+    static void write_last_gener_file( int32_t num_gener );
+
+    // =================================================================
+    //                           Public Attributes
+    // =================================================================
+
+
+
+
+
+  protected :
+
+    // =================================================================
+    //                         Forbidden Constructors
+    // =================================================================
+    ae_background_writer( const ae_background_writer &model )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+    
+    // A file waiting to be compressed (raw holds its uncompressed content)
+    struct pending_file
+    {
+      FILE*   raw;
+      char*   name;
+      gzFile  gz_file;                      // Only valid until the file is closed
+      std::vector<int64_t>* entry_starts;   // NULL if the file is not indexed
+    };
+    
+    // A batch of files, possibly followed by the update of LAST_GENER_FNAME
+    struct batch
+    {
+      std::vector<pending_file> files;
+      int32_t                   num_gener; // -1 if LAST_GENER_FNAME is not to be updated
+    };
+
+
+    // =================================================================
+    //                           Protected Methods
+    // =================================================================
+    static FILE* open_snapshot( const char* file_name );
+    static void  sync_to_disk( const char* path );
+    void work( void );
+    void write_batch( batch* to_write );
+
+    // =================================================================
+    //                          Protected Attributes
+    // =================================================================
+    int32_t         _queue_size;
+    ae_thread_pool* _thread_pool; // Compresses the blocks of indexed files
+    
+    std::vector<pending_file> _open_files; // Files opened since the last commit
+    
+    std::thread             _worker;
+    std::mutex              _mutex;
+    std::condition_variable _batch_available;
+    std::condition_variable _batch_done;
+    std::deque<batch*>      _queue;        // Includes the batch being written
+    bool                    _stop;
+};
+
+
+// =====================================================================
+//                           Getters' definitions
+// =====================================================================
+
+// =====================================================================
+//                           Setters' definitions
+// =====================================================================
+
+// =====================================================================
+//                          Operators' definitions
+// =====================================================================
+
+// =====================================================================
+//                       Inline functions' definition
+// =====================================================================
+
+
+#endif // __AE_BACKGROUND_WRITER_H__
@@ -0,0 +1,430 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_block_backup.h>
+#include <ae_thread_pool.h>
+
+
+
+
+//##############################################################################
+//                                                                             #
+//                            Class ae_block_backup                            #
+//                                                                             #
+//##############################################################################
+
+// =================================================================
+//                    Definition of static attributes
+// =================================================================
+// An empty gzip member is made of a 10-byte header, the extra field (XLEN,
+// then a subfield: SI1, SI2, LEN and the payload), an empty deflate block and
+// an 8-byte trailer (CRC32 and ISIZE of the content)
+static const int32_t  EMPTY_MEMBER_OVERHEAD = 10 + 2 + 4 + 2 + 8;
+static const int32_t  GZIP_FEXTRA           = 0x04;   // Flag of the gzip header telling there is an extra field
+static const int32_t  MAX_PAYLOAD_SIZE      = 65535 - 4;
+
+static const char     INDEX_SUBFIELD[2]     = { 'A', 'i' };
+static const char     TRAILER_SUBFIELD[2]   = { 'A', 't' };
+static const int32_t  TRAILER_PAYLOAD_SIZE  = sizeof(int64_t) + sizeof(int32_t);  // Offset of the index, version
+static const int32_t  TRAILER_SIZE          = EMPTY_MEMBER_OVERHEAD + TRAILER_PAYLOAD_SIZE;
+static const int32_t  INDEX_HEADER_SIZE     = 2 * sizeof(int32_t) + sizeof(int64_t); // Numbers of blocks and entries, raw size
+static const int32_t  BLOCK_BACKUP_VERSION  = 2;
+
+// =================================================================
+//                             Constructors
+// =================================================================
+/*!
+  Read the index of file_name (if any, see is_indexed)
+*/
+ae_block_backup::ae_block_backup( const char* file_name )
+{
+  _file_name      = strdup( file_name );
+  _nb_blocks      = 0;
+  _nb_entries     = 0;
+  _raw_size       = 0;
+  _block_offsets  = NULL;
+  _block_starts   = NULL;
+  _entry_starts   = NULL;
+  
+  FILE* file = fopen( file_name, "r" );
+  if ( file != NULL )
+  {
+    if ( ! read_index( file ) )
+    {
+      _nb_blocks  = 0;
+      _nb_entries = 0;
+    }
+    fclose( file );
+  }
+}
+
+// =================================================================
+//                             Destructors
+// =================================================================
+ae_block_backup::~ae_block_backup( void )
+{
+  free( _file_name );
+  delete [] _block_offsets;
+  delete [] _block_starts;
+  delete [] _entry_starts;
+}
+
+// =================================================================
+//                            Public Methods
+// =================================================================
+/*!
+  Open the file for reading at the start of the entry-th entry
+
+  Only the block the entry belongs to is decompressed (up to the entry).
+  The returned gzFile must be closed with gzclose.
+*/
+gzFile ae_block_backup::open_entry( int32_t entry ) const
+{
+  assert( is_indexed() && entry >= 0 && entry < _nb_entries );
+  
+  // Last block starting before the entry
+  int32_t block = std::upper_bound( _block_starts, _block_starts + _nb_blocks, _entry_starts[entry] ) - _block_starts - 1;
+  
+  int fd = open( _file_name, O_RDONLY );
+  gzFile gz_file = NULL;
+  if ( fd != -1 && lseek( fd, _block_offsets[block], SEEK_SET ) != -1 )
+  {
+    gz_file = gzdopen( fd, "r" );
+  }
+  
+  if ( gz_file == NULL ||
+       gzseek( gz_file, _entry_starts[entry] - _block_starts[block], SEEK_SET ) == -1 )
+  {
+    printf( "%s:%d: error: could not read entry %"PRId32" of %s\n", __FILE__, __LINE__, entry, _file_name );
+    exit( EXIT_FAILURE );
+  }
+  
+  return gz_file;
+}
+
+/*!
+  Write the raw content of raw_file into file_name as a block backup
+
+  entry_starts are the positions of the entries in the raw content, in
+  increasing order. The blocks are compressed on thread_pool (if not NULL).
+  They are read, compressed and written a batch (of as many blocks as there
+  are threads) at a time: only the blocks of a batch are held in memory.
+*/
+void ae_block_backup::write( const char* file_name, FILE* raw_file, const std::vector<int64_t>& entry_starts,
+                             ae_thread_pool* thread_pool /*= NULL*/ )
+{
+  // 1) Cut the raw content into blocks (between entries)
+  fseeko( raw_file, 0, SEEK_END );
+  int64_t raw_size = ftello( raw_file );
+  rewind( raw_file );
+  
+  std::vector<int64_t> block_starts( 1, 0 );
+  for ( size_t i = 0 ; i < entry_starts.size() ; i++ )
+  {
+    if ( entry_starts[i] - block_starts.back() >= BLOCK_BACKUP_BLOCK_SIZE )
+    {
+      block_starts.push_back( entry_starts[i] );
+    }
+  }
+  int32_t nb_blocks = block_starts.size();
+  
+  // 2) Compress each block into a gzip member of its own and write it
+  FILE* file = fopen( file_name, "w" );
+  if ( file == NULL )
+  {
+    printf( "%s:%d: error: could not open file %s\n", __FILE__, __LINE__, file_name );
+    exit( EXIT_FAILURE );
+  }
+  
+  int32_t batch_size = ( thread_pool != NULL ) ? thread_pool->get_nb_threads() : 1;
+  std::vector< std::vector<Bytef> > raw_blocks( batch_size );
+  std::vector< std::vector<Bytef> > members( batch_size );
+  std::vector<uLong>                member_sizes( batch_size );
+  
+  std::vector<int64_t> block_offsets( nb_blocks );
+  int64_t offset = 0;
+  
+  for ( int32_t first_block = 0 ; first_block < nb_blocks ; first_block += batch_size )
+  {
+    int32_t nb_blocks_in_batch = std::min( batch_size, nb_blocks - first_block );
+    
+    // Read the raw content of the blocks of the batch
+    for ( int32_t i = 0 ; i < nb_blocks_in_batch ; i++ )
+    {
+      int32_t block = first_block + i;
+      int64_t end   = ( block < nb_blocks - 1 ) ? block_starts[block + 1] : raw_size;
+      
+      raw_blocks[i].resize( end - block_starts[block] );
+      if ( fread( raw_blocks[i].data(), 1, raw_blocks[i].size(), raw_file ) != raw_blocks[i].size() )
+      {
+        printf( "%s:%d: error: could not read the content of %s\n", __FILE__, __LINE__, file_name );
+        exit( EXIT_FAILURE );
+      }
+    }
+    
+    auto compress_block = [&]( int32_t i )
+    {
+      z_stream stream;
+      stream.zalloc = Z_NULL;
+      stream.zfree  = Z_NULL;
+      stream.opaque = Z_NULL;
+      deflateInit2( &stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY );
+      
+      members[i].resize( deflateBound( &stream, raw_blocks[i].size() ) );
+      
+      stream.next_in    = raw_blocks[i].data();
+      stream.avail_in   = raw_blocks[i].size();
+      stream.next_out   = members[i].data();
+      stream.avail_out  = members[i].size();
+      
+      if ( deflate( &stream, Z_FINISH ) != Z_STREAM_END )
+      {
+        printf( "%s:%d: error: could not compress block %"PRId32" of %s\n", __FILE__, __LINE__, first_block + i, file_name );
+        exit( EXIT_FAILURE );
+      }
+      
+      member_sizes[i] = stream.total_out;
+      deflateEnd( &stream );
+    };
+    
+    if ( thread_pool != NULL )
+    {
+      thread_pool->run( nb_blocks_in_batch, compress_block );
+    }
+    else
+    {
+      for ( int32_t i = 0 ; i < nb_blocks_in_batch ; i++ ) compress_block( i );
+    }
+    
+    for ( int32_t i = 0 ; i < nb_blocks_in_batch ; i++ )
+    {
+      block_offsets[first_block + i] = offset;
+      fwrite( members[i].data(), 1, member_sizes[i], file );
+      offset += member_sizes[i];
+    }
+  }
+  
+  // 3) Write the index and the trailer
+  //    Each entry start is stored relative to the previous entry of its block
+  //    (or to the block start), hence as a small int32_t, and the tables are
+  //    deflated
+  int32_t nb_entries = entry_starts.size();
+  std::vector<int32_t> block_first_entries( nb_blocks );
+  std::vector<int32_t> entry_deltas( nb_entries );
+  for ( int32_t block = 0 ; block < nb_blocks ; block++ )
+  {
+    block_first_entries[block] = std::lower_bound( entry_starts.begin(), entry_starts.end(), block_starts[block] ) -
+                                 entry_starts.begin();
+  }
+  for ( int32_t block = 0 ; block < nb_blocks ; block++ )
+  {
+    int32_t end = ( block < nb_blocks - 1 ) ? block_first_entries[block + 1] : nb_entries;
+    for ( int32_t entry = block_first_entries[block] ; entry < end ; entry++ )
+    {
+      entry_deltas[entry] = entry_starts[entry] -
+                            ( ( entry > block_first_entries[block] ) ? entry_starts[entry - 1] : block_starts[block] );
+    }
+  }
+  
+  std::vector<char> tables;
+  tables.insert( tables.end(), (char*) block_offsets.data(), (char*) ( block_offsets.data() + nb_blocks ) );
+  tables.insert( tables.end(), (char*) block_starts.data(), (char*) ( block_starts.data() + nb_blocks ) );
+  tables.insert( tables.end(), (char*) block_first_entries.data(), (char*) ( block_first_entries.data() + nb_blocks ) );
+  tables.insert( tables.end(), (char*) entry_deltas.data(), (char*) ( entry_deltas.data() + nb_entries ) );
+  
+  std::vector<char> index( INDEX_HEADER_SIZE + compressBound( tables.size() ) );
+  memcpy( &index[0], &nb_blocks, sizeof(nb_blocks) );
+  memcpy( &index[sizeof(nb_blocks)], &nb_entries, sizeof(nb_entries) );
+  memcpy( &index[2 * sizeof(int32_t)], &raw_size, sizeof(raw_size) );
+  uLongf compressed_size = index.size() - INDEX_HEADER_SIZE;
+  if ( compress2( (Bytef*) &index[INDEX_HEADER_SIZE], &compressed_size,
+                  (const Bytef*) tables.data(), tables.size(), Z_BEST_COMPRESSION ) != Z_OK )
+  {
+    printf( "%s:%d: error: could not compress the index of %s\n", __FILE__, __LINE__, file_name );
+    exit( EXIT_FAILURE );
+  }
+  index.resize( INDEX_HEADER_SIZE + compressed_size );
+  
+  for ( size_t done = 0 ; done < index.size() ; done += MAX_PAYLOAD_SIZE )
+  {
+    int32_t size = std::min( index.size() - done, (size_t) MAX_PAYLOAD_SIZE );
+    write_empty_member( file, INDEX_SUBFIELD, &index[done], size );
+  }
+  
+  char trailer[TRAILER_PAYLOAD_SIZE];
+  memcpy( trailer, &offset, sizeof(offset) );
+  memcpy( trailer + sizeof(offset), &BLOCK_BACKUP_VERSION, sizeof(BLOCK_BACKUP_VERSION) );
+  write_empty_member( file, TRAILER_SUBFIELD, trailer, TRAILER_PAYLOAD_SIZE );
+  
+  if ( fclose( file ) != 0 )
+  {
+    printf( "%s:%d: error: could not write file %s\n", __FILE__, __LINE__, file_name );
+    exit( EXIT_FAILURE );
+  }
+}
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+/*!
+  Read the index of file (return false if it has none)
+*/
+bool ae_block_backup::read_index( FILE* file )
+{
+  unsigned char header[16]; // Header and extra field, up to the payload
+  
+  // Check whether the file ends with a trailer and retrieve the offset of the index
+  fseeko( file, 0, SEEK_END );
+  int64_t file_size = ftello( file );
+  if ( file_size < TRAILER_SIZE ) return false;
+  
+  int64_t trailer_offset = file_size - TRAILER_SIZE;
+  char    trailer[TRAILER_PAYLOAD_SIZE];
+  int64_t index_offset;
+  int32_t version;
+  
+  fseeko( file, trailer_offset, SEEK_SET );
+  if ( fread( header, 1, 16, file ) != 16 ||
+       header[0] != 0x1f || header[1] != 0x8b || header[3] != GZIP_FEXTRA ||
+       header[12] != TRAILER_SUBFIELD[0] || header[13] != TRAILER_SUBFIELD[1] ||
+       header[14] + ( header[15] << 8 ) != TRAILER_PAYLOAD_SIZE ||
+       fread( trailer, 1, TRAILER_PAYLOAD_SIZE, file ) != TRAILER_PAYLOAD_SIZE )
+  {
+    return false;
+  }
+  memcpy( &index_offset, trailer, sizeof(index_offset) );
+  memcpy( &version, trailer + sizeof(index_offset), sizeof(version) );
+  if ( version != BLOCK_BACKUP_VERSION || index_offset < 0 || index_offset > trailer_offset ) return false;
+  
+  // Gather the payloads of the index members
+  std::vector<char> index;
+  int64_t member_offset = index_offset;
+  while ( member_offset < trailer_offset )
+  {
+    fseeko( file, member_offset, SEEK_SET );
+    if ( fread( header, 1, 16, file ) != 16 ||
+         header[12] != INDEX_SUBFIELD[0] || header[13] != INDEX_SUBFIELD[1] )
+    {
+      return false;
+    }
+    int32_t size = header[14] + ( header[15] << 8 );
+    
+    index.resize( index.size() + size );
+    if ( (int32_t) fread( &index[index.size() - size], 1, size, file ) != size ) return false;
+    
+    member_offset += EMPTY_MEMBER_OVERHEAD + size;
+  }
+  
+  // Decode the index
+  if ( index.size() < (size_t) INDEX_HEADER_SIZE ) return false;
+  memcpy( &_nb_blocks, &index[0], sizeof(_nb_blocks) );
+  memcpy( &_nb_entries, &index[sizeof(_nb_blocks)], sizeof(_nb_entries) );
+  memcpy( &_raw_size, &index[2 * sizeof(int32_t)], sizeof(_raw_size) );
+  if ( _nb_blocks < 1 || _nb_entries < 0 || _raw_size < 0 ) return false;
+  
+  // Deflated tables, with entry starts relative to the previous entry of their block
+  uLongf tables_size = _nb_blocks * ( 2 * sizeof(int64_t) + sizeof(int32_t) ) + _nb_entries * sizeof(int32_t);
+  std::vector<char> tables( tables_size );
+  if ( uncompress( (Bytef*) tables.data(), &tables_size,
+                   (const Bytef*) &index[INDEX_HEADER_SIZE], index.size() - INDEX_HEADER_SIZE ) != Z_OK ||
+       tables_size != tables.size() )
+  {
+    return false;
+  }
+  
+  _block_offsets  = new int64_t[_nb_blocks];
+  _block_starts   = new int64_t[_nb_blocks];
+  _entry_starts   = new int64_t[_nb_entries];
+  
+  std::vector<int32_t> block_first_entries( _nb_blocks );
+  std::vector<int32_t> entry_deltas( _nb_entries );
+  
+  char* data = tables.data();
+  memcpy( _block_offsets, data, _nb_blocks * sizeof(int64_t) );
+  data += _nb_blocks * sizeof(int64_t);
+  memcpy( _block_starts, data, _nb_blocks * sizeof(int64_t) );
+  data += _nb_blocks * sizeof(int64_t);
+  memcpy( block_first_entries.data(), data, _nb_blocks * sizeof(int32_t) );
+  data += _nb_blocks * sizeof(int32_t);
+  memcpy( entry_deltas.data(), data, _nb_entries * sizeof(int32_t) );
+  
+  if ( block_first_entries[0] != 0 ) return false;
+  for ( int32_t block = 0 ; block < _nb_blocks ; block++ )
+  {
+    int32_t end = ( block < _nb_blocks - 1 ) ? block_first_entries[block + 1] : _nb_entries;
+    if ( end < block_first_entries[block] || end > _nb_entries ) return false;
+    
+    int64_t entry_start = _block_starts[block];
+    for ( int32_t entry = block_first_entries[block] ; entry < end ; entry++ )
+    {
+      entry_start += entry_deltas[entry];
+      _entry_starts[entry] = entry_start;
+    }
+  }
+  
+  return true;
+}
+
+/*!
+  Write a gzip member with no content whose extra field holds payload (in a subfield named subfield_id)
+*/
+void ae_block_backup::write_empty_member( FILE* file, const char subfield_id[2], const char* payload, int32_t payload_size )
+{
+  assert( payload_size <= MAX_PAYLOAD_SIZE );
+  
+  int32_t xlen = payload_size + 4;
+  unsigned char header[16] =
+  {
+    0x1f, 0x8b, Z_DEFLATED, GZIP_FEXTRA,  // ID1, ID2, CM, FLG
+    0, 0, 0, 0, 0, 3,                     // MTIME, XFL, OS (Unix)
+    (unsigned char) ( xlen & 0xff ), (unsigned char) ( xlen >> 8 ),
+    (unsigned char) subfield_id[0], (unsigned char) subfield_id[1],
+    (unsigned char) ( payload_size & 0xff ), (unsigned char) ( payload_size >> 8 )
+  };
+  
+  // Empty final fixed-Huffman deflate block, then CRC32 and ISIZE of the (empty) content
+  unsigned char end[10] = { 0x03, 0x00, 0, 0, 0, 0, 0, 0, 0, 0 };
+  
+  fwrite( header, 1, sizeof(header), file );
+  fwrite( payload, 1, payload_size, file );
+  fwrite( end, 1, sizeof(end), file );
+}
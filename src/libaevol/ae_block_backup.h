@@ -0,0 +1,208 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+/*!
+  \class ae_block_backup
+  
+  \brief Gzip file made of independently compressed blocks, with an index of its entries
+  
+  The raw (uncompressed) content of the file is a sequence of bytes in which
+  some positions mark the start of an entry (e.g. an individual in a
+  population backup). It is cut, between entries, into blocks of about
+  BLOCK_BACKUP_BLOCK_SIZE bytes that are compressed concurrently, each one into
+  a gzip member of its own. These are followed by the index (the position of
+  each block in the file and of each entry in the raw content), stored in the
+  extra field of empty gzip members, and by a fixed-size trailer pointing to
+  the index.
+  
+  The whole is hence a valid (multi-member) gzip file with the same raw
+  content as a plain one: gzread, zcat, etc. read it as usual. But any entry
+  can also be read without decompressing what lies before its own block
+  (see open_entry).
+  
+  Index payload (native byte order):
+    int32_t nb_blocks, nb_entries
+    int64_t raw_size                        (of the whole raw content)
+    then the following tables, deflated (zlib format):
+    int64_t block_offsets[nb_blocks]        (in the file)
+    int64_t block_starts[nb_blocks]         (in the raw content)
+    int32_t block_first_entries[nb_blocks]  (first entry starting in each block)
+    int32_t entry_deltas[nb_entries]        (from the previous entry of the block, or its start)
+*/
+
+
+#ifndef __AE_BLOCK_BACKUP_H__
+#define __AE_BLOCK_BACKUP_H__
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <zlib.h>
+#include <vector>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_macros.h>
+#include <ae_object.h>
+
+
+
+
+// =================================================================
+//                          Class declarations
+// =================================================================
+class ae_thread_pool;
+
+
+
+
+
+
+class ae_block_backup : public ae_object
+{
+  public :
+    // =================================================================
+    //                             Constructors
+    // =================================================================
+    ae_block_backup( const char* file_name );
+
+    // =================================================================
+    //                             Destructors
+    // =================================================================
+    virtual ~ae_block_backup( void );
+
+    // =================================================================
+    //                        Accessors: getters
+    // =================================================================
+    inline bool     is_indexed( void ) const;
+    inline int32_t  get_nb_entries( void ) const;
+    inline int64_t  get_entry_size( int32_t entry ) const;
+
+    // =================================================================
+    //                        Accessors: setters
+    // =================================================================
+
+    // =================================================================
+    //                              Operators
+    // =================================================================
+
+    // =================================================================
+    //                            Public Methods
+    // =================================================================
+    gzFile open_entry( int32_t entry ) const;
+    
+    static void write(  const char* file_name, FILE* raw_file, const std::vector<int64_t>& entry_starts,
+                        ae_thread_pool* thread_pool = NULL );
+
+    // =================================================================
+    //                           Public Attributes
+    // =================================================================
+
+
+
+
+
+  protected :
+
+    // =================================================================
+    //                         Forbidden Constructors
+    // =================================================================
+    ae_block_backup( void )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+    ae_block_backup( const ae_block_backup &model )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+
+
+    // =================================================================
+    //                           Protected Methods
+    // =================================================================
+    bool read_index( FILE* file );
+    
+    static void write_empty_member( FILE* file, const char subfield_id[2], const char* payload, int32_t payload_size );
+
+    // =================================================================
+    //                          Protected Attributes
+    // =================================================================
+    char* _file_name;
+    
+    int32_t   _nb_blocks;   // 0 if the file is not indexed (e.g. plain gzip file)
+    int32_t   _nb_entries;
+    int64_t   _raw_size;
+    int64_t*  _block_offsets;
+    int64_t*  _block_starts;
+    int64_t*  _entry_starts;
+};
+
+
+// =====================================================================
+//                           Getters' definitions
+// =====================================================================
+inline bool ae_block_backup::is_indexed( void ) const
+{
+  return ( _nb_blocks > 0 );
+}
+
+inline int32_t ae_block_backup::get_nb_entries( void ) const
+{
+  return _nb_entries;
+}
+
+/*!
+  Size of the entry-th entry in the raw content (up to the next entry or the end)
+*/
+inline int64_t ae_block_backup::get_entry_size( int32_t entry ) const
+{
+  assert( is_indexed() && entry >= 0 && entry < _nb_entries );
+  return ( ( entry < _nb_entries - 1 ) ? _entry_starts[entry + 1] : _raw_size ) - _entry_starts[entry];
+}
+
+// =====================================================================
+//                           Setters' definitions
+// =====================================================================
+
+// =====================================================================
+//                          Operators' definitions
+// =====================================================================
+
+// =====================================================================
+//                       Inline functions' definition
+// =====================================================================
+
+
+#endif // __AE_BLOCK_BACKUP_H__
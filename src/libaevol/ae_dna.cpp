@@ -44,10 +44,12 @@
 #include <ae_dna.h>
 #include <ae_genetic_unit.h>
 #include <ae_individual.h>
+#include <ae_mut_sampler.h>
 #include <ae_rna.h>
 #include <ae_utils.h>
 #include <ae_vis_a_vis.h>
 #include <ae_align.h>
+#include <ae_profiler.h>
 
 
 
@@ -99,10 +101,11 @@ ae_dna::ae_dna( ae_genetic_unit* gen_unit, const ae_dna &model ) : ae_string( mo
 
 /**
  * Creates a new piece of dna identical to the parent's but belonging to <gen_unit>
+ * The sequence is shared with the parent until either of them is modified
  * The replication report is set to NULL
  */
 ae_dna::ae_dna( ae_genetic_unit* gen_unit, ae_dna* const parent_dna ) :
-    ae_string( parent_dna->_data, parent_dna->_length )
+    ae_string( *parent_dna )
 {
   _gen_unit = gen_unit;
   _exp_m    = gen_unit->get_exp_m();
@@ -222,7 +225,9 @@ char* ae_dna::get_subsequence( int32_t from, int32_t to, ae_strand strand ) cons
 // =================================================================
 void ae_dna::perform_mutations( int32_t parent_id )
 {
-  if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+  PROFILE_SCOPE( MUTATIONS );
+  
+  if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
   {
     _replic_report = new ae_dna_replic_report();
   }
@@ -255,17 +260,18 @@ void ae_dna::perform_mutations( int32_t parent_id )
 void ae_dna::do_small_mutations( void )
 {
   // ==============================================================
-  //  1. Compute how many rearrangements this genome will undertake
+  //  1. Compute how many small mutations this genome will undertake
   // ==============================================================
   //
   // Given the rate p (by nucl.) of insertion - for instance -, the number of 
   // insertions we perform on the genome follows a binomial law B(n, p), with 
-  // n = genome length.
+  // n = genome length. The numbers of events of the 3 types are drawn by
+  // ae_mut_sampler.
   
-  int32_t nb_swi = _indiv->_mut_prng->binomial_random( _length, _indiv->get_point_mutation_rate()  );
-  int32_t nb_ins = _indiv->_mut_prng->binomial_random( _length, _indiv->get_small_insertion_rate() );
-  int32_t nb_del = _indiv->_mut_prng->binomial_random( _length, _indiv->get_small_deletion_rate()  );
-  int32_t nb_mut = nb_swi + nb_ins + nb_del;
+  double rates[3] = { _indiv->get_point_mutation_rate(),    // 0: switch
+                      _indiv->get_small_insertion_rate(),   // 1: small insertion
+                      _indiv->get_small_deletion_rate() };  // 2: small deletion
+  ae_mut_sampler sampler( _indiv->_mut_prng, _length, 3, rates );
 
 
 
@@ -273,51 +279,31 @@ void ae_dna::do_small_mutations( void )
   //  2. Perform those small mutations in a random order
   // ====================================================
   // 
-  // We put the '_nb_small_mutations' mutation events in an "urn". Then we repeat a random drawing
-  // of one mutation event in this urn, without replacement, until no mutation 
-  // event is left in the urn. Here is the "urn" we use at the beginning:
-  //
-  //     -----------------------------------------------------------
-  //    | swi | swi | swi | ins | ins | ins | del | del | del | del |
-  //     -----------------------------------------------------------
-  //                      ^                 ^                       ^
-  //                  nb_swi             nb_swi                   nb_swi
-  //                                    +nb_ins                  +nb_ins 
-  //                                                             +nb_del 
-  //
-  // Random draw of one mutation = random draw of one position in this "urn". 
-  // Given this position, we know what kind of mutation we have drawn.
+  // The sampler hands the mutation events out as a random drawing without
+  // replacement from an "urn" containing all of them.
 
-
-  int32_t random_value;
   ae_mutation* mut = NULL;
 
-  for ( int32_t i = nb_mut ; i >= 1 ; i-- ) 
+  for ( int32_t i = sampler.get_nb_events() ; i >= 1 ; i-- ) 
   {
-    random_value = _indiv->_mut_prng->random( i );
+    int8_t event = sampler.draw_event();
     
-    if ( random_value < nb_swi )
+    if ( event == 0 )
     {
       mut = do_switch();
-      assert( mut != NULL || !(_exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL) );
-      
-      nb_swi--;  // updating the urn (no replacement!)...
+      assert( mut != NULL || !(_exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT) );
     }
-    else if ( random_value < nb_swi + nb_ins )
+    else if ( event == 1 )
     {
       mut = do_small_insertion();
-      
-      nb_ins--;
     }
-    else // ( random_value >= nb_swi + nb_ins ) => del
+    else // ( event == 2 ) => del
     {
       mut = do_small_deletion();
-      
-      nb_del--;
     }
     
     // Record mutation in tree
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       if ( mut != NULL )
       {
@@ -343,69 +329,48 @@ void ae_dna::do_rearrangements( void )
   // 
   // Given the rate p (by nucl.) of duplication - for instance -, the number of 
   // duplications we perform on the genome follows a binomial law B(n, p), with 
-  // n = genome length.
+  // n = genome length. The numbers of events of the 4 types are drawn by
+  // ae_mut_sampler.
   
-  int32_t nb_dupl  = _indiv->_mut_prng->binomial_random( _length, _indiv->get_duplication_rate() );
-  int32_t nb_del   = _indiv->_mut_prng->binomial_random( _length, _indiv->get_deletion_rate() );
-  int32_t nb_trans = _indiv->_mut_prng->binomial_random( _length, _indiv->get_translocation_rate() );
-  int32_t nb_inv   = _indiv->_mut_prng->binomial_random( _length, _indiv->get_inversion_rate() );
-  int32_t nb_rear  = nb_dupl + nb_del + nb_trans + nb_inv;
+  double rates[4] = { _indiv->get_duplication_rate(),     // 0: duplication
+                      _indiv->get_deletion_rate(),        // 1: deletion
+                      _indiv->get_translocation_rate(),   // 2: translocation
+                      _indiv->get_inversion_rate() };     // 3: inversion
+  ae_mut_sampler sampler( _indiv->_mut_prng, _length, 4, rates );
   
 
   // ===================================================
   //  2. Perform those rearrangements in a random order
   // ===================================================
   //  
-  // We put the nb_rea rearrangements in an "urn". Then we repeat a random draw 
-  // of one rearrangement in this urn, without replacement, until no rearrange-
-  // -ment is left in the urn. Here is the "urn" we use at the beginning:
-  //
-  //     ------------------------------------------------------------------------------
-  //    | Dupl | Dupl | Dupl | Del | Del | Del | Del | Trans | Trans | Inv | Inv | Inv |
-  //     ------------------------------------------------------------------------------
-  //                         ^                       ^               ^                 ^
-  //                      nb_dupl                 nb_dupl         nb_dupl           nb_dupl
-  //                                             +nb_del         +nb_del           +nb_del
-  //                                                             +nb_trans         +nb_trans
-  //                                                                               +nb_inv
-  //
-  // Random draw of one rearrangement = random draw of one position in this urn. 
-  // Given this position, we know what kind of rearrangement we have drawn.
+  // The sampler hands the rearrangements out as a random drawing without
+  // replacement from an "urn" containing all of them.
   
-  int32_t random_value;
   ae_mutation* mut = NULL;
 
-  for ( int32_t i = nb_rear ; i >= 1 ; i-- )
+  for ( int32_t i = sampler.get_nb_events() ; i >= 1 ; i-- )
   {
-    random_value = _indiv->_mut_prng->random( i );
+    int8_t event = sampler.draw_event();
     
-    if ( random_value < nb_dupl ) 
+    if ( event == 0 ) 
     {
       mut = do_duplication();
-      
-      nb_dupl--;  // Updating the urn (no replacement!)...
     }
-    else if ( random_value < nb_dupl + nb_del ) 
+    else if ( event == 1 ) 
     {
       mut = do_deletion();
-      
-      nb_del--;
     }
-    else if ( random_value < nb_dupl + nb_del + nb_trans ) 
+    else if ( event == 2 ) 
     {
       mut = do_translocation();
-      
-      nb_trans--;
     }
     else 
     {
       mut = do_inversion();
-      
-      nb_inv--;
     }
     
     // Record rearrangement in tree
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       if ( mut != NULL )
       {
@@ -539,7 +504,7 @@ void ae_dna::do_rearrangements_with_align( void )
           do_duplication( alignment->get_i_1(), alignment->get_i_2(), alignment->get_i_2() );
           
           // Report the duplication
-          if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+          if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
           {
             // Report the insertion
             mut = new ae_mutation();
@@ -580,7 +545,7 @@ void ae_dna::do_rearrangements_with_align( void )
           do_deletion( alignment->get_i_1(), alignment->get_i_2() );
           
           // Report the deletion
-          if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+          if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
           {
             // Report the insertion
             mut = new ae_mutation();
@@ -664,7 +629,7 @@ void ae_dna::do_rearrangements_with_align( void )
           insert_GU( translocated_segment, alignment_2->get_i_1(), alignment_2->get_i_2(), (alignment_2->get_sense() == INDIRECT) );
 
           // Report the translocation
-          if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+          if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
           {
             mut = new ae_mutation();
             mut->report_translocation( alignment->get_i_1(), alignment->get_i_2(),
@@ -729,7 +694,7 @@ void ae_dna::do_rearrangements_with_align( void )
       do_inversion( alignment->get_i_1(), alignment->get_i_2() );
       
       // Report the inversion
-      if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+      if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
       {
         mut = new ae_mutation();
         mut->report_inversion( alignment->get_i_1(), alignment->get_i_2(), segment_length, needed_score );
@@ -763,7 +728,7 @@ void ae_dna::do_rearrangements_with_align( void )
     //////////////////////////////////////////////////////////////////////////////////////////
     if ( mut != NULL )
     {
-      if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+      if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
       {
         _replic_report->add_rear( mut );
         mut = NULL;
@@ -783,7 +748,7 @@ void ae_dna::do_transfer( int32_t parent_id )
   if ( _exp_m->get_sel()->get_prng()->random() < _exp_m->get_HT_ins_rate() )
   {
     mut = do_ins_HT(parent_id);
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       if ( mut != NULL )
       {
@@ -803,7 +768,7 @@ void ae_dna::do_transfer( int32_t parent_id )
   if ( _exp_m->get_sel()->get_prng()->random() < _exp_m->get_HT_repl_rate() )
   {
     mut = do_repl_HT(parent_id);
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       if ( mut != NULL )
       {
@@ -829,7 +794,7 @@ ae_mutation* ae_dna::do_switch( void )
 
   if ( do_switch( pos ) )
   {
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       // Report the mutation
       mut = new ae_mutation();
@@ -884,7 +849,7 @@ ae_mutation* ae_dna::do_small_insertion( void )
   // Proceed to the insertion and report it
   if ( do_small_insertion( pos, nb_insert, inserted_seq ) )
   {
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       // Report the insertion
       mut = new ae_mutation();
@@ -931,7 +896,7 @@ ae_mutation* ae_dna::do_small_deletion( void )
   
   if ( do_small_deletion( pos, nb_del ) )
   {
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       mut = new ae_mutation();
       mut->report_small_deletion( pos, nb_del );
@@ -944,8 +909,8 @@ ae_mutation* ae_dna::do_small_deletion( void )
 bool ae_dna::do_switch( int32_t pos ) 
 {
   // Perform the mutation
-  if ( _data[pos] == '0' )  _data[pos] = '1';
-  else                      _data[pos] = '0';
+  switch_base( pos );
+  _switched_pos.push_back( pos );
   
   // Remove promoters containing the switched base
   _gen_unit->remove_promoters_around( pos, ae_utils::mod(pos + 1, _length) );
@@ -1063,7 +1028,7 @@ ae_mutation* ae_dna::do_duplication( void )
     do_duplication( pos_1, pos_2, pos_3 );
     
     // Report the duplication
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       mut = new ae_mutation();
       mut->report_duplication( pos_1, pos_2, pos_3, segment_length );
@@ -1111,7 +1076,7 @@ ae_mutation* ae_dna::do_deletion( void )
     do_deletion( pos_1, pos_2 );
     
     // Report the deletion
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       mut = new ae_mutation();
       mut->report_deletion( pos_1, pos_2, segment_length );
@@ -1251,7 +1216,7 @@ ae_mutation* ae_dna::do_translocation( void )
       if ( do_inter_GU_translocation( pos_1_rel, pos_2_rel, pos_3_rel, pos_4_rel, invert ) )
       {
         // Report the translocation
-        if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+        if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
         {
           mut = new ae_mutation();
           mut->report_translocation( pos_1_rel, pos_2_rel, pos_3_rel, pos_4_rel, segment_length, invert );
@@ -1280,7 +1245,7 @@ ae_mutation* ae_dna::do_translocation( void )
       if ( do_translocation( pos_1_rel, pos_2_rel, pos_3_rel, pos_4_rel, invert ) )
       {
         // Report the translocation
-        if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+        if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
         {
           mut = new ae_mutation();
           mut->report_translocation( pos_1_rel, pos_2_rel, pos_3_rel, pos_4_rel, segment_length, invert );
@@ -1321,7 +1286,7 @@ ae_mutation* ae_dna::do_translocation( void )
     if ( do_translocation( pos_1, pos_2, pos_3, pos_4, invert ) )
     {
       // Report the translocation
-      if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+      if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
       {
         mut = new ae_mutation();
         mut->report_translocation( pos_1, pos_2, pos_3, pos_4, segment_length, invert );
@@ -1357,7 +1322,7 @@ ae_mutation* ae_dna::do_inversion( void )
   if( do_inversion( pos_1, pos_2 ) == true )
   {
     // Report the inversion
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       mut = new ae_mutation();
       mut->report_inversion( pos_1, pos_2, segment_length );
@@ -1390,7 +1355,7 @@ ae_mutation* ae_dna::do_insertion( const char* seq_to_insert, int32_t seq_length
   
   if ( do_insertion( pos, seq_to_insert, seq_length ) )
   {
-    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+    if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
     {
       // Report the insertion
       mut = new ae_mutation();
@@ -1451,9 +1416,9 @@ bool ae_dna::do_duplication( int32_t pos_1, int32_t pos_2, int32_t pos_3 )
   
   // Create a copy of the promoters beared by the segment to be duplicated
   // (they will be inserted in the individual's RNA list later)
-  ae_list<ae_rna*>** duplicated_promoters = new ae_list<ae_rna*>*[2];
-  duplicated_promoters[LEADING] = new ae_list<ae_rna*>();
-  duplicated_promoters[LAGGING] = new ae_list<ae_rna*>();
+  ae_promoter_list** duplicated_promoters = new ae_promoter_list*[2];
+  duplicated_promoters[LEADING] = new ae_promoter_list();
+  duplicated_promoters[LAGGING] = new ae_promoter_list();
   _gen_unit->duplicate_promoters_included_in( pos_1, pos_2, duplicated_promoters );
   
   _gen_unit->remove_promoters_around( pos_3 );
@@ -1808,24 +1773,12 @@ bool ae_dna::do_inversion( int32_t pos_1, int32_t pos_2 )
   //                                             pos_2    <-'
   //
   
-  int32_t seg_length = pos_2 - pos_1;
-  
-  // Create the inverted sequence
-  char* inverted_segment = NULL;
-  inverted_segment = new char[seg_length+1];
-  for ( int32_t i = 0, j = pos_2 - 1 ; i < seg_length ; i++, j-- )
-  {
-    if ( _data[j] == '0' ) inverted_segment[i] = '1';
-    else                   inverted_segment[i] = '0';
-  }
-  inverted_segment[seg_length] = '\0';
-  
   // Remove promoters that included a breakpoint
   _gen_unit->remove_promoters_around( pos_1 );
   _gen_unit->remove_promoters_around( pos_2 );
   
   // Invert the sequence
-  replace( pos_1, inverted_segment, seg_length );
+  invert( pos_1, pos_2 );
   
   // Update promoter list
   if ( _length >= PROM_SIZE )
@@ -1836,8 +1789,6 @@ bool ae_dna::do_inversion( int32_t pos_1, int32_t pos_2 )
     _gen_unit->look_for_new_promoters_around( pos_2 );
   }
   
-  delete [] inverted_segment;
-  
   return true;
 }
 
@@ -1950,7 +1901,7 @@ ae_mutation* ae_dna::do_ins_HT( int32_t parent_id )
             _indiv->assert_promoters_order();
           #endif
           
-          if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+          if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
           {
             char* donor_seq;
             if(alignment_2->get_sense() == DIRECT)
@@ -2145,7 +2096,7 @@ ae_mutation* ae_dna::do_repl_HT( int32_t parent_id )
             delete [] alignment2_donor_dna;
         }
         
-        if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+        if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
         {
           // Report the transfer
           char* donor_seq;
@@ -2338,22 +2289,13 @@ void ae_dna::compute_statistical_data( void )
   //~ }
 }
 
-/* static */ void ae_dna::set_GU( ae_list<ae_rna*>** rna_list, ae_genetic_unit* GU )
+/* static */ void ae_dna::set_GU( ae_promoter_list** rna_list, ae_genetic_unit* GU )
 {
-  ae_list_node<ae_rna*>* rna_node  = NULL;
-  ae_rna* rna = NULL;
-  
   for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
   {
-    rna_node = rna_list[strand]->get_first();
-    
-    while ( rna_node != NULL )
+    for ( int32_t i = 0 ; i < rna_list[strand]->get_nb_elts() ; i++ )
     {
-      rna = rna_node->get_obj();
-      
-      rna->set_genetic_unit( GU );
-
-      rna_node = rna_node->get_next();
+      rna_list[strand]->get_rna( i )->set_genetic_unit( GU );
     }
   }
 }
@@ -2371,9 +2313,9 @@ ae_genetic_unit* ae_dna::extract_into_new_GU( int32_t pos_1, int32_t pos_2 )
 
   // Remove promoters belonging to the sequence (to be extracted) from the "old" GU
   // and put them in a stand-alone promoter list (with indices ranging from 0 to seq_length-1)
-  ae_list<ae_rna*>** proms_GU_1  = new ae_list<ae_rna*>*[2];
-  proms_GU_1[LEADING]   = new ae_list<ae_rna*>();
-  proms_GU_1[LAGGING]   = new ae_list<ae_rna*>();
+  ae_promoter_list** proms_GU_1  = new ae_promoter_list*[2];
+  proms_GU_1[LEADING]   = new ae_promoter_list();
+  proms_GU_1[LAGGING]   = new ae_promoter_list();
   _gen_unit->extract_promoters_included_in( pos_1, pos_2, proms_GU_1 );  
   ae_genetic_unit::shift_promoters( proms_GU_1, -pos_1, _length );
   
@@ -2425,9 +2367,9 @@ ae_genetic_unit* ae_dna::copy_into_new_GU( int32_t pos_1, int32_t pos_2 ) const
   // ==================== Copy promoters from old sequence ====================
   // Copy the promoters belonging to the sequence to be copied from the "old" GU
   // into a stand-alone promoter list (with indices ranging from 0 to seq_length-1)
-  ae_list<ae_rna*>** proms_new_GU  = new ae_list<ae_rna*>*[2];
-  proms_new_GU[LEADING]   = new ae_list<ae_rna*>();
-  proms_new_GU[LAGGING]   = new ae_list<ae_rna*>();
+  ae_promoter_list** proms_new_GU  = new ae_promoter_list*[2];
+  proms_new_GU[LEADING]   = new ae_promoter_list();
+  proms_new_GU[LAGGING]   = new ae_promoter_list();
   _gen_unit->copy_promoters_included_in( pos_1, pos_2, proms_new_GU );
   ae_genetic_unit::shift_promoters( proms_new_GU, -pos_1, _length );
   
@@ -2566,12 +2508,12 @@ void ae_dna::insert_GU( ae_genetic_unit* GU_to_insert, int32_t pos_B, int32_t po
   // NOTE : Once removed the promoters starting on sequence D, the remaining is precisely the promoters
   //        starting on sequence C (and they are at their rightful position). We can hence directly use 
   //        the list of promoters from GU_to_insert.
-  ae_list<ae_rna*>** proms_C = new ae_list<ae_rna*>*[2];
-  proms_C[LEADING]  = new ae_list<ae_rna*>();
-  proms_C[LAGGING]  = new ae_list<ae_rna*>();
-  ae_list<ae_rna*>** proms_D  = new ae_list<ae_rna*>*[2];
-  proms_D[LEADING]  = new ae_list<ae_rna*>();
-  proms_D[LAGGING]  = new ae_list<ae_rna*>();
+  ae_promoter_list** proms_C = new ae_promoter_list*[2];
+  proms_C[LEADING]  = new ae_promoter_list();
+  proms_C[LAGGING]  = new ae_promoter_list();
+  ae_promoter_list** proms_D  = new ae_promoter_list*[2];
+  proms_D[LEADING]  = new ae_promoter_list();
+  proms_D[LAGGING]  = new ae_promoter_list();
   
   if ( pos_D != 0 ) // TODO : Manage this in the different functions? with a parameter WholeGenomeEventHandling ?
   {
@@ -2897,25 +2839,13 @@ void ae_dna::ABCDE_to_ADCBE( int32_t pos_B, int32_t pos_C, int32_t pos_D, int32_
   int32_t len_B = pos_C - pos_B;
   int32_t len_C = pos_D - pos_C;
   int32_t len_D = pos_E - pos_D;
-  int32_t len_E = _length - pos_E;
   int32_t len_AD   = len_A + len_D;
   int32_t len_ADC  = len_AD + len_C;
   int32_t len_ADCB = len_ADC + len_B;
   
-  // Create new sequence
-  char* new_genome = new char[_nb_blocks * BLOCK_SIZE];
-  
-  memcpy( new_genome,             _data,          len_A * sizeof(char) );
-  memcpy( &new_genome[len_A],     &_data[pos_D],  len_D * sizeof(char) );
-  memcpy( &new_genome[len_AD],    &_data[pos_C],  len_C * sizeof(char) );
-  memcpy( &new_genome[len_ADC],   &_data[pos_B],  len_B * sizeof(char) );
-  memcpy( &new_genome[len_ADCB],  &_data[pos_E],  len_E * sizeof(char) );
-  new_genome[_length] = '\0';
-  
-  // Replace sequence
-  // NB : The size of the genome doesn't change. Therefore, we don't need to update _length and _nb_blocks
-  delete [] _data;
-  _data = new_genome;
+  // Rearrange the sequence in place: ABCDE => ADBCE => ADCBE
+  exchange( pos_B, pos_D, pos_E );
+  exchange( len_AD, len_AD + len_B, pos_E );
   
   
   // ========== Update promoter list ==========
@@ -2933,15 +2863,15 @@ void ae_dna::ABCDE_to_ADCBE( int32_t pos_B, int32_t pos_C, int32_t pos_D, int32_
     _gen_unit->remove_promoters_around( pos_E );
     
     // Create temporary lists for promoters to move and/or invert
-    ae_list<ae_rna*>** promoters_B = new ae_list<ae_rna*>*[2];
-    promoters_B[LEADING] = new ae_list<ae_rna*>();
-    promoters_B[LAGGING] = new ae_list<ae_rna*>();
-    ae_list<ae_rna*>** promoters_C = new ae_list<ae_rna*>*[2];
-    promoters_C[LEADING] = new ae_list<ae_rna*>();
-    promoters_C[LAGGING] = new ae_list<ae_rna*>();
-    ae_list<ae_rna*>** promoters_D = new ae_list<ae_rna*>*[2];
-    promoters_D[LEADING] = new ae_list<ae_rna*>();
-    promoters_D[LAGGING] = new ae_list<ae_rna*>();
+    ae_promoter_list** promoters_B = new ae_promoter_list*[2];
+    promoters_B[LEADING] = new ae_promoter_list();
+    promoters_B[LAGGING] = new ae_promoter_list();
+    ae_promoter_list** promoters_C = new ae_promoter_list*[2];
+    promoters_C[LEADING] = new ae_promoter_list();
+    promoters_C[LAGGING] = new ae_promoter_list();
+    ae_promoter_list** promoters_D = new ae_promoter_list*[2];
+    promoters_D[LEADING] = new ae_promoter_list();
+    promoters_D[LAGGING] = new ae_promoter_list();
     
     // 2) Extract promoters that are totally included in each segment to be moved (B, C and D)
     if ( len_B >= PROM_SIZE )
@@ -3009,56 +2939,14 @@ void ae_dna::ABCDE_to_ADBpCpE( int32_t pos_B, int32_t pos_C, int32_t pos_D, int3
   int32_t len_B = pos_C - pos_B;
   int32_t len_C = pos_D - pos_C;
   int32_t len_D = pos_E - pos_D;
-  int32_t len_E = _length - pos_E;
   int32_t len_AD   = len_A + len_D;
   int32_t len_ADB  = len_AD + len_B;
   int32_t len_ADBC = len_ADB + len_C;
   
-  // Create new sequence
-  char* new_genome = new char[_nb_blocks * BLOCK_SIZE];
-  
-  // Copy segments A and D
-  memcpy( new_genome,         _data,            len_A * sizeof(char) );
-  memcpy( &new_genome[len_A], &_data[pos_D],  len_D * sizeof(char) );
-  
-  
-  // Build Bp and put it in the new genome
-  char* inverted_segment = new char[len_B+1];
-  
-  for ( int32_t i = 0, j = pos_C - 1 ; i < len_B ; i++, j-- )
-  {
-    if ( _data[j] == '0' ) inverted_segment[i] = '1';
-    else                   inverted_segment[i] = '0';
-  }
-  inverted_segment[len_B] = '\0';
-  
-  memcpy( &new_genome[len_AD], inverted_segment, len_B * sizeof(char) );
-  
-  delete [] inverted_segment;
-  
-  
-  // Build Cp and put it in the new genome
-  inverted_segment = new char[len_C+1];
-  
-  for ( int32_t i = 0, j = pos_D - 1 ; i < len_C ; i++, j-- )
-  {
-    if ( _data[j] == '0' ) inverted_segment[i] = '1';
-    else                   inverted_segment[i] = '0';
-  }
-  inverted_segment[len_C] = '\0';
-  
-  memcpy( &new_genome[len_ADB], inverted_segment, len_C * sizeof(char) );
-  
-  delete [] inverted_segment;
-  
-  // Copy segment E into the new genome
-  memcpy( &new_genome[len_ADBC], &_data[pos_E], len_E * sizeof(char) );
-  new_genome[_length] = '\0';
-  
-  
-  // Replace sequence
-  delete [] _data;
-  _data = new_genome;
+  // Rearrange the sequence in place: ABCDE => ADBCE => ADBpCpE
+  exchange( pos_B, pos_D, pos_E );
+  invert( len_AD, len_ADB );
+  invert( len_ADB, len_ADBC );
   
   
   // ========== Update promoter list ==========
@@ -3076,15 +2964,15 @@ void ae_dna::ABCDE_to_ADBpCpE( int32_t pos_B, int32_t pos_C, int32_t pos_D, int3
     _gen_unit->remove_promoters_around( pos_E );
     
     // Create temporary lists for promoters to move and/or invert
-    ae_list<ae_rna*>** promoters_B = new ae_list<ae_rna*>*[2];
-    promoters_B[LEADING] = new ae_list<ae_rna*>();
-    promoters_B[LAGGING] = new ae_list<ae_rna*>();
-    ae_list<ae_rna*>** promoters_C = new ae_list<ae_rna*>*[2];
-    promoters_C[LEADING] = new ae_list<ae_rna*>();
-    promoters_C[LAGGING] = new ae_list<ae_rna*>();
-    ae_list<ae_rna*>** promoters_D = new ae_list<ae_rna*>*[2];
-    promoters_D[LEADING] = new ae_list<ae_rna*>();
-    promoters_D[LAGGING] = new ae_list<ae_rna*>();
+    ae_promoter_list** promoters_B = new ae_promoter_list*[2];
+    promoters_B[LEADING] = new ae_promoter_list();
+    promoters_B[LAGGING] = new ae_promoter_list();
+    ae_promoter_list** promoters_C = new ae_promoter_list*[2];
+    promoters_C[LEADING] = new ae_promoter_list();
+    promoters_C[LAGGING] = new ae_promoter_list();
+    ae_promoter_list** promoters_D = new ae_promoter_list*[2];
+    promoters_D[LEADING] = new ae_promoter_list();
+    promoters_D[LAGGING] = new ae_promoter_list();
     
     // 2) Extract promoters that are totally included in each segment to be moved (B, C and D)
     if ( len_B >= PROM_SIZE )
@@ -3156,56 +3044,14 @@ void ae_dna::ABCDE_to_ACpDpBE( int32_t pos_B, int32_t pos_C, int32_t pos_D, int3
   int32_t len_B = pos_C - pos_B;
   int32_t len_C = pos_D - pos_C;
   int32_t len_D = pos_E - pos_D;
-  int32_t len_E = _length - pos_E;
   int32_t len_AC   = len_A + len_C;
   int32_t len_ACD  = len_AC + len_D;
   int32_t len_ACDB = len_ACD + len_B;
   
-  // Create new sequence
-  char* new_genome = new char[_nb_blocks * BLOCK_SIZE];
-  
-  // Copy segment A
-  memcpy( new_genome, _data, len_A * sizeof(char) );
-  
-  
-  // Build Cp and put it in the new genome
-  char* inverted_segment = new char[len_C+1];
-  
-  for ( int32_t i = 0, j = pos_D - 1 ; i < len_C ; i++, j-- )
-  {
-    if ( _data[j] == '0' ) inverted_segment[i] = '1';
-    else                   inverted_segment[i] = '0';
-  }
-  inverted_segment[len_C] = '\0';
-  
-  memcpy( &new_genome[len_A], inverted_segment, len_C * sizeof(char) );
-  
-  delete [] inverted_segment;
-  
-  
-  // Build Dp and put it in the new genome
-  inverted_segment = new char[len_D+1];
-  
-  for ( int32_t i = 0, j = pos_E - 1 ; i < len_D ; i++, j-- )
-  {
-    if ( _data[j] == '0' ) inverted_segment[i] = '1';
-    else                   inverted_segment[i] = '0';
-  }
-  inverted_segment[len_D] = '\0';
-  
-  memcpy( &new_genome[len_AC], inverted_segment, len_D * sizeof(char) );
-  
-  delete [] inverted_segment;
-  
-  // Copy segments B and E
-  memcpy( &new_genome[len_ACD],   &_data[pos_B], len_B * sizeof(char) );
-  memcpy( &new_genome[len_ACDB],  &_data[pos_E], len_E * sizeof(char) );
-  new_genome[_length] = '\0';
-  
-  
-  // Replace sequence
-  delete [] _data;
-  _data = new_genome;
+  // Rearrange the sequence in place: ABCDE => ACDBE => ACpDpBE
+  exchange( pos_B, pos_C, pos_E );
+  invert( len_A, len_AC );
+  invert( len_AC, len_ACD );
   
   
   // ========== Update promoter list ==========
@@ -3223,15 +3069,15 @@ void ae_dna::ABCDE_to_ACpDpBE( int32_t pos_B, int32_t pos_C, int32_t pos_D, int3
     _gen_unit->remove_promoters_around( pos_E );
     
     // Create temporary lists for promoters to move and/or invert
-    ae_list<ae_rna*>** promoters_B = new ae_list<ae_rna*>*[2];
-    promoters_B[LEADING] = new ae_list<ae_rna*>();
-    promoters_B[LAGGING] = new ae_list<ae_rna*>();
-    ae_list<ae_rna*>** promoters_C = new ae_list<ae_rna*>*[2];
-    promoters_C[LEADING] = new ae_list<ae_rna*>();
-    promoters_C[LAGGING] = new ae_list<ae_rna*>();
-    ae_list<ae_rna*>** promoters_D = new ae_list<ae_rna*>*[2];
-    promoters_D[LEADING] = new ae_list<ae_rna*>();
-    promoters_D[LAGGING] = new ae_list<ae_rna*>();
+    ae_promoter_list** promoters_B = new ae_promoter_list*[2];
+    promoters_B[LEADING] = new ae_promoter_list();
+    promoters_B[LAGGING] = new ae_promoter_list();
+    ae_promoter_list** promoters_C = new ae_promoter_list*[2];
+    promoters_C[LEADING] = new ae_promoter_list();
+    promoters_C[LAGGING] = new ae_promoter_list();
+    ae_promoter_list** promoters_D = new ae_promoter_list*[2];
+    promoters_D[LEADING] = new ae_promoter_list();
+    promoters_D[LAGGING] = new ae_promoter_list();
     
     // 2) Extract promoters that are totally included in each segment to be moved (B, C and D)
     if ( len_B >= PROM_SIZE )
@@ -3340,9 +3186,9 @@ void ae_dna::inter_GU_ABCDE_to_ACDBE( int32_t pos_B, int32_t pos_C, int32_t pos_
     destination_GU->remove_promoters_around( pos_E );
     
     // Create temporary lists for promoters to move and/or invert
-    ae_list<ae_rna*>** promoters_B = new ae_list<ae_rna*>*[2];
-    promoters_B[LEADING] = new ae_list<ae_rna*>();
-    promoters_B[LAGGING] = new ae_list<ae_rna*>();
+    ae_promoter_list** promoters_B = new ae_promoter_list*[2];
+    promoters_B[LEADING] = new ae_promoter_list();
+    promoters_B[LAGGING] = new ae_promoter_list();
     
     // 2) Extract promoters that are totally included in each segment to be moved (B, C and E)
     if ( len_B >= PROM_SIZE )
@@ -3361,16 +3207,11 @@ void ae_dna::inter_GU_ABCDE_to_ACDBE( int32_t pos_B, int32_t pos_C, int32_t pos_
     ae_genetic_unit::shift_promoters( promoters_B, len_D - len_A, destination_GU->get_dna()->get_length() );
     
     // Reassign promoters to their new genetic unit
-    ae_list_node<ae_rna*>* rna_node; 
-    ae_rna* rna;
     for (int32_t tmp_strand = 0;  tmp_strand < 2; tmp_strand++)
     {
-      rna_node = promoters_B[tmp_strand]->get_first();
-      while ( rna_node )
+      for ( int32_t i = 0 ; i < promoters_B[tmp_strand]->get_nb_elts() ; i++ )
       {
-        rna = rna_node->get_obj();
-        rna->set_genetic_unit(destination_GU); 
-        rna_node = rna_node->get_next();
+        promoters_B[tmp_strand]->get_rna( i )->set_genetic_unit(destination_GU); 
       }
     }
 
@@ -35,6 +35,7 @@
 #include <inttypes.h>
 #include <stdlib.h>
 #include <zlib.h>
+#include <vector>
 
 
 
@@ -58,6 +59,7 @@ class ae_individual;
 class ae_genetic_unit;
 class ae_vis_a_vis;
 class ae_rna;
+class ae_promoter_list;
 
 
 
@@ -89,7 +91,10 @@ class ae_dna : public ae_string
     //   inline const char*   get_data( void ) const;
     //   inline       void    set_data( char* data, int32_t length = -1 );
     //   inline       int32_t get_length( void ) const;
+    //   inline       uint64_t get_bits( int32_t first, int8_t nb ) const;
+    //   inline       uint64_t get_circular_bits( int32_t first, int8_t nb ) const;
     inline ae_dna_replic_report*  get_replic_report( void ) const;
+    inline const std::vector<int32_t>& get_switched_pos( void ) const;
     inline void                   set_replic_report( ae_dna_replic_report * rep ); // for post-treatment only
     
     inline ae_genetic_unit *      get_genetic_unit( void ) const;
@@ -161,7 +166,7 @@ class ae_dna : public ae_string
     void compute_statistical_data( void );
     
     
-    static void set_GU( ae_list<ae_rna*>** rna_list, ae_genetic_unit* GU );
+    static void set_GU( ae_promoter_list** rna_list, ae_genetic_unit* GU );
   
   
     // =================================================================
@@ -204,12 +209,18 @@ class ae_dna : public ae_string
     ae_exp_manager* _exp_m;
     
     // From ae_string
+    //   char*   _buffer;
+    //   std::atomic<int32_t>* _nb_refs;
     //   char*   _data;
     //   int32_t _length;
-    //   int32_t _nb_blocks;
+    //   int32_t _head;
+    //   int32_t _capacity;
+    //   uint64_t* _bits;
+    //   int32_t _bits_capacity;
     ae_individual*        _indiv;
     ae_genetic_unit*      _gen_unit; // Genetic unit which the genetic unit belongs to
     ae_dna_replic_report* _replic_report;
+    std::vector<int32_t>  _switched_pos; // Positions switched since this DNA was created (see get_switched_pos)
 };
 
 
@@ -221,6 +232,19 @@ inline ae_dna_replic_report* ae_dna::get_replic_report( void ) const
   return _replic_report;
 }
 
+/*!
+  Positions of the switches this DNA underwent since it was created, in the order they
+  were performed (a position may appear more than once).
+  
+  Unlike the replication report, this is kept whether the tree is recorded or not.
+  It only accounts for all the modifications of the sequence as long as
+  is_switched_only() holds.
+*/
+inline const std::vector<int32_t>& ae_dna::get_switched_pos( void ) const
+{
+  return _switched_pos;
+}
+
 inline ae_individual* ae_dna::get_indiv(void) const
 {
   return _indiv;
@@ -90,7 +90,8 @@ enum ae_strand
 enum ae_tree_mode
 {
   LIGHT   = 0,
-  NORMAL  = 1
+  NORMAL  = 1,
+  PRUNED  = 2
 };
 
 enum ae_log_type
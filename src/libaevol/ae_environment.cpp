@@ -387,23 +387,25 @@ void ae_environment::build( void )
   // 1) Generate sample points from gaussians
   // ----------------------------------------
   // NB : Extreme points (at abscissa MIN_X and MAX_X) will be generated, we need to erase the list first
-  _points->erase( true );
+  _nb_points = 0;
+  reserve( _sampling + 1 );
   
   ae_list_node<ae_gaussian*>* node = NULL;
   
   for ( int16_t i = 0 ; i <= _sampling ; i++ )
   {
-    ae_point_2d* new_point = new ae_point_2d( X_MIN + (double)i * (X_MAX - X_MIN) / (double)_sampling, 0.0 );
+    double x = X_MIN + (double)i * (X_MAX - X_MIN) / (double)_sampling;
+    double y = 0.0;
     node = _gaussians->get_first();
     
     while ( node )
     {
-      new_point->y += node->get_obj()->compute_y( new_point->x );
+      y += node->get_obj()->compute_y( x );
       
       node = node->get_next();
     }
     
-    _points->add( new_point );
+    add_point( x, y );
   }
   
   
@@ -488,12 +490,9 @@ void ae_environment::apply_noise( void )
     }
     else // _cur_noise has already been created -> reinitialize all its points to 0
     {
-      ae_list_node<ae_point_2d*>* point_node  = _cur_noise->get_points()->get_first();
-      while ( point_node != NULL )
+      for ( int32_t i = 0 ; i < _cur_noise->get_nb_points() ; i++ )
       {
-        point_node->get_obj()->y = 0;
-        
-        point_node = point_node->get_next();
+        _cur_noise->get_point( i ).y = 0;
       }
     }
     
@@ -507,7 +506,7 @@ void ae_environment::apply_noise( void )
     {
       int32_t num_zone;
       int32_t nb_zones = 1 << fractal_step;
-      int32_t nb_points_in_each_zone = _cur_noise->get_points()->get_nb_elts() / nb_zones;
+      int32_t nb_points_in_each_zone = _cur_noise->get_nb_points() / nb_zones;
       
       // Compute current noise intensity
       // We first test the trivial (most common) cases, then the general (positive or negative) cases
@@ -544,17 +543,10 @@ void ae_environment::apply_noise( void )
       }
       
       // For each point in the noise fuzzy set, apply the noise computed for the corresponding zone
-      ae_list_node<ae_point_2d*>* point_node  = _cur_noise->get_points()->get_first();
-      ae_point_2d*  point       = NULL;
-      int32_t       point_index = 0;
-      while ( point_node != NULL )
+      for ( int32_t point_index = 0 ; point_index < _cur_noise->get_nb_points() ; point_index++ )
       {
-        point = point_node->get_obj();
-        
-        num_zone = floor( point_index++ / nb_points_in_each_zone );
-        point->y += noise_component[num_zone];
-        
-        point_node = point_node->get_next();
+        num_zone = floor( point_index / nb_points_in_each_zone );
+        _cur_noise->get_point( point_index ).y += noise_component[num_zone];
       }
       delete noise_component;
       
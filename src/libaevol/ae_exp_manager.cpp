@@ -43,6 +43,7 @@
 // =================================================================
 #include <ae_exp_manager.h>
 #include <ae_population.h>
+#include <ae_profiler.h>
 
 #ifdef __X11
   #include <ae_population_X11.h>
@@ -91,6 +92,9 @@ ae_exp_manager::ae_exp_manager( void )
   
   // ------------------------------------------------------------- Quit signal
   _quit_signal_received = false;
+  
+  // ------------------------------------------------- Multithreaded execution
+  _thread_pool = NULL;
 }
 
 // ===========================================================================
@@ -103,6 +107,7 @@ ae_exp_manager::~ae_exp_manager( void )
   delete _output_m;
   delete _env;
   if ( _spatial_structure != NULL ){delete _spatial_structure;}
+  delete _thread_pool;
 }
 
 // ===========================================================================
@@ -164,6 +169,8 @@ void ae_exp_manager::write_setup_files( void )
   
   These are written in the current directory in gzipped binary files 
   whose names are appended with the current generation number.
+  If a writer is provided, the files are only complete once it has written
+  them (see ae_background_writer::commit).
 
   WARNING: The experimental setup and output profile are *not* saved. These
   should be saved once and for all when the experiment is created.
@@ -179,18 +186,26 @@ void ae_exp_manager::write_setup_files( void )
   \see write_setup_files( void )
   \see save_copy( char* dir, int32_t num_gener )
 */
-void ae_exp_manager::save( void ) const
+void ae_exp_manager::save( ae_background_writer* writer /*= NULL*/ ) const
 {
   // 1) Create missing directories
   create_missing_directories();
   
   // 2) Open backup files (environment, population, selection and spatial structure)
+  //    The writer will compress and write them once they are closed. If none
+  //    is provided, a local one is used (and waited for)
+  ae_background_writer* local_writer = NULL;
+  if ( writer == NULL )
+  {
+    local_writer = new ae_background_writer( get_nb_threads() );
+    writer = local_writer;
+  }
   gzFile env_file, pop_file, sel_file, sp_struct_file;
-  open_backup_files( env_file, pop_file, sel_file, sp_struct_file, _num_gener, "w" );
+  open_backup_files( env_file, pop_file, sel_file, sp_struct_file, _num_gener, "w", ".", writer );
   
   // 3) Write the state of the environment, population and spatial structure into the backups
   get_env()->save( env_file );
-  get_pop()->save( pop_file );
+  get_pop()->save( pop_file, writer->get_entry_starts( pop_file ) );
   get_sel()->save( sel_file );
   if ( is_spatially_structured() )
   {
@@ -199,6 +214,12 @@ void ae_exp_manager::save( void ) const
   
   // 4) Close backup files
   close_backup_files( env_file, pop_file, sel_file, sp_struct_file );
+  
+  if ( local_writer != NULL )
+  {
+    local_writer->commit();
+    delete local_writer;
+  }
 }
 
 /*!
@@ -238,8 +259,9 @@ void ae_exp_manager::save_copy( char* dir, int32_t num_gener /*= 0*/ ) const
   gzFile exp_s_gzfile, out_p_gzfile;
   FILE*  exp_s_txtfile, * out_p_txtfile;
   open_setup_files( exp_s_gzfile, exp_s_txtfile, out_p_gzfile, out_p_txtfile, num_gener, "w", dir );
+  ae_background_writer writer( get_nb_threads() );
   gzFile env_file, pop_file, sel_file, sp_struct_file;
-  open_backup_files( env_file, pop_file, sel_file, sp_struct_file, num_gener, "w", dir );
+  open_backup_files( env_file, pop_file, sel_file, sp_struct_file, num_gener, "w", dir, &writer );
   
   // 3) Write setup data
   _exp_s->write_setup_file( exp_s_gzfile );
@@ -247,7 +269,7 @@ void ae_exp_manager::save_copy( char* dir, int32_t num_gener /*= 0*/ ) const
   
   // 4) Write the state of the environment, population, selection and spatial structure into the backups
   get_env()->save( env_file );
-  get_pop()->save( pop_file );
+  get_pop()->save( pop_file, writer.get_entry_starts( pop_file ) );
   get_sel()->save( sel_file );
   if ( is_spatially_structured() )
   {
@@ -257,6 +279,7 @@ void ae_exp_manager::save_copy( char* dir, int32_t num_gener /*= 0*/ ) const
   // 4) Close setup and backup files
   close_setup_files( exp_s_gzfile, exp_s_txtfile, out_p_gzfile, out_p_txtfile );
   close_backup_files( env_file, pop_file, sel_file, sp_struct_file );
+  writer.commit();
 }
 
 
@@ -305,9 +328,13 @@ void ae_exp_manager::load( int32_t first_gener, bool use_text_files, bool verbos
   }
   
   // ------------------------------------------------ Retrieve population data
+  //   Block backups (see ae_block_backup) are loaded concurrently
   printf( "  Loading population..." );
   fflush( stdout );
-  _pop->load( pop_file, verbose );
+  char pop_file_name[255];
+  sprintf( pop_file_name, "./"POP_FNAME_FORMAT, first_gener );
+  ae_block_backup pop_index( pop_file_name );
+  _pop->load( pop_file, verbose, pop_index.is_indexed() ? &pop_index : NULL );
   printf( "OK\n" );
   
   // --------------------------------------------- Retrieve environmental data
@@ -461,9 +488,11 @@ void ae_exp_manager::load( int32_t first_gener,
   }
   
   // ------------------------------------------------ Retrieve population data
+  //   Block backups (see ae_block_backup) are loaded concurrently
   printf( "  Loading population..." );
   fflush( stdout );
-  _pop->load( pop_file, verbose );
+  ae_block_backup pop_index( pop_file_name );
+  _pop->load( pop_file, verbose, pop_index.is_indexed() ? &pop_index : NULL );
   printf( "OK\n" );
   
   // --------------------------------------------- Retrieve environmental data
@@ -524,6 +553,19 @@ void ae_exp_manager::load( int32_t first_gener,
   }
 }
 
+/*!
+  \brief Run the replications on nb_threads threads
+
+  Once a number of threads has been set (even 1), each offspring draws its
+  mutations from its own stream (see ae_selection::do_replications) so that
+  the outcome of a run does not depend on the number of threads used.
+*/
+void ae_exp_manager::set_nb_threads( int16_t nb_threads )
+{
+  delete _thread_pool;
+  _thread_pool = new ae_thread_pool( nb_threads );
+}
+
 /*!
   Run the simulation
  */
@@ -533,9 +575,16 @@ void ae_exp_manager::run_evolution( void )
   // Save the setup files to keep track of the setup history
   write_setup_files();
   
+  // Have the backups and trees written in the background from now on
+  _output_m->start_background_writer();
+  
   // Dump the initial state of the population; useful for restarts
   _output_m->write_current_generation_outputs();
   
+  #ifdef PROFILING
+    ae_profiler::write_generation( _num_gener );
+  #endif
+  
   while ( _num_gener < _last_gener )
   {
     printf( "============================== %"PRId32" ==============================\n", _num_gener );
@@ -559,10 +608,19 @@ void ae_exp_manager::run_evolution( void )
     }
     // Write statistical data and store phylogenetic data (tree)
     _output_m->write_current_generation_outputs();
+    
+    #ifdef PROFILING
+      // Time spent in each phase of the generation
+      ae_profiler::write_generation( _num_gener );
+    #endif
   }
   
   _output_m->flush();
   
+  #ifdef PROFILING
+    ae_profiler::close();
+  #endif
+  
   printf( "============================== %"PRId32" ==============================\n", _num_gener );
   printf( "  distance to target (metabolic) : %f\n", _pop->get_best()->get_dist_to_target_by_feature( METABOLISM ) );
   printf( "===================================================================\n");
@@ -627,9 +685,11 @@ void ae_exp_manager::open_backup_files( gzFile& env_file,
                                         gzFile& sp_struct_file,
                                         int32_t num_gener,
                                         const char mode[3],
-                                        const char* dir /*= "."*/ ) const
+                                        const char* dir /*= "."*/,
+                                        ae_background_writer* writer /*= NULL*/ ) const
 {
   assert( strcmp( mode, "w" ) == 0 or strcmp( mode, "r" ) == 0 );
+  assert( writer == NULL or strcmp( mode, "w" ) == 0 );
   
   // -------------------------------------------------------------------------
   // 1) Generate backup file names for mandatory files.
@@ -647,9 +707,18 @@ void ae_exp_manager::open_backup_files( gzFile& env_file,
   // -------------------------------------------------------------------------
   // 2) Open backup files (environment, population and selection)
   // -------------------------------------------------------------------------
-  env_file = gzopen( env_file_name, mode );
-  pop_file = gzopen( pop_file_name, mode );
-  exp_backup_file = gzopen( exp_backup_file_name, mode );
+  if ( writer != NULL )
+  {
+    env_file = writer->open( env_file_name );
+    pop_file = writer->open( pop_file_name, true );
+    exp_backup_file = writer->open( exp_backup_file_name );
+  }
+  else
+  {
+    env_file = gzopen( env_file_name, mode );
+    pop_file = gzopen( pop_file_name, mode );
+    exp_backup_file = gzopen( exp_backup_file_name, mode );
+  }
   
   
   // -------------------------------------------------------------------------
@@ -710,7 +779,7 @@ void ae_exp_manager::open_backup_files( gzFile& env_file,
   // If there should be spatial structure, open file and check
   if ( spatially_structured )
   {
-    sp_struct_file = gzopen( sp_struct_file_name, mode );
+    sp_struct_file = ( writer != NULL ) ? writer->open( sp_struct_file_name ) : gzopen( sp_struct_file_name, mode );
     
     if ( sp_struct_file == Z_NULL )
     {
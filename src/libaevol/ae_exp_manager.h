@@ -56,6 +56,7 @@
 #include <ae_exp_setup.h>
 #include <ae_output_manager.h>
 #include <ae_population.h>
+#include <ae_thread_pool.h>
 
 
 
@@ -96,6 +97,9 @@ class ae_exp_manager : public ae_object
   
     inline bool quit_signal_received( void ) const;
     
+    inline ae_thread_pool* get_thread_pool( void ) const;
+    inline int16_t get_nb_threads( void ) const;
+    
     
     inline int16_t  get_nb_env_segments( void ) const;
     
@@ -157,6 +161,7 @@ class ae_exp_manager : public ae_object
     // =======================================================================
     inline void set_first_gener( int32_t first_gener );
     inline void set_nb_gener( int32_t nb_gener );
+    void set_nb_threads( int16_t nb_threads );
     //~ inline void set_min_genome_length( int32_t min_genome_length );
     //~ inline void set_max_genome_length( int32_t max_genome_length );
     inline void set_spatial_structure(  int16_t grid_width,
@@ -171,7 +176,7 @@ class ae_exp_manager : public ae_object
     //                               Public Methods
     // =======================================================================
     void write_setup_files( void );
-    void save( void ) const;
+    void save( ae_background_writer* writer = NULL ) const;
     void save_copy( char* dir, int32_t num_gener = 0 ) const;
     void load( int32_t first_gener, bool use_text_files, bool verbose, bool to_be_run = true);
     void load( int32_t first_gener,
@@ -224,7 +229,8 @@ class ae_exp_manager : public ae_object
                             gzFile& sp_struct_file,
                             int32_t num_gener,
                             const char mode[3],
-                            const char* dir = "." ) const;
+                            const char* dir = ".",
+                            ae_background_writer* writer = NULL ) const;
     void close_backup_files(  gzFile& env_file,
                               gzFile& pop_file,
                               gzFile& sel_file,
@@ -264,6 +270,11 @@ class ae_exp_manager : public ae_object
     // Set to true when ctrl-Q is received. Will cause the simulation
     // to be ended after current generation is completed
     bool _quit_signal_received;
+    
+    // ----------------------------------------------- Multithreaded execution
+    // NULL unless a number of threads has been explicitly provided, in which
+    // case the replication of the individuals is done in parallel
+    ae_thread_pool* _thread_pool;
 };
 
 
@@ -300,6 +311,16 @@ inline bool ae_exp_manager::quit_signal_received( void ) const
   return _quit_signal_received;
 }
 
+inline ae_thread_pool* ae_exp_manager::get_thread_pool( void ) const
+{
+  return _thread_pool;
+}
+
+inline int16_t ae_exp_manager::get_nb_threads( void ) const
+{
+  return ( _thread_pool != NULL ) ? _thread_pool->get_nb_threads() : 1;
+}
+
 inline ae_environment* ae_exp_manager::get_env( void ) const
 {
   return _env;
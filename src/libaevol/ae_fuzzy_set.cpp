@@ -31,6 +31,7 @@
 //                              Libraries
 // =================================================================
 #include <math.h>
+#include <algorithm>
 
 
 
@@ -57,31 +58,30 @@
 // =================================================================
 ae_fuzzy_set::ae_fuzzy_set( void )
 {
-  _points = new ae_list<ae_point_2d*>();
+  _nb_points  = 0;
+  _capacity   = 16;
+  _points     = new ae_point_2d[_capacity];
   
   initialize();
 }
 
 ae_fuzzy_set::ae_fuzzy_set( const ae_fuzzy_set &model )
 {
-  _points = new ae_list<ae_point_2d*>();
-
-  ae_list_node<ae_point_2d*>* model_point_parser = model._points->get_first();
-  ae_point_2d*  model_point;
-
-  while ( model_point_parser != NULL )
+  _nb_points  = model._nb_points;
+  _capacity   = ( model._nb_points > 16 ) ? model._nb_points : 16;
+  _points     = new ae_point_2d[_capacity];
+  
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
   {
-    model_point = model_point_parser->get_obj();
-
-    _points->add( new ae_point_2d( *model_point ) );
-
-    model_point_parser = model_point_parser->get_next();
+    _points[i] = model._points[i];
   }
 }
 
 ae_fuzzy_set::ae_fuzzy_set( gzFile backup_file )
 {
-  _points = new ae_list<ae_point_2d*>();
+  _nb_points  = 0;
+  _capacity   = 16;
+  _points     = new ae_point_2d[_capacity];
   
   load( backup_file );
 }
@@ -91,11 +91,7 @@ ae_fuzzy_set::ae_fuzzy_set( gzFile backup_file )
 // =================================================================
 ae_fuzzy_set::~ae_fuzzy_set( void )
 {
-  if ( _points != NULL )
-  {
-    _points->erase( true );
-    delete _points;
-  }
+  delete [] _points;
 }
 
 // =================================================================
@@ -111,96 +107,35 @@ void ae_fuzzy_set::simplify( void )
   //  |  A+          \   /
   //  |   |           \ /
   //  |---+------------+-------+----->
-
-  //  printf("initial nb of points %d\n",_points.get_count());
-
-  ae_list_node<ae_point_2d*>* node = _points->get_first();
-  ae_list_node<ae_point_2d*>* next_node = NULL;
-  ae_list_node<ae_point_2d*>* other_node = NULL;
-  ae_point_2d* pt = NULL;
-  ae_point_2d* next_pt = NULL;
-  ae_point_2d* other_pt = NULL;
-  double x, y, next_x, next_y, other_x, other_y;
-
-  while ( node != NULL )
+  //
+  // i.e. the points surrounded by two points with the same abscissa (A)
+  // and then those surrounded by two points with the same ordinate (B)
+  
+  int32_t nb_kept = 0;
+  double  prev_x  = 0.0;
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
   {
-    pt = node->get_obj();
-    x = pt->x;
-    y = pt->y;
-    next_node = node->get_next();
-    if ( next_node != NULL )
+    double x = _points[i].x;
+    if ( i == 0 || i == _nb_points - 1 || prev_x != x || _points[i + 1].x != x )
     {
-      next_pt = next_node->get_obj();
-      next_x = next_pt->x;
-      next_y = next_pt->y;
-      if ( next_x == x )
-      {
-        // discontinuity on x
-        // is the next point also on the same x ?
-        other_node = next_node->get_next();
-        while ( other_node != NULL )
-        {
-          other_pt = other_node->get_obj();
-          other_x = other_pt->x;
-          other_y = other_pt->y;
-          if ( other_x == x )
-          {
-            _points->remove( next_node, true, true );
-            next_node = other_node;
-          }
-          else
-          {
-            break;
-          }
-          other_node = other_node->get_next();
-        }
-      }
+      _points[nb_kept++] = _points[i];
     }
-    node = next_node;
+    prev_x = x;
   }
-
-
-  node = _points->get_first();
-  next_node = NULL;
-  other_node = NULL;
-  pt = NULL;
-  next_pt = NULL;
-  other_pt = NULL;
-
-  while ( node != NULL )
+  _nb_points = nb_kept;
+  
+  nb_kept = 0;
+  double prev_y = 0.0;
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
   {
-    pt = node->get_obj();
-    x = pt->x;
-    y = pt->y;
-    next_node = node->get_next();
-    if ( next_node != NULL )
+    double y = _points[i].y;
+    if ( i == 0 || i == _nb_points - 1 || prev_y != y || _points[i + 1].y != y )
     {
-      next_pt = next_node->get_obj();
-      next_x = next_pt->x;
-      next_y = next_pt->y;
-      if ( next_y == y )
-      {
-        // plateau on y
-        // is the next point also on the same y ?
-        other_node = next_node->get_next();
-        while ( other_node != NULL )
-        {
-          other_pt = other_node->get_obj();
-          other_x = other_pt->x;
-          other_y = other_pt->y;
-          if ( other_y == y )
-          {
-            _points->remove( next_node, true, true );
-            next_node = other_node;
-            next_pt = next_node->get_obj();
-          }
-          else break;
-          other_node = other_node->get_next();
-        }
-      }
+      _points[nb_kept++] = _points[i];
     }
-    node = next_node;
+    prev_y = y;
   }
+  _nb_points = nb_kept;
   
   #ifdef DEBUG
     _assert_order();
@@ -209,113 +144,179 @@ void ae_fuzzy_set::simplify( void )
 
 void ae_fuzzy_set::print_points( void ) const
 {
-  ae_list_node<ae_point_2d*>* point_node = _points->get_first();
-  ae_point_2d*  point;
-
-  while ( point_node != NULL )
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
   {
-    point = point_node->get_obj();
-
-    printf( "  (%f, %f)\n", point->x, point->y );
-
-    point_node = point_node->get_next();
+    printf( "  (%f, %f)\n", _points[i].x, _points[i].y );
   }
 }
 
 void ae_fuzzy_set::add_triangle( double mean, double width, double height )
 {
-  assert( X_MIN <= mean   && mean <= X_MAX );
-  assert( W_MIN <= width ); // the maximum width depends on each individual
-  // assert( MIN_H <= height && height <= MAX_H ); Not necessarily because the concentration can be > 1
-  
-  if ( fabs(width) < 1e-15 || fabs(height) < 1e-15 ) return;
-  
-  // Compute triangle points' coordinates
-  double x0 = mean - width;
-  double x1 = mean;
-  double x2 = mean + width;
-  //~ double y0 = 0.0;
-  double y1 = height;
-  //~ double y2 = 0.0;
-
-  // We will need at least a point at abscissa x0, x1 and x2,
-  // Create them if they don't exist or update them if they do.
-  ae_list_node<ae_point_2d*>* node_0 = NULL;
-  ae_list_node<ae_point_2d*>* node_1 = NULL;
-  ae_list_node<ae_point_2d*>* node_2 = NULL;
-
-  if ( x0 >= X_MIN )  node_0 = create_interpolated_point( x0 );
-                      node_1 = create_interpolated_point( x1, node_0 );
-  if ( x2 <= X_MAX )  node_2 = create_interpolated_point( x2, node_1 );
-
+  double triangle[3] = { mean, width, height };
+  add_triangles( 1, triangle );
+}
 
-  // Update all the points in the list having their abscisse in ]x0;x2[
-  ae_list_node<ae_point_2d*>* point_node;
-  ae_point_2d*  point;
-  if ( node_0 != NULL ) point_node = node_0->get_next();
-  else point_node = _points->get_first();
+/*!
+  Add nb_triangles triangles to the fuzzy set, triangle i being given by
+  (triangles[3*i], triangles[3*i+1], triangles[3*i+2]) = (mean, width, height)
 
-  while ( point_node != node_2 )
+  The abscissas of all the vertices are sorted and merged with those of the
+  existing points in a single pass. The ordinate of each resulting point is
+  then given by the closed form of the triangles spanning it, which are kept
+  in an active set during the sweep.
+*/
+void ae_fuzzy_set::add_triangles( int32_t nb_triangles, const double* triangles )
+{
+  // 1) Compute the vertices of the (non-degenerate) triangles
+  double*   x0      = new double[4 * nb_triangles];
+  double*   x1      = x0 + nb_triangles;
+  double*   x2      = x1 + nb_triangles;
+  double*   heights = x2 + nb_triangles;
+  double*   new_x   = new double[3 * nb_triangles];
+  int32_t*  order   = new int32_t[2 * nb_triangles];
+  int32_t*  active  = order + nb_triangles;
+  int32_t   nb_tri  = 0;
+  int32_t   nb_new_x = 0;
+  
+  for ( int32_t i = 0 ; i < nb_triangles ; i++ )
   {
-    point = point_node->get_obj();
-
-    if ( point_node == node_1 )
+    double mean   = triangles[3 * i];
+    double width  = triangles[3 * i + 1];
+    double height = triangles[3 * i + 2];
+    
+    assert( X_MIN <= mean   && mean <= X_MAX );
+    assert( W_MIN <= width ); // the maximum width depends on each individual
+    // assert( MIN_H <= height && height <= MAX_H ); Not necessarily because the concentration can be > 1
+    
+    if ( fabs(width) < 1e-15 || fabs(height) < 1e-15 ) continue;
+    
+    x0[nb_tri]      = mean - width;
+    x1[nb_tri]      = mean;
+    x2[nb_tri]      = mean + width;
+    heights[nb_tri] = height;
+    
+    // We will need at least a point at abscissa x0, x1 and x2
+    if ( x0[nb_tri] >= X_MIN )  new_x[nb_new_x++] = x0[nb_tri];
+                                new_x[nb_new_x++] = x1[nb_tri];
+    if ( x2[nb_tri] <= X_MAX )  new_x[nb_new_x++] = x2[nb_tri];
+    
+    order[nb_tri] = nb_tri;
+    nb_tri++;
+  }
+  
+  if ( nb_tri > 0 )
+  {
+    std::sort( new_x, new_x + nb_new_x );
+    std::sort( order, order + nb_tri, [x0]( int32_t a, int32_t b ) { return x0[a] < x0[b]; } );
+    
+    // 2) Merge the new abscissas with the existing points, interpolating
+    //    the current ordinate at the new ones
+    int32_t       capacity    = _nb_points + nb_new_x;
+    ae_point_2d*  points      = new ae_point_2d[capacity];
+    int32_t       nb_points   = 0;
+    int32_t       j           = 0;
+    
+    for ( int32_t i = 0 ; i < _nb_points ; i++ )
     {
-      point->y += y1;
+      while ( j < nb_new_x && new_x[j] <= _points[i].x )
+      {
+        if ( new_x[j] < _points[i].x && ( nb_points == 0 || new_x[j] != points[nb_points - 1].x ) )
+        {
+          const ae_point_2d& prev = _points[i - 1];
+          points[nb_points].x = new_x[j];
+          points[nb_points].y = prev.y + (_points[i].y - prev.y) * (new_x[j] - prev.x) / (_points[i].x - prev.x);
+          nb_points++;
+        }
+        j++;
+      }
+      
+      points[nb_points++] = _points[i];
     }
-    else
+    
+    // 3) Sweep the points, adding the contribution of each triangle spanning them
+    int32_t next_tri  = 0;
+    int32_t nb_active = 0;
+    
+    for ( int32_t i = 0 ; i < nb_points ; i++ )
     {
-      if ( point->x < x1 )
+      double x = points[i].x;
+      
+      while ( next_tri < nb_tri && x0[order[next_tri]] < x )
       {
-        point->y += y1 * (point->x - x0) / (x1 - x0);
+        active[nb_active++] = order[next_tri++];
       }
-      else
+      
+      for ( int32_t k = 0 ; k < nb_active ; )
       {
-        point->y += y1 * (x2 - point->x) / (x2 - x1);
+        int32_t t = active[k];
+        
+        if ( x2[t] <= x )
+        {
+          active[k] = active[--nb_active];
+          continue;
+        }
+        
+        if ( x == x1[t] )    points[i].y += heights[t];
+        else if ( x < x1[t] ) points[i].y += heights[t] * (x - x0[t]) / (x1[t] - x0[t]);
+        else                  points[i].y += heights[t] * (x2[t] - x) / (x2[t] - x1[t]);
+        
+        k++;
       }
     }
-
-    point_node = point_node->get_next();
+    
+    replace_points( points, nb_points, capacity );
   }
   
+  delete [] x0;
+  delete [] new_x;
+  delete [] order;
+  
   #ifdef DEBUG
     _assert_order();
   #endif
 }
 
-void ae_fuzzy_set::add( ae_fuzzy_set* to_add )
+void ae_fuzzy_set::add( const ae_fuzzy_set* to_add )
 {
   // Add interpolated points (one point is needed for each abscissa present in either of the two point lists)
-  ae_list_node<ae_point_2d*>* point_node = _points->get_first();
-  ae_list_node<ae_point_2d*>* point_to_add_node = to_add->get_points()->get_first();
-  ae_point_2d*  point;
-  ae_point_2d*  point_to_add;
-
-  while ( point_to_add_node != NULL )
+  int32_t       capacity  = _nb_points + to_add->_nb_points;
+  ae_point_2d*  points    = new ae_point_2d[capacity];
+  int32_t       nb_points = 0;
+  int32_t       i         = 0;
+  
+  for ( int32_t j = 0 ; j < to_add->_nb_points ; j++ )
   {
-    point_to_add = point_to_add_node->get_obj();
-
-    point_node = create_interpolated_point( point_to_add->x, point_node );
-
-    point_to_add_node = point_to_add_node->get_next();
+    double x = to_add->_points[j].x;
+    
+    while ( _points[i].x < x )
+    {
+      points[nb_points++] = _points[i++];
+    }
+    
+    if ( _points[i].x == x || ( nb_points > 0 && points[nb_points - 1].x == x ) ) continue;
+    
+    const ae_point_2d& prev = points[nb_points - 1];
+    points[nb_points].x = x;
+    points[nb_points].y = prev.y + (_points[i].y - prev.y) * (x - prev.x) / (_points[i].x - prev.x);
+    nb_points++;
   }
-
-
+  while ( i < _nb_points )
+  {
+    points[nb_points++] = _points[i++];
+  }
+  
+  
   // Update each point's ordinate
-  point_node = _points->get_first();
-
-  while ( point_node != NULL )
+  int32_t j = 0;
+  for ( i = 0 ; i < nb_points ; i++ )
   {
-    point = point_node->get_obj();
-
-    point->y += to_add->get_y( point->x );  // It is possible to gain some execution time here
-                                            // by parsing  to_add's point list and using the
-                                            // get_y( double x, ae_list_node* list_entry ) function
-                                            // instead of get_y( double x )
-
-    point_node = point_node->get_next();
+    while ( to_add->_points[j].x < points[i].x ) j++;
+    
+    points[i].y += to_add->get_y( points[i].x, j > 0 ? j - 1 : 0 );
   }
   
+  replace_points( points, nb_points, capacity );
+  
   #ifdef DEBUG
     _assert_order();
   #endif
@@ -328,39 +329,37 @@ void ae_fuzzy_set::sub( ae_fuzzy_set* to_sub )
   to_sub->simplify();
 
 
-  // 2. Add.
-  ae_list_node<ae_point_2d*>* bn = _points->get_first();
-  ae_list_node<ae_point_2d*>* rn = (to_sub->_points)->get_first();
-  ae_list_node<ae_point_2d*>* next_bn = NULL;
-  ae_list_node<ae_point_2d*>* next_rn = NULL;
-  ae_point_2d* bpt = NULL;
-  ae_point_2d* rpt = NULL;
-  ae_point_2d* next_bpt = NULL;
-  ae_point_2d* next_rpt = NULL;
-  ae_point_2d* new_pt = NULL;
-  double xb, yb, xr, yr, next_xb, next_yb, next_xr, next_yr;
+  // 2. Sub.
+  const ae_point_2d*  black     = _points;
+  const ae_point_2d*  red       = to_sub->_points;
+  int32_t             nb_black  = _nb_points;
+  int32_t             nb_red    = to_sub->_nb_points;
+  int32_t             bn        = 0;
+  int32_t             rn        = 0;
+  double xb = 0.0, yb = 0.0, xr = 0.0, yr = 0.0, next_yb = 0.0, next_yr = 0.0;
   double yb_interpol, yr_interpol;
   bool red_discont = false;
   bool black_discont = false;
-  ae_list<ae_point_2d*>* result = new ae_list<ae_point_2d*>();
+  
+  // Each step consumes at least as many points as it creates, except the last one
+  int32_t       capacity  = nb_black + nb_red + 2;
+  ae_point_2d*  result    = new ae_point_2d[capacity];
+  int32_t       nb_result = 0;
+  
+  #define ADD_RESULT( X, Y ) { result[nb_result].x = X; result[nb_result].y = Y; nb_result++; }
 
-  while ( bn != NULL || rn != NULL ) // there are more points to deal with
+  while ( bn < nb_black || rn < nb_red ) // there are more points to deal with
   {
     // get data for the black function
-    if ( bn != NULL )
+    if ( bn < nb_black )
     {
       black_discont = false;
-      bpt = bn->get_obj();
-      xb = bpt->x;
-      yb = bpt->y;
-      next_bn = bn->get_next();
-      if ( next_bn != NULL )
+      xb = black[bn].x;
+      yb = black[bn].y;
+      if ( bn + 1 < nb_black )
       {
-        next_bpt = next_bn->get_obj();
-        next_xb = next_bpt->x;
-        next_yb = next_bpt->y;
-
-        if ( next_xb == xb )
+        next_yb = black[bn + 1].y;
+        if ( black[bn + 1].x == xb )
         {
           black_discont = true;
         }
@@ -373,44 +372,30 @@ void ae_fuzzy_set::sub( ae_fuzzy_set* to_sub )
       // xb and yb have the same values as those of the last black point
       yr_interpol = to_sub->get_y( xb );
 
-      if ( rn != NULL && yb != 0 )
+      if ( rn < nb_red && yb != 0 )
       {
-        new_pt = new ae_point_2d( xb, -yr_interpol );
-        assert( new_pt );
-        result->add( new_pt );
+        ADD_RESULT( xb, -yr_interpol );
       }
 
-      while ( rn != NULL )
+      while ( rn < nb_red )
       {
-        rpt = rn->get_obj();
-        xr = rpt->x;
-        yr = rpt->y;
-        new_pt = new ae_point_2d( xr, -yr );
-        assert( new_pt );
-        result->add( new_pt );
-
-        rn = rn->get_next();
+        ADD_RESULT( red[rn].x, -red[rn].y );
+        rn++;
       }
 
       break;
     }
 
     // get data for the red function
-    if ( rn != NULL )
+    if ( rn < nb_red )
     {
       red_discont = false;
-      rpt = rn->get_obj();
-      xr = rpt->x;
-      yr = rpt->y;
-      next_rn = rn->get_next();
-
-      if ( next_rn != NULL )
+      xr = red[rn].x;
+      yr = red[rn].y;
+      if ( rn + 1 < nb_red )
       {
-        next_rpt  = next_rn->get_obj();
-        next_xr   = next_rpt->x;
-        next_yr   = next_rpt->y;
-
-        if ( next_xr == xr )
+        next_yr = red[rn + 1].y;
+        if ( red[rn + 1].x == xr )
         {
           red_discont = true;
         }
@@ -421,26 +406,17 @@ void ae_fuzzy_set::sub( ae_fuzzy_set* to_sub )
       // no more red point, do as if the red function were 0:
       // simply copy the (eventual) remaining black points in the result
       // xr and yr have the same values as those of the last red point
-      // printf("no more red point\n");
       yb_interpol = get_y( xr );
 
-      if ( bn != NULL && yr != 0 )
+      if ( bn < nb_black && yr != 0 )
       {
-        new_pt = new ae_point_2d( xr, yb_interpol );
-        assert( new_pt );
-        result->add( new_pt );
+        ADD_RESULT( xr, yb_interpol );
       }
 
-      while ( bn != NULL )
+      while ( bn < nb_black )
       {
-        bpt = bn->get_obj();
-        xb = bpt->x;
-        yb = bpt->y;
-        new_pt = new ae_point_2d( xb, yb );
-        assert( new_pt );
-        result->add( new_pt );
-
-        bn = bn->get_next();
+        ADD_RESULT( black[bn].x, black[bn].y );
+        bn++;
       }
       break;
     }
@@ -451,182 +427,54 @@ void ae_fuzzy_set::sub( ae_fuzzy_set* to_sub )
     {
       // ----------------- case 1 : xb == xr -----------------------
       // there will be at at least one point P on x == xb == x_c
-
-      if ( ! red_discont && ! black_discont )
+      // P+ (if any) is computed using the following black and/or red point
+      // and we jump over the following point of each discontinuous function
+      ADD_RESULT( xb, yb - yr );
+      if ( black_discont || red_discont )
       {
-        // case 1a : no discontinuity
-        // => P(x, yb + yr)
-        new_pt = new ae_point_2d( xb, yb - yr );
-        assert( new_pt );
-        result->add( new_pt );
-
-        bn = next_bn;
-        if ( bn != NULL ) next_bn = bn->get_next();
-        rn = next_rn;
-        if ( rn != NULL ) next_rn = rn->get_next();
+        ADD_RESULT( xb, ( black_discont ? next_yb : yb ) - ( red_discont ? next_yr : yr ) );
       }
-      else
+      
+      bn += black_discont ? 2 : 1;
+      rn += red_discont ? 2 : 1;
+    }
+    else if ( xb < xr )
+    {
+      // ----------------- case 2 : xb < xr -----------------------
+      // there will be at at least one point P on x == xb (two if
+      // there is a discontinuity on xb in the black function)
+      // can there be a discontinuity on xr ? yes, but we will deal
+      // with it later, when min{xb,xr} will be xr
+      yr_interpol = to_sub->get_y( xb );
+      
+      ADD_RESULT( xb, yb - yr_interpol );
+      if ( black_discont )
       {
-        if ( black_discont && ! red_discont )
-        {
-          // case 1b : discontinuity in the black function only
-          // => P-(x, yb- + yr) and P+(x, yb+ + yr)
-          // P+ is computed using the following black point
-          new_pt = new ae_point_2d( xb, yb - yr );
-          assert( new_pt );
-          result->add( new_pt );
-
-          new_pt = new ae_point_2d( xb, next_yb - yr );
-          assert( new_pt );
-          result->add( new_pt );
-
-          if ( next_bn != NULL ) bn = next_bn->get_next(); // jump over the next black point
-          if ( bn != NULL ) next_bn = bn->get_next();
-          rn = next_rn;
-          if ( rn != NULL ) next_rn = rn->get_next();
-        }
-        else
-        {
-          if ( ! black_discont && red_discont )
-          {
-            // case 1c : discontinuity in the red function only
-            // => P-(x, yb + yr-) and P+(x, yb + yr+)
-            // P+ is computed using the following red point
-            new_pt = new ae_point_2d( xb, yb - yr );
-            assert( new_pt );
-            result->add( new_pt );
-
-            new_pt = new ae_point_2d( xb, yb - next_yr );
-            assert( new_pt );
-            result->add( new_pt );
-
-            bn = next_bn;
-            if ( bn != NULL ) next_bn = bn->get_next();
-            if ( next_rn != NULL ) rn = next_rn->get_next(); // jump over the next red point
-            if ( rn != NULL ) next_rn = rn->get_next();
-          }
-          else
-          {
-            // case 1d : discontinuity in both functions
-            // => P-(x, yb- + yr-) and P+(x, yb+ + yr+)
-            // P+ is computed using both the following red and black points
-            new_pt = new ae_point_2d( xb, yb - yr );
-            assert( new_pt );
-            result->add( new_pt );
-
-            new_pt = new ae_point_2d( xb, next_yb - next_yr );
-            assert( new_pt );
-            result->add( new_pt );
-
-            if ( next_bn != NULL ) bn = next_bn->get_next(); // jump over the next black point
-            if ( bn != NULL ) next_bn = bn->get_next();
-            if ( next_rn != NULL ) rn = next_rn->get_next(); // jump over the next red point
-            if ( rn != NULL ) next_rn = rn->get_next();
-          }
-        }
+        ADD_RESULT( xb, next_yb - yr_interpol );
       }
+      
+      bn += black_discont ? 2 : 1;
     }
     else
     {
-      // xb is the === zone:
-      //
-      // ==============|---|---|================
-      //           xr-eps  xr  xr+eps
-
-      if( xb < xr )
-      {
-        // ----------------- case 2 : xb < xr -----------------------
-        // xb is the === zone:
-        //
-        // ==============|---|---|-----------------
-        //           xr-eps  xr  xr+eps
-        //
-        // there will be at at least one point P on x == xb
-
-        yr_interpol = to_sub->get_y( xb );
-
-        if ( ! black_discont )
-        {
-          // case 2a : no discontinuity
-          // => P(xb, yb + red(xb))
-          new_pt = new ae_point_2d( xb, yb - yr_interpol );
-          assert( new_pt );
-          result->add( new_pt );
-
-          bn = next_bn;
-          if ( bn != NULL ) next_bn = bn->get_next();
-        }
-        else
-        {
-          // case 2b : discontinuity on xb in the black function
-          // => P-(xb, yb- + red(xb)) and P+(xb, yb+ + red(xb))
-          new_pt = new ae_point_2d( xb, yb - yr_interpol );
-          assert( new_pt );
-          result->add( new_pt );
-
-          new_pt = new ae_point_2d( xb, next_yb - yr_interpol );
-          assert( new_pt );
-          result->add( new_pt );
-
-          if ( next_bn != NULL ) bn = next_bn->get_next(); // jump over the next bn
-          if ( bn != NULL ) next_bn = bn->get_next();
-        }
-        // can there be a discontinuity on xr ? yes, but we will deal
-        // with it later, when min{xb,xr} will be xr
-
-        // bn goes one step further and rn doesn't move
-        // if there is a discontinuity on xb, the same thing will
-        // happen with the following black point
-      }
-      else
+      // ----------------- case 3 : xb > xr -----------------------
+      // there will be at at least one point P on x == xr (two if
+      // there is a discontinuity on xr in the red function)
+      yb_interpol = get_y( xr );
+      
+      ADD_RESULT( xr, yb_interpol - yr );
+      if ( red_discont )
       {
-        // ----------------- case 3 : xb > xr -----------------------
-        // xb is the === zone:
-        //
-        // --------------|---|---|===============
-        //           xr-eps  xr  xr+eps
-        //
-        // there will be at at least one point P on x == xr
-
-        yb_interpol = get_y( xr );
-
-        if ( ! red_discont )
-        {
-          // case 3a : no discontinuity
-          // => P(xr, yr + black(xr))
-          new_pt = new ae_point_2d( xr, yb_interpol - yr );
-          assert( new_pt );
-          result->add( new_pt );
-
-          rn = next_rn;
-          if ( rn != NULL ) next_rn = rn->get_next();
-        }
-        else
-        {
-          // case 2b : discontinuity on xr
-          // => P-(xr, yr- + black(xr)) and P+(xr, yr+ + black(xr))
-          new_pt = new ae_point_2d( xr, yb_interpol - yr );
-          assert( new_pt );
-          result->add( new_pt );
-
-          new_pt = new ae_point_2d( xr, yb_interpol - next_yr );
-          assert( new_pt );
-          result->add( new_pt );
-
-          if ( next_rn != NULL ) rn = next_rn->get_next(); // jump over next red point
-          if ( rn != NULL ) next_rn = rn->get_next();
-        }
-
-        // store xr, rn goes one step further and bn doesn't move
-        // if there is a discontinuity on xr, the same thing will
-        // happen with the following red point
+        ADD_RESULT( xr, yb_interpol - next_yr );
       }
+      
+      rn += red_discont ? 2 : 1;
     }
   }
+  
+  #undef ADD_RESULT
 
-  _points->erase( true );
-  delete _points;
-  _points = result;
+  replace_points( result, nb_result, capacity );
   
   #ifdef DEBUG
     _assert_order();
@@ -636,42 +484,13 @@ void ae_fuzzy_set::sub( ae_fuzzy_set* to_sub )
 double ae_fuzzy_set::get_geometric_area( void ) const
 {
   double area = 0;
-  double tmp, tmp2;
   
-  ae_point_2d*  point =  _points->get_first()->get_obj();
-  ae_list_node<ae_point_2d*>* next_point_node = _points->get_first()->get_next();
-  ae_point_2d*  next_point = NULL;
-
-  while ( next_point_node != NULL )
+  for ( int32_t i = 1 ; i < _nb_points ; i++ )
   {
-    next_point = next_point_node->get_obj();
-
-    if ( point->x != next_point->x )
+    if ( _points[i - 1].x != _points[i].x )
     {
-      if ( (point->y > 0 && next_point->y < 0) || (point->y < 0 && next_point->y > 0) )
-      {
-        // The segment [point, next_point] crosses the abscissa axis => We will compute the area in 2 parts
-        ae_point_2d* pt_zero  = new ae_point_2d( get_x( 0.0, point, next_point ), 0.0 );
-
-        tmp = (point->y + pt_zero->y) * (pt_zero->x - point->x) / 2.0;              // Negative if y1 is negative
-        tmp2 =  (pt_zero->y + next_point->y) * (next_point->x - pt_zero->x) / 2.0;  // Negative if y2 is negative
-
-        delete pt_zero;
-
-        area += ( tmp  >= 0 )? tmp  : -tmp;
-        area += ( tmp2 >= 0 )? tmp2 : -tmp2;
-      }
-      else
-      {
-        // The segment is entirely above or underneath the abscissa axis
-        tmp = (point->y + next_point->y) * (next_point->x - point->x) / 2.0;
-
-        area += ( tmp >= 0 )? tmp : -tmp;
-      }
+      area += get_trapezoid_area( _points[i - 1].x, _points[i - 1].y, _points[i].x, _points[i].y );
     }
-
-    point = next_point;
-    next_point_node = next_point_node->get_next();
   }
 
   return area;
@@ -680,190 +499,233 @@ double ae_fuzzy_set::get_geometric_area( void ) const
 double ae_fuzzy_set::get_geometric_area( double start_segment, double end_segment ) const
 {
   // Fuzzy set first (resp last) point must be at x = X_MIN (resp x = X_MAX)
-  assert( _points->get_first() != _points->get_last() );
-  assert( _points->get_first()->get_obj()->x == X_MIN );
-  assert( _points->get_last()->get_obj()->x == X_MAX );
+  assert( _nb_points >= 2 );
+  assert( _points[0].x == X_MIN );
+  assert( _points[_nb_points - 1].x == X_MAX );
   
   // We must have ( X_MIN <= start_segment < end_segment <= X_MAX )
   assert( start_segment >= X_MIN && start_segment < end_segment && end_segment <= X_MAX );
   
+  // If there are no points at x = start_segment and x = end_segment, we must interpolate them
+  int32_t i = 0;
+  while ( _points[i].x < start_segment ) i++;
+  
+  double prev_x = start_segment;
+  double prev_y = ( _points[i].x == start_segment ) ? _points[i].y : get_y( start_segment, i - 1 );
+  
   double area = 0;
-  double tmp, tmp2;
+  for ( ; i < _nb_points && _points[i].x <= end_segment ; i++ )
+  {
+    if ( prev_x != _points[i].x )
+    {
+      area += get_trapezoid_area( prev_x, prev_y, _points[i].x, _points[i].y );
+    }
+    
+    prev_x = _points[i].x;
+    prev_y = _points[i].y;
+  }
   
-  ae_list_node<ae_point_2d*>* point_node      = _points->get_first();
-  ae_list_node<ae_point_2d*>* next_point_node = point_node->get_next();
+  if ( prev_x < end_segment )
+  {
+    double end_y = prev_y + (_points[i].y - prev_y) * (end_segment - prev_x) / (_points[i].x - prev_x);
+    area += get_trapezoid_area( prev_x, prev_y, end_segment, end_y );
+  }
   
-  ae_point_2d*  point       = point_node->get_obj();
-  ae_point_2d*  next_point  = NULL;
+  return area;
+}
+
+/*!
+  Compute the area between this fuzzy set and target on each of the (sorted) segments
 
-  while ( next_point_node != NULL )
+  This is done in a single sweep over the points of both fuzzy sets and the
+  segment boundaries. Between two consecutive abscissas of the sweep, both
+  fuzzy sets are linear and so is their difference.
+*/
+void ae_fuzzy_set::get_distance_by_segment( const ae_fuzzy_set* target, int16_t nb_segments, ae_env_segment** segments, double* distances ) const
+{
+  const ae_point_2d*  p   = _points;
+  const ae_point_2d*  q   = target->_points;
+  int32_t             n   = _nb_points;
+  int32_t             m   = target->_nb_points;
+  
+  assert( p[0].x == X_MIN && p[n - 1].x == X_MAX );
+  assert( q[0].x == X_MIN && q[m - 1].x == X_MAX );
+  
+  for ( int16_t s = 0 ; s < nb_segments ; s++ )
   {
-    next_point = next_point_node->get_obj();
+    distances[s] = 0.0;
+  }
+  
+  // At each abscissa x of the sweep, i (resp. j) is the index of the first
+  // point of this (resp. target) such that p[i].x > x.
+  // The difference is evaluated right of x (after the discontinuity, if any)
+  // and left of the next abscissa (before the discontinuity, if any).
+  int32_t i   = 0;
+  int32_t j   = 0;
+  int16_t seg = 0;
+  double  x   = X_MIN;
+  
+  while ( i < n && p[i].x <= x ) i++;
+  while ( j < m && q[j].x <= x ) j++;
+  double d = p[i - 1].y - q[j - 1].y;
+  
+  while ( x < X_MAX )
+  {
+    while ( seg < nb_segments && segments[seg]->stop <= x ) seg++;
     
-    // If there are no points at x = start_segment and x = end_segment, we must interpolate them
-    if ( point->x < start_segment && next_point->x > start_segment )
+    double next_x = ( p[i].x < q[j].x ) ? p[i].x : q[j].x;
+    if ( seg < nb_segments )
     {
-      next_point      = new ae_point_2d( start_segment, get_y( start_segment, point_node ) );
-      next_point_node = _points->add_after( next_point, point_node );
-      
-      continue;
-    }
-    if ( point->x < end_segment && next_point->x > end_segment )
-    {
-      next_point      = new ae_point_2d( end_segment, get_y( end_segment, point_node ) );
-      next_point_node = _points->add_after( next_point, point_node );
-      
-      continue;
+      double boundary = ( segments[seg]->start > x ) ? segments[seg]->start : segments[seg]->stop;
+      if ( boundary < next_x ) next_x = boundary;
     }
-
-    // If we are within the segment, compute the area
-    if ( point->x >= start_segment && next_point->x <= end_segment ) 
+    
+    // Values of both fuzzy sets left of next_x
+    double yp = ( p[i].x == next_x ) ? p[i].y : p[i - 1].y + (p[i].y - p[i - 1].y) * (next_x - p[i - 1].x) / (p[i].x - p[i - 1].x);
+    double yq = ( q[j].x == next_x ) ? q[j].y : q[j - 1].y + (q[j].y - q[j - 1].y) * (next_x - q[j - 1].x) / (q[j].x - q[j - 1].x);
+    
+    if ( seg < nb_segments && segments[seg]->start <= x )
     {
-      if ( point->x != next_point->x )
-      {
-        if ( (point->y > 0 && next_point->y < 0) || (point->y < 0 && next_point->y > 0) )
-        {
-          // The segment [point, next_point] crosses the abscissa axis => We will compute the area in 2 parts
-          ae_point_2d* pt_zero  = new ae_point_2d( get_x( 0.0, point, next_point ), 0.0 );
-
-          tmp = (point->y + pt_zero->y) * (pt_zero->x - point->x) / 2.0;              // Negative if y1 is negative
-          tmp2 =  (pt_zero->y + next_point->y) * (next_point->x - pt_zero->x) / 2.0;  // Negative if y2 is negative
-
-          delete pt_zero;
-
-          area += ( tmp  >= 0 )? tmp  : -tmp;
-          area += ( tmp2 >= 0 )? tmp2 : -tmp2;
-        }
-        else
-        {
-          // The segment is entirely above or underneath the abscissa axis
-          tmp = (point->y + next_point->y) * (next_point->x - point->x) / 2.0;
-
-          area += ( tmp >= 0 )? tmp : -tmp;
-        }
-      }
+      distances[seg] += get_trapezoid_area( x, d, next_x, yp - yq );
     }
     
-    point       = next_point;
-    point_node  = next_point_node;
-    next_point_node = next_point_node->get_next();
+    // Values of both fuzzy sets right of next_x
+    x = next_x;
+    while ( i < n && p[i].x <= x ) i++;
+    while ( j < m && q[j].x <= x ) j++;
+    if ( p[i - 1].x == x ) yp = p[i - 1].y;
+    if ( q[j - 1].x == x ) yq = q[j - 1].y;
+    d = yp - yq;
   }
-  
-  return area;
 }
 
 
 void ae_fuzzy_set::add_upper_bound( double upper_bound )
 {
-  ae_list_node<ae_point_2d*>* point_node = _points->get_first();
-  ae_point_2d*  point;
-
-  ae_list_node<ae_point_2d*>* prev_node;
-  ae_list_node<ae_point_2d*>* next_node;
-  ae_point_2d*  prev_point;
-  ae_point_2d*  next_point;
-
-  while ( point_node != NULL )
+  // Count the points to be created at the intersections of the segments and the ceiling
+  int32_t nb_new_points = 0;
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
   {
-    point = point_node->get_obj();
-
-    if ( point->y > upper_bound )
+    if ( _points[i].y > upper_bound )
     {
-      prev_node = point_node->get_prev();
-      next_node = point_node->get_next();
-
-      if ( prev_node != NULL )
+      if ( i > 0 && _points[i - 1].y < upper_bound ) nb_new_points++;
+      if ( i < _nb_points - 1 && _points[i + 1].y < upper_bound ) nb_new_points++;
+    }
+  }
+  
+  if ( nb_new_points == 0 )
+  {
+    // Simply lower the points down to upper_bound
+    for ( int32_t i = 0 ; i < _nb_points ; i++ )
+    {
+      if ( _points[i].y > upper_bound ) _points[i].y = upper_bound;
+    }
+    return;
+  }
+  
+  int32_t       capacity  = _nb_points + nb_new_points;
+  ae_point_2d*  points    = new ae_point_2d[capacity];
+  int32_t       nb_points = 0;
+  
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
+  {
+    if ( _points[i].y > upper_bound )
+    {
+      if ( i > 0 && _points[i - 1].y < upper_bound ) // In fact it can only be < or ==
       {
-        prev_point = prev_node->get_obj();
-
-        if ( prev_point->y < upper_bound ) // In fact it can only be < or ==
-        {
-          // Create a point at the intersection of the segment and the ceiling defined by the upper bound
-          _points->add_after( new ae_point_2d( get_x( upper_bound, prev_point, point ), upper_bound ), prev_node );
-        }
+        // Create a point at the intersection of the segment and the ceiling defined by the upper bound
+        points[nb_points].x = get_x( upper_bound, &_points[i - 1], &_points[i] );
+        points[nb_points].y = upper_bound;
+        nb_points++;
       }
-
-      if ( next_node != NULL )
+      
+      // Lower current point down to upper_bound
+      points[nb_points].x = _points[i].x;
+      points[nb_points].y = upper_bound;
+      nb_points++;
+      
+      if ( i < _nb_points - 1 && _points[i + 1].y < upper_bound )
       {
-        next_point = next_node->get_obj();
-
-        if ( next_point->y < upper_bound )
-        {
-          // Create a point at the intersection of the segment and the ceiling defined by the upper bound
-          _points->add_after( new ae_point_2d( get_x( upper_bound, point, next_point ), upper_bound ), point_node );
-        }
+        // Create a point at the intersection of the segment and the ceiling defined by the upper bound
+        points[nb_points].x = get_x( upper_bound, &_points[i], &_points[i + 1] );
+        points[nb_points].y = upper_bound;
+        nb_points++;
       }
-
-      // Lower current point down to upper_bound
-      point->y = upper_bound;
     }
-
-    point_node = point_node->get_next();
+    else
+    {
+      points[nb_points++] = _points[i];
+    }
   }
   
+  replace_points( points, nb_points, capacity );
+  
   #ifdef DEBUG
     _assert_order();
   #endif
 }
 
+
 void ae_fuzzy_set::add_lower_bound( double lower_bound )
 {
-  ae_list_node<ae_point_2d*>* point_node = _points->get_first();
-  ae_point_2d*  point;
-
-  ae_list_node<ae_point_2d*>* prev_node;
-  ae_list_node<ae_point_2d*>* next_node;
-  ae_point_2d*  prev_point;
-  ae_point_2d*  next_point;
-
-  while ( point_node != NULL )
+  // Count the points to be created at the intersections of the segments and the floor
+  int32_t nb_new_points = 0;
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
   {
-    point = point_node->get_obj();
-
-    if ( point->y < lower_bound )
+    if ( _points[i].y < lower_bound )
     {
-      prev_node = point_node->get_prev();
-      next_node = point_node->get_next();
-
-      if ( prev_node != NULL )
+      if ( i > 0 && _points[i - 1].y > lower_bound ) nb_new_points++;
+      if ( i < _nb_points - 1 && _points[i + 1].y > lower_bound ) nb_new_points++;
+    }
+  }
+  
+  if ( nb_new_points == 0 )
+  {
+    // Simply raise the points up to lower_bound
+    for ( int32_t i = 0 ; i < _nb_points ; i++ )
+    {
+      if ( _points[i].y < lower_bound ) _points[i].y = lower_bound;
+    }
+    return;
+  }
+  
+  int32_t       capacity  = _nb_points + nb_new_points;
+  ae_point_2d*  points    = new ae_point_2d[capacity];
+  int32_t       nb_points = 0;
+  
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
+  {
+    if ( _points[i].y < lower_bound )
+    {
+      if ( i > 0 && _points[i - 1].y > lower_bound ) // In fact it can only be > or ==
       {
-        prev_point = prev_node->get_obj();
-
-        if ( prev_point->y > lower_bound ) // In fact it can only be > or ==
-        {
-          // Create a point at the intersection of the segment and the floor defined by the lower bound
-          _points->add_after( new ae_point_2d( get_x( lower_bound, prev_point, point ), lower_bound ), prev_node );
-            
-          #ifdef DEBUG
-            _assert_order();
-          #endif
-        }
-        // else nothing to do
+        // Create a point at the intersection of the segment and the floor defined by the lower bound
+        points[nb_points].x = get_x( lower_bound, &_points[i - 1], &_points[i] );
+        points[nb_points].y = lower_bound;
+        nb_points++;
       }
-
-      if ( next_node != NULL )
+      
+      // Raise current point up to lower_bound
+      points[nb_points].x = _points[i].x;
+      points[nb_points].y = lower_bound;
+      nb_points++;
+      
+      if ( i < _nb_points - 1 && _points[i + 1].y > lower_bound )
       {
-        next_point = next_node->get_obj();
-
-        if ( next_point->y > lower_bound )
-        {
-          // Create a point at the intersection of the segment and the floor defined by the lower bound
-          _points->add_after( new ae_point_2d( get_x( lower_bound, point, next_point ), lower_bound ), point_node );
-            
-          #ifdef DEBUG
-            _assert_order();
-          #endif
-        }
-        // else nothing to do
+        // Create a point at the intersection of the segment and the floor defined by the lower bound
+        points[nb_points].x = get_x( lower_bound, &_points[i], &_points[i + 1] );
+        points[nb_points].y = lower_bound;
+        nb_points++;
       }
-
-      // Raise current point up to lower_bound
-      point->y = lower_bound;
     }
-
-    point_node = point_node->get_next();
+    else
+    {
+      points[nb_points++] = _points[i];
+    }
   }
   
+  replace_points( points, nb_points, capacity );
+  
   #ifdef DEBUG
     _assert_order();
   #endif
@@ -872,52 +734,35 @@ void ae_fuzzy_set::add_lower_bound( double lower_bound )
 
 bool ae_fuzzy_set::is_identical_to( const ae_fuzzy_set * other, double tolerance  ) const
 {
-  if ( _points->get_nb_elts() != other->_points->get_nb_elts())
+  if ( _nb_points != other->_nb_points )
   {
     return false;
   }
 
-  ae_list_node<ae_point_2d*>* point_node = _points->get_first();
-  ae_point_2d*  point = NULL;
-
-  ae_list_node<ae_point_2d*>* other_node = other->_points->get_first();
-  ae_point_2d*  other_point = NULL;
-
-  bool ok = true;
-
-  while ( ok && (point_node != NULL) )
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
   {
-    point = point_node->get_obj();
-    other_point = other_node->get_obj();
-
-    if (fabs(point->x - other_point->x)> tolerance*(fabs(point->x) + fabs(other_point->x)) || fabs(point->y - other_point->y)>tolerance*(fabs(point->y) + fabs(other_point->y)))
-      {ok = false;}
+    const ae_point_2d& point        = _points[i];
+    const ae_point_2d& other_point  = other->_points[i];
 
-    point_node = point_node->get_next();
-    other_node = other_node->get_next();
+    if ( fabs(point.x - other_point.x) > tolerance*(fabs(point.x) + fabs(other_point.x)) ||
+         fabs(point.y - other_point.y) > tolerance*(fabs(point.y) + fabs(other_point.y)) )
+    {
+      return false;
+    }
   }
   
-  return ok;
+  return true;
 }
 
 
 void ae_fuzzy_set::save( gzFile backup_file ) const
 {
-  int16_t nb_points = (_points == NULL) ? 0 : _points->get_nb_elts();
+  int16_t nb_points = _nb_points;
   gzwrite( backup_file, &nb_points, sizeof(nb_points) );
   
-  if ( _points != NULL )
+  for ( int16_t i = 0 ; i < nb_points ; i++ )
   {
-    ae_list_node<ae_point_2d*>* point_node = _points->get_first();
-    ae_point_2d*  point;
-    for ( int16_t i = 0 ; i < nb_points ; i++ )
-    {
-      point = point_node->get_obj();
-      
-      point->save( backup_file );
-      
-      point_node = point_node->get_next();
-    }
+    _points[i].save( backup_file );
   }
 }
 
@@ -927,11 +772,13 @@ void ae_fuzzy_set::load( gzFile backup_file )
   int16_t nb_points;
   gzread( backup_file, &nb_points, sizeof(nb_points) );
   
-  if ( nb_points > 0 ) _points = new ae_list<ae_point_2d*>();
+  _nb_points = 0;
+  reserve( nb_points );
   
   for ( int16_t i = 0 ; i < nb_points ; i++ )
   {
-    _points->add( new ae_point_2d( backup_file ) );
+    ae_point_2d point( backup_file );
+    add_point( point.x, point.y );
   }
 }
 
@@ -939,88 +786,91 @@ void ae_fuzzy_set::load( gzFile backup_file )
 // =================================================================
 //                           Protected Methods
 // =================================================================
-double ae_fuzzy_set::get_y( double x, ae_list_node<ae_point_2d*>* list_entry ) const
+void ae_fuzzy_set::reserve( int32_t capacity )
 {
-  if ( list_entry == NULL ) list_entry = _points->get_first();
-
-  assert( x >= X_MIN && x <= X_MAX );
-  assert( list_entry != NULL );
-  assert( list_entry->get_obj()->x <= x );
-  assert( _points->get_nb_elts() >= 2 );
+  if ( capacity <= _capacity ) return;
+  
+  ae_point_2d* points = new ae_point_2d[capacity];
+  for ( int32_t i = 0 ; i < _nb_points ; i++ )
+  {
+    points[i] = _points[i];
+  }
+  
+  replace_points( points, _nb_points, capacity );
+}
 
-  // Look for the first point of the list having point->x >= x
-  ae_list_node<ae_point_2d*>* point_node  = list_entry;
-  ae_point_2d*  point       = point_node->get_obj();
+void ae_fuzzy_set::replace_points( ae_point_2d* points, int32_t nb_points, int32_t capacity )
+{
+  delete [] _points;
+  _points     = points;
+  _nb_points  = nb_points;
+  _capacity   = capacity;
+}
 
-  while ( point->x < x )
+void ae_fuzzy_set::_assert_order( void )
+{
+  assert( _points[0].x == X_MIN );
+  assert( _points[_nb_points - 1].x == X_MAX );
+  
+  for ( int32_t i = 0 ; i < _nb_points - 1 ; i++ )
   {
-    point_node = point_node->get_next();
-    point      = point_node->get_obj();
+    assert( _points[i].x <= _points[i + 1].x );
   }
+}
+
+
+// =================================================================
+//                           Private Methods
+// =================================================================
+double ae_fuzzy_set::get_y( double x, int32_t start ) const
+{
+  assert( x >= X_MIN && x <= X_MAX );
+  assert( start >= 0 && start < _nb_points );
+  assert( _points[start].x <= x );
+  assert( _nb_points >= 2 );
+
+  // Look for the first point having point.x >= x
+  int32_t i = start;
+  while ( _points[i].x < x ) i++;
 
   // If a point with abscissa x exists, return it's y, otherwise compute the needed y by interpolation
   // from the 2 flanking points
-  if ( point->x == x ) return point->y;
+  if ( _points[i].x == x ) return _points[i].y;
   else
   {
-    ae_point_2d* prev_point = point_node->get_prev()->get_obj();
-    return prev_point->y + (point->y - prev_point->y) * (x - prev_point->x) / (point->x - prev_point->x);
+    const ae_point_2d& prev_point = _points[i - 1];
+    return prev_point.y + (_points[i].y - prev_point.y) * (x - prev_point.x) / (_points[i].x - prev_point.x);
   }
 }
 
-ae_list_node<ae_point_2d*>* ae_fuzzy_set::create_interpolated_point( double x, ae_list_node<ae_point_2d*>* list_entry )
+int32_t ae_fuzzy_set::create_interpolated_point( double x, int32_t start )
 {
-  if ( list_entry == NULL ) list_entry = _points->get_first();
-
   assert( x >= X_MIN && x <= X_MAX );
-  assert( list_entry->get_obj()->x <= x );
-  assert( _points->get_nb_elts() >= 2 );
+  assert( start >= 0 && start < _nb_points );
+  assert( _points[start].x <= x );
+  assert( _nb_points >= 2 );
 
-  // Look for the first point of the list having point->x >= x
-  ae_list_node<ae_point_2d*>* point_node  = list_entry;
-  ae_point_2d*  point       = point_node->get_obj();
+  // Look for the first point having point.x >= x
+  int32_t i = start;
+  while ( _points[i].x < x ) i++;
 
-  while ( point->x < x )
-  {
-    point_node = point_node->get_next();
-    point      = point_node->get_obj();
-  }
-
-  if ( point->x == x )
-  {
-    // The point already exists, nothing to do
-    return point_node;
-  }
-  else
+  // If the point already exists, there is nothing to do
+  if ( _points[i].x == x ) return i;
+  
+  double y = get_y( x, i - 1 );
+  
+  if ( _nb_points == _capacity ) reserve( 2 * _capacity );
+  for ( int32_t j = _nb_points ; j > i ; j-- )
   {
-    point_node = _points->add_before( new ae_point_2d( x, get_y( x ) ), point_node );
-    return point_node;
+    _points[j] = _points[j - 1];
   }
+  _points[i].x = x;
+  _points[i].y = y;
+  _nb_points++;
   
   #ifdef DEBUG
     _assert_order();
   #endif
-}
-
-void ae_fuzzy_set::_assert_order( void )
-{
-  assert( (_points->get_first()->get_obj())->x == X_MIN );
-  assert( (_points->get_last()->get_obj())->x == X_MAX );
   
-  ae_list_node<ae_point_2d*>* point_node  = _points->get_first();
-  ae_list_node<ae_point_2d*>* next_point_node = point_node->get_next();
-  ae_point_2d*  point;
-  ae_point_2d*  next_point;
-
-  while ( next_point_node != NULL )
-  {
-    point = point_node->get_obj();
-    next_point = next_point_node->get_obj();
-    
-    assert( point->x <= next_point->x );
-    
-    point_node = point_node->get_next();
-    next_point_node = next_point_node->get_next();
-  }
+  return i;
 }
-
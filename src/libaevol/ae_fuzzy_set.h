@@ -30,6 +30,11 @@
  *         abscissa are bound between MIN_X and MAX_X (defined elsewhere)
  *         A "fuzzy set" should always have at least two points of abscissa
  *         MIN_X and MAX_X
+ *
+ *         The points are kept sorted by abscissa in a flat array (two
+ *         consecutive points may share the same abscissa, which makes a
+ *         discontinuity). Operations that add points (add, sub, bounds,
+ *         add_triangles) build the new array in a single merge pass.
  */
  
  
@@ -41,6 +46,7 @@
 //                              Libraries
 // =================================================================
 #include <inttypes.h>
+#include <zlib.h>
 
 
 
@@ -50,6 +56,7 @@
 #include <ae_object.h>
 #include <ae_list.h>
 #include <ae_point_2d.h>
+#include <ae_env_segment.h>
 #include <ae_macros.h>
 
 
@@ -84,7 +91,8 @@ class ae_fuzzy_set : public ae_object
     // =================================================================
     //                              Accessors
     // =================================================================
-    inline ae_list<ae_point_2d*>* get_points( void );
+    inline int32_t      get_nb_points( void ) const;
+    inline ae_point_2d& get_point( int32_t i ) const;
   
     // =================================================================
     //                            Public Methods
@@ -93,13 +101,15 @@ class ae_fuzzy_set : public ae_object
     void simplify( void );
     void print_points( void ) const;
     void add_triangle( double mean, double width, double height );
-    void add( ae_fuzzy_set* to_add );
+    void add_triangles( int32_t nb_triangles, const double* triangles );
+    void add( const ae_fuzzy_set* to_add );
     void sub( ae_fuzzy_set* to_sub );
     double get_geometric_area( void ) const;
     double get_geometric_area( double start_segment, double end_segment ) const;
+    void get_distance_by_segment( const ae_fuzzy_set* target, int16_t nb_segments, ae_env_segment** segments, double* distances ) const;
     inline double get_y( double x ) const;
-    inline double get_x( double y, ae_point_2d* left_point, ae_point_2d* right_point ) const;
-    inline ae_list_node<ae_point_2d*>* create_interpolated_point( double x );
+    inline double get_x( double y, const ae_point_2d* left_point, const ae_point_2d* right_point ) const;
+    inline int32_t create_interpolated_point( double x );
     
     void add_upper_bound( double upper_bound );
     void add_lower_bound( double lower_bound );
@@ -140,13 +150,22 @@ class ae_fuzzy_set : public ae_object
     // =================================================================
     //                           Protected Methods
     // =================================================================
+    inline void add_point( double x, double y );
+    void reserve( int32_t capacity );
+    void replace_points( ae_point_2d* points, int32_t nb_points, int32_t capacity );
+    
+    // Area between the x-axis and the segment [(x1, y1), (x2, y2)]
+    static inline double get_trapezoid_area( double x1, double y1, double x2, double y2 );
+    
     void _assert_order( void );
   
     // =================================================================
     //                          Protected Attributes
     // =================================================================
-    exp_manager*            _exp_m;
-    ae_list<ae_point_2d*>*  _points;
+    exp_manager*  _exp_m;
+    int32_t       _nb_points;
+    int32_t       _capacity;
+    ae_point_2d*  _points;
   
   
   
@@ -154,22 +173,27 @@ class ae_fuzzy_set : public ae_object
   
   private :
     
-    // WARNING :  The 2 following functions are private because they are dangerous.
-    //            They are optimized versions of their omonyms, beginning their search at the given list entry.
-    //            The following conditions are MANDATORY : 
-    //              list_entry must be a node of the point list (_points)
-    //              the corresponding point's abscissa must be <= x
-    double get_y( double x, ae_list_node<ae_point_2d*>* list_entry ) const;
-    ae_list_node<ae_point_2d*>* create_interpolated_point( double x, ae_list_node<ae_point_2d*>* list_entry );
+    // WARNING :  The following functions are private because they are dangerous.
+    //            They are optimized versions of their omonyms, beginning their search at the given index.
+    //            The following condition is MANDATORY : 
+    //              the abscissa of the point at index start must be <= x
+    double get_y( double x, int32_t start ) const;
+    int32_t create_interpolated_point( double x, int32_t start );
 };
 
 
 // =====================================================================
 //                          Accessors definitions
 // =====================================================================
-ae_list<ae_point_2d*>* ae_fuzzy_set::get_points( void )
+inline int32_t ae_fuzzy_set::get_nb_points( void ) const
+{
+  return _nb_points;
+}
+
+inline ae_point_2d& ae_fuzzy_set::get_point( int32_t i ) const
 {
-  return _points;
+  assert( i >= 0 && i < _nb_points );
+  return _points[i];
 }
 
 // =====================================================================
@@ -177,17 +201,17 @@ ae_list<ae_point_2d*>* ae_fuzzy_set::get_points( void )
 // =====================================================================
 void ae_fuzzy_set::initialize( void )
 {
-  _points->erase( true );
-  _points->add( new ae_point_2d( X_MIN, 0.0 ) );
-  _points->add( new ae_point_2d( X_MAX, 0.0 ) );
+  _nb_points = 0;
+  add_point( X_MIN, 0.0 );
+  add_point( X_MAX, 0.0 );
 }
 
 double ae_fuzzy_set::get_y( double x ) const
 {
-  return get_y( x, _points->get_first() );
+  return get_y( x, 0 );
 }
 
-double ae_fuzzy_set::get_x( double y, ae_point_2d* left_point, ae_point_2d* right_point ) const
+double ae_fuzzy_set::get_x( double y, const ae_point_2d* left_point, const ae_point_2d* right_point ) const
 {
   assert( left_point != NULL );
   assert( right_point != NULL );
@@ -201,9 +225,42 @@ double ae_fuzzy_set::get_x( double y, ae_point_2d* left_point, ae_point_2d* righ
   else return tmp;
 }
 
-ae_list_node<ae_point_2d*>* ae_fuzzy_set::create_interpolated_point( double x )
+int32_t ae_fuzzy_set::create_interpolated_point( double x )
+{
+  return create_interpolated_point( x, 0 );
+}
+
+void ae_fuzzy_set::add_point( double x, double y )
 {
-  return create_interpolated_point( x, _points->get_first() );
+  if ( _nb_points == _capacity ) reserve( 2 * _capacity );
+  _points[_nb_points].x = x;
+  _points[_nb_points].y = y;
+  _nb_points++;
+}
+
+double ae_fuzzy_set::get_trapezoid_area( double x1, double y1, double x2, double y2 )
+{
+  double tmp, tmp2;
+  
+  if ( (y1 > 0 && y2 < 0) || (y1 < 0 && y2 > 0) )
+  {
+    // The segment crosses the abscissa axis => We will compute the area in 2 parts
+    double x_zero = x1 + (x2 - x1) * (0.0 - y1) / (y2 - y1);
+    if ( x_zero < x1 ) x_zero = x1;
+    else if ( x_zero > x2 ) x_zero = x2;
+    
+    tmp   = (y1 + 0.0) * (x_zero - x1) / 2.0;  // Negative if y1 is negative
+    tmp2  = (0.0 + y2) * (x2 - x_zero) / 2.0;  // Negative if y2 is negative
+    
+    return ( ( tmp >= 0 ) ? tmp : -tmp ) + ( ( tmp2 >= 0 ) ? tmp2 : -tmp2 );
+  }
+  else
+  {
+    // The segment is entirely above or underneath the abscissa axis
+    tmp = (y1 + y2) * (x2 - x1) / 2.0;
+    
+    return ( tmp >= 0 ) ? tmp : -tmp;
+  }
 }
 
 
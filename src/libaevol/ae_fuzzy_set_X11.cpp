@@ -76,7 +76,6 @@ void ae_fuzzy_set_X11::display( ae_X11_window* win, color_map color, bool fill /
   double delta_x = X_MAX - X_MIN;
   double delta_y = y_max - y_min;
   
-  ae_list_node<ae_point_2d*>* node = _points->get_first();
   ae_point_2d*  cur_point   = NULL;
   ae_point_2d*  next_point  = NULL;
   int16_t cur_x;
@@ -85,10 +84,10 @@ void ae_fuzzy_set_X11::display( ae_X11_window* win, color_map color, bool fill /
   int16_t next_y;
   
   
-  while ( (node != NULL) && (node->get_next() != NULL) )
+  for ( int32_t i = 0 ; i < _nb_points - 1 ; i++ )
   {
-    cur_point   = node->get_obj();
-    next_point  = node->get_next()->get_obj();
+    cur_point   = &_points[i];
+    next_point  = &_points[i + 1];
     
     // Display segment [cur_point, next_point]
     cur_x   = (      (cur_point->x -  X_MIN) / delta_x  ) * win->get_width();
@@ -99,18 +98,16 @@ void ae_fuzzy_set_X11::display( ae_X11_window* win, color_map color, bool fill /
     if ( fill )
     {
       char* fill_color;
-      for ( int16_t i = cur_x ; i < next_x ; i++ )
+      for ( int16_t col = cur_x ; col < next_x ; col++ )
       {
-        fill_color = ae_X11_window::get_color( ((double)i / win->get_width()) * (X_MAX - X_MIN) );
-        win->draw_line( i, ( 1 - ((0 -  y_min) / delta_y) ) * win->get_height(),
-                        i, cur_y + (((i - cur_x) * (next_y - cur_y)) / (next_x - cur_x)) , fill_color );
+        fill_color = ae_X11_window::get_color( ((double)col / win->get_width()) * (X_MAX - X_MIN) );
+        win->draw_line( col, ( 1 - ((0 -  y_min) / delta_y) ) * win->get_height(),
+                        col, cur_y + (((col - cur_x) * (next_y - cur_y)) / (next_x - cur_x)) , fill_color );
         delete [] fill_color;
       }
     }
     
     win->draw_line( cur_x, cur_y, next_x, next_y, color, bold );
-    
-    node = node->get_next();
   }
 }
 
@@ -31,6 +31,9 @@
 //                              Libraries
 // =================================================================
 #include <assert.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 
 // =================================================================
@@ -40,7 +43,8 @@
 
 #include <ae_exp_manager.h>
 #include <ae_exp_setup.h>
-#include <ae_codon.h>
+#include <ae_motif_scanner.h>
+#include <ae_profiler.h>
 
 #ifdef __REGUL
   #include <ae_individual_R.h>
@@ -54,13 +58,34 @@
 // =================================================================
 //                       Miscellaneous Functions
 // =================================================================
-int compare_prot_pos( const void* pos, const void* prot ) // This function has to be a plain int
-                                                            // to comply with the definition of bsearch()
+/*!
+  Pack the first <size> chars of <seq> the way ae_string::get_bits does (bit i is set when seq[i] is '1')
+*/
+static constexpr uint64_t motif_bits( const char* seq, int8_t size )
+{
+  return ( size == 0 ) ? 0 : motif_bits( seq, size - 1 ) | ( (uint64_t) ( seq[size - 1] == '1' ) << ( size - 1 ) );
+}
+
+/*!
+  Pack the first <size> chars of <seq> in reverse order (bit size - 1 - i is set when seq[i] is '1')
+*/
+static constexpr uint64_t reversed_motif_bits( const char* seq, int8_t size )
+{
+  return ( size == 0 ) ? 0 : ( reversed_motif_bits( seq + 1, size - 1 ) | ( (uint64_t) ( seq[0] == '1' ) << ( size - 1 ) ) );
+}
+
+static constexpr uint64_t motif_mask( int8_t size )
 {
-  if ( ((ae_protein*)prot)->get_shine_dal_pos() == *(int32_t*)pos ) return 0;
-  else return 1;
+  return ( size == 64 ) ? ~UINT64_C(0) : ( UINT64_C(1) << size ) - 1;
 }
 
+// Consensus sequences as read by get_motif on each strand (on the LAGGING
+// strand, the bases that must be read are the complement of these ones)
+static constexpr uint64_t PROM_BITS               = motif_bits( PROM_SEQ, PROM_SIZE );
+static constexpr uint64_t PROM_BITS_LAGGING       = reversed_motif_bits( PROM_SEQ, PROM_SIZE );
+static constexpr uint64_t SHINE_DAL_BITS          = motif_bits( SHINE_DAL_SEQ, SHINE_DAL_SIZE );
+static constexpr uint64_t SHINE_DAL_BITS_LAGGING  = reversed_motif_bits( SHINE_DAL_SEQ, SHINE_DAL_SIZE );
+
 //##############################################################################
 //                                                                             #
 //                            Class ae_genetic_unit                            #
@@ -98,13 +123,16 @@ ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, int32_t length )
   _dna = new ae_dna( this, length );
   
   // Create empty rna and protein lists
-  _rna_list           = new ae_list<ae_rna*>*[2];
-  _rna_list[LEADING]  = new ae_list<ae_rna*>();
-  _rna_list[LAGGING]  = new ae_list<ae_rna*>();
+  _rna_list           = new ae_promoter_list*[2];
+  _rna_list[LEADING]  = new ae_promoter_list();
+  _rna_list[LAGGING]  = new ae_promoter_list();
 
   _protein_list           = new ae_list<ae_protein*>*[2];
   _protein_list[LEADING]  = new ae_list<ae_protein*>();
   _protein_list[LAGGING]  = new ae_list<ae_protein*>();
+  _protein_map            = new ae_protein_map*[2];
+  _protein_map[LEADING]   = new ae_protein_map();
+  _protein_map[LAGGING]   = new ae_protein_map();
   
   // Create empty fuzzy sets for the phenotypic contributions
   _activ_contribution = new ae_fuzzy_set();
@@ -141,7 +169,7 @@ ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, int32_t length )
     seq will be used directly which means the caller must not delete it
     The same goes for prom_list if it is provided.
 */
-ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, char* seq, int32_t length, ae_list<ae_rna*>** prom_list /*= NULL*/ )
+ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, char* seq, int32_t length, ae_promoter_list** prom_list /*= NULL*/ )
 {
   _exp_m = indiv->get_exp_m();
   _indiv = indiv;
@@ -167,9 +195,9 @@ ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, char* seq, int32_t lengt
   else
   {
     // Create empty rna lists
-    _rna_list           = new ae_list<ae_rna*>*[2];
-    _rna_list[LEADING]  = new ae_list<ae_rna*>();
-    _rna_list[LAGGING]  = new ae_list<ae_rna*>();
+    _rna_list           = new ae_promoter_list*[2];
+    _rna_list[LEADING]  = new ae_promoter_list();
+    _rna_list[LAGGING]  = new ae_promoter_list();
     
     // Look for promoters
     locate_promoters();
@@ -179,6 +207,9 @@ ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, char* seq, int32_t lengt
   _protein_list           = new ae_list<ae_protein*>*[2];
   _protein_list[LEADING]  = new ae_list<ae_protein*>();
   _protein_list[LAGGING]  = new ae_list<ae_protein*>();
+  _protein_map            = new ae_protein_map*[2];
+  _protein_map[LEADING]   = new ae_protein_map();
+  _protein_map[LAGGING]   = new ae_protein_map();
   
   // Create empty fuzzy sets for the phenotypic contributions
   _activ_contribution = new ae_fuzzy_set();
@@ -227,13 +258,16 @@ ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, const ae_genetic_unit &m
   _dna = new ae_dna( this, *(model._dna) );
   
   // Create empty rna and protein lists
-  _rna_list           = new ae_list<ae_rna*>*[2];
-  _rna_list[LEADING]  = new ae_list<ae_rna*>();
-  _rna_list[LAGGING]  = new ae_list<ae_rna*>();
+  _rna_list           = new ae_promoter_list*[2];
+  _rna_list[LEADING]  = new ae_promoter_list();
+  _rna_list[LAGGING]  = new ae_promoter_list();
 
   _protein_list           = new ae_list<ae_protein*>*[2];
   _protein_list[LEADING]  = new ae_list<ae_protein*>();
   _protein_list[LAGGING]  = new ae_list<ae_protein*>();
+  _protein_map            = new ae_protein_map*[2];
+  _protein_map[LEADING]   = new ae_protein_map();
+  _protein_map[LAGGING]   = new ae_protein_map();
   
   // Create empty fuzzy sets for the phenotypic contributions
   _activ_contribution = new ae_fuzzy_set();
@@ -278,26 +312,24 @@ ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, ae_genetic_unit* const p
   
   // Copy promoter list (_rna_list)
   // Note that the length of the RNA will have to be recomputed (do_transcription)
-  _rna_list     = new ae_list<ae_rna*>*[2];
+  _rna_list     = new ae_promoter_list*[2];
   
   for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
   {
-    _rna_list[strand] = new ae_list<ae_rna*>();
+    int32_t nb_rnas = parent->_rna_list[strand]->get_nb_elts();
+    _rna_list[strand] = new ae_promoter_list( nb_rnas );
 
-    ae_list_node<ae_rna*>* rna_node = parent->_rna_list[strand]->get_first();
     ae_rna* rna;
 
-    while ( rna_node != NULL )
+    for ( int32_t i = 0 ; i < nb_rnas ; i++ )
     {
-      rna = rna_node->get_obj();
+      rna = parent->_rna_list[strand]->get_rna( i );
 
       #ifndef __REGUL
         _rna_list[strand]->add( new ae_rna( this, *rna ) );
       #else
         _rna_list[strand]->add( new ae_rna_R( this, *(dynamic_cast<ae_rna_R*>(rna)) ) );
       #endif
-
-      rna_node = rna_node->get_next();
     }
   }
 
@@ -305,6 +337,9 @@ ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, ae_genetic_unit* const p
   _protein_list           = new ae_list<ae_protein*>*[2];
   _protein_list[LEADING]  = new ae_list<ae_protein*>();
   _protein_list[LAGGING]  = new ae_list<ae_protein*>();
+  _protein_map            = new ae_protein_map*[2];
+  _protein_map[LEADING]   = new ae_protein_map();
+  _protein_map[LAGGING]   = new ae_protein_map();
   
   // Create empty fuzzy sets for the phenotypic contributions
   _activ_contribution = new ae_fuzzy_set();
@@ -344,13 +379,16 @@ ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, gzFile backup_file )
   gzread( backup_file, &_min_gu_length, sizeof(_min_gu_length) );
   gzread( backup_file, &_max_gu_length, sizeof(_max_gu_length) );
   
-  _rna_list           = new ae_list<ae_rna*>*[2];
-  _rna_list[LEADING]  = new ae_list<ae_rna*>();
-  _rna_list[LAGGING]  = new ae_list<ae_rna*>();
+  _rna_list           = new ae_promoter_list*[2];
+  _rna_list[LEADING]  = new ae_promoter_list();
+  _rna_list[LAGGING]  = new ae_promoter_list();
 
   _protein_list           = new ae_list<ae_protein*>*[2];
   _protein_list[LEADING]  = new ae_list<ae_protein*>();
   _protein_list[LAGGING]  = new ae_list<ae_protein*>();
+  _protein_map            = new ae_protein_map*[2];
+  _protein_map[LEADING]   = new ae_protein_map();
+  _protein_map[LAGGING]   = new ae_protein_map();
   
   // Create empty fuzzy sets for the phenotypic contributions
   _activ_contribution = new ae_fuzzy_set();
@@ -398,13 +436,16 @@ ae_genetic_unit::ae_genetic_unit( ae_individual* indiv, char* organism_file_name
   _dna = new ae_dna( this, organism_file_name );
   
   // Create empty rna and protein lists
-  _rna_list           = new ae_list<ae_rna*>*[2];
-  _rna_list[LEADING]  = new ae_list<ae_rna*>();
-  _rna_list[LAGGING]  = new ae_list<ae_rna*>();
+  _rna_list           = new ae_promoter_list*[2];
+  _rna_list[LEADING]  = new ae_promoter_list();
+  _rna_list[LAGGING]  = new ae_promoter_list();
 
   _protein_list           = new ae_list<ae_protein*>*[2];
   _protein_list[LEADING]  = new ae_list<ae_protein*>();
   _protein_list[LAGGING]  = new ae_list<ae_protein*>();
+  _protein_map            = new ae_protein_map*[2];
+  _protein_map[LEADING]   = new ae_protein_map();
+  _protein_map[LAGGING]   = new ae_protein_map();
   
   // Create empty fuzzy sets for the phenotypic contributions
   _activ_contribution = new ae_fuzzy_set();
@@ -444,6 +485,9 @@ ae_genetic_unit::~ae_genetic_unit( void )
   delete _protein_list[LEADING];
   delete _protein_list[LAGGING];
   delete [] _protein_list;
+  delete _protein_map[LEADING];
+  delete _protein_map[LAGGING];
+  delete [] _protein_map;
   
   assert( _rna_list           != NULL );
   assert( _rna_list[LEADING]  != NULL );
@@ -477,30 +521,47 @@ void ae_genetic_unit::locate_promoters( void )
 {
   // Look for promoters in the genome and create a new ae_rna
   // in the corresponding strand's RNA list
-  int8_t dist; // Hamming distance of the sequence from the promoter consensus
+  int8_t dist[64]; // Hamming distances of the sequences from the promoter consensus
   
   // Empty RNA list
   _rna_list[LEADING]->erase( true );
   _rna_list[LAGGING]->erase( true );
 
-  if ( _dna->get_length() >= PROM_SIZE )
+  int32_t len = _dna->get_length();
+  PROFILE_COUNT( PROMOTERS_SCANNED, 2 * len );
+  if ( len >= PROM_SIZE )
   {
-    for ( int32_t i = 0 ; i < _dna->get_length() ; i++ )
+    // The scanner handles 64 consecutive positions at once, the RNAs are
+    // added in increasing order of position on the leading strand and in
+    // decreasing order on the lagging strand
+    ae_motif_scanner scanner( _dna );
+    uint64_t found;
+    
+    for ( int32_t first = 0 ; first < len ; first += 64 )
     {
-      if ( is_promoter( LEADING, i, dist ) ) // dist takes the hamming distance of the sequence from the consensus
+      found = scanner.scan_promoters( LEADING, first, dist );
+      for ( ; found != 0 ; found &= found - 1 )
       {
+        int8_t j = __builtin_ctzll( found );
         #ifndef __REGUL
-          _rna_list[LEADING]->add( new ae_rna( this, LEADING, i, dist ) );
+          _rna_list[LEADING]->add( new ae_rna( this, LEADING, first + j, dist[j] ) );
         #else
-          _rna_list[LEADING]->add( new ae_rna_R( this, LEADING, i, dist ) );
+          _rna_list[LEADING]->add( new ae_rna_R( this, LEADING, first + j, dist[j] ) );
         #endif
       }
-      if ( is_promoter( LAGGING, _dna->get_length() - i - 1, dist ) )
+    }
+    
+    for ( int32_t first = ( ( len - 1 ) / 64 ) * 64 ; first >= 0 ; first -= 64 )
+    {
+      found = scanner.scan_promoters( LAGGING, first, dist );
+      while ( found != 0 )
       {
+        int8_t j = 63 - __builtin_clzll( found );
+        found &= ~( UINT64_C(1) << j );
         #ifndef __REGUL
-          _rna_list[LAGGING]->add( new ae_rna( this, LAGGING, _dna->get_length() - i - 1, dist ) );
+          _rna_list[LAGGING]->add( new ae_rna( this, LAGGING, first + j, dist[j] ) );
         #else
-          _rna_list[LAGGING]->add( new ae_rna_R( this, LAGGING, _dna->get_length() - i - 1, dist ) );
+          _rna_list[LAGGING]->add( new ae_rna_R( this, LAGGING, first + j, dist[j] ) );
         #endif
       }
     }
@@ -512,173 +573,113 @@ void ae_genetic_unit::do_transcription( void )
   if ( _transcribed ) return;
   _transcribed = true;
   
-  ae_list_node<ae_rna*>* rna_node    = NULL;
   ae_rna* rna = NULL;
   int32_t transcript_start  = -1;
   int32_t genome_length     = _dna->get_length();
-  
+
   // If the genome is not long enough to bear a promoter and a terminator,
   // we set all its RNAs to a length of -1
   if ( genome_length < PROM_SIZE + TERM_SIZE )
   {
-    rna_node = _rna_list[LEADING]->get_first();
-    while ( rna_node != NULL )
-    { 
-      rna_node->get_obj()->set_transcript_length( -1 );
-      rna_node = rna_node->get_next();
+    for ( int32_t i = 0 ; i < _rna_list[LEADING]->get_nb_elts() ; i++ )
+    {
+      _rna_list[LEADING]->get_rna( i )->set_transcript_length( -1 );
     }
-    
-    rna_node = _rna_list[LAGGING]->get_first();
-    while ( rna_node != NULL )
-    { 
-      rna_node->get_obj()->set_transcript_length( -1 );
-      rna_node = rna_node->get_next();
+
+    for ( int32_t i = 0 ; i < _rna_list[LAGGING]->get_nb_elts() ; i++ )
+    {
+      _rna_list[LAGGING]->get_rna( i )->set_transcript_length( -1 );
     }
-    
+
     return;
   }
 
+  // Index the terminators by their position on the leading strand, in increasing
+  // order. A terminator is its own reverse complement, hence there is a terminator
+  // at pos on the leading strand if and only if there is one at pos + TERM_SIZE - 1
+  // on the lagging strand: the same index serves both strands.
+  int32_t   nb_blocks  = ( genome_length + 63 ) / 64;
+  uint64_t* term_masks = new uint64_t[nb_blocks];
+  int32_t   nb_term    = 0;
+  
+  ae_motif_scanner scanner( _dna );
+  for ( int32_t block = 0 ; block < nb_blocks ; block++ )
+  {
+    term_masks[block] = scanner.scan_terminators( 64 * block );
+    nb_term += __builtin_popcountll( term_masks[block] );
+  }
+  
+  int32_t* term_pos = new int32_t[nb_term];
+  int32_t* term_end = term_pos;
+  for ( int32_t block = 0 ; block < nb_blocks ; block++ )
+  {
+    for ( uint64_t found = term_masks[block] ; found != 0 ; found &= found - 1 )
+    {
+      *term_end++ = 64 * block + __builtin_ctzll( found );
+    }
+  }
+  delete [] term_masks;
+  
+  // When there is no terminator at all, no RNA can actually be produced. We set the
+  // transcript length to -1, which will prevent the search for coding sequences
+  // downstream of the promoters. However, we do not destroy the ae_rna objects, they
+  // must still be kept in memory and transmitted to the offspring in case a mutation
+  // recreates a terminator.
+
   // ----------------
   //  LEADING strand
   // ----------------
-  rna_node = _rna_list[LEADING]->get_first();
-
-  while ( rna_node != NULL )
+  for ( int32_t i = 0 ; i < _rna_list[LEADING]->get_nb_elts() ; i++ )
   {
-    rna = rna_node->get_obj();
-    transcript_start = rna->get_first_transcribed_pos();
-    rna->set_transcript_length( -1 );
+    rna = _rna_list[LEADING]->get_rna( i );
 
-    int32_t i;
-    for ( i = 0 ; i < genome_length ; i++ )
+    if ( nb_term == 0 )
     {
-      if ( is_terminator( LEADING, transcript_start + i ) )
-      {
-        // Found terminator => set transcript's length
-        rna->set_transcript_length( i + TERM_SIZE );
-
-        // Deduce the length of all the RNAs that share the same terminator
-        // These are the RNAs whose promoter is entirely (and strictly) included
-        // between the promoter and the terminator of the RNA we have just treated.
-        // They are hence the RNAs whose promoter starts at most i bases after the
-        // current rna's promoter
-        ae_list_node<ae_rna*>* rna_node_2  = rna_node->get_next();
-        ae_rna* rna_2 = NULL;
-        while ( rna_node_2 != NULL )
-        {
-          rna_2 = rna_node_2->get_obj();
-
-          // We know rna_2 is after rna => rna_2->pos > rna->pos (LEADING strand) because the list is sorted
-          if ( rna_2->get_promoter_pos() - rna->get_promoter_pos() <= i )
-          {
-            rna_2->set_transcript_length( i - (rna_2->get_promoter_pos() - rna->get_promoter_pos()) + TERM_SIZE );
-
-            // Step forward in RNA list
-            rna_node = rna_node_2;
-          }
-          else
-          {
-            // The promoter of rna_2 is after (or contains a part of) the terminator of rna,
-            // we will need to search its own terminator
-            break;
-          }
-
-          rna_node_2 = rna_node_2->get_next();
-        }
-
-        // Terminator found for this RNA, nothing else to do (for this RNA)
-        break;
-      }
+      rna->set_transcript_length( -1 );
+    }
+    else
+    {
+      // The transcript ends with the first terminator found downstream of the promoter
+      transcript_start = rna->get_first_transcribed_pos();
+      int32_t* next_term = std::lower_bound( term_pos, term_end, transcript_start );
+      int32_t term = ( next_term != term_end ) ? *next_term : term_pos[0] + genome_length;
+      
+      rna->set_transcript_length( term - transcript_start + TERM_SIZE );
     }
-
-    if (i == genome_length)
-      {
-        // We have searched the whole genome and found no terminator for this promoter.
-        // We consider that no RNA can actually be produced, hence we set the transcript 
-        // length to -1. This will prevent the search for coding sequences downstream of this promoter.
-        // However, we do not destroy the ae_rna object, it must still be kept in memory and 
-        // transmitted to the offspring in case a mutation recreates a terminator.
-        rna->set_transcript_length( -1 );
-      }
-
-    rna_node = rna_node->get_next();
   }
 
   // ----------------
   //  LAGGING strand
   // ----------------
-  rna_node = _rna_list[LAGGING]->get_first();
-
-  while ( rna_node != NULL )
+  for ( int32_t i = 0 ; i < _rna_list[LAGGING]->get_nb_elts() ; i++ )
   {
-    rna = rna_node->get_obj();
-    transcript_start = rna->get_first_transcribed_pos();
-    rna->set_transcript_length( -1 );
+    rna = _rna_list[LAGGING]->get_rna( i );
 
-    int32_t i;
-    for ( i = 0 ; i < genome_length ; i++ )
+    if ( nb_term == 0 )
     {
-      if ( is_terminator( LAGGING, transcript_start - i ) )
-      {
-        // Found terminator => set transcript's length
-        rna->set_transcript_length( i + TERM_SIZE );
-
-        // Deduce the length of all the RNAs that share the same terminator
-        // These are the RNAs whose promoter is entirely (and strictly) included
-        // between the promoter and the terminator of the RNA we have just treated.
-        // They are hence the RNAs whose promoter starts at most i bases after the
-        // current rna's promoter
-        ae_list_node<ae_rna*>* rna_node_2  = rna_node->get_next();
-        ae_rna* rna_2 = NULL;
-        while ( rna_node_2 != NULL )
-        {
-          rna_2 = rna_node_2->get_obj();
-
-          // We know rna_2 is after rna => rna_2->pos < rna->pos (LAGGING strand) because the list is sorted
-          if ( rna->get_promoter_pos() - rna_2->get_promoter_pos() <= i )
-          {
-            rna_2->set_transcript_length( i - (rna->get_promoter_pos() - rna_2->get_promoter_pos()) + TERM_SIZE );
-
-            // Step forward in RNA list
-            rna_node = rna_node_2;
-          }
-          else
-          {
-            // The promoter of rna_2 is after (or contains a part of) the terminator of rna,
-            // we will need to search its own terminator
-            break;
-          }
-
-          rna_node_2 = rna_node_2->get_next();
-        }
-
-        // Terminator found for this RNA, nothing else to do (for this RNA)
-        break;
-      }
+      rna->set_transcript_length( -1 );
+    }
+    else
+    {
+      // Same as above with terminators indexed by their last base on the lagging strand
+      transcript_start = rna->get_first_transcribed_pos();
+      int32_t last = ae_utils::mod( transcript_start - (TERM_SIZE - 1), genome_length );
+      int32_t* next_term = std::upper_bound( term_pos, term_end, last );
+      int32_t term = ( next_term != term_pos ) ? *(next_term - 1) : term_pos[nb_term - 1] - genome_length;
+      
+      rna->set_transcript_length( last - term + TERM_SIZE );
     }
-
-    if (i == genome_length)
-      {
-        // We have searched the whole genome and found no terminator for this promoter.
-        // We consider that no RNA can actually be produced, hence we set the transcript 
-        // length to -1. This will prevent the search for coding sequences downstream of this promoter.
-        // However, we do not destroy the ae_rna object, it must still be kept in memory and 
-        // transmitted to the offspring in case a mutation recreates a terminator.
-        rna->set_transcript_length( -1 );
-      }
-
-    rna_node = rna_node->get_next();
   }
+  
+  delete [] term_pos;
 
 
   /******************** DEBUG (print rnas' sequences, positions and strands ********************/
   /*for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
   {
-    rna_node = _rna_list[strand]->get_first();
-
-    while ( rna_node != NULL )
+    for ( int32_t i = 0 ; i < _rna_list[strand]->get_nb_elts() ; i++ )
     {
-      rna = rna_node->get_obj();
+      rna = _rna_list[strand]->get_rna( i );
 
       char* seq = new char[PROM_SIZE + rna->get_transcript_length() + 1];
 
@@ -699,8 +700,6 @@ void ae_genetic_unit::do_transcription( void )
       printf( "RNA at pos : %"PRId32"      length : %"PRId32"\n", rna->get_promoter_pos(), rna->get_transcript_length() );
       printf( "  strand : %s    basal_level : %f\n", (rna->get_strand() == LEADING)?"LEADING":"LAGGING", rna->get_basal_level() );
       //~ getchar();
-
-      rna_node = rna_node->get_next();
     }
   }*/
   /******************** END DEBUG ********************/
@@ -712,253 +711,17 @@ void ae_genetic_unit::do_translation( void )
   _translated = true;
   if ( ! _transcribed ) do_transcription();
   
-  ae_list_node<ae_rna*>* rna_node    = NULL;
-  ae_rna* rna = NULL;
-  int32_t transcript_start  = -1;
-  int32_t transcript_length = -1;
-  int32_t genome_length     = _dna->get_length();
-
-  // ----------------
-  //  LEADING strand
-  // ----------------
-  rna_node = _rna_list[LEADING]->get_first();
-
-  while ( rna_node != NULL )
-  {
-    rna = rna_node->get_obj();
-    transcript_start  = rna->get_first_transcribed_pos();
-    transcript_length = rna->get_transcript_length();
-
-    // Try every position where a translation process could occur
-    // Minimum number of bases needed is SHINE_DAL_SIZE + SHINE_START_SPACER + 3 * CODON_SIZE
-    // (3 codons for START + STOP + at least one amino-acid)
-    for ( int32_t i = 0 ; transcript_length - i >= SHINE_DAL_SIZE + SHINE_START_SPACER + 3 * CODON_SIZE ; i++ )
-    {
-      if (  ( is_shine_dalgarno( LEADING, ae_utils::mod(transcript_start + i, genome_length) ) ) &&
-            ( is_start( LEADING, ae_utils::mod(transcript_start + i + SHINE_DAL_SIZE + SHINE_START_SPACER, genome_length) ) ) )
-      {
-        // We found a translation initiation, we can now build the protein until we find a STOP codon or until we reach the end
-        // of the transcript (in which case the protein is not valid)
-
-
-        // First of all, we will check whether this CDS has already been translated (because it is present on another RNA
-        // In that case, we don't need to tranlate it again, we only need to increase the protein's concentration according to
-        // the promoter transcription level
-        int32_t shine_dal_pos = ae_utils::mod(transcript_start + i, genome_length);
-        ae_list_node<ae_protein*>* protein_node = _protein_list[LEADING]->bsearch( &shine_dal_pos, compare_prot_pos );
-
-        if ( protein_node != NULL )
-        {
-          ae_protein* protein = protein_node->get_obj();
-          protein->add_RNA( rna );
-          rna->add_transcribed_protein( protein );
-        }
-        else
-        {
-          // Build codon list and make new protein when stop found
-          int32_t j = i + SHINE_DAL_SIZE + SHINE_START_SPACER + CODON_SIZE; // next codon to examine
-          ae_codon* codon;
-          ae_list<ae_codon*>* codon_list = new ae_list<ae_codon*>();
-          //~ int32_t nb_m, nb_w, nb_h;  // Number of M, W, H-codons found in the gene
-          //~ nb_m = nb_w = nb_h = 0; // TODO : usefull?
-
-          while ( (transcript_length - j >= CODON_SIZE) )
-          {
-            codon = new ae_codon( _dna, LEADING, ae_utils::mod(transcript_start + j, genome_length) );
-
-            if ( codon->is_stop() )
-            {
-              if ( codon_list->is_empty() == false ) // at least one amino-acid
-              {
-                // The protein is valid, create the corresponding object
-                ae_protein* protein;
-                #ifndef __REGUL
-                  protein = new ae_protein( this, codon_list, LEADING, shine_dal_pos, rna );
-                #else
-                  protein = new ae_protein_R( this, codon_list, LEADING, shine_dal_pos, rna );
-                #endif
-                
-                // The codon list will be kept in the protein
-                codon_list = NULL;
-                
-                _protein_list[LEADING]->add( protein );
-                rna->add_transcribed_protein( protein );
-                
-                if ( protein->get_is_functional() )
-                {
-                  _nb_fun_genes++;
-                  //~ _overall_size_fun_genes += ( protein->get_length() + 2 ) * CODON_SIZE;
-                  _overall_size_fun_genes += protein->get_length() * CODON_SIZE;
-                  
-                  if ( protein->get_height() > 0 )  _nb_genes_activ++;
-                  else                              _nb_genes_inhib++;
-                }
-                else
-                {
-                  _nb_non_fun_genes++;
-                  //~ _overall_size_non_fun_genes += ( protein->get_length() + 2 ) * CODON_SIZE;
-                  _overall_size_non_fun_genes += protein->get_length() * CODON_SIZE;
-                }
-              }
-
-              delete codon;
-              break;
-            }
-            else
-            {
-              codon_list->add( codon );
-            }
-
-            j += CODON_SIZE;
-          }
-          
-          // The codon list is no longer useful, delete it with all its items 
-          // TODO : memory leek in RAEVOL?
-//          #ifndef __REGUL
-            if ( codon_list != NULL )
-            {
-              codon_list->erase( true );
-              delete codon_list;
-            }
-//          #endif
-        }
-      }
-    }
-    
-    // Statistics
-    if ( ! rna->get_transcribed_proteins()->is_empty() ) // coding RNA
-    {
-      _nb_coding_RNAs++;
-      _overall_size_coding_RNAs += rna->get_transcript_length();
-    }
-    else // non-coding RNA
-    {
-      _nb_non_coding_RNAs++;
-      _overall_size_non_coding_RNAs += rna->get_transcript_length();
-    }
-
-    rna_node = rna_node->get_next();
-  }
-
-  // ----------------
-  //  LAGGING strand
-  // ----------------
-  rna_node = _rna_list[LAGGING]->get_first();
-
-  while ( rna_node != NULL )
+  for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
   {
-    rna = rna_node->get_obj();
-    transcript_start  = rna->get_first_transcribed_pos();
-    transcript_length = rna->get_transcript_length();
-
-    // Try every position where a translation process could occur
-    // Minimum number of bases needed is SHINE_DAL_SIZE + SHINE_START_SPACER + 3 * CODON_SIZE
-    // (3 codons for START + STOP + at least one amino-acid)
-    for ( int32_t i = 0 ; transcript_length - i >= SHINE_DAL_SIZE + SHINE_START_SPACER + 3 * CODON_SIZE ; i++ )
-    {
-      if (  ( is_shine_dalgarno( LAGGING, ae_utils::mod(transcript_start - i, genome_length) ) ) &&
-            ( is_start( LAGGING, ae_utils::mod(transcript_start - i - SHINE_DAL_SIZE - SHINE_START_SPACER, genome_length) ) ) )
-      {
-        // We found a translation initiation, we can now build the protein until we find a STOP codon or until we reach the end
-        // of the transcript (in which case the protein is not valid)
-
-        // First of all, we will check whether this CDS has already been translated (because it is present on another RNA
-        // In that case, we don't need to tranlate it again, we only need to increase the protein's concentration according to
-        // the promoter strength
-        int32_t shine_dal_pos = ae_utils::mod(transcript_start - i, genome_length);
-        ae_list_node<ae_protein*>* protein_node = _protein_list[LAGGING]->bsearch( &shine_dal_pos, compare_prot_pos );
-
-        if ( protein_node != NULL )
-        {
-          ae_protein* protein = protein_node->get_obj();
-          protein->add_RNA( rna );
-          rna->add_transcribed_protein( protein );
-        }
-        else
-        {
-          // Build codon list and make new protein when stop found
-          int32_t j = i + SHINE_DAL_SIZE + SHINE_START_SPACER + CODON_SIZE; // next codon to examine
-          ae_codon* codon;
-          ae_list<ae_codon*>* codon_list = new ae_list<ae_codon*>();
-          //~ int32_t nb_m, nb_w, nb_h; // Number of M, W, H-codons found in the gene
-          //~ nb_m = nb_w = nb_h = 0;
-
-          while ( (transcript_length - j >= CODON_SIZE) )
-          {
-            codon = new ae_codon( _dna, LAGGING, ae_utils::mod(transcript_start - j, genome_length) );
-
-            if ( codon->is_stop() )
-            {
-              if ( codon_list->is_empty() == false ) // at least one amino-acid
-              {
-                // The protein is valid, create the corresponding object
-                ae_protein* protein;
-                #ifndef __REGUL
-                  protein = new ae_protein( this, codon_list, LAGGING, shine_dal_pos, rna );
-                #else
-                  protein = new ae_protein_R( this, codon_list, LAGGING, shine_dal_pos, rna );
-                #endif
-                
-                // The codon list will be kept in the protein
-                codon_list = NULL;
-                
-                _protein_list[LAGGING]->add( protein );
-                rna->add_transcribed_protein( protein );
-                
-                if ( protein->get_is_functional() )
-                {
-                  _nb_fun_genes++;
-                  //~ _overall_size_fun_genes += ( protein->get_length() + 2 ) * CODON_SIZE;
-                  _overall_size_fun_genes += protein->get_length() * CODON_SIZE;
-                  
-                  if ( protein->get_height() > 0 )  _nb_genes_activ++;
-                  else                              _nb_genes_inhib++;
-                }
-                else
-                {
-                  _nb_non_fun_genes++;
-                  _overall_size_non_fun_genes += ( protein->get_length() + 2 ) * CODON_SIZE;
-                }
-              }
-
-              delete codon;
-              break;
-            }
-            else
-            {
-              codon_list->add( codon );
-            }
-
-            j += CODON_SIZE;
-          }
-          
-          // The codon list is no longer useful, delete it with all its items 
-          // TODO : memory leek in RAEVOL?
-//          #ifndef __REGUL
-            if ( codon_list != NULL )
-            {
-              codon_list->erase( true );
-              delete codon_list;
-            }
-//          #endif
-        }
-      }
-    }
-    
-    // Statistics
-    if ( ! rna->get_transcribed_proteins()->is_empty() ) // coding RNA
-    {
-      _nb_coding_RNAs++;
-      _overall_size_coding_RNAs += rna->get_transcript_length();
-    }
-    else // non-coding RNA
+    for ( int32_t rna_ind = 0 ; rna_ind < _rna_list[strand]->get_nb_elts() ; rna_ind++ )
     {
-      _nb_non_coding_RNAs++;
-      _overall_size_non_coding_RNAs += rna->get_transcript_length();
+      ae_rna* rna = _rna_list[strand]->get_rna( rna_ind );
+      translate_rna( rna );
+      count_rna( rna );
     }
-
-    rna_node = rna_node->get_next();
   }
+  
+  PROFILE_COUNT( PROTEINS_BUILT, _protein_list[LEADING]->get_nb_elts() + _protein_list[LAGGING]->get_nb_elts() );
 }
 
 void ae_genetic_unit::compute_phenotypic_contribution( void )
@@ -969,6 +732,14 @@ void ae_genetic_unit::compute_phenotypic_contribution( void )
   
   ae_list_node<ae_protein*>* prot_node;
   ae_protein*   prot;
+  
+  // The triangles (mean, width, height) of the activating and inhibiting proteins
+  // are collected first and then added in one go to their respective fuzzy set
+  int32_t nb_prot = _protein_list[LEADING]->get_nb_elts() + _protein_list[LAGGING]->get_nb_elts();
+  double* activ_triangles = new double[3 * nb_prot];
+  double* inhib_triangles = new double[3 * nb_prot];
+  int32_t nb_activ = 0;
+  int32_t nb_inhib = 0;
 
   // LEADING strand
   prot_node = _protein_list[LEADING]->get_first();
@@ -1013,15 +784,17 @@ void ae_genetic_unit::compute_phenotypic_contribution( void )
       
       if ( prot->get_height() > 0 )
       {
-        _activ_contribution->add_triangle(  prot->get_mean(),
-                                            prot->get_width(),
-                                            prot->get_height() * prot->get_concentration() );
+        activ_triangles[3 * nb_activ]     = prot->get_mean();
+        activ_triangles[3 * nb_activ + 1] = prot->get_width();
+        activ_triangles[3 * nb_activ + 2] = prot->get_height() * prot->get_concentration();
+        nb_activ++;
       }
       else
       {
-        _inhib_contribution->add_triangle(  prot->get_mean(),
-                                            prot->get_width(),
-                                            prot->get_height() * prot->get_concentration() );
+        inhib_triangles[3 * nb_inhib]     = prot->get_mean();
+        inhib_triangles[3 * nb_inhib + 1] = prot->get_width();
+        inhib_triangles[3 * nb_inhib + 2] = prot->get_height() * prot->get_concentration();
+        nb_inhib++;
       }
     }
 
@@ -1071,20 +844,27 @@ void ae_genetic_unit::compute_phenotypic_contribution( void )
 
       if ( prot->get_height() > 0 )
       {
-        _activ_contribution->add_triangle(  prot->get_mean(),
-                                            prot->get_width(),
-                                            prot->get_height() * prot->get_concentration() );
+        activ_triangles[3 * nb_activ]     = prot->get_mean();
+        activ_triangles[3 * nb_activ + 1] = prot->get_width();
+        activ_triangles[3 * nb_activ + 2] = prot->get_height() * prot->get_concentration();
+        nb_activ++;
       }
       else
       {
-        _inhib_contribution->add_triangle(  prot->get_mean(),
-                                            prot->get_width(),
-                                            prot->get_height() * prot->get_concentration() );
+        inhib_triangles[3 * nb_inhib]     = prot->get_mean();
+        inhib_triangles[3 * nb_inhib + 1] = prot->get_width();
+        inhib_triangles[3 * nb_inhib + 2] = prot->get_height() * prot->get_concentration();
+        nb_inhib++;
       }
     }
 
     prot_node = prot_node->get_next();
   }
+  
+  _activ_contribution->add_triangles( nb_activ, activ_triangles );
+  _inhib_contribution->add_triangles( nb_inhib, inhib_triangles );
+  delete [] activ_triangles;
+  delete [] inhib_triangles;
 
 
   // It is not necessary to add a lower bound to _activ_contribution as there can be no negative y
@@ -1103,6 +883,126 @@ void ae_genetic_unit::compute_phenotypic_contribution( void )
   }
 }
 
+/*!
+  \brief Copy the transcription, translation and phenotypic contribution of <parent>.
+
+  This GU must have been copied from <parent>. If its DNA has not been modified since,
+  its RNA list is identical to <parent>'s. The proteins are copied rather than recomputed,
+  together with the links between RNAs and proteins.
+  
+  If its DNA has only undergone switches, the RNAs and proteins that contain none of the
+  switched positions are copied as well and only the other ones are recomputed (see
+  inherit_unswitched_expression). The phenotypic contribution is then left to be computed.
+  
+  Nothing is done if <parent>'s phenotypic contribution has not been computed or if the
+  DNA has undergone any other kind of mutation.
+*/
+void ae_genetic_unit::inherit_expression( const ae_genetic_unit* parent )
+{
+  if ( _transcribed || ! parent->_phenotypic_contributions_computed ) return;
+  
+  if ( _dna->is_modified() )
+  {
+    if ( _dna->is_switched_only() && _dna->get_length() >= PROM_SIZE + TERM_SIZE )
+    {
+      inherit_unswitched_expression( parent );
+    }
+    return;
+  }
+  
+  _transcribed                        = true;
+  _translated                         = true;
+  _phenotypic_contributions_computed  = true;
+  
+  // The RNAs of the parent and of the child correspond one-to-one by index,
+  // the proteins by their rank in the lists. The copy of a parent protein is
+  // looked up in a (reused) vector sorted by parent protein
+  typedef std::pair<const ae_protein*, ae_protein*> protein_copy_t;
+  static thread_local std::vector<protein_copy_t> protein_copy;
+  
+  for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
+  {
+    // Copy the transcript lengths
+    ae_promoter_list* rnas        = _rna_list[strand];
+    ae_promoter_list* parent_rnas = parent->_rna_list[strand];
+    
+    for ( int32_t i = 0 ; i < rnas->get_nb_elts() ; i++ )
+    {
+      assert( rnas->get_promoter_pos( i ) == parent_rnas->get_promoter_pos( i ) );
+      rnas->get_rna( i )->set_transcript_length( parent_rnas->get_rna( i )->get_transcript_length() );
+    }
+    
+    // Copy the proteins and the RNAs they are transcribed from
+    protein_copy.clear();
+    ae_list_node<ae_protein*>* prot_node = parent->_protein_list[strand]->get_first();
+    while ( prot_node != NULL )
+    {
+      ae_protein* prot = new ae_protein( this, *(prot_node->get_obj()) );
+      
+      ae_list_node<ae_rna*>* prot_rna_node = prot_node->get_obj()->get_rna_list()->get_first();
+      while ( prot_rna_node != NULL )
+      {
+        // Index of the RNA in the lists (sorted by promoter position, decreasing on the LAGGING strand)
+        int32_t pos = prot_rna_node->get_obj()->get_promoter_pos();
+        int32_t i   = ( strand == LEADING ) ? parent_rnas->get_boundary( LEADING, pos ) :
+                                              parent_rnas->get_boundary( LAGGING, pos + 1 );
+        assert( parent_rnas->get_rna( i ) == prot_rna_node->get_obj() );
+        
+        prot->get_rna_list()->add( rnas->get_rna( i ) );
+        prot_rna_node = prot_rna_node->get_next();
+      }
+      
+      _protein_list[strand]->add( prot );
+      _protein_map[strand]->add( prot );
+      protein_copy.push_back( protein_copy_t( prot_node->get_obj(), prot ) );
+      
+      prot_node = prot_node->get_next();
+    }
+    std::sort( protein_copy.begin(), protein_copy.end() );
+    
+    // Copy the proteins transcribed from each RNA
+    for ( int32_t i = 0 ; i < rnas->get_nb_elts() ; i++ )
+    {
+      prot_node = parent_rnas->get_rna( i )->get_transcribed_proteins()->get_first();
+      while ( prot_node != NULL )
+      {
+        std::vector<protein_copy_t>::iterator copy =
+            std::lower_bound( protein_copy.begin(), protein_copy.end(), protein_copy_t( prot_node->get_obj(), NULL ) );
+        assert( copy != protein_copy.end() && copy->first == prot_node->get_obj() );
+        
+        rnas->get_rna( i )->add_transcribed_protein( copy->second );
+        prot_node = prot_node->get_next();
+      }
+    }
+  }
+  
+  // Statistics gathered during translation
+  _nb_coding_RNAs               = parent->_nb_coding_RNAs;
+  _nb_non_coding_RNAs           = parent->_nb_non_coding_RNAs;
+  _overall_size_coding_RNAs     = parent->_overall_size_coding_RNAs;
+  _overall_size_non_coding_RNAs = parent->_overall_size_non_coding_RNAs;
+  _nb_genes_activ               = parent->_nb_genes_activ;
+  _nb_genes_inhib               = parent->_nb_genes_inhib;
+  _nb_fun_genes                 = parent->_nb_fun_genes;
+  _nb_non_fun_genes             = parent->_nb_non_fun_genes;
+  _overall_size_fun_genes       = parent->_overall_size_fun_genes;
+  _overall_size_non_fun_genes   = parent->_overall_size_non_fun_genes;
+  
+  // Phenotypic contributions
+  delete _activ_contribution;
+  delete _inhib_contribution;
+  _activ_contribution = new ae_fuzzy_set( *(parent->_activ_contribution) );
+  _inhib_contribution = new ae_fuzzy_set( *(parent->_inhib_contribution) );
+  
+  if ( _exp_m->get_output_m()->get_compute_phen_contrib_by_GU() )
+  {
+    _phenotypic_contribution = new ae_phenotype();
+    _phenotypic_contribution->add( _activ_contribution );
+    _phenotypic_contribution->add( _inhib_contribution );
+    _phenotypic_contribution->simplify();
+  }
+}
+
 /*!
   \brief Compute the areas between the phenotype and the environment for each environmental segment.
 
@@ -1115,27 +1015,20 @@ void ae_genetic_unit::compute_distance_to_target( ae_environment* env )
   
   compute_phenotypic_contribution();
   
-  // Compute the difference between the (whole) phenotype and the environment
-  ae_fuzzy_set* delta = new ae_fuzzy_set( *_phenotypic_contribution );
-  delta->sub( env );
-  
   ae_env_segment** segments = env->get_segments();
   
-  // TODO : We should take into account that we compute the areas in order (from the leftmost segment, rightwards)
-  //   => We shouldn't parse the whole list of points on the left of the segment we are considering (we have 
-  //      already been through them!)
-  
   if ( _dist_to_target_per_segment == NULL )
   {
     _dist_to_target_per_segment = new double [env->get_nb_segments()]; // Can not be allocated in constructor because number of segments is then unknow
   }
+  
+  // Compute the areas between the phenotype and the environment on all the segments in a single pass
+  _phenotypic_contribution->get_distance_by_segment( env, env->get_nb_segments(), segments, _dist_to_target_per_segment );
+  
   for ( int16_t i = 0 ; i < env->get_nb_segments() ; i++ )
   {
-    _dist_to_target_per_segment[i] = delta->get_geometric_area( segments[i]->start, segments[i]->stop );
     _dist_to_target_by_feature[segments[i]->feature] += _dist_to_target_per_segment[i];
   }
-  
-  delete delta;
 }
     
 /*!
@@ -1245,6 +1138,8 @@ void ae_genetic_unit::reset_expression( void )
 
   _protein_list[LEADING]->erase(true);
   _protein_list[LAGGING]->erase(true);
+  _protein_map[LEADING]->erase();
+  _protein_map[LAGGING]->erase();
 
   if ( _activ_contribution != NULL )
   {
@@ -1269,24 +1164,20 @@ void ae_genetic_unit::reset_expression( void )
 
 
 
-void ae_genetic_unit::print_rnas( ae_list<ae_rna*>* rnas, ae_strand strand )
+void ae_genetic_unit::print_rnas( ae_promoter_list* rnas, ae_strand strand )
 {
-  ae_list_node<ae_rna*>* rna_node = NULL;
   ae_rna* rna = NULL;
 
   printf( "  %s ( %"PRId32" )\n", strand == LEADING ? "LEADING" : "LAGGING", rnas->get_nb_elts() );
-  rna_node = rnas->get_first();
   
-  while ( rna_node != NULL )
+  for ( int32_t i = 0 ; i < rnas->get_nb_elts() ; i++ )
   {
-    rna = rna_node->get_obj();
+    rna = rnas->get_rna( i );
     
     assert( rna->get_strand() == strand );
 
     printf( "    Promoter on %s at %"PRId32"\n", strand == LEADING ? "LEADING" : "LAGGING", rna->get_promoter_pos() );
     //~ printf( "      length %"PRId32"  basal_level %f\n", rna->get_transcript_length(), rna->get_basal_level() );
-
-    rna_node = rna_node->get_next();
   }
 }
 
@@ -1329,72 +1220,34 @@ void ae_genetic_unit::print_proteins( void ) const
 
 bool ae_genetic_unit::is_promoter( ae_strand strand, int32_t pos, int8_t& dist ) const
 {
-  //~ printf( "=============================================== is_promoter\n" );
-  //~ printf( "pos : %"PRId32"\n", pos );
+  PROFILE_COUNT( PROMOTERS_SCANNED, 1 );
   
-  const char* genome  = _dna->get_data();
-  int32_t  len        = _dna->get_length();
-
-  dist = 0;
+  uint64_t motif = get_motif( strand, pos, PROM_SIZE );
+  uint64_t mismatches;
 
   if ( strand == LEADING )
   {
-    //~ printf( "LEADING\n" );
-    for ( int16_t i = 0 ; i < PROM_SIZE ; i++ )
-    {
-      //~ printf( "  i : %"PRId32" dist : %"PRId8"\n", i, dist );
-      if ( genome[(pos+i)%len] != PROM_SEQ[i] )
-      {
-        dist++;
-        if ( dist > PROM_MAX_DIFF )
-        {  
-          //~ printf( "=============================================== END is_promoter\n" );
-          return false;
-        }
-      }
-    }
+    mismatches = motif ^ PROM_BITS;
   }
   else // ( strand == LAGGING )
   {
-    //~ printf( "LAGGING\n" );
-    for ( int16_t i = 0 ; i < PROM_SIZE ; i++ )
-    {
-      //~ printf( "  i : %"PRId32" dist : %"PRId8"\n", i, dist );
-      if ( genome[ae_utils::mod((pos-i),len)] == PROM_SEQ[i] ) // == and not != because we are on the complementary strand...
-      {
-        dist++;
-        if ( dist > PROM_MAX_DIFF )
-        {
-          //~ printf( "=============================================== END is_promoter\n" );
-          return false;
-        }
-      }
-    }
+    // A base matches when it is the complement of the consensus...
+    mismatches = ~( motif ^ PROM_BITS_LAGGING ) & motif_mask( PROM_SIZE );
   }
 
-  
-  //~ printf( "=============================================== END is_promoter\n" );
-  return true;
+  dist = __builtin_popcountll( mismatches );
+
+  return ( dist <= PROM_MAX_DIFF );
 }
 
 bool ae_genetic_unit::is_terminator( ae_strand strand, int32_t pos ) const
 {
-  const char* genome  = _dna->get_data();
-  int32_t  len        = _dna->get_length();
+  // Whatever the strand, base i of the window must differ from base TERM_SIZE - 1 - i
+  uint64_t motif = get_motif( strand, pos, TERM_SIZE );
 
-  if ( strand == LEADING )
-  {
-    for ( int16_t i = 0 ; i < TERM_STEM_SIZE ; i++ )
-    {
-      if ( genome[ae_utils::mod(pos+i,len)] == genome[ae_utils::mod(pos+(TERM_SIZE-1)-i,len)] ) return false;
-    }
-  }
-  else // ( strand == LAGGING )
+  for ( int16_t i = 0 ; i < TERM_STEM_SIZE ; i++ )
   {
-    for ( int16_t i = 0 ; i < TERM_STEM_SIZE ; i++ )
-    {
-      if ( genome[ae_utils::mod(pos-i,len)] == genome[ae_utils::mod(pos-(TERM_SIZE-1)+i,len)] ) return false;
-    }
+    if ( ( ( motif >> i ) & 1 ) == ( ( motif >> ( (TERM_SIZE-1) - i ) ) & 1 ) ) return false;
   }
 
   return true;
@@ -1402,67 +1255,23 @@ bool ae_genetic_unit::is_terminator( ae_strand strand, int32_t pos ) const
 
 bool ae_genetic_unit::is_shine_dalgarno( ae_strand strand, int32_t pos ) const
 {
-  const char* genome  = _dna->get_data();
-  int32_t  len        = _dna->get_length();
+  uint64_t motif = get_motif( strand, pos, SHINE_DAL_SIZE );
 
   if ( strand == LEADING )
   {
-    for ( int8_t i = 0 ; i < SHINE_DAL_SIZE ; i++ )
-    {
-      if ( genome[ae_utils::mod((pos+i),len)] != SHINE_DAL_SEQ[i] )
-      {
-        return false;
-      }
-    }
+    return ( motif == SHINE_DAL_BITS );
   }
   else // ( strand == LAGGING )
   {
-    for ( int8_t i = 0 ; i < SHINE_DAL_SIZE ; i++ )
-    {
-      if ( genome[ae_utils::mod((pos-i),len)] == SHINE_DAL_SEQ[i] ) // == and not != because we are on the complementary strand...
-      {
-        return false;
-      }
-    }
+    // Every base must be the complement of the consensus...
+    return ( motif == ( ~SHINE_DAL_BITS_LAGGING & motif_mask( SHINE_DAL_SIZE ) ) );
   }
-
-  return true;
 }
 
-int8_t ae_genetic_unit::get_codon( ae_strand strand, int32_t pos ) const
-{
-  const char* genome  = _dna->get_data();
-  int32_t  len        = _dna->get_length();
-  int8_t codon        = 0;
-
-  if ( strand == LEADING )
-  {
-    for ( int8_t i = 0 ; i < CODON_SIZE ; i++ )
-    {
-      if ( genome[ae_utils::mod((pos+i),len)] == '1' )
-      {
-        codon += 1 << ( CODON_SIZE - i - 1 ); //pow( 2, CODON_SIZE - i - 1 );
-      }
-    }
-  }
-  else // ( strand == LAGGING )
-  {
-    for ( int8_t i = 0 ; i < CODON_SIZE ; i++ )
-    {
-      if ( genome[ae_utils::mod((pos-i),len)] != '1' ) // == and not != because we are on the complementary strand...
-      {
-        codon += 1 << ( CODON_SIZE - i - 1 ); //pow( 2, CODON_SIZE - i - 1 );
-      }
-    }
-  }
-
-  return codon;
-}
-
-void ae_genetic_unit::compute_non_coding( void )
-{ 
-  if ( _non_coding_computed ) return;
-  _non_coding_computed = true;
+void ae_genetic_unit::compute_non_coding( void )
+{ 
+  if ( _non_coding_computed ) return;
+  _non_coding_computed = true;
 
   // Create a table of <genome_length> bools initialized to false (non-coding)
   int32_t genome_length = _dna->get_length();
@@ -1718,12 +1527,11 @@ void ae_genetic_unit::compute_non_coding( void )
   // Parse RNA lists and mark the corresponding bases as coding (only for the coding RNAs)
   for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
   {
-    ae_list_node<ae_rna*>* rna_node  = _rna_list[strand]->get_first();
     ae_rna* rna = NULL;
 
-    while ( rna_node != NULL )
+    for ( int32_t rna_ind = 0 ; rna_ind < _rna_list[strand]->get_nb_elts() ; rna_ind++ )
     {
-      rna = rna_node->get_obj();
+      rna = _rna_list[strand]->get_rna( rna_ind );
       
       int32_t first;
       int32_t last;
@@ -1803,8 +1611,6 @@ void ae_genetic_unit::compute_non_coding( void )
           }
         }
       }
-      
-      rna_node = rna_node->get_next();
     }
   }
   
@@ -1955,60 +1761,35 @@ void ae_genetic_unit::compute_non_coding( void )
   delete [] is_not_neutral;
 }
 
-void ae_genetic_unit::duplicate_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** duplicated_promoters )
+void ae_genetic_unit::duplicate_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_promoter_list** duplicated_promoters )
 {
   // 1) Get promoters to be duplicated
   get_promoters_included_in( pos_1, pos_2, duplicated_promoters );
   
   // 2) Set RNAs' position as their position on the duplicated segment
-  ae_list_node<ae_rna*>* rna_node  = NULL;
-  
-  // -- LEADING --
-  rna_node = duplicated_promoters[LEADING]->get_first();
-  while ( rna_node != NULL )
+  for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
   {
-    
+    for ( int32_t i = 0 ; i < duplicated_promoters[strand]->get_nb_elts() ; i++ )
+    {
 #ifndef __REGUL
-    // Make a copy of current RNA
-    ae_rna* copy = new ae_rna( this, *(rna_node->get_obj()) );
+      // Make a copy of current RNA
+      ae_rna* copy = new ae_rna( this, *(duplicated_promoters[strand]->get_rna( i )) );
 #else
-    // Make a copy of current RNA
-    ae_rna_R* copy = new ae_rna_R( this, *(rna_node->get_obj()) );
-#endif    
-    
-    // Set RNA's position as it's position on the duplicated segment
-    copy->shift_position( -pos_1, _dna->get_length() );
-    
-    // Replace current object by the copy
-    // Do not delete the replaced object as it is still a valid promoter in the individual's promoter list
-    rna_node->set_obj( copy );
-    
-    rna_node = rna_node->get_next();
-  }
-  
-  // -- LAGGING --
-  rna_node = duplicated_promoters[LAGGING]->get_first();
-  while ( rna_node != NULL )
-  {
-    
-#ifndef __REGUL    
-    // Make a copy of current RNA
-    ae_rna* copy = new ae_rna( this, *(rna_node->get_obj()) );
-#else
-    // Make a copy of current RNA
-    ae_rna_R* copy = new ae_rna_R( this, *(rna_node->get_obj()) );
-#endif    
-    // Set RNA's position as it's position on the duplicated segment
-    copy->shift_position( -pos_1, _dna->get_length() );
-    
-    // Replace current object by the copy (don't delete the replaced object as it is still a valid promoter)
-    rna_node->set_obj( copy );
-    
-    rna_node = rna_node->get_next();
+      // Make a copy of current RNA
+      ae_rna_R* copy = new ae_rna_R( this, *(duplicated_promoters[strand]->get_rna( i )) );
+#endif
+      
+      // Set RNA's position as it's position on the duplicated segment
+      copy->shift_position( -pos_1, _dna->get_length() );
+      
+      // Replace current object by the copy
+      // Do not delete the replaced object as it is still a valid promoter in the individual's promoter list
+      duplicated_promoters[strand]->set_rna( i, copy );
+    }
   }
 }
 
-void ae_genetic_unit::get_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** promoters )
+void ae_genetic_unit::get_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_promoter_list** promoters )
 {
   assert( pos_1 >= 0 && pos_1 <= _dna->get_length() && pos_2 >= 0 && pos_2 <= _dna->get_length() );
   
@@ -2063,113 +1844,79 @@ void ae_genetic_unit::get_promoters_included_in( int32_t pos_1, int32_t pos_2, a
   }
 }
 
-void ae_genetic_unit::get_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* leading_promoters )
+void ae_genetic_unit::get_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* leading_promoters )
 {
   assert( pos_1 >= 0 && pos_1 < pos_2 && pos_2 <= _dna->get_length() );
   
-  // Go to first RNA after pos_1
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_1 )
-  {
-    rna_node  = rna_node->get_next();
-  }
+  // Add the RNAs from the first one after pos_1 to the last one before pos_2
+  int32_t first = _rna_list[LEADING]->get_boundary( LEADING, pos_1 );
+  int32_t last  = _rna_list[LEADING]->get_boundary( LEADING, pos_2 );
   
-  // Add RNAs to new_list until we pass pos_2 (or we reach the end of the list)
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_2 )
+  for ( int32_t i = first ; i < last ; i++ )
   {
-    leading_promoters->add( rna_node->get_obj() );
-    
-    rna_node = rna_node->get_next();
+    leading_promoters->add( _rna_list[LEADING]->get_rna( i ) );
   }
 }
 
-void ae_genetic_unit::get_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* lagging_promoters )
+void ae_genetic_unit::get_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* lagging_promoters )
 {
   assert( pos_1 >= 0 && pos_1 < pos_2 && pos_2 <= _dna->get_length() );
   
-  // Go to first RNA before pos_2
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_first();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos_2 )
-  {
-    rna_node = rna_node->get_next();
-  }
+  // Add the RNAs from the first one before pos_2 to the last one after pos_1
+  int32_t first = _rna_list[LAGGING]->get_boundary( LAGGING, pos_2 );
+  int32_t last  = _rna_list[LAGGING]->get_boundary( LAGGING, pos_1 );
   
-  // Add RNAs to new_list until we pass pos_1 (or we reach the end of the list)
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos_1 )
+  for ( int32_t i = first ; i < last ; i++ )
   {
-    lagging_promoters->add( rna_node->get_obj() );
-    
-    rna_node = rna_node->get_next();
+    lagging_promoters->add( _rna_list[LAGGING]->get_rna( i ) );
   }
 }
 
-void ae_genetic_unit::get_leading_promoters_starting_after( int32_t pos, ae_list<ae_rna*>* leading_promoters )
+void ae_genetic_unit::get_leading_promoters_starting_after( int32_t pos, ae_promoter_list* leading_promoters )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  // Go to first RNA after pos
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos )
+  // Add the RNAs from the first one after pos to the end of the list
+  for ( int32_t i = _rna_list[LEADING]->get_boundary( LEADING, pos ) ; i < _rna_list[LEADING]->get_nb_elts() ; i++ )
   {
-    rna_node  = rna_node->get_next();
-  }
-  
-  // Add RNAs to new_list until we reach the end of the list
-  while ( rna_node != NULL )
-  {
-    leading_promoters->add( rna_node->get_obj() );
-    
-    rna_node = rna_node->get_next();
+    leading_promoters->add( _rna_list[LEADING]->get_rna( i ) );
   }
 }
 
-void ae_genetic_unit::get_leading_promoters_starting_before( int32_t pos, ae_list<ae_rna*>* leading_promoters )
+void ae_genetic_unit::get_leading_promoters_starting_before( int32_t pos, ae_promoter_list* leading_promoters )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
+  // Add the RNAs from the beginning of the list to the last one before pos
+  int32_t last = _rna_list[LEADING]->get_boundary( LEADING, pos );
   
-  // Add RNAs to new_list until we pass pos (or we reach the end of the list)
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos )
+  for ( int32_t i = 0 ; i < last ; i++ )
   {
-    leading_promoters->add( rna_node->get_obj() );
-    
-    rna_node = rna_node->get_next();
+    leading_promoters->add( _rna_list[LEADING]->get_rna( i ) );
   }
 }
 
-void ae_genetic_unit::get_lagging_promoters_starting_before( int32_t pos, ae_list<ae_rna*>* lagging_promoters )
+void ae_genetic_unit::get_lagging_promoters_starting_before( int32_t pos, ae_promoter_list* lagging_promoters )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  // Go to first RNA before pos
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_first();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos )
-  {
-    rna_node  = rna_node->get_next();
-  }
-  
-  // Add RNAs to new_list until we reach the end of the list
-  while ( rna_node != NULL )
+  // Add the RNAs from the first one before pos to the end of the list
+  for ( int32_t i = _rna_list[LAGGING]->get_boundary( LAGGING, pos ) ; i < _rna_list[LAGGING]->get_nb_elts() ; i++ )
   {
-    lagging_promoters->add( rna_node->get_obj() );
-    
-    rna_node = rna_node->get_next();
+    lagging_promoters->add( _rna_list[LAGGING]->get_rna( i ) );
   }
 }
 
-void ae_genetic_unit::get_lagging_promoters_starting_after( int32_t pos, ae_list<ae_rna*>* lagging_promoters )
+void ae_genetic_unit::get_lagging_promoters_starting_after( int32_t pos, ae_promoter_list* lagging_promoters )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_first();
+  // Add the RNAs from the beginning of the list to the last one after pos
+  int32_t last = _rna_list[LAGGING]->get_boundary( LAGGING, pos );
   
-  // Add RNAs to new_list until we pass pos (or we reach the end of the list)
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos )
+  for ( int32_t i = 0 ; i < last ; i++ )
   {
-    lagging_promoters->add( rna_node->get_obj() );
-    
-    rna_node = rna_node->get_next();
+    lagging_promoters->add( _rna_list[LAGGING]->get_rna( i ) );
   }
 }
 
@@ -2181,9 +1928,9 @@ void ae_genetic_unit::invert_promoters_included_in( int32_t pos_1, int32_t pos_2
   
   if ( segment_length >= PROM_SIZE )
   {
-    ae_list<ae_rna*>** inverted_promoters = new ae_list<ae_rna*>*[2];
-    inverted_promoters[LEADING] = new ae_list<ae_rna*>();
-    inverted_promoters[LAGGING] = new ae_list<ae_rna*>();
+    ae_promoter_list** inverted_promoters = new ae_promoter_list*[2];
+    inverted_promoters[LEADING] = new ae_promoter_list();
+    inverted_promoters[LAGGING] = new ae_promoter_list();
     
     //~ print_rnas();
     
@@ -2207,7 +1954,7 @@ void ae_genetic_unit::invert_promoters_included_in( int32_t pos_1, int32_t pos_2
 /*!
   \brief Invert all the promoters of promoter_lists for a sequence of length seq_length.
 */
-/*static*/ void ae_genetic_unit::invert_promoters( ae_list<ae_rna*>** promoter_lists, int32_t seq_length )
+/*static*/ void ae_genetic_unit::invert_promoters( ae_promoter_list** promoter_lists, int32_t seq_length )
 {
   ae_genetic_unit::invert_promoters( promoter_lists, 0, seq_length );
 }
@@ -2217,255 +1964,98 @@ void ae_genetic_unit::invert_promoters_included_in( int32_t pos_1, int32_t pos_2
 
   WARNING : This function is pretty specific, make sure you understand its precise behaviour before using it.
 */
-/*static*/ void ae_genetic_unit::invert_promoters( ae_list<ae_rna*>** promoter_lists, int32_t pos_1, int32_t pos_2 )
+/*static*/ void ae_genetic_unit::invert_promoters( ae_promoter_list** promoter_lists, int32_t pos_1, int32_t pos_2 )
 {
   assert( pos_1 >= 0 && pos_1 <= pos_2 ); // Could check (pos_2 < length) but another parameter would be necessary
   
   // Exchange LEADING and LAGGING lists
-  ae_list<ae_rna*>* tmp   = promoter_lists[LEADING];
+  ae_promoter_list* tmp   = promoter_lists[LEADING];
   promoter_lists[LEADING] = promoter_lists[LAGGING];
   promoter_lists[LAGGING] = tmp;
-    
-  // Update the position and strand of each promoter to be inverted...
-  ae_list_node<ae_rna*>* rna_node  = NULL;
-  ae_rna* rna             = NULL;
+  
+  // Update the position and strand of each promoter to be inverted
+  // (the order of each list is preserved since the positions are mirrored)
+  ae_rna* rna = NULL;
   
   // ...on the former LAGGING strand (becoming the LEADING strand)
-  rna_node = promoter_lists[LEADING]->get_first();
-  int i = 0;
-  while ( rna_node != NULL )
+  for ( int32_t i = 0 ; i < promoter_lists[LEADING]->get_nb_elts() ; i++ )
   {
-    i++;
-    rna = rna_node->get_obj();
+    rna = promoter_lists[LEADING]->get_rna( i );
     assert( rna->get_strand() == LAGGING );
     assert( rna->get_promoter_pos() >= pos_1 && rna->get_promoter_pos() < pos_2 );
-    rna->set_promoter_pos( pos_1 + pos_2 - rna->get_promoter_pos() - 1 );
+    promoter_lists[LEADING]->set_promoter_pos( i, pos_1 + pos_2 - rna->get_promoter_pos() - 1 );
     rna->set_strand( LEADING );
-    
-    rna_node = rna_node->get_next();
   }
   
-  
   // ... and on the former LEADING strand (becoming the LAGGING strand)
-  rna_node = promoter_lists[LAGGING]->get_first();
-  i = 0;
-  while ( rna_node != NULL )
+  for ( int32_t i = 0 ; i < promoter_lists[LAGGING]->get_nb_elts() ; i++ )
   {
-    i++;
-    rna = rna_node->get_obj();
+    rna = promoter_lists[LAGGING]->get_rna( i );
     assert( rna->get_strand() == LEADING );
     assert( rna->get_promoter_pos() >= pos_1 && rna->get_promoter_pos() < pos_2 );
-    rna->set_promoter_pos( pos_1 + pos_2 - rna->get_promoter_pos() - 1);
+    promoter_lists[LAGGING]->set_promoter_pos( i, pos_1 + pos_2 - rna->get_promoter_pos() - 1 );
     rna->set_strand( LAGGING );
-    
-    rna_node = rna_node->get_next();
   }
 }
 
-void ae_genetic_unit::extract_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* extracted_promoters )
+void ae_genetic_unit::extract_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* extracted_promoters )
 {
   assert( pos_1 >= 0 && pos_1 < pos_2 && pos_2 <= _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node = NULL;
-  
-  // Find the first promoters in the interval
-  ae_list_node<ae_rna*>* node_first = NULL;
-  rna_node = _rna_list[LEADING]->get_first();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_1 )
-  {
-    rna_node  = rna_node->get_next();
-  }
-  if ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_2 )
-  {
-    node_first = rna_node;
-  }
-  
-  if ( node_first != NULL )
-  {
-    // Find the last promoters in the interval
-    ae_list_node<ae_rna*>* node_last = node_first;
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_2 )
-    {
-      node_last = rna_node;
-      rna_node  = rna_node->get_next();
-    }
-  
-    // Extract the promoters (remove them from the individual's list and put them in extracted_promoters)
-    //~ print_rnas();
-    ae_list<ae_rna*>* tmp_list = _rna_list[LEADING]->extract_sublist( node_first, node_last );
-    //~ printf( "----------------------------------------------------\n" );
-    //~ print_rnas( tmp_list, LEADING );
-    //~ printf( "-------------------------==========-----------------\n" );
-    extracted_promoters->merge( tmp_list );
-    delete tmp_list;
-  }
+  // Extract the promoters (remove them from the individual's list and put them in extracted_promoters)
+  _rna_list[LEADING]->extract(  _rna_list[LEADING]->get_boundary( LEADING, pos_1 ),
+                                _rna_list[LEADING]->get_boundary( LEADING, pos_2 ),
+                                extracted_promoters );
 }
 
-void ae_genetic_unit::extract_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* extracted_promoters )
+void ae_genetic_unit::extract_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* extracted_promoters )
 {
   assert( pos_1 >= 0 && pos_1 < pos_2 && pos_2 <= _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node = NULL;
-  
-  // Find the first promoters in the interval (if any)
-  ae_list_node<ae_rna*>* node_first = NULL;
-  rna_node = _rna_list[LAGGING]->get_first();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos_2 )
-  {
-    rna_node  = rna_node->get_next();
-  }
-  if ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos_1 )
-  {
-    node_first = rna_node;
-  }
-  
-  // BREAKPOINT (contenu de extracted_promoters)
-  
-  if ( node_first != NULL )
-  {
-    // Find the last promoters in the interval
-    ae_list_node<ae_rna*>* node_last = NULL;
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos_1 )
-    {
-      node_last = rna_node;
-      rna_node  = rna_node->get_next();
-    }
-  
-    //~ // <DEBUG>
-    //~ printf( "_rna_list[LAGGING]  (first : %p last : %p)\n", _rna_list[LAGGING]->get_first(), _rna_list[LAGGING]->get_last() );
-    //~ ae_list_node* anode = _rna_list[LAGGING]->get_first();
-    //~ while ( anode )
-    //~ {
-      //~ printf( "  node : %p\n", anode );
-      //~ anode = anode->get_next();
-    //~ }
-    //~ // </DEBUG>
-    
-    // Extract the promoters (remove them from the individual's list and put the in extracted_promoters)
-    //~ printf( "tmp_list = _rna_list[LAGGING]->extract_sublist( %p, %p);\n", node_first, node_last );
-    ae_list<ae_rna*>* tmp_list = _rna_list[LAGGING]->extract_sublist( node_first, node_last );
-    
-    //~ // <DEBUG>
-    //~ printf( "tmp_list  (first : %p last : %p)\n", tmp_list->get_first(), tmp_list->get_last() );
-    //~ anode = tmp_list->get_first();
-    //~ while ( anode )
-    //~ {
-      //~ printf( "  node : %p\n", anode );
-      //~ anode = anode->get_next();
-    //~ }
-    //~ printf( "_rna_list[LAGGING]  (first : %p last : %p)\n", _rna_list[LAGGING]->get_first(), _rna_list[LAGGING]->get_last() );
-    //~ anode = _rna_list[LAGGING]->get_first();
-    //~ while ( anode )
-    //~ {
-      //~ printf( "  node : %p\n", anode );
-      //~ anode = anode->get_next();
-    //~ }
-    //~ // </DEBUG>
-    
-    extracted_promoters->merge( tmp_list );
-    
-    delete tmp_list;
-  }
+  // Extract the promoters (remove them from the individual's list and put them in extracted_promoters)
+  _rna_list[LAGGING]->extract(  _rna_list[LAGGING]->get_boundary( LAGGING, pos_2 ),
+                                _rna_list[LAGGING]->get_boundary( LAGGING, pos_1 ),
+                                extracted_promoters );
 }
 
-void ae_genetic_unit::extract_leading_promoters_starting_after( int32_t pos, ae_list<ae_rna*>* extracted_promoters )
+void ae_genetic_unit::extract_leading_promoters_starting_after( int32_t pos, ae_promoter_list* extracted_promoters )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node = NULL;
-  
-  // Find the first promoters in the interval
-  ae_list_node<ae_rna*>* node_first = NULL;
-  rna_node = _rna_list[LEADING]->get_first();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos )
-  {
-    rna_node = rna_node->get_next();
-  }
-  node_first = rna_node;
-  
-  if ( node_first != NULL )
-  {
-    // Extract the promoters (remove them from the individual's list and put the in extracted_promoters)
-    ae_list<ae_rna*>* tmp_list = _rna_list[LEADING]->extract_ending_sublist( node_first );
-    extracted_promoters->merge( tmp_list );
-    delete tmp_list;
-  }
+  // Extract the promoters (remove them from the individual's list and put them in extracted_promoters)
+  _rna_list[LEADING]->extract(  _rna_list[LEADING]->get_boundary( LEADING, pos ),
+                                _rna_list[LEADING]->get_nb_elts(),
+                                extracted_promoters );
 }
 
-void ae_genetic_unit::extract_leading_promoters_starting_before( int32_t pos, ae_list<ae_rna*>* extracted_promoters )
+void ae_genetic_unit::extract_leading_promoters_starting_before( int32_t pos, ae_promoter_list* extracted_promoters )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node = NULL;
-  
-  // Find the last promoters in the interval
-  rna_node = _rna_list[LEADING]->get_first();
-  
-  // Find the last promoters in the interval
-  ae_list_node<ae_rna*>* node_last = NULL;
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos )
-  {
-    node_last = rna_node;
-    rna_node  = rna_node->get_next();
-  }
-  
-  if ( node_last != NULL )
-  {
-    // Extract the promoters (remove them from the individual's list and put the in extracted_promoters)
-    ae_list<ae_rna*>* tmp_list = _rna_list[LEADING]->extract_starting_sublist( node_last );
-    extracted_promoters->merge( tmp_list );
-    delete tmp_list;
-  }
+  // Extract the promoters (remove them from the individual's list and put them in extracted_promoters)
+  _rna_list[LEADING]->extract(  0,
+                                _rna_list[LEADING]->get_boundary( LEADING, pos ),
+                                extracted_promoters );
 }
 
-void ae_genetic_unit::extract_lagging_promoters_starting_before( int32_t pos, ae_list<ae_rna*>* extracted_promoters )
+void ae_genetic_unit::extract_lagging_promoters_starting_before( int32_t pos, ae_promoter_list* extracted_promoters )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node = NULL;
-  
-  // Find the first promoters in the interval
-  ae_list_node<ae_rna*>* node_first = NULL;
-  rna_node = _rna_list[LAGGING]->get_first();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos )
-  {
-    rna_node  = rna_node->get_next();
-  }
-  node_first = rna_node;
-  
-  if ( node_first != NULL )
-  {
-    // Extract the promoters (remove them from the individual's list and put the in extracted_promoters)
-    ae_list<ae_rna*>* tmp_list = _rna_list[LAGGING]->extract_ending_sublist( node_first );
-    extracted_promoters->merge( tmp_list );
-    delete tmp_list;
-  }
+  // Extract the promoters (remove them from the individual's list and put them in extracted_promoters)
+  _rna_list[LAGGING]->extract(  _rna_list[LAGGING]->get_boundary( LAGGING, pos ),
+                                _rna_list[LAGGING]->get_nb_elts(),
+                                extracted_promoters );
 }
 
-void ae_genetic_unit::extract_lagging_promoters_starting_after( int32_t pos, ae_list<ae_rna*>* extracted_promoters )
+void ae_genetic_unit::extract_lagging_promoters_starting_after( int32_t pos, ae_promoter_list* extracted_promoters )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node = NULL;
-  
-  // Find the last promoters in the interval
-  rna_node = _rna_list[LAGGING]->get_first();
-  
-  // Find the last promoters in the interval
-  ae_list_node<ae_rna*>* node_last = NULL;
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos )
-  {
-    node_last = rna_node;
-    rna_node  = rna_node->get_next();
-  }
-  
-  if ( node_last != NULL )
-  {
-    // Extract the promoters (remove them from the individual's list and put the in extracted_promoters)
-    ae_list<ae_rna*>* tmp_list = _rna_list[LAGGING]->extract_starting_sublist( node_last );
-    extracted_promoters->merge( tmp_list );
-    delete tmp_list;
-  }
+  // Extract the promoters (remove them from the individual's list and put them in extracted_promoters)
+  _rna_list[LAGGING]->extract(  0,
+                                _rna_list[LAGGING]->get_boundary( LAGGING, pos ),
+                                extracted_promoters );
 }
 
 /*!
@@ -2474,25 +2064,10 @@ void ae_genetic_unit::extract_lagging_promoters_starting_after( int32_t pos, ae_
   Every promoter in double stranded list <promoters_to_shift> will be shifted by <delta_pos>,
   then a modulo <seq_length> will be applied
 */
-/*static*/ void ae_genetic_unit::shift_promoters( ae_list<ae_rna*>** promoters_to_shift, int32_t delta_pos, int32_t seq_length )
+/*static*/ void ae_genetic_unit::shift_promoters( ae_promoter_list** promoters_to_shift, int32_t delta_pos, int32_t seq_length )
 {
-  ae_list_node<ae_rna*>* rna_node  = NULL;
-  
-  // -- LEADING --
-  rna_node = promoters_to_shift[LEADING]->get_first();
-  while ( rna_node != NULL )
-  {
-    rna_node->get_obj()->shift_position( delta_pos, seq_length );
-    rna_node = rna_node->get_next();
-  }
-  
-  // -- LAGGING --
-  rna_node = promoters_to_shift[LAGGING]->get_first();
-  while ( rna_node != NULL )
-  {
-    rna_node->get_obj()->shift_position( delta_pos, seq_length );
-    rna_node = rna_node->get_next();
-  }
+  promoters_to_shift[LEADING]->shift( 0, promoters_to_shift[LEADING]->get_nb_elts(), delta_pos, seq_length );
+  promoters_to_shift[LAGGING]->shift( 0, promoters_to_shift[LAGGING]->get_nb_elts(), delta_pos, seq_length );
 }
 
 /*!
@@ -2502,64 +2077,20 @@ void ae_genetic_unit::extract_lagging_promoters_starting_after( int32_t pos, ae_
   and the positions of the promoters from <promoters_to_insert> and <this->_rna_list> must not be interlaced
   i.e. no promoter in <this->_rna_list> must have a position in [first_prom_to_insert->pos ; last_prom_to_insert->pos]
 */
-void ae_genetic_unit::insert_promoters( ae_list<ae_rna*>** promoters_to_insert )
+void ae_genetic_unit::insert_promoters( ae_promoter_list** promoters_to_insert )
 {
-  ae_list_node<ae_rna*>* rna_node            = NULL;
-  ae_list_node<ae_rna*>* rna_node_to_insert  = NULL;
-  
-  // -- LEADING --
-  if ( promoters_to_insert[LEADING]->get_nb_elts() > 0 )
-  {
-    // Get to the right position in individual's list (first promoter after the inserted segment)
-    int32_t pos_last_leading_to_insert = promoters_to_insert[LEADING]->get_last()->get_obj()->get_promoter_pos();
-    rna_node = _rna_list[LEADING]->get_first();
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_last_leading_to_insert )
-    {
-      rna_node = rna_node->get_next();
-    }
-    
-    // Insert the promoters in the individual's RNA list
-    rna_node_to_insert = promoters_to_insert[LEADING]->get_first();
-    while ( rna_node_to_insert != NULL )
-    {
-      if ( rna_node != NULL )
-      {
-        _rna_list[LEADING]->add_before( rna_node_to_insert->get_obj(), rna_node );
-      }
-      else
-      {
-        _rna_list[LEADING]->add( rna_node_to_insert->get_obj() );
-      }
-      
-      rna_node_to_insert = rna_node_to_insert->get_next();
-    }
-  }
-  
-  // -- LAGGING --
-  if ( promoters_to_insert[LAGGING]->get_nb_elts() > 0 )
+  for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
   {
-    // Get to the right position in individual's list (first promoter after the inserted segment)
-    int32_t pos_last_lagging_to_insert = promoters_to_insert[LAGGING]->get_last()->get_obj()->get_promoter_pos();
-    rna_node = _rna_list[LAGGING]->get_first();
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos_last_lagging_to_insert )
-    {
-      rna_node = rna_node->get_next();
-    }
+    int32_t nb_to_insert = promoters_to_insert[strand]->get_nb_elts();
     
-    // Insert the promoters in the individual's RNA list
-    rna_node_to_insert = promoters_to_insert[LAGGING]->get_first();
-    while ( rna_node_to_insert != NULL )
+    if ( nb_to_insert > 0 )
     {
-      if ( rna_node != NULL )
-      {
-        _rna_list[LAGGING]->add_before( rna_node_to_insert->get_obj(), rna_node );
-      }
-      else
-      {
-        _rna_list[LAGGING]->add( rna_node_to_insert->get_obj() );
-      }
+      // Get to the right position in individual's list (first promoter after the inserted segment)
+      int32_t pos_last_to_insert = promoters_to_insert[strand]->get_promoter_pos( nb_to_insert - 1 );
       
-      rna_node_to_insert = rna_node_to_insert->get_next();
+      // Insert the promoters in the individual's RNA list
+      _rna_list[strand]->insert( _rna_list[strand]->get_boundary( (ae_strand) strand, pos_last_to_insert ),
+                                 promoters_to_insert[strand] );
     }
   }
 }
@@ -2570,70 +2101,22 @@ void ae_genetic_unit::insert_promoters( ae_list<ae_rna*>** promoters_to_insert )
   The promoters in <promoters_to_insert> must be at their rightful position according to a stand-alone sequence
   (i.e. at a RELATIVE position). Their position will be updated automatically.
 */
-void ae_genetic_unit::insert_promoters_at( ae_list<ae_rna*>** promoters_to_insert, int32_t pos )
+void ae_genetic_unit::insert_promoters_at( ae_promoter_list** promoters_to_insert, int32_t pos )
 {
-  ae_list_node<ae_rna*>* rna_node = NULL;
-  ae_list_node<ae_rna*>* inserted_rna_node = NULL;
-  
-  // -- LEADING --
-  if ( promoters_to_insert[LEADING]->get_nb_elts() > 0 )
-  {
-    // Get to the right position in individual's list (first promoter after the inserted segment)
-    rna_node = _rna_list[LEADING]->get_first();
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos )
-    {
-      rna_node = rna_node->get_next();
-    }
-    
-    // Insert the promoters in the individual's RNA list
-    inserted_rna_node = promoters_to_insert[LEADING]->get_first();
-    while ( inserted_rna_node != NULL )
-    {
-      // Update promoter position
-      inserted_rna_node->get_obj()->shift_position( pos, _dna->get_length() );
-      
-      // Insert
-      if ( rna_node != NULL )
-      {
-        _rna_list[LEADING]->add_before( inserted_rna_node->get_obj(), rna_node );
-      }
-      else
-      {
-        _rna_list[LEADING]->add( inserted_rna_node->get_obj() );
-      }
-      
-      inserted_rna_node = inserted_rna_node->get_next();
-    }
-  }
-  
-  // -- LAGGING --
-  if ( promoters_to_insert[LAGGING]->get_nb_elts() > 0 )
+  for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
   {
-    // Get to the right position in individual's list (first promoter after the inserted segment)
-    rna_node = _rna_list[LAGGING]->get_first();
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos )
-    {
-      rna_node = rna_node->get_next();
-    }
+    int32_t nb_to_insert = promoters_to_insert[strand]->get_nb_elts();
     
-    // Insert the duplicated promoters in the individual's RNA list
-    inserted_rna_node = promoters_to_insert[LAGGING]->get_first();
-    while ( inserted_rna_node != NULL )
+    if ( nb_to_insert > 0 )
     {
-      // Update promoter position
-      inserted_rna_node->get_obj()->shift_position( pos, _dna->get_length() );
+      // Get to the right position in individual's list (first promoter after the inserted segment)
+      int32_t insertion_index = _rna_list[strand]->get_boundary( (ae_strand) strand, pos );
       
-      // Insert
-      if ( rna_node != NULL )
-      {
-        _rna_list[LAGGING]->add_before( inserted_rna_node->get_obj(), rna_node );
-      }
-      else
-      {
-        _rna_list[LAGGING]->add( inserted_rna_node->get_obj() );
-      }
+      // Update promoter positions
+      promoters_to_insert[strand]->shift( 0, nb_to_insert, pos, _dna->get_length() );
       
-      inserted_rna_node = inserted_rna_node->get_next();
+      // Insert the promoters in the individual's RNA list
+      _rna_list[strand]->insert( insertion_index, promoters_to_insert[strand] );
     }
   }
 }
@@ -2653,25 +2136,10 @@ void ae_genetic_unit::remove_leading_promoters_starting_between( int32_t pos_1,
   }
   else
   {
-    ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
-    
-    // Go to first RNA after pos_1
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_1 )
-    {
-      rna_node  = rna_node->get_next();
-    }
-    
-    // Delete RNAs until we pass pos_2 (or we reach the end of the list)
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_2 )
-    {
-      ae_list_node<ae_rna*>* next_node = rna_node->get_next();
-      //~ printf( "remove LEADING promoter at [%"PRId32", %"PRId32"]\n", rna_node->get_obj()->get_promoter_pos(),
-              //~ ae_utils::mod( rna_node->get_obj()->get_promoter_pos() + PROM_SIZE, _dna->get_length() ) );
-      
-      _rna_list[LEADING]->remove( rna_node, true, true );
-      
-      rna_node = next_node;
-    }
+    // Delete RNAs from the first one after pos_1 to the last one before pos_2
+    _rna_list[LEADING]->remove( _rna_list[LEADING]->get_boundary( LEADING, pos_1 ),
+                                _rna_list[LEADING]->get_boundary( LEADING, pos_2 ),
+                                true );
   }
 }
 
@@ -2704,25 +2172,10 @@ void ae_genetic_unit::remove_lagging_promoters_starting_between( int32_t pos_1,
   }
   else
   {
-    ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_first();
-    
-    // Go to first RNA before pos_2
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos_2 )
-    {
-      rna_node  = rna_node->get_next();
-    }
-    
-    // Delete RNAs until we pass pos_1 (or we reach the end of the list)
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos_1 )
-    {
-      ae_list_node<ae_rna*>* next_node = rna_node->get_next();
-      
-      //~ printf( "remove LAGGING promoter at [%"PRId32", %"PRId32"]\n", rna_node->get_obj()->get_promoter_pos(),
-              //~ ae_utils::mod( rna_node->get_obj()->get_promoter_pos() - PROM_SIZE, _dna->get_length() ) );
-      _rna_list[LAGGING]->remove( rna_node, true, true );
-      
-      rna_node = next_node;
-    }
+    // Delete RNAs from the first one before pos_2 to the last one after pos_1
+    _rna_list[LAGGING]->remove( _rna_list[LAGGING]->get_boundary( LAGGING, pos_2 ),
+                                _rna_list[LAGGING]->get_boundary( LAGGING, pos_1 ),
+                                true );
   }
 }
 
@@ -2734,17 +2187,7 @@ void ae_genetic_unit::remove_leading_promoters_starting_before( int32_t pos )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
-  
-  // Delete RNAs until we reach pos (or we reach the end of the list)
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos )
-  {
-    ae_list_node<ae_rna*>* next_node = rna_node->get_next();
-    
-    _rna_list[LEADING]->remove( rna_node, true, true );
-    
-    rna_node = next_node;
-  }
+  _rna_list[LEADING]->remove( 0, _rna_list[LEADING]->get_boundary( LEADING, pos ), true );
 }
 
 
@@ -2766,18 +2209,7 @@ void ae_genetic_unit::remove_lagging_promoters_starting_before( int32_t pos )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_last();
-  
-  // Delete RNAs until we reach pos (or we reach the beginning of the list )
-  ae_list_node<ae_rna*>* prev_node = NULL;
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos )
-  {
-    prev_node = rna_node->get_prev();
-    
-    _rna_list[LAGGING]->remove( rna_node, true, true );
-    
-    rna_node = prev_node;
-  }
+  _rna_list[LAGGING]->remove( _rna_list[LAGGING]->get_boundary( LAGGING, pos ), _rna_list[LAGGING]->get_nb_elts(), true );
 }
 
 
@@ -2788,19 +2220,7 @@ void ae_genetic_unit::remove_leading_promoters_starting_after( int32_t pos )
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  ae_list_node<ae_rna*>* rna_node = _rna_list[LEADING]->get_last();
-  
-  // Delete RNAs until we pass pos ( or we reach the beginning of the list)
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos )
-  {
-    ae_list_node<ae_rna*>* prev_node = rna_node->get_prev();
-    //~ printf( "remove LEADING promoter at [%"PRId32", %"PRId32"]\n", rna_node->get_obj()->get_promoter_pos(),
-            //~ ae_utils::mod( rna_node->get_obj()->get_promoter_pos() + PROM_SIZE, _dna->get_length() ) );
-    
-    _rna_list[LEADING]->remove( rna_node, true, true );
-    
-    rna_node = prev_node;
-  }
+  _rna_list[LEADING]->remove( _rna_list[LEADING]->get_boundary( LEADING, pos ), _rna_list[LEADING]->get_nb_elts(), true );
 }
 
 
@@ -2822,20 +2242,7 @@ void ae_genetic_unit::remove_lagging_promoters_starting_after( int32_t pos )
 {
   assert( pos < _dna->get_length() && pos >= 0 );
   
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_first();
-  
-  // Delete RNAs until we pass pos (or we reach the end of the list)
-  ae_list_node<ae_rna*>* next_node = NULL;
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos )
-  {
-    next_node = rna_node->get_next();
-    
-    //~ printf( "remove LAGGING promoter at [%"PRId32", %"PRId32"]\n", rna_node->get_obj()->get_promoter_pos(),
-            //~ ae_utils::mod( rna_node->get_obj()->get_promoter_pos() - PROM_SIZE, _dna->get_length() ) );
-    _rna_list[LAGGING]->remove( rna_node, true, true );
-    
-    rna_node  = next_node;
-  }
+  _rna_list[LAGGING]->remove( 0, _rna_list[LAGGING]->get_boundary( LAGGING, pos ), true );
 }
 
 
@@ -2865,34 +2272,15 @@ void ae_genetic_unit::look_for_new_leading_promoters_starting_between( int32_t p
     {
       if ( is_promoter( LEADING, i, dist ) ) // dist takes the hamming distance of the sequence from the consensus
       {
-        //~ char tmp[255];
-        //~ memcpy( tmp, &_dna->get_data()[i], PROM_SIZE * sizeof(char) );
-        //~ printf( "new promoter found on the LEADING strand at position %"PRId32" : %s\n", i, tmp );
-        
         // Look for the right place to insert the new promoter in the list
-        ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
-        
-        while( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < i )
-        {
-          rna_node = rna_node->get_next();
-        }
+        int32_t index = _rna_list[LEADING]->get_boundary( LEADING, i );
         
-        if ( rna_node == NULL )
+        if ( index == _rna_list[LEADING]->get_nb_elts() || _rna_list[LEADING]->get_promoter_pos( index ) != i ) // If not already in list
         {
-          // Add at the end of the list
           #ifndef __REGUL
-            _rna_list[LEADING]->add( new ae_rna( this, LEADING, i, dist ) );
+            _rna_list[LEADING]->insert( index, new ae_rna( this, LEADING, i, dist ) );
           #else
-            _rna_list[LEADING]->add( new ae_rna_R( this, LEADING, i, dist ) );
-          #endif
-        }
-        else if ( rna_node->get_obj()->get_promoter_pos() != i ) // If not already in list
-        {
-          // Add before rna_node
-          #ifndef __REGUL
-            _rna_list[LEADING]->add_before( new ae_rna( this, LEADING, i, dist ), rna_node );
-          #else
-            _rna_list[LEADING]->add_before( new ae_rna_R( this, LEADING, i, dist ), rna_node );
+            _rna_list[LEADING]->insert( index, new ae_rna_R( this, LEADING, i, dist ) );
           #endif
         }
       }
@@ -2933,36 +2321,20 @@ void ae_genetic_unit::look_for_new_lagging_promoters_starting_between( int32_t p
   else
   {
     int8_t dist; // Hamming distance of the sequence from the promoter consensus
-    ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_first();
     
     for ( int32_t i = pos_2 - 1 ; i >= pos_1 ; i-- )
     {
       if ( is_promoter( LAGGING, i, dist ) ) // dist takes the hamming distance of the sequence from the consensus
       {
-        assert ( i >= 0 && i < _dna->get_length() );
-        
         // Look for the right place to insert the new promoter in the list
-        while( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() > i )
-        {
-          rna_node = rna_node->get_next();
-        }
+        int32_t index = _rna_list[LAGGING]->get_boundary( LAGGING, i + 1 );
         
-        if ( rna_node == NULL )
-        {
-          // Add at the end of the list
-          #ifndef __REGUL
-            _rna_list[LAGGING]->add( new ae_rna( this, LAGGING, i, dist ) );
-          #else
-            _rna_list[LAGGING]->add( new ae_rna_R( this, LAGGING, i, dist ) );
-          #endif
-        }
-        else if ( rna_node->get_obj()->get_promoter_pos() != i ) // If not already in list
+        if ( index == _rna_list[LAGGING]->get_nb_elts() || _rna_list[LAGGING]->get_promoter_pos( index ) != i ) // If not already in list
         {
-          // Add before rna_node
           #ifndef __REGUL
-            _rna_list[LAGGING]->add_before( new ae_rna( this, LAGGING, i, dist ), rna_node );
+            _rna_list[LAGGING]->insert( index, new ae_rna( this, LAGGING, i, dist ) );
           #else
-            _rna_list[LAGGING]->add_before( new ae_rna_R( this, LAGGING, i, dist ), rna_node );
+            _rna_list[LAGGING]->insert( index, new ae_rna_R( this, LAGGING, i, dist ) );
           #endif
         }
       }
@@ -2978,44 +2350,22 @@ void ae_genetic_unit::look_for_new_leading_promoters_starting_after( int32_t pos
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  
   // Hamming distance of the sequence from the promoter consensus
   int8_t dist;
   
-  // rna list node used to find the new promoter's place in the list
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
-  
-  
   for ( int32_t i = pos ; i < _dna->get_length() ; i++ )
   {
     if ( is_promoter( LEADING, i, dist ) ) // dist takes the hamming distance of the sequence from the consensus
     {
-      //~ char tmp[255];
-      //~ memcpy( tmp, &_dna->get_data()[i], PROM_SIZE * sizeof(char) );
-      //~ printf( "new promoter found on the LEADING strand at position %"PRId32" : %s\n", i, tmp );
-      
       // Look for the right place to insert the new promoter in the list
-      while( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < i )
-      {
-        rna_node = rna_node->get_next();
-      }
+      int32_t index = _rna_list[LEADING]->get_boundary( LEADING, i );
       
-      if ( rna_node == NULL )
+      if ( index == _rna_list[LEADING]->get_nb_elts() || _rna_list[LEADING]->get_promoter_pos( index ) != i ) // If not already in list
       {
-        // Add at the end of the list
         #ifndef __REGUL
-          _rna_list[LEADING]->add( new ae_rna( this, LEADING, i, dist ) );
+          _rna_list[LEADING]->insert( index, new ae_rna( this, LEADING, i, dist ) );
         #else
-          _rna_list[LEADING]->add( new ae_rna_R( this, LEADING, i, dist ) );
-        #endif
-      }
-      else if ( rna_node->get_obj()->get_promoter_pos() != i ) // If not already in list
-      {
-        // Add before rna_node
-        #ifndef __REGUL
-          _rna_list[LEADING]->add_before( new ae_rna( this, LEADING, i, dist ), rna_node );
-        #else
-          _rna_list[LEADING]->add_before( new ae_rna_R( this, LEADING, i, dist ), rna_node );
+          _rna_list[LEADING]->insert( index, new ae_rna_R( this, LEADING, i, dist ) );
         #endif
       }
     }
@@ -3041,42 +2391,22 @@ void ae_genetic_unit::look_for_new_lagging_promoters_starting_after( int32_t pos
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  
   // Hamming distance of the sequence from the promoter consensus
   int8_t dist;
   
-  // rna list node used to find the new promoter's place in the list
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_first();
-  
-  
   for ( int32_t i = _dna->get_length() - 1 ; i >= pos ; i-- )
   {
     if ( is_promoter( LAGGING, i, dist ) ) // dist takes the hamming distance of the sequence from the consensus
     {
-      assert ( i >= 0 && i < _dna->get_length() );
-      
       // Look for the right place to insert the new promoter in the list
-      while( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() > i )
-      {
-        rna_node = rna_node->get_next();
-      }
+      int32_t index = _rna_list[LAGGING]->get_boundary( LAGGING, i + 1 );
       
-      if ( rna_node == NULL )
-      {
-        // Add at the end of the list
-        #ifndef __REGUL
-          _rna_list[LAGGING]->add( new ae_rna( this, LAGGING, i, dist ) );
-        #else
-          _rna_list[LAGGING]->add( new ae_rna_R( this, LAGGING, i, dist ) );
-        #endif
-      }
-      else if ( rna_node->get_obj()->get_promoter_pos() != i ) // If not already in list
+      if ( index == _rna_list[LAGGING]->get_nb_elts() || _rna_list[LAGGING]->get_promoter_pos( index ) != i ) // If not already in list
       {
-        // Add before rna_node
         #ifndef __REGUL
-          _rna_list[LAGGING]->add_before( new ae_rna( this, LAGGING, i, dist ), rna_node );
+          _rna_list[LAGGING]->insert( index, new ae_rna( this, LAGGING, i, dist ) );
         #else
-          _rna_list[LAGGING]->add_before( new ae_rna_R( this, LAGGING, i, dist ), rna_node );
+          _rna_list[LAGGING]->insert( index, new ae_rna_R( this, LAGGING, i, dist ) );
         #endif
       }
     }
@@ -3091,44 +2421,22 @@ void ae_genetic_unit::look_for_new_leading_promoters_starting_before( int32_t po
 {
   assert( pos >= 0 && pos < _dna->get_length() );
   
-  
   // Hamming distance of the sequence from the promoter consensus
   int8_t dist;
   
-  // rna list node used to find the new promoter's place in the list
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
-  
-  
   for ( int32_t i = 0 ; i < pos ; i++ )
   {
     if ( is_promoter( LEADING, i, dist ) ) // dist takes the hamming distance of the sequence from the consensus
     {
-      //~ char tmp[255];
-      //~ memcpy( tmp, &_dna->get_data()[i], PROM_SIZE * sizeof(char) );
-      //~ printf( "new promoter found on the LEADING strand at position %"PRId32" : %s\n", i, tmp );
-      
       // Look for the right place to insert the new promoter in the list
-      while( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < i )
-      {
-        rna_node = rna_node->get_next();
-      }
+      int32_t index = _rna_list[LEADING]->get_boundary( LEADING, i );
       
-      if ( rna_node == NULL )
+      if ( index == _rna_list[LEADING]->get_nb_elts() || _rna_list[LEADING]->get_promoter_pos( index ) != i ) // If not already in list
       {
-        // Add at the end of the list
         #ifndef __REGUL
-          _rna_list[LEADING]->add( new ae_rna( this, LEADING, i, dist ) );
+          _rna_list[LEADING]->insert( index, new ae_rna( this, LEADING, i, dist ) );
         #else
-          _rna_list[LEADING]->add( new ae_rna_R( this, LEADING, i, dist ) );
-        #endif
-      }
-      else if ( rna_node->get_obj()->get_promoter_pos() != i ) // If not already in list
-      {
-        // Add before rna_node
-        #ifndef __REGUL
-          _rna_list[LEADING]->add_before( new ae_rna( this, LEADING, i, dist ), rna_node );
-        #else
-          _rna_list[LEADING]->add_before( new ae_rna_R( this, LEADING, i, dist ), rna_node );
+          _rna_list[LEADING]->insert( index, new ae_rna_R( this, LEADING, i, dist ) );
         #endif
       }
     }
@@ -3157,38 +2465,19 @@ void ae_genetic_unit::look_for_new_lagging_promoters_starting_before( int32_t po
   // Hamming distance of the sequence from the promoter consensus
   int8_t dist;
   
-  // rna list node used to find the new promoter's place in the list
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_first();
-  
-  
   for ( int32_t i = pos - 1 ; i >= 0 ; i-- )
   {
     if ( is_promoter( LAGGING, i, dist ) ) // dist takes the hamming distance of the sequence from the consensus
     {
-      assert ( i >= 0 && i < _dna->get_length() );
-      
       // Look for the right place to insert the new promoter in the list
-      while( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() > i )
-      {
-        rna_node = rna_node->get_next();
-      }
+      int32_t index = _rna_list[LAGGING]->get_boundary( LAGGING, i + 1 );
       
-      if ( rna_node == NULL )
-      {
-        // Add at the end of the list
-        #ifndef __REGUL
-          _rna_list[LAGGING]->add( new ae_rna( this, LAGGING, i, dist ) );
-        #else
-          _rna_list[LAGGING]->add( new ae_rna_R( this, LAGGING, i, dist ) );
-        #endif
-      }
-      else if ( rna_node->get_obj()->get_promoter_pos() != i ) // If not already in list
+      if ( index == _rna_list[LAGGING]->get_nb_elts() || _rna_list[LAGGING]->get_promoter_pos( index ) != i ) // If not already in list
       {
-        // Add before rna_node
         #ifndef __REGUL
-          _rna_list[LAGGING]->add_before( new ae_rna( this, LAGGING, i, dist ), rna_node );
+          _rna_list[LAGGING]->insert( index, new ae_rna( this, LAGGING, i, dist ) );
         #else
-          _rna_list[LAGGING]->add_before( new ae_rna_R( this, LAGGING, i, dist ), rna_node );
+          _rna_list[LAGGING]->insert( index, new ae_rna_R( this, LAGGING, i, dist ) );
         #endif
       }
     }
@@ -3201,24 +2490,8 @@ void ae_genetic_unit::look_for_new_lagging_promoters_starting_before( int32_t po
 */
 void ae_genetic_unit::move_all_leading_promoters_after( int32_t pos, int32_t delta_pos )
 {
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
-  
-  // Go to first RNA after pos
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos )
-  {
-    //~ printf( "don't move leading promoter at position %"PRId32"\n", rna_node->get_obj()->get_promoter_pos() );
-    rna_node = rna_node->get_next();
-  }
-  
-  // Update all the remaining RNAs
-  while ( rna_node != NULL )
-  {
-    //~ printf( "move leading promoter at position %"PRId32"\n", rna_node->get_obj()->get_promoter_pos() );
-    rna_node->get_obj()->shift_position( delta_pos, _dna->get_length() );
-    //~ printf( "new position : %"PRId32"\n", rna_node->get_obj()->get_promoter_pos() );
-    
-    rna_node = rna_node->get_next();
-  }
+  _rna_list[LEADING]->shift(  _rna_list[LEADING]->get_boundary( LEADING, pos ), _rna_list[LEADING]->get_nb_elts(),
+                              delta_pos, _dna->get_length() );
 }
 
 
@@ -3238,63 +2511,42 @@ void ae_genetic_unit::move_all_leading_promoters_after( int32_t pos, int32_t del
 */
 void ae_genetic_unit::move_all_lagging_promoters_after( int32_t pos, int32_t delta_pos )
 {
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_first();
-  ae_rna*       rna;
-  
-  // Update RNAs until we pass pos (or we reach the end of the list)
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() >= pos )
-  {
-    rna = rna_node->get_obj();
-    if ( rna->get_promoter_pos() < pos ) break;
-    
-    rna->shift_position( delta_pos, _dna->get_length() );
-    
-    rna_node = rna_node->get_next();
-  }
+  _rna_list[LAGGING]->shift(  0, _rna_list[LAGGING]->get_boundary( LAGGING, pos ),
+                              delta_pos, _dna->get_length() );
 }
 
 
 /*!
   \brief Copy (into new_promoter_list) the promoters from the LEADING strand whose starting positions lie in [pos_1 ; pos_2[
 */
-void ae_genetic_unit::copy_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* new_promoter_list )
+void ae_genetic_unit::copy_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* new_promoter_list )
 {
   // 1) Go to first RNA to copy
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LEADING]->get_first();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_1 )
-  {
-    //~ printf( "don't move leading promoter at position %"PRId32"\n", rna_node->get_obj()->get_promoter_pos() );
-    rna_node = rna_node->get_next();
-  }
+  int32_t first = _rna_list[LEADING]->get_boundary( LEADING, pos_1 );
   
   // 2) Copy RNAs
   if ( pos_1 < pos_2 )
   {
     // Copy from pos_1 to pos_2
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_2 )
+    int32_t last = _rna_list[LEADING]->get_boundary( LEADING, pos_2 );
+    for ( int32_t i = first ; i < last ; i++ )
     {
-      new_promoter_list->add( new ae_rna( this, *(rna_node->get_obj()) ) );
-      
-      rna_node = rna_node->get_next();
+      new_promoter_list->add( new ae_rna( this, *(_rna_list[LEADING]->get_rna( i )) ) );
     }
   }
   else
   {
     // Copy from pos_1 to the end of the list
-    while ( rna_node != NULL )
+    for ( int32_t i = first ; i < _rna_list[LEADING]->get_nb_elts() ; i++ )
     {
-      new_promoter_list->add( new ae_rna( this, *(rna_node->get_obj()) ) );
-      
-      rna_node = rna_node->get_next();
+      new_promoter_list->add( new ae_rna( this, *(_rna_list[LEADING]->get_rna( i )) ) );
     }
     
     // Copy from the beginning of the list to pos_2
-    rna_node  = _rna_list[LEADING]->get_first();
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_2 )
+    int32_t last = _rna_list[LEADING]->get_boundary( LEADING, pos_2 );
+    for ( int32_t i = 0 ; i < last ; i++ )
     {
-      new_promoter_list->add( new ae_rna( this, *(rna_node->get_obj()) ) );
-      
-      rna_node = rna_node->get_next();
+      new_promoter_list->add( new ae_rna( this, *(_rna_list[LEADING]->get_rna( i )) ) );
     }
   }
 }
@@ -3314,43 +2566,34 @@ void ae_genetic_unit::copy_leading_promoters_starting_between( int32_t pos_1, in
                        pos
   \endverbatim
 */
-void ae_genetic_unit::copy_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* new_promoter_list )
+void ae_genetic_unit::copy_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* new_promoter_list )
 {
-  // Go to first RNA to copy
-  ae_list_node<ae_rna*>* rna_node  = _rna_list[LAGGING]->get_last();
-  while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_1 )
-  {
-    rna_node  = rna_node->get_prev();
-  }
+  // 1) Go to first RNA to copy
+  int32_t first = _rna_list[LAGGING]->get_boundary( LAGGING, pos_2 );
   
-  // Copy RNAs
+  // 2) Copy RNAs
   if ( pos_1 < pos_2 )
   {
-    // Copy from pos_1 to pos_2
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_2 )
+    // Copy from pos_2 to pos_1 (the list is in decreasing order of position)
+    int32_t last = _rna_list[LAGGING]->get_boundary( LAGGING, pos_1 );
+    for ( int32_t i = first ; i < last ; i++ )
     {
-      new_promoter_list->add_front( new ae_rna( this, *(rna_node->get_obj()) ) );
-      
-      rna_node = rna_node->get_prev();
+      new_promoter_list->add( new ae_rna( this, *(_rna_list[LAGGING]->get_rna( i )) ) );
     }
   }
   else
   {
-    // Copy from pos_1 to the beginning of the list (we are going backwards)
-    while ( rna_node != NULL )
+    // Copy from pos_2 to the end of the list
+    for ( int32_t i = first ; i < _rna_list[LAGGING]->get_nb_elts() ; i++ )
     {
-      new_promoter_list->add_front( new ae_rna( this, *(rna_node->get_obj()) ) );
-      
-      rna_node = rna_node->get_prev();
+      new_promoter_list->add( new ae_rna( this, *(_rna_list[LAGGING]->get_rna( i )) ) );
     }
     
-    // Copy from the end of the list to pos_2 (we are going backwards)
-    rna_node  = _rna_list[LAGGING]->get_last();
-    while ( rna_node != NULL && rna_node->get_obj()->get_promoter_pos() < pos_2 )
+    // Copy from the beginning of the list to pos_1
+    int32_t last = _rna_list[LAGGING]->get_boundary( LAGGING, pos_1 );
+    for ( int32_t i = 0 ; i < last ; i++ )
     {
-      new_promoter_list->add_front( new ae_rna( this, *(rna_node->get_obj()) ) );
-      
-      rna_node = rna_node->get_prev();
+      new_promoter_list->add( new ae_rna( this, *(_rna_list[LAGGING]->get_rna( i )) ) );
     }
   }
 }
@@ -3388,28 +2631,23 @@ int32_t ae_genetic_unit::get_nb_terminators( void )
     assert_promoters_order();
     
     // Make a backup of the genetic unit's lists of RNAs
-    ae_list<ae_rna*>** old_rna_list = _rna_list;
+    ae_promoter_list** old_rna_list = _rna_list;
     
-    _rna_list           = new ae_list<ae_rna*>*[2];
-    _rna_list[LEADING]  = new ae_list<ae_rna*>();
-    _rna_list[LAGGING]  = new ae_list<ae_rna*>();
+    _rna_list           = new ae_promoter_list*[2];
+    _rna_list[LEADING]  = new ae_promoter_list();
+    _rna_list[LAGGING]  = new ae_promoter_list();
     
     locate_promoters();
     
     // Compare lists
-    ae_list_node<ae_rna*>*  node_old  = NULL;
-    ae_list_node<ae_rna*>*  node_new  = NULL;
     ae_rna* rna_old   = NULL;
     ae_rna* rna_new   = NULL;
 
     for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
     {
-      node_old  = old_rna_list[strand]->get_first();
-      node_new  = _rna_list[strand]->get_first();
-      
-      while ( node_old != NULL || node_new != NULL )
+      for ( int32_t i = 0 ; i < old_rna_list[strand]->get_nb_elts() || i < _rna_list[strand]->get_nb_elts() ; i++ )
       {
-        if( node_old == NULL || node_new == NULL )
+        if( i >= old_rna_list[strand]->get_nb_elts() || i >= _rna_list[strand]->get_nb_elts() )
         {
           printf( "****************************** NB_ELTS problem ******************************\n" );
           printf( "should be : \n" );
@@ -3418,11 +2656,11 @@ int32_t ae_genetic_unit::get_nb_terminators( void )
           print_rnas( old_rna_list );
           printf( "****************************************************************************\n" );
           printf( "  genome length : %"PRId32"\n", _dna->get_length() );
-          assert( node_old != NULL && node_new != NULL );
+          assert( i < old_rna_list[strand]->get_nb_elts() && i < _rna_list[strand]->get_nb_elts() );
         }
         
-        rna_old = node_old->get_obj();
-        rna_new = node_new->get_obj();
+        rna_old = old_rna_list[strand]->get_rna( i );
+        rna_new = _rna_list[strand]->get_rna( i );
         
         if ( rna_old->get_strand() != rna_new->get_strand() )
         {
@@ -3468,9 +2706,6 @@ int32_t ae_genetic_unit::get_nb_terminators( void )
           printf( "  genome length : %"PRId32"\n", _dna->get_length() );
           assert( rna_old->get_basal_level() == rna_new->get_basal_level() );
         }
-        
-        node_old = node_old->get_next();
-        node_new = node_new->get_next();
       }
     }
     
@@ -3485,22 +2720,23 @@ int32_t ae_genetic_unit::get_nb_terminators( void )
   
   void ae_genetic_unit::assert_promoters_order( void )
   {
-    ae_list_node<ae_rna*>* node1 = NULL;
-    ae_list_node<ae_rna*>* node2 = NULL;
     ae_rna* rna1 = NULL;
     ae_rna* rna2 = NULL;
     
     for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
     {
+      for ( int32_t i = 0 ; i < _rna_list[strand]->get_nb_elts() ; i++ )
+      {
+        // Check that the positions mirrored by the list are up to date
+        assert( _rna_list[strand]->get_promoter_pos( i ) == _rna_list[strand]->get_rna( i )->get_promoter_pos() );
+      }
+      
       if ( _rna_list[strand]->get_nb_elts() >= 2 )
       {
-        node1 = _rna_list[strand]->get_first();
-        node2 = node1->get_next();
-        
-        while ( node2 != NULL )
+        for ( int32_t i = 1 ; i < _rna_list[strand]->get_nb_elts() ; i++ )
         {
-          rna1 = node1->get_obj();
-          rna2 = node2->get_obj();
+          rna1 = _rna_list[strand]->get_rna( i - 1 );
+          rna2 = _rna_list[strand]->get_rna( i );
           
           if ( strand == LEADING )
           {
@@ -3522,9 +2758,6 @@ int32_t ae_genetic_unit::get_nb_terminators( void )
               assert( rna1->get_promoter_pos() > rna2->get_promoter_pos() );
             }
           }
-          
-          node1 = node2;
-          node2 = node2->get_next();
         }
       }
     }
@@ -3545,11 +2778,10 @@ bool* ae_genetic_unit::is_belonging_to_coding_RNA( void )
   // Parse RNA lists and mark the corresponding bases as coding (only for the coding RNAs)
   for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
   {
-    ae_list_node<ae_rna*>* rna_node  = _rna_list[strand]->get_first();
     ae_rna* rna = NULL;
-    while ( rna_node != NULL )
+    for ( int32_t rna_ind = 0 ; rna_ind < _rna_list[strand]->get_nb_elts() ; rna_ind++ )
     {
-      rna = rna_node->get_obj();
+      rna = _rna_list[strand]->get_rna( rna_ind );
       
       int32_t first;
       int32_t last;
@@ -3585,8 +2817,7 @@ bool* ae_genetic_unit::is_belonging_to_coding_RNA( void )
             belongs_to_coding_RNA[i] = true;
           }
         }
-      }      
-      rna_node = rna_node->get_next();
+      }
     }
   }
   return(belongs_to_coding_RNA);
@@ -3824,3 +3055,309 @@ void ae_genetic_unit::init_statistical_data( void ) // TODO : integrate into com
   _end_neutral_regions = NULL;
 }
 
+/*!
+  \brief Transcribe and translate the RNAs that contain a switched position, copy the
+  transcription and translation of the other ones from <parent>.
+  
+  This GU must have been copied from <parent> and its DNA must have undergone nothing
+  but switches since (see ae_dna::get_switched_pos), its promoters having been updated
+  accordingly. A switch only changes the promoters, terminators and codons it belongs
+  to, hence an RNA of <parent> whose promoter, transcript and terminator contain none
+  of the switched positions has the same transcript and bears the same CDSs in this GU.
+  
+  The outcome is exactly that of do_transcription and do_translation, down to the
+  order of the proteins (which the phenotypic contribution depends on): the RNAs are
+  handled in the same order, see inherit_translation.
+*/
+void ae_genetic_unit::inherit_unswitched_expression( const ae_genetic_unit* parent )
+{
+  _transcribed  = true;
+  _translated   = true;
+  
+  int32_t genome_length = _dna->get_length();
+  int32_t nb_built      = 0;
+  
+  // Shine-Dalgarno positions of the proteins translated from scratch on the current strand
+  static thread_local std::vector<int32_t> new_proteins;
+  
+  for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
+  {
+    ae_promoter_list* rnas        = _rna_list[strand];
+    ae_promoter_list* parent_rnas = parent->_rna_list[strand];
+    new_proteins.clear();
+    
+    for ( int32_t i = 0 ; i < rnas->get_nb_elts() ; i++ )
+    {
+      ae_rna* rna = rnas->get_rna( i );
+      int32_t pos = rnas->get_promoter_pos( i );
+      
+      // Look for the RNA of the parent having the same promoter (the lists are sorted
+      // by promoter position, decreasing on the LAGGING strand)
+      int32_t parent_i = ( strand == LEADING ) ? parent_rnas->get_boundary( LEADING, pos ) :
+                                                 parent_rnas->get_boundary( LAGGING, pos + 1 );
+      const ae_rna* parent_rna = NULL;
+      if ( parent_i < parent_rnas->get_nb_elts() && parent_rnas->get_promoter_pos( parent_i ) == pos )
+      {
+        // It can only be kept if its whole sequence (and not the whole genome) is unchanged. When
+        // it has no terminator, any switch may have created one.
+        parent_rna = parent_rnas->get_rna( parent_i );
+        int32_t span = PROM_SIZE + parent_rna->get_transcript_length();
+        if ( parent_rna->get_transcript_length() < 0 || span >= genome_length ||
+             is_switched_within( (ae_strand) strand, pos, span ) )
+        {
+          parent_rna = NULL;
+        }
+      }
+      
+      if ( parent_rna != NULL )
+      {
+        assert( parent_rna->get_basal_level() == rna->get_basal_level() );
+        rna->set_transcript_length( parent_rna->get_transcript_length() );
+        inherit_translation( rna, parent_rna, parent, new_proteins );
+      }
+      else
+      {
+        transcribe_rna( rna );
+        translate_rna( rna, &new_proteins );
+      }
+      
+      count_rna( rna );
+    }
+    
+    nb_built += new_proteins.size();
+  }
+  
+  PROFILE_COUNT( PROTEINS_BUILT, nb_built );
+}
+
+/*!
+  Whether any of the switched positions of the DNA lies within the <span> bases read
+  on <strand> from <pos>
+*/
+bool ae_genetic_unit::is_switched_within( ae_strand strand, int32_t pos, int32_t span ) const
+{
+  const std::vector<int32_t>& switched = _dna->get_switched_pos();
+  int32_t genome_length = _dna->get_length();
+  
+  for ( size_t i = 0 ; i < switched.size() ; i++ )
+  {
+    int32_t dist = ( strand == LEADING ) ? ae_utils::mod( switched[i] - pos, genome_length ) :
+                                           ae_utils::mod( pos - switched[i], genome_length );
+    if ( dist < span ) return true;
+  }
+  
+  return false;
+}
+
+/*!
+  Set the transcript length of <rna> alone, the way do_transcription does it for all the RNAs
+  (the genome must be long enough to bear a promoter and a terminator)
+*/
+void ae_genetic_unit::transcribe_rna( ae_rna* rna )
+{
+  int32_t genome_length = _dna->get_length();
+  
+  // The transcript ends with the first terminator found downstream of the promoter.
+  // Terminators are identified by their position on the leading strand (see do_transcription).
+  int32_t first, step;
+  if ( rna->get_strand() == LEADING )
+  {
+    first = rna->get_first_transcribed_pos();
+    step  = 1;
+  }
+  else // ( rna->get_strand() == LAGGING )
+  {
+    first = ae_utils::mod( rna->get_first_transcribed_pos() - (TERM_SIZE - 1), genome_length );
+    step  = -1;
+  }
+  
+  for ( int32_t dist = 0 ; dist < genome_length ; dist++ )
+  {
+    if ( is_terminator( LEADING, ae_utils::mod( first + step * dist, genome_length ) ) )
+    {
+      rna->set_transcript_length( dist + TERM_SIZE );
+      return;
+    }
+  }
+  
+  // No terminator at all (see do_transcription)
+  rna->set_transcript_length( -1 );
+}
+
+/*!
+  Look for the CDSs of <rna> and add the corresponding proteins to <rna> (and to this GU if
+  they were not translated from another RNA yet). The Shine-Dalgarno position of the proteins
+  that are created is appended to <new_proteins> if provided.
+*/
+void ae_genetic_unit::translate_rna( ae_rna* rna, std::vector<int32_t>* new_proteins /* = NULL */ )
+{
+  ae_strand strand            = rna->get_strand();
+  int32_t   step              = ( strand == LEADING ) ? 1 : -1;
+  int32_t   transcript_start  = rna->get_first_transcribed_pos();
+  int32_t   transcript_length = rna->get_transcript_length();
+  int32_t   genome_length     = _dna->get_length();
+
+  // Try every position where a translation process could occur
+  // Minimum number of bases needed is SHINE_DAL_SIZE + SHINE_START_SPACER + 3 * CODON_SIZE
+  // (3 codons for START + STOP + at least one amino-acid)
+  for ( int32_t i = 0 ; transcript_length - i >= SHINE_DAL_SIZE + SHINE_START_SPACER + 3 * CODON_SIZE ; i++ )
+  {
+    int32_t shine_dal_pos = ae_utils::mod( transcript_start + step * i, genome_length );
+    
+    if (  ( is_shine_dalgarno( strand, shine_dal_pos ) ) &&
+          ( is_start( strand, ae_utils::mod( transcript_start + step * (i + SHINE_DAL_SIZE + SHINE_START_SPACER), genome_length ) ) ) )
+    {
+      // We found a translation initiation, we can now build the protein until we find a STOP codon or until we reach the end
+      // of the transcript (in which case the protein is not valid)
+
+      // First of all, we will check whether this CDS has already been translated (because it is present on another RNA
+      // In that case, we don't need to tranlate it again, we only need to increase the protein's concentration according to
+      // the promoter transcription level
+      ae_protein* protein = _protein_map[strand]->get( shine_dal_pos );
+
+      if ( protein != NULL )
+      {
+        protein->add_RNA( rna );
+        rna->add_transcribed_protein( protein );
+      }
+      else
+      {
+        // Look for the STOP codon, the protein will only be built if it is found before the end of the transcript
+        int32_t first_codon = i + SHINE_DAL_SIZE + SHINE_START_SPACER + CODON_SIZE;
+        int32_t j = first_codon; // next codon to examine
+
+        while ( (transcript_length - j >= CODON_SIZE) &&
+                ! is_stop( strand, ae_utils::mod( transcript_start + step * j, genome_length ) ) )
+        {
+          j += CODON_SIZE;
+        }
+
+        int32_t nb_AA = ( j - first_codon ) / CODON_SIZE;
+        if ( (transcript_length - j >= CODON_SIZE) && nb_AA > 0 ) // STOP found and at least one amino-acid
+        {
+          // The protein is valid, create the corresponding object
+          #ifndef __REGUL
+            protein = new ae_protein( this, nb_AA, strand, shine_dal_pos, rna );
+          #else
+            protein = new ae_protein_R( this, nb_AA, strand, shine_dal_pos, rna );
+          #endif
+          
+          add_protein( protein, rna );
+          if ( new_proteins != NULL ) new_proteins->push_back( shine_dal_pos );
+        }
+      }
+    }
+  }
+}
+
+/*!
+  Same as translate_rna for an RNA of this GU that has the same sequence as <parent_rna>,
+  its counterpart in <parent> (see inherit_unswitched_expression)
+  
+  The CDSs of the RNA are those of the parent's RNA, plus those of the proteins that have
+  been translated from scratch (given by <new_proteins>) since such a CDS may have been
+  ignored in the parent (for want of a STOP codon within the RNA, translate_rna only
+  takes up CDSs that lie across the end of the RNA if they have already been translated).
+  The CDSs are handled in the same order as in translate_rna, and the proteins that have
+  not been translated from another RNA yet are copied from the parent.
+*/
+void ae_genetic_unit::inherit_translation( ae_rna* rna, const ae_rna* parent_rna, const ae_genetic_unit* parent,
+                                           const std::vector<int32_t>& new_proteins )
+{
+  ae_strand strand            = rna->get_strand();
+  int32_t   step              = ( strand == LEADING ) ? 1 : -1;
+  int32_t   transcript_start  = rna->get_first_transcribed_pos();
+  int32_t   transcript_length = rna->get_transcript_length();
+  int32_t   genome_length     = _dna->get_length();
+  int32_t   last_tried        = transcript_length - ( SHINE_DAL_SIZE + SHINE_START_SPACER + 3 * CODON_SIZE );
+  
+  // Positions of the CDSs in the transcript (as i in translate_rna)
+  static thread_local std::vector<int32_t> cds;
+  cds.clear();
+  
+  ae_list_node<ae_protein*>* prot_node = parent_rna->get_transcribed_proteins()->get_first();
+  while ( prot_node != NULL )
+  {
+    cds.push_back( ae_utils::mod( step * ( prot_node->get_obj()->get_shine_dal_pos() - transcript_start ), genome_length ) );
+    prot_node = prot_node->get_next();
+  }
+  
+  for ( size_t k = 0 ; k < new_proteins.size() ; k++ )
+  {
+    int32_t i = ae_utils::mod( step * ( new_proteins[k] - transcript_start ), genome_length );
+    if ( i <= last_tried ) cds.push_back( i );
+  }
+  
+  std::sort( cds.begin(), cds.end() );
+  cds.erase( std::unique( cds.begin(), cds.end() ), cds.end() );
+  
+  for ( size_t k = 0 ; k < cds.size() ; k++ )
+  {
+    int32_t shine_dal_pos = ae_utils::mod( transcript_start + step * cds[k], genome_length );
+    ae_protein* protein = _protein_map[strand]->get( shine_dal_pos );
+    
+    if ( protein != NULL )
+    {
+      protein->add_RNA( rna );
+      rna->add_transcribed_protein( protein );
+    }
+    else
+    {
+      // Only a CDS of the parent's RNA can be missing. The CDS is the same as in the parent,
+      // provided that its STOP codon lies within the RNA: it would have been found first.
+      const ae_protein* model = parent->_protein_map[strand]->get( shine_dal_pos );
+      assert( model != NULL );
+      
+      int32_t stop = cds[k] + SHINE_DAL_SIZE + SHINE_START_SPACER + CODON_SIZE * ( model->get_length() + 1 );
+      if ( transcript_length - stop >= CODON_SIZE )
+      {
+        add_protein( new ae_protein( this, *model, rna ), rna );
+      }
+    }
+  }
+}
+
+/*!
+  Add a newly translated <protein> (whose RNA list only holds <rna>) to this GU and to <rna>
+*/
+void ae_genetic_unit::add_protein( ae_protein* protein, ae_rna* rna )
+{
+  _protein_list[protein->get_strand()]->add( protein );
+  _protein_map[protein->get_strand()]->add( protein );
+  rna->add_transcribed_protein( protein );
+  
+  if ( protein->get_is_functional() )
+  {
+    _nb_fun_genes++;
+    //~ _overall_size_fun_genes += ( protein->get_length() + 2 ) * CODON_SIZE;
+    _overall_size_fun_genes += protein->get_length() * CODON_SIZE;
+    
+    if ( protein->get_height() > 0 )  _nb_genes_activ++;
+    else                              _nb_genes_inhib++;
+  }
+  else
+  {
+    _nb_non_fun_genes++;
+    // NB : the START and STOP codons of the non functional genes are only counted on the LAGGING strand
+    //~ _overall_size_non_fun_genes += ( protein->get_length() + 2 ) * CODON_SIZE;
+    _overall_size_non_fun_genes += ( protein->get_length() + ( ( protein->get_strand() == LAGGING ) ? 2 : 0 ) ) * CODON_SIZE;
+  }
+}
+
+/*!
+  Update the RNA statistics with <rna>, once it has been translated
+*/
+void ae_genetic_unit::count_rna( ae_rna* rna )
+{
+  if ( ! rna->get_transcribed_proteins()->is_empty() ) // coding RNA
+  {
+    _nb_coding_RNAs++;
+    _overall_size_coding_RNAs += rna->get_transcript_length();
+  }
+  else // non-coding RNA
+  {
+    _nb_non_coding_RNAs++;
+    _overall_size_non_coding_RNAs += rna->get_transcript_length();
+  }
+}
+
@@ -34,6 +34,7 @@
 // =================================================================
 #include <inttypes.h>
 #include <stdio.h>
+#include <vector>
 
 
 
@@ -42,6 +43,8 @@
 // =================================================================
 #include <ae_dna.h>
 #include <ae_rna.h>
+#include <ae_promoter_list.h>
+#include <ae_protein_map.h>
 #include <ae_protein.h>
 #include <ae_fuzzy_set.h>
 #include <ae_environment.h>
@@ -67,7 +70,7 @@ class ae_genetic_unit : public ae_object
     //                             Constructors
     // =================================================================
     ae_genetic_unit( ae_individual* indiv, int32_t length );
-    ae_genetic_unit( ae_individual* indiv, char* seq, int32_t length, ae_list<ae_rna*>** prom_list = NULL );
+    ae_genetic_unit( ae_individual* indiv, char* seq, int32_t length, ae_promoter_list** prom_list = NULL );
     ae_genetic_unit( ae_individual* indiv, const ae_genetic_unit &model );
     ae_genetic_unit( ae_individual* indiv, ae_genetic_unit* const parent );
     ae_genetic_unit( ae_individual* indiv, gzFile backup_file );
@@ -89,8 +92,9 @@ class ae_genetic_unit : public ae_object
     inline ae_fuzzy_set*    get_inhib_contribution( void )      const;
     inline ae_fuzzy_set*    get_phenotypic_contribution( void ) const;
     
-    inline ae_list<ae_rna*>** get_rna_list( void )                const;
+    inline ae_promoter_list** get_rna_list( void )                const;
     inline ae_list<ae_protein*>** get_protein_list( void ) const;
+    inline ae_protein*            get_protein_at( ae_strand strand, int32_t shine_dal_pos ) const;
     
     
     // Direct DNA access
@@ -136,7 +140,7 @@ class ae_genetic_unit : public ae_object
     inline double   get_fitness_by_feature( ae_env_axis_feature feature )         const;
     
     
-    inline void  set_rna_list( ae_list<ae_rna*>** new_list );
+    inline void  set_rna_list( ae_promoter_list** new_list );
 
     inline int32_t  get_min_gu_length( void ) const;
     inline int32_t  get_max_gu_length( void ) const;
@@ -152,6 +156,7 @@ class ae_genetic_unit : public ae_object
     void do_transcription( void );
     void do_translation( void );
     void compute_phenotypic_contribution( void );
+    void inherit_expression( const ae_genetic_unit* parent );
     
     // DM: these two are identical to functions from ae_individual 
     void compute_distance_to_target( ae_environment* envir );
@@ -160,8 +165,8 @@ class ae_genetic_unit : public ae_object
     void reset_expression( void ); // useful for post-treatment programs
     
     inline void print_rnas( void ) const;
-    inline static void print_rnas( ae_list<ae_rna*>** rnas );
-    static void print_rnas( ae_list<ae_rna*>* rnas, ae_strand strand );
+    inline static void print_rnas( ae_promoter_list** rnas );
+    static void print_rnas( ae_promoter_list* rnas, ae_strand strand );
     void print_proteins( void ) const;
 
     bool        is_promoter( ae_strand strand, int32_t pos, int8_t& dist ) const;
@@ -169,37 +174,37 @@ class ae_genetic_unit : public ae_object
     bool        is_shine_dalgarno( ae_strand strand, int32_t pos ) const;
     inline bool is_start( ae_strand strand, int32_t pos ) const;
     inline bool is_stop( ae_strand strand, int32_t pos ) const;
-    int8_t      get_codon( ae_strand strand, int32_t pos ) const;
+    inline int8_t get_codon( ae_strand strand, int32_t pos ) const;
     
     void compute_non_coding( void );
   
     
-    void duplicate_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** duplicated_promoters );
+    void duplicate_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_promoter_list** duplicated_promoters );
 
-    void get_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** promoters );
-    void get_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* leading_promoters );
-    void get_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* lagging_promoters );
-    void get_leading_promoters_starting_after( int32_t pos, ae_list<ae_rna*>* leading_promoters );
-    void get_leading_promoters_starting_before( int32_t pos, ae_list<ae_rna*>* leading_promoters );
-    void get_lagging_promoters_starting_before( int32_t pos, ae_list<ae_rna*>* lagging_promoters );
-    void get_lagging_promoters_starting_after( int32_t pos, ae_list<ae_rna*>* lagging_promoters );
+    void get_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_promoter_list** promoters );
+    void get_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* leading_promoters );
+    void get_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* lagging_promoters );
+    void get_leading_promoters_starting_after( int32_t pos, ae_promoter_list* leading_promoters );
+    void get_leading_promoters_starting_before( int32_t pos, ae_promoter_list* leading_promoters );
+    void get_lagging_promoters_starting_before( int32_t pos, ae_promoter_list* lagging_promoters );
+    void get_lagging_promoters_starting_after( int32_t pos, ae_promoter_list* lagging_promoters );
     
     void invert_promoters_included_in( int32_t pos_1, int32_t pos_2 );
-    static void invert_promoters( ae_list<ae_rna*>** promoter_lists, int32_t seq_length );
-    static void invert_promoters( ae_list<ae_rna*>** promoter_lists, int32_t pos_1, int32_t pos_2 ); // See WARNING
-    
-    inline void extract_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** extracted_promoters );
-    inline void extract_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** extracted_promoters );
-    void extract_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* extracted_promoters );
-    void extract_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* extracted_promoters );
-    void extract_leading_promoters_starting_after( int32_t pos, ae_list<ae_rna*>* extracted_promoters );
-    void extract_leading_promoters_starting_before( int32_t pos, ae_list<ae_rna*>* extracted_promoters );
-    void extract_lagging_promoters_starting_before( int32_t pos, ae_list<ae_rna*>* extracted_promoters );
-    void extract_lagging_promoters_starting_after( int32_t pos, ae_list<ae_rna*>* extracted_promoters );
-    
-    static void shift_promoters( ae_list<ae_rna*>** promoters_to_shift, int32_t delta_pos, int32_t seq_length );
-    void insert_promoters( ae_list<ae_rna*>** promoters_to_insert );
-    void insert_promoters_at( ae_list<ae_rna*>** promoters_to_insert, int32_t pos );
+    static void invert_promoters( ae_promoter_list** promoter_lists, int32_t seq_length );
+    static void invert_promoters( ae_promoter_list** promoter_lists, int32_t pos_1, int32_t pos_2 ); // See WARNING
+    
+    inline void extract_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_promoter_list** extracted_promoters );
+    inline void extract_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list** extracted_promoters );
+    void extract_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* extracted_promoters );
+    void extract_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* extracted_promoters );
+    void extract_leading_promoters_starting_after( int32_t pos, ae_promoter_list* extracted_promoters );
+    void extract_leading_promoters_starting_before( int32_t pos, ae_promoter_list* extracted_promoters );
+    void extract_lagging_promoters_starting_before( int32_t pos, ae_promoter_list* extracted_promoters );
+    void extract_lagging_promoters_starting_after( int32_t pos, ae_promoter_list* extracted_promoters );
+    
+    static void shift_promoters( ae_promoter_list** promoters_to_shift, int32_t delta_pos, int32_t seq_length );
+    void insert_promoters( ae_promoter_list** promoters_to_insert );
+    void insert_promoters_at( ae_promoter_list** promoters_to_insert, int32_t pos );
     
     inline void remove_promoters_around( int32_t pos );
     inline void remove_promoters_around( int32_t pos_1, int32_t pos_2 );
@@ -217,10 +222,10 @@ class ae_genetic_unit : public ae_object
     //~ void duplicate_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, int32_t delta_pos );
     //~ void duplicate_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, int32_t delta_pos );
     
-    inline void copy_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** new_promoter_lists );
-    inline void copy_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** new_promoter_lists );
-    void copy_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* new_promoter_list );
-    void copy_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>* new_promoter_list );
+    inline void copy_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_promoter_list** new_promoter_lists );
+    inline void copy_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list** new_promoter_lists );
+    void copy_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* new_promoter_list );
+    void copy_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list* new_promoter_list );
     //~ inline void copy_all_promoters( ae_list** new_promoter_lists );
 
     void save( gzFile backup_file );
@@ -269,6 +274,17 @@ class ae_genetic_unit : public ae_object
     // =================================================================
     void init_statistical_data( void );
     
+    void inherit_unswitched_expression( const ae_genetic_unit* parent );
+    bool is_switched_within( ae_strand strand, int32_t pos, int32_t span ) const;
+    void transcribe_rna( ae_rna* rna );
+    void translate_rna( ae_rna* rna, std::vector<int32_t>* new_proteins = NULL );
+    void inherit_translation( ae_rna* rna, const ae_rna* parent_rna, const ae_genetic_unit* parent,
+                              const std::vector<int32_t>& new_proteins );
+    void add_protein( ae_protein* protein, ae_rna* rna );
+    void count_rna( ae_rna* rna );
+    
+    inline uint64_t get_motif( ae_strand strand, int32_t pos, int8_t size ) const;
+    
     void remove_leading_promoters_starting_between( int32_t pos_1, int32_t pos_2 );
     void remove_lagging_promoters_starting_between( int32_t pos_1, int32_t pos_2 );
     void remove_leading_promoters_starting_before( int32_t pos );
@@ -296,8 +312,9 @@ class ae_genetic_unit : public ae_object
     ae_fuzzy_set*   _phenotypic_contribution;
     // NB : _phenotypic_contribution is only an indicative value, not used for the whole phenotype computation
     
-    ae_list<ae_rna*>**     _rna_list;
+    ae_promoter_list**     _rna_list;
     ae_list<ae_protein*>** _protein_list;
+    ae_protein_map**       _protein_map;  // Proteins of each strand indexed by Shine-Dalgarno position
 
     // DM: For plasmid work, we sometimes *need* all the data (e.g. fitness, secretion) calculated for each GU
     double* _dist_to_target_per_segment;
@@ -380,12 +397,12 @@ inline ae_dna* ae_genetic_unit::get_dna( void ) const
   return _dna;
 }
 
-inline ae_list<ae_rna*>** ae_genetic_unit::get_rna_list( void ) const
+inline ae_promoter_list** ae_genetic_unit::get_rna_list( void ) const
 {
   return _rna_list;
 }
 
-inline void ae_genetic_unit::set_rna_list( ae_list<ae_rna*>** new_list )
+inline void ae_genetic_unit::set_rna_list( ae_promoter_list** new_list )
 {
   _rna_list = new_list;
 } // TODO : erase that! // NOTE : Why?
@@ -399,6 +416,18 @@ inline ae_list<ae_protein*>** ae_genetic_unit::get_protein_list( void ) const
   return _protein_list;
 }
 
+/*!
+  Return the protein whose Shine-Dalgarno sequence lies at <shine_dal_pos> on <strand> (NULL if there is none)
+
+  The genetic unit must have been translated.
+*/
+inline ae_protein* ae_genetic_unit::get_protein_at( ae_strand strand, int32_t shine_dal_pos ) const
+{
+  assert( _translated );
+
+  return _protein_map[strand]->get( shine_dal_pos );
+}
+
 inline ae_fuzzy_set* ae_genetic_unit::get_activ_contribution( void ) const
 {
   return _activ_contribution;
@@ -643,12 +672,54 @@ inline void ae_genetic_unit::print_rnas( void ) const
   print_rnas( _rna_list );
 }
 
-inline /* static */ void ae_genetic_unit::print_rnas( ae_list<ae_rna*>** rnas )
+inline /* static */ void ae_genetic_unit::print_rnas( ae_promoter_list** rnas )
 {
   print_rnas( rnas[LEADING], LEADING );
   print_rnas( rnas[LAGGING], LAGGING );
 }
 
+/*!
+  Get the <size> (at most 64) bases read on <strand> from <pos> as bits, in
+  the order of the sequence: bit j is set when base pos + j is '1' on the
+  LEADING strand and when base pos - size + 1 + j is '1' on the LAGGING strand.
+  
+  Hence the i-th base read on the LAGGING strand is the complement of bit
+  size - 1 - i (the complement is left to the caller).
+*/
+inline uint64_t ae_genetic_unit::get_motif( ae_strand strand, int32_t pos, int8_t size ) const
+{
+  if ( strand == LEADING )
+  {
+    return _dna->get_circular_bits( pos, size );
+  }
+  else // ( strand == LAGGING )
+  {
+    return _dna->get_circular_bits( pos - size + 1, size );
+  }
+}
+
+inline int8_t ae_genetic_unit::get_codon( ae_strand strand, int32_t pos ) const
+{
+  uint64_t motif = get_motif( strand, pos, CODON_SIZE );
+  int8_t   codon = 0;
+
+  if ( strand == LEADING )
+  {
+    // The first base read is the most significant one
+    for ( int8_t i = 0 ; i < CODON_SIZE ; i++ )
+    {
+      codon |= ( ( motif >> i ) & 1 ) << ( CODON_SIZE - i - 1 );
+    }
+  }
+  else // ( strand == LAGGING )
+  {
+    // The bases are already in the right order, only the complement is needed
+    codon = ~motif & ( ( 1 << CODON_SIZE ) - 1 );
+  }
+
+  return codon;
+}
+
 inline bool ae_genetic_unit::is_start( ae_strand strand, int32_t index ) const
 {
   return ( get_codon( strand, index ) == CODON_START );
@@ -671,7 +742,7 @@ inline void ae_genetic_unit::move_all_promoters_after( int32_t pos, int32_t delt
   move_all_lagging_promoters_after( pos, delta_pos );
 }
 
-inline void ae_genetic_unit::extract_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** extracted_promoters )
+inline void ae_genetic_unit::extract_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_promoter_list** extracted_promoters )
 {
   assert( pos_1 >= 0 && pos_1 < pos_2 && pos_2 <= _dna->get_length() );
   if ( pos_2 - pos_1 >= PROM_SIZE )
@@ -681,7 +752,7 @@ inline void ae_genetic_unit::extract_promoters_included_in( int32_t pos_1, int32
   }
 }
 
-inline void ae_genetic_unit::extract_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** extracted_promoters )
+inline void ae_genetic_unit::extract_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list** extracted_promoters )
 {
   extract_leading_promoters_starting_between( pos_1, pos_2, extracted_promoters[LEADING] );
   extract_lagging_promoters_starting_between( pos_1, pos_2, extracted_promoters[LAGGING] );
@@ -810,7 +881,7 @@ inline void ae_genetic_unit::look_for_new_promoters_around( int32_t pos_1, int32
   //~ duplicate_lagging_promoters_starting_between( pos_1, pos_2, delta_pos );
 //~ }
 
-inline void ae_genetic_unit::copy_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** new_promoter_lists )
+inline void ae_genetic_unit::copy_promoters_included_in( int32_t pos_1, int32_t pos_2, ae_promoter_list** new_promoter_lists )
 {
   if ( ae_utils::mod( pos_2 - pos_1 - 1, _dna->get_length() ) + 1 >= PROM_SIZE )
   {
@@ -819,13 +890,13 @@ inline void ae_genetic_unit::copy_promoters_included_in( int32_t pos_1, int32_t
   }
 }
 
-inline void ae_genetic_unit::copy_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_list<ae_rna*>** new_promoter_lists )
+inline void ae_genetic_unit::copy_promoters_starting_between( int32_t pos_1, int32_t pos_2, ae_promoter_list** new_promoter_lists )
 {
   copy_leading_promoters_starting_between( pos_1, pos_2, new_promoter_lists[LEADING] );
   copy_lagging_promoters_starting_between( pos_1, pos_2, new_promoter_lists[LAGGING] );
 }
 
-//~ inline void ae_genetic_unit::copy_all_promoters( ae_list<ae_rna*>** new_promoter_lists )
+//~ inline void ae_genetic_unit::copy_all_promoters( ae_promoter_list** new_promoter_lists )
 //~ {
   //~ ae_list_node<ae_rna*>* rna_node = NULL;
   
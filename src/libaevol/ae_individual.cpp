@@ -48,6 +48,7 @@
 #include <ae_population.h>
 #include <ae_vis_a_vis.h>
 #include <ae_utils.h>
+#include <ae_profiler.h>
 
 #ifdef __NO_X
   #ifdef __REGUL
@@ -220,7 +221,13 @@ ae_individual::ae_individual( ae_exp_manager* exp_m, gzFile backup_file )
   // Retrieve the PRNGs
   #ifdef DISTRIBUTED_PRNG
     _mut_prng   = new ae_jumping_mt( backup_file );
-    _stoch_prng = new ae_jumping_mt( backup_file );
+    _stoch_prng = NULL;
+    int8_t tmp_with_stoch;
+    gzread( backup_file, &tmp_with_stoch, sizeof(tmp_with_stoch) );
+    if ( tmp_with_stoch )
+    {
+      _stoch_prng = new ae_jumping_mt( backup_file );
+    }
   #else
     _mut_prng   = exp_m->get_pop()->get_mut_prng();
     _stoch_prng = exp_m->get_pop()->get_stoch_prng();
@@ -354,7 +361,7 @@ ae_individual::ae_individual( const ae_individual &model )
   // PRNGs
   #ifdef DISTRIBUTED_PRNG
     _mut_prng   = new ae_jumping_mt( *(model._mut_prng) );
-    _stoch_prng = new ae_jumping_mt( *(model._stoch_prng) );
+    _stoch_prng = ( model._stoch_prng == NULL ) ? NULL : new ae_jumping_mt( *(model._stoch_prng) );
   #else
     _mut_prng   = model._mut_prng;
     _stoch_prng = model._stoch_prng;
@@ -491,6 +498,8 @@ ae_individual::ae_individual( const ae_individual &model )
   The location of promoters will be copied but no further process will be performed.
 
   The phenotype and the fitness are not set, neither is the statistical data.
+
+  With DISTRIBUTED_PRNG, the new individual takes ownership of the PRNGs.
 */
 ae_individual::ae_individual( ae_individual* const parent, int32_t id, ae_jumping_mt* mut_prng, ae_jumping_mt* stoch_prng )
 {
@@ -552,7 +561,7 @@ ae_individual::ae_individual( ae_individual* const parent, int32_t id, ae_jumpin
   }
 
   // Create a new replication report to store mutational events
-  if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() == NORMAL )
+  if ( _exp_m->get_output_m()->get_record_tree() && _exp_m->get_output_m()->get_tree_mode() != LIGHT )
   {
     _replic_report = new ae_replication_report( this, parent );
     
@@ -731,28 +740,16 @@ void ae_individual::compute_distance_to_target( ae_environment* envir )
   
   if ( ! _phenotype_computed ) compute_phenotype();
   
-  // Compute the difference between the (whole) phenotype and the environment
-  ae_fuzzy_set* delta = new ae_fuzzy_set( *_phenotype );
-  delta->sub( envir );
-  
   ae_env_segment** segments = envir->get_segments();
   _dist_to_target_by_segment = new double [envir->get_nb_segments()];
-  for ( int8_t i = 0 ; i < envir->get_nb_segments() ; i++ )
-  {
-    _dist_to_target_by_segment[i] = 0;
-  }
   
-  // TODO : We should take into account that we compute the areas in order (from the leftmost segment, rightwards)
-  //   => We shouldn't parse the whole list of points on the left of the segment we are considering (we have 
-  //      already been through them!)
+  // Compute the areas between the phenotype and the environment on all the segments in a single pass
+  _phenotype->get_distance_by_segment( envir, envir->get_nb_segments(), segments, _dist_to_target_by_segment );
   
   for ( int16_t i = 0 ; i < envir->get_nb_segments() ; i++ )
   {
-    _dist_to_target_by_segment[i] = delta->get_geometric_area( segments[i]->start, segments[i]->stop );
     _dist_to_target_by_feature[segments[i]->feature] += _dist_to_target_by_segment[i];
   }
-  
-  delete delta;
 }
 
 /*!
@@ -844,6 +841,98 @@ void ae_individual::compute_fitness( ae_environment* envir )
   #endif
 }
 
+/*!
+  \brief Copy the expression of the genetic units that have not been modified since this
+  individual was copied from <parent>, instead of recomputing it on evaluation. The genetic
+  units that have only undergone switches only recompute the RNAs and proteins they affect.
+  
+  See ae_genetic_unit::inherit_expression.
+*/
+void ae_individual::inherit_expression( const ae_individual* parent )
+{
+  if ( _genetic_unit_list->get_nb_elts() != parent->_genetic_unit_list->get_nb_elts() ) return;
+  
+  ae_list_node<ae_genetic_unit*>* gen_unit_node         = _genetic_unit_list->get_first();
+  ae_list_node<ae_genetic_unit*>* parent_gen_unit_node  = parent->_genetic_unit_list->get_first();
+  
+  while ( gen_unit_node != NULL )
+  {
+    gen_unit_node->get_obj()->inherit_expression( parent_gen_unit_node->get_obj() );
+    
+    gen_unit_node         = gen_unit_node->get_next();
+    parent_gen_unit_node  = parent_gen_unit_node->get_next();
+  }
+}
+
+/*!
+  \brief Take over the evaluation of <parent> (phenotype, distance to target and fitness)
+  if none of the genetic units has been modified since this individual was copied from it.
+  
+  Returns whether it did, in which case the individual is evaluated. The expression of the
+  genetic units is inherited as well (see inherit_expression), as are the non-coding
+  statistics if they were computed for the parent.
+  
+  This is only done when the fitness depends on nothing but the phenotype, i.e. when there
+  is no secretion and the environment neither varies nor is noisy.
+*/
+bool ae_individual::inherit_evaluation( const ae_individual* parent )
+{
+  ae_environment* envir = _exp_m->get_env();
+  
+  if ( _evaluated || ! parent->_evaluated || parent->_dist_to_target_by_segment == NULL ) return false;
+  if ( _exp_m->get_with_secretion() ) return false;
+  if ( envir->get_var_method() != NO_VAR || envir->is_noise_allowed() ) return false;
+  if ( _genetic_unit_list->get_nb_elts() != parent->_genetic_unit_list->get_nb_elts() ) return false;
+  
+  ae_list_node<ae_genetic_unit*>* gen_unit_node = _genetic_unit_list->get_first();
+  while ( gen_unit_node != NULL )
+  {
+    if ( gen_unit_node->get_obj()->get_dna()->is_modified() ) return false;
+    gen_unit_node = gen_unit_node->get_next();
+  }
+  
+  // Expression (this only gathers the RNAs and proteins of the genetic units)
+  inherit_expression( parent );
+  do_transcription_translation_folding();
+  
+  // Phenotype
+  _phenotype_activ    = new ae_fuzzy_set( *(parent->_phenotype_activ) );
+  _phenotype_inhib    = new ae_fuzzy_set( *(parent->_phenotype_inhib) );
+  _phenotype          = new ae_phenotype( this, *(parent->_phenotype) );
+  _phenotype_computed = true;
+  
+  // Distance to target and fitness
+  _dist_to_target_by_segment = new double [envir->get_nb_segments()];
+  memcpy( _dist_to_target_by_segment, parent->_dist_to_target_by_segment, envir->get_nb_segments() * sizeof(double) );
+  for ( int8_t i = 0 ; i < NB_FEATURES ; i++ )
+  {
+    _dist_to_target_by_feature[i] = parent->_dist_to_target_by_feature[i];
+    _fitness_by_feature[i]        = parent->_fitness_by_feature[i];
+  }
+  _fitness = parent->_fitness;
+  _distance_to_target_computed  = true;
+  _fitness_computed             = true;
+  
+  // Non-coding statistics
+  if ( parent->_non_coding_computed )
+  {
+    _nb_bases_in_0_CDS                  = parent->_nb_bases_in_0_CDS;
+    _nb_bases_in_0_functional_CDS       = parent->_nb_bases_in_0_functional_CDS;
+    _nb_bases_in_0_non_functional_CDS   = parent->_nb_bases_in_0_non_functional_CDS;
+    _nb_bases_in_0_RNA                  = parent->_nb_bases_in_0_RNA;
+    _nb_bases_in_0_coding_RNA           = parent->_nb_bases_in_0_coding_RNA;
+    _nb_bases_in_0_non_coding_RNA       = parent->_nb_bases_in_0_non_coding_RNA;
+    _nb_bases_in_neutral_regions        = parent->_nb_bases_in_neutral_regions;
+    _nb_neutral_regions                 = parent->_nb_neutral_regions;
+    _non_coding_computed                = true;
+  }
+  
+  // Whatever has not been inherited (contributions of the genetic units to the fitness)
+  evaluate( envir );
+  
+  return true;
+}
+
 void ae_individual::reevaluate( ae_environment* envir /*= NULL*/ )
 {
   // useful for post-treatment programs that replay mutations
@@ -907,27 +996,19 @@ void ae_individual::reevaluate( ae_environment* envir /*= NULL*/ )
   _protein_list->erase( false ); 
   
   ae_list_node<ae_genetic_unit*>* gen_unit_node = _genetic_unit_list->get_first();
-  ae_list_node<ae_rna*>* rna_node = NULL;
-  ae_rna*           rna = NULL;
   ae_genetic_unit*  gen_unit = NULL;
   
   while ( gen_unit_node != NULL )
     {
       gen_unit = gen_unit_node->get_obj();
 
-      rna_node = (gen_unit->get_rna_list()[LEADING])->get_first();
-      while(rna_node !=NULL)
+      for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
       {
-        rna = rna_node->get_obj();
-        rna->get_transcribed_proteins()->erase( false );
-        rna_node = rna_node->get_next();
-      }
-      rna_node = (gen_unit->get_rna_list()[LAGGING])->get_first();
-      while(rna_node !=NULL)
-      {
-        rna = rna_node->get_obj();
-        rna->get_transcribed_proteins()->erase( false );
-        rna_node = rna_node->get_next();
+        ae_promoter_list* rnas = gen_unit->get_rna_list()[strand];
+        for ( int32_t i = 0 ; i < rnas->get_nb_elts() ; i++ )
+        {
+          rnas->get_rna( i )->get_transcribed_proteins()->erase( false );
+        }
       }
       
       (gen_unit->get_protein_list()[LEADING])->erase( true );
@@ -967,6 +1048,7 @@ void ae_individual::do_transcription( void )
 {
   if ( _transcribed == true ) return; // Transcription has already been performed, nothing to do.
   _transcribed = true;
+  PROFILE_SCOPE( TRANSCRIPTION );
   
   ae_list_node<ae_genetic_unit*>* gen_unit_node = _genetic_unit_list->get_first();
   ae_genetic_unit*  gen_unit;
@@ -976,8 +1058,7 @@ void ae_individual::do_transcription( void )
     gen_unit = gen_unit_node->get_obj();
     
     gen_unit->do_transcription();
-    _rna_list->add_list( gen_unit->get_rna_list()[LEADING] );
-    _rna_list->add_list( gen_unit->get_rna_list()[LAGGING] );
+    add_rnas( gen_unit );
      
     gen_unit_node = gen_unit_node->get_next();
   }
@@ -988,6 +1069,7 @@ void ae_individual::do_translation( void )
   if ( _translated == true ) return; // ARNs have already been translated, nothing to do.
   _translated = true;
   if ( _transcribed == false ) do_transcription();
+  PROFILE_SCOPE( TRANSLATION );
   
   ae_list_node<ae_genetic_unit*>* gen_unit_node = _genetic_unit_list->get_first();
   ae_genetic_unit*  gen_unit;
@@ -1009,6 +1091,7 @@ void ae_individual::do_folding( void )
   if ( _folded == true ) return; // Proteins have already been folded, nothing to do.
   _folded = true;
   if ( _translated == false ) do_translation();
+  PROFILE_SCOPE( PHENOTYPE );
   
   ae_list_node<ae_genetic_unit*>* gen_unit_node = _genetic_unit_list->get_first();
   ae_genetic_unit*  gen_unit;
@@ -1040,6 +1123,7 @@ void ae_individual::evaluate( ae_environment* envir /*= NULL*/ )
   // ----------------------------------------------------------------------
   // 2) Compute phenotype and compare it to the environment => fitness
   // ----------------------------------------------------------------------
+  PROFILE_SCOPE( PHENOTYPE );
   compute_phenotype();
   compute_distance_to_target( envir );
   compute_fitness( envir );
@@ -1085,6 +1169,7 @@ void ae_individual::compute_statistical_data( void )
 {
   if ( _statistical_data_computed ) return; // Statistical data has already been computed, nothing to do.
   _statistical_data_computed = true;
+  PROFILE_SCOPE( STATS );
   
   if ( not _phenotype_computed )
   {
@@ -1153,6 +1238,20 @@ void ae_individual::compute_non_coding( void )
   }
 }
 
+#ifdef DISTRIBUTED_PRNG
+/*!
+  Make the individual's PRNGs jump ahead
+
+  This is to be done each time one of its PRNGs is copied, so that the copy
+  and the original do not draw the same numbers.
+*/
+void ae_individual::do_prng_jump( void )
+{
+  _mut_prng->jump();
+  if ( _stoch_prng != NULL ) _stoch_prng->jump();
+}
+#endif
+
 void ae_individual::save( gzFile backup_file ) const
 {
   // Write the "age" of the strain
@@ -1161,7 +1260,12 @@ void ae_individual::save( gzFile backup_file ) const
   #ifdef DISTRIBUTED_PRNG
     // Write the PRNG's state
     _mut_prng->save( backup_file );
-    _stoch_prng->save( backup_file );
+    int8_t tmp_with_stoch = _stoch_prng == NULL ? 0 : 1;
+    gzwrite( backup_file, &tmp_with_stoch, sizeof(tmp_with_stoch) );
+    if ( tmp_with_stoch )
+    {
+      _stoch_prng->save( backup_file );
+    }
   #endif
   
   // Write id and rank
@@ -1524,9 +1628,23 @@ void ae_individual::make_rna_list( void )
   {
     gen_unit = gen_unit_node->get_obj();
     
-    _rna_list->add_list( gen_unit->get_rna_list()[LEADING] );
-    _rna_list->add_list( gen_unit->get_rna_list()[LAGGING] );
+    add_rnas( gen_unit );
     
     gen_unit_node = gen_unit_node->get_next();
   }
 }
+
+/*!
+  Append the RNAs of both strands of gen_unit to the individual's RNA list
+*/
+void ae_individual::add_rnas( ae_genetic_unit* gen_unit )
+{
+  for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
+  {
+    ae_promoter_list* rnas = gen_unit->get_rna_list()[strand];
+    for ( int32_t i = 0 ; i < rnas->get_nb_elts() ; i++ )
+    {
+      _rna_list->add( rnas->get_rna( i ) );
+    }
+  }
+}
@@ -290,6 +290,8 @@ class ae_individual : public ae_object
     
     virtual void evaluate( ae_environment* envir = NULL );
     virtual void reevaluate( ae_environment* envir = NULL );
+    void inherit_expression( const ae_individual* parent );
+    bool inherit_evaluation( const ae_individual* parent );
     inline void do_transcription_translation_folding( void );
     void do_transcription( void );
     void do_translation( void );
@@ -307,6 +309,10 @@ class ae_individual : public ae_object
 
     virtual void save( gzFile backup_file ) const;
     
+    #ifdef DISTRIBUTED_PRNG
+      void do_prng_jump( void );
+    #endif
+    
     int32_t get_nb_terminators( void );
     
     #ifdef DEBUG
@@ -360,6 +366,7 @@ class ae_individual : public ae_object
     // =================================================================
     virtual void make_protein_list( void );
     virtual void make_rna_list( void );
+    void add_rnas( ae_genetic_unit* gen_unit );
 
     // =================================================================
     //                          Protected Attributes
@@ -1428,11 +1435,19 @@ inline void ae_individual::set_with_stochasticity( bool with_stoch )
 
 inline void ae_individual::set_stoch_prng( ae_jumping_mt* prng )
 {
+  #ifdef DISTRIBUTED_PRNG
+    // The individual owns its PRNGs
+    if ( prng != _stoch_prng ) delete _stoch_prng;
+  #endif
   _stoch_prng = prng;
 }
 
 inline void ae_individual::set_mut_prng( ae_jumping_mt* prng )
 {
+  #ifdef DISTRIBUTED_PRNG
+    // The individual owns its PRNGs
+    if ( prng != _mut_prng ) delete _mut_prng;
+  #endif
   _mut_prng = prng;
 }
 
@@ -623,7 +623,6 @@ void ae_individual_X11::display_rnas( ae_X11_window* win )
   // ---------------
   //  Draw each RNA
   // ---------------
-  ae_list_node<ae_rna*>* rna_node  = NULL;
   ae_rna*       rna       = NULL;
 
   // NB : As we want OriC to be at the "top" of the circle and the orientation
@@ -640,11 +639,9 @@ void ae_individual_X11::display_rnas( ae_X11_window* win )
   // ----------------
   //  LEADING strand
   // ----------------
-  rna_node = gen_unit->get_rna_list()[LEADING]->get_first();
-
-  while ( rna_node != NULL )
+  for ( int32_t rna_ind = 0 ; rna_ind < gen_unit->get_rna_list()[LEADING]->get_nb_elts() ; rna_ind++ )
   {
-    rna = rna_node->get_obj();
+    rna = gen_unit->get_rna_list()[LEADING]->get_rna( rna_ind );
 
     // Alpha : angles from OriC (in degrees)
     // Theta : angles on the trigonometric circle (in degrees)
@@ -738,18 +735,14 @@ void ae_individual_X11::display_rnas( ae_X11_window* win )
     win->fill_arc( pos_x, pos_y, arrow_thick, ae_utils::mod(180+theta_last, 360), 180, color );
     
     delete [] color;
-
-    rna_node = rna_node->get_next();
   }
 
   // ----------------
   //  LAGGING strand
   // ----------------
-  rna_node = gen_unit->get_rna_list()[LAGGING]->get_first();
-
-  while ( rna_node != NULL )
+  for ( int32_t rna_ind = 0 ; rna_ind < gen_unit->get_rna_list()[LAGGING]->get_nb_elts() ; rna_ind++ )
   {
-    rna = rna_node->get_obj();
+    rna = gen_unit->get_rna_list()[LAGGING]->get_rna( rna_ind );
 
     // Alpha : angles from OriC (in degrees)
     // Theta : angles on the trigonometric circle (in degrees)
@@ -843,8 +836,6 @@ void ae_individual_X11::display_rnas( ae_X11_window* win )
     win->fill_arc( pos_x, pos_y, arrow_thick, theta_last, 180, color );
     
     delete [] color;
-
-    rna_node = rna_node->get_next();
   }
 }
 
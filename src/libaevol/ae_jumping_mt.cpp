@@ -30,8 +30,10 @@
 // =================================================================
 //                              Libraries
 // =================================================================
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <vector>
 
 
 
@@ -53,8 +55,6 @@
 // =================================================================
 //                    Definition of static attributes
 // =================================================================
-int32_t ae_jumping_mt::nb_jumps   = 0;
-double  ae_jumping_mt::jump_time  = 0;
 
 // =================================================================
 //                             Constructors
@@ -66,6 +66,10 @@ ae_jumping_mt::ae_jumping_mt( const uint32_t& simple_seed )
 {
   _sfmt = new sfmt_t();
   sfmt_init_gen_rand( _sfmt, simple_seed );
+  #ifdef BUFFERED_PRNG
+    init_buffer();
+    load_buffer();
+  #endif
   
   // Jump to get rid of the initializatino skew
   jump();
@@ -77,8 +81,15 @@ ae_jumping_mt::ae_jumping_mt( const uint32_t& simple_seed )
 ae_jumping_mt::ae_jumping_mt( const ae_jumping_mt& model )
 {
   _sfmt = new sfmt_t();
-  memcpy(_sfmt->state, model._sfmt->state, SFMT_N*sizeof(_sfmt->state[0]));
-  _sfmt->idx = model._sfmt->idx;
+  #ifdef BUFFERED_PRNG
+    // Only the block of the model's current position is copied
+    init_buffer();
+    model.get_unbuffered_state( _sfmt );
+    load_buffer();
+  #else
+    memcpy(_sfmt->state, model._sfmt->state, SFMT_N*sizeof(_sfmt->state[0]));
+    _sfmt->idx = model._sfmt->idx;
+  #endif
 }
 
 /*!
@@ -89,6 +100,10 @@ ae_jumping_mt::ae_jumping_mt( gzFile backup_file )
   _sfmt = new sfmt_t();
   gzread( backup_file, _sfmt->state, SFMT_N * sizeof( _sfmt->state[0] ) );
   gzread( backup_file, &(_sfmt->idx), sizeof( _sfmt->idx ) );
+  #ifdef BUFFERED_PRNG
+    init_buffer();
+    load_buffer();
+  #endif
 }
 
 // =================================================================
@@ -97,6 +112,9 @@ ae_jumping_mt::ae_jumping_mt( gzFile backup_file )
 ae_jumping_mt::~ae_jumping_mt( void )
 {
   delete _sfmt;
+  #ifdef BUFFERED_PRNG
+    free( _buffer );
+  #endif
 }
 
 // =================================================================
@@ -104,11 +122,18 @@ ae_jumping_mt::~ae_jumping_mt( void )
 // =================================================================
 /*!
   Jump Ahead by a predefined jump length
+
+  This only modifies the state of this generator, distinct generators can
+  hence jump concurrently.
+
+  With BUFFERED_PRNG, the jump starts from the position of the next number to
+  be served and the numbers left in the buffer are discarded.
  */
 void ae_jumping_mt::jump( void )
 {
-  //~ clock_t start, end;
-  //~ start = clock();
+  #ifdef BUFFERED_PRNG
+    get_unbuffered_state( _sfmt );
+  #endif
   
   #ifdef TRIVIAL_METHOD_JUMP_SIZE
     for ( int i = 0 ; i < TRIVIAL_METHOD_JUMP_SIZE ; i++ )
@@ -118,19 +143,68 @@ void ae_jumping_mt::jump( void )
   #else
     SFMT_jump( _sfmt, jump_poly );
   #endif
-    
-    
-  //~ int nb_sup_steps = 100 * (double)rand() / ((double)RAND_MAX + 1);
-  //~ for ( int i = 0 ; i < nb_sup_steps ; i++ )
-  //~ {
-    //~ sfmt_genrand_real2( _sfmt );
-  //~ }
-    
   
+  #ifdef BUFFERED_PRNG
+    load_buffer();
+  #endif
+}
+
+/*!
+  Fill <uniforms> with <nb> doubles in [0, 1) with a uniform distribution
+
+  The numbers are exactly those that <nb> successive calls to random() would
+  return, and the generator is left in the same state, but all the whole
+  blocks of the generator they span are generated at once with the bulk
+  generator of SFMT (sfmt_fill_array32).
+ */
+void ae_jumping_mt::random_array( double* uniforms, int32_t nb )
+{
+  int32_t i = 0;
   
-  //~ end = clock();
-  //~ jump_time += (end - start) * 1000 / CLOCKS_PER_SEC;
-  //~ nb_jumps++;
+  #ifdef BUFFERED_PRNG
+    // The buffer is already filled by the bulk generator
+    while ( i < nb )
+    {
+      if ( _buffer_pos == _buffer_size ) refill_buffer();
+      
+      int32_t nb_served = _buffer_size - _buffer_pos;
+      if ( nb_served > nb - i ) nb_served = nb - i;
+      for ( int32_t j = 0 ; j < nb_served ; j++ )
+      {
+        uniforms[i++] = sfmt_to_real2( _buffer[_buffer_pos++] );
+      }
+    }
+  #else
+    // Use up what is left of the current block of the generator
+    while ( i < nb && _sfmt->idx < SFMT_N32 )
+    {
+      uniforms[i++] = sfmt_genrand_real2( _sfmt );
+    }
+    
+    // Whole blocks of the generator (the bulk generator needs at least one and a
+    // multiple of 4 numbers): the state it leaves (the last SFMT_N32 numbers it
+    // generated) is then a block, as with random(), rather than a shifted one
+    int32_t nb_bulk = ( ( nb - i ) / SFMT_N32 ) * SFMT_N32;
+    if ( nb_bulk > 0 )
+    {
+      // SFMT generates 128-bit words, the bulk generator fills arrays of them
+      static thread_local std::vector<w128_t> block;
+      if ( (int32_t) block.size() < nb_bulk / 4 ) block.resize( nb_bulk / 4 );
+      
+      uint32_t* numbers = block[0].u;
+      sfmt_fill_array32( _sfmt, numbers, nb_bulk );
+      for ( int32_t j = 0 ; j < nb_bulk ; j++ )
+      {
+        uniforms[i++] = sfmt_to_real2( numbers[j] );
+      }
+    }
+    
+    // Remaining numbers (less than a block)
+    while ( i < nb )
+    {
+      uniforms[i++] = sfmt_genrand_real2( _sfmt );
+    }
+  #endif
 }
 
 /*!
@@ -327,10 +401,26 @@ void ae_jumping_mt::multinomial_drawing( int32_t* destination, double* source, i
   destination[nb_colors-1] = n;
 }
 
+/*!
+  Write the generator into a gz backup file
+
+  The backup only depends on the position of the generator in its sequence
+  (how many numbers it has served since it was seeded or jumped), not on how
+  they were drawn (random, random_array...). With BUFFERED_PRNG, the position
+  in the buffer is saved as the state an unbuffered generator would be in:
+  backups are the same, and can be resumed, with or without buffering.
+ */
 void ae_jumping_mt::save( gzFile backup_file ) const
 {
-  gzwrite( backup_file, _sfmt->state, SFMT_N * sizeof( _sfmt->state[0] ) );
-  gzwrite( backup_file, &(_sfmt->idx), sizeof( _sfmt->idx ) );
+  #ifdef BUFFERED_PRNG
+    sfmt_t sfmt;
+    get_unbuffered_state( &sfmt );
+    gzwrite( backup_file, sfmt.state, SFMT_N * sizeof( sfmt.state[0] ) );
+    gzwrite( backup_file, &(sfmt.idx), sizeof( sfmt.idx ) );
+  #else
+    gzwrite( backup_file, _sfmt->state, SFMT_N * sizeof( _sfmt->state[0] ) );
+    gzwrite( backup_file, &(_sfmt->idx), sizeof( _sfmt->idx ) );
+  #endif
 }
 
 
@@ -364,6 +454,71 @@ double ae_jumping_mt::gammln( double X )
   return -tmp + log(2.5066282746310005 * ser / x); 
 }
 
+#ifdef BUFFERED_PRNG
+/*!
+  Allocate the (cache-aligned) buffer
+ */
+void ae_jumping_mt::init_buffer( void )
+{
+  if ( posix_memalign( (void**) &_buffer, MT_BUFFER_ALIGN, MT_BUFFER_SIZE * sizeof( *_buffer ) ) != 0 )
+  {
+    printf( "%s:%d: error: could not allocate the buffer of the generator.\n", __FILE__, __LINE__ );
+    exit( EXIT_FAILURE );
+  }
+}
+
+/*!
+  Make _sfmt, which must hold an unbuffered state, the buffered one
+
+  The block of the generator is moved into the buffer, the numbers it has
+  left will be served first.
+ */
+void ae_jumping_mt::load_buffer( void )
+{
+  memcpy( _buffer, _sfmt->state, SFMT_N32 * sizeof( *_buffer ) );
+  _buffer_size  = SFMT_N32;
+  _buffer_pos   = _sfmt->idx;
+  _sfmt->idx    = SFMT_N32;
+}
+
+/*!
+  Fill the buffer with the next blocks of the generator
+
+  Many generators (e.g. the individuals' mutation PRNGs) only serve a few
+  numbers: the number of blocks generated starts at 2 and doubles with each
+  refill, up to the capacity of the buffer.
+ */
+void ae_jumping_mt::refill_buffer( void )
+{
+  int32_t size = 2 * _buffer_size;
+  if ( size > MT_BUFFER_SIZE ) size = MT_BUFFER_SIZE;
+  
+  sfmt_fill_array32( _sfmt, _buffer, size );
+  _buffer_size  = size;
+  _buffer_pos   = 0;
+}
+
+/*!
+  Write into sfmt the state an unbuffered generator would be in
+
+  That is the block of the buffer holding the next number to be served (or the
+  previous one with no number left when the next number starts a block).
+ */
+void ae_jumping_mt::get_unbuffered_state( sfmt_t* sfmt ) const
+{
+  int32_t block = _buffer_pos / SFMT_N32;
+  int32_t idx   = _buffer_pos % SFMT_N32;
+  if ( idx == 0 && block > 0 )
+  {
+    block--;
+    idx = SFMT_N32;
+  }
+  
+  memcpy( sfmt->state, &_buffer[block * SFMT_N32], SFMT_N32 * sizeof( *_buffer ) );
+  sfmt->idx = idx;
+}
+#endif
+
 // =================================================================
 //                          Non inline accessors
 // =================================================================
@@ -59,6 +59,13 @@
 #define MT_RAND_MAX         4294967295.0
 #define MT_RAND_MAX_PLUS_1  4294967296.0
 
+#ifdef BUFFERED_PRNG
+  // Capacity (in 32-bit numbers) of the output buffer of the generators:
+  // the smallest whole number of SFMT blocks holding 1024 numbers (4 KiB)
+  #define MT_BUFFER_SIZE  ( ( ( 1024 + SFMT_N32 - 1 ) / SFMT_N32 ) * SFMT_N32 )
+  #define MT_BUFFER_ALIGN 64  // Buffers are aligned on a cache line
+#endif
+
 
 
 
@@ -98,6 +105,7 @@ class ae_jumping_mt : public ae_object
     inline int16_t  random( int16_t max );  // ~
     inline int32_t  random( int32_t max );  // ~ > Integer in [0, max[ (uniform distribution)
     inline int64_t  random( int64_t max );  // ~
+    void            random_array( double* uniforms, int32_t nb ); // Fill uniforms with nb doubles in [0, 1[ (same as nb calls to random())
     int32_t         binomial_random( int32_t nb, double prob ); // Binomial drawing of parameters (nb, prob)
     double          gaussian_random( void );                    // Double following a Standard Normal distribution
     int8_t          roulette_random( double* probs, int8_t nb_elts ); // Roulette selection
@@ -111,8 +119,6 @@ class ae_jumping_mt : public ae_object
     // =================================================================
     //                           Public Attributes
     // =================================================================
-    static int32_t nb_jumps;
-    static double  jump_time;
 
 
 
@@ -139,11 +145,26 @@ class ae_jumping_mt : public ae_object
     //                           Protected Methods
     // =================================================================
     static double gammln( double X );
+    #ifdef BUFFERED_PRNG
+      void init_buffer( void );
+      void load_buffer( void );
+      void refill_buffer( void );
+      void get_unbuffered_state( sfmt_t* sfmt ) const;
+    #endif
 
     // =================================================================
     //                          Protected Attributes
     // =================================================================
     sfmt_t* _sfmt;
+    
+    #ifdef BUFFERED_PRNG
+      // Numbers are served from _buffer, which holds whole blocks of the
+      // generator. _sfmt is then always at the end of _buffer (its state is
+      // the last block of _buffer) with no number left (idx == SFMT_N32)
+      uint32_t* _buffer;
+      int32_t   _buffer_size; // Number of numbers in _buffer (multiple of SFMT_N32)
+      int32_t   _buffer_pos;  // Index of the next number to be served
+    #endif
 };
 
 
@@ -167,7 +188,12 @@ class ae_jumping_mt : public ae_object
  */
 inline double ae_jumping_mt::random( void )
 {
-  return sfmt_genrand_real2( _sfmt );
+  #ifdef BUFFERED_PRNG
+    if ( _buffer_pos == _buffer_size ) refill_buffer();
+    return sfmt_to_real2( _buffer[_buffer_pos++] );
+  #else
+    return sfmt_genrand_real2( _sfmt );
+  #endif
 }
 
 /*!
@@ -175,7 +201,7 @@ inline double ae_jumping_mt::random( void )
  */
 inline int8_t ae_jumping_mt::random( int8_t max )
 {
-  return (int8_t) floor( ((double)max) * sfmt_genrand_real2(_sfmt) );
+  return (int8_t) floor( ((double)max) * random() );
 }
 
 /*!
@@ -183,7 +209,7 @@ inline int8_t ae_jumping_mt::random( int8_t max )
  */
 inline int16_t ae_jumping_mt::random( int16_t max )
 {
-  return (int16_t) floor( ((double)max) * sfmt_genrand_real2(_sfmt) );
+  return (int16_t) floor( ((double)max) * random() );
 }
 
 /*!
@@ -191,7 +217,7 @@ inline int16_t ae_jumping_mt::random( int16_t max )
  */
 inline int32_t ae_jumping_mt::random( int32_t max )
 {
-  return (int32_t) floor( ((double)max) * sfmt_genrand_real2(_sfmt) );
+  return (int32_t) floor( ((double)max) * random() );
 }
 
 /*!
@@ -199,7 +225,7 @@ inline int32_t ae_jumping_mt::random( int32_t max )
  */
 inline int64_t ae_jumping_mt::random( int64_t max )
 {
-  return (int64_t) floor( ((double)max) * sfmt_genrand_real2(_sfmt) );
+  return (int64_t) floor( ((double)max) * random() );
 }
 
 
@@ -35,6 +35,8 @@
 #include <string.h>
 #include <assert.h>
 
+#include <ae_pool.h>
+
 
 
 template <typename T>
@@ -56,6 +58,10 @@ class ae_list_node
     inline ae_list_node( const ae_list_node &model );
     
     virtual inline ~ae_list_node( void );
+    
+    // Nodes are allocated in the small object pool (see ae_pool)
+    static void* operator new( size_t size )              { return ae_pool::allocate( size ); };
+    static void  operator delete( void* ptr, size_t size ) { ae_pool::release( ptr, size ); };
 
     inline T&             get_obj( void );
     inline ae_list_node*  get_prev( void );
@@ -86,6 +92,10 @@ class ae_list
     //~ inline ae_list( ae_list* parent );
     /*inline ae_list( const ae_list &model );*/
     inline virtual ~ae_list();
+    
+    // Lists are allocated in the small object pool (see ae_pool)
+    static void* operator new( size_t size )              { return ae_pool::allocate( size ); };
+    static void  operator delete( void* ptr, size_t size ) { ae_pool::release( ptr, size ); };
 
     // Add obj in a newly created node at the end (resp beginning) of the list
     // => syntaxic sugar for add_after( obj, _last );
@@ -61,6 +61,7 @@
 #define SP_STRUCT_FNAME_FORMAT    SP_STRUCT_DIR"/"SP_STRUCT_FNAME_BASE".ae"
 // Stats
 #define STATS_DIR   "stats"
+#define PROFILE_FNAME STATS_DIR"/profile.out"
 // Tree
 #define TREE_DIR    "tree"
 // Last gener file
@@ -71,6 +72,21 @@
 
 #define FIXED_POPULATION_SIZE // Some calculation can be spared if we know that the size of the population is fixed
 
+#define GRID_TILE_SIZE  INT16_C(16) // Side of the square tiles in which the grid is divided for parallel processing
+#define STAT_CHUNK_SIZE INT32_C(64) // Number of individuals whose statistics are gathered by the same task
+
+#define POOL_GRANULARITY  16          // Block sizes of the small object pool are multiples of this (bytes)
+#define POOL_MAX_SIZE     512         // Larger objects are not pooled (bytes)
+#define POOL_NB_CLASSES   ( POOL_MAX_SIZE / POOL_GRANULARITY )
+#define POOL_SLAB_SIZE    ( 1 << 16 ) // Memory is obtained from the system by slabs of this size (bytes)
+#define POOL_BATCH_SIZE   64          // Number of free blocks threads exchange at once
+
+#define BACKGROUND_WRITER_QUEUE_SIZE  2     // Number of batches of output files that may wait to be written
+#define BACKGROUND_WRITER_BUFFER_SIZE ( 1 << 16 ) // Size of the chunks output files are compressed by (bytes)
+#define BACKGROUND_WRITER_SNAPSHOT_SUFFIX ".tmp" // Suffix of the files holding the uncompressed content of pending output files
+#define BACKGROUND_WRITER_PARTIAL_SUFFIX  ".part" // Suffix of output files while they are being compressed
+#define BLOCK_BACKUP_BLOCK_SIZE       ( 1 << 18 ) // Size from which the content of block backups is cut into a new block (bytes)
+
 #define PROM_SIZE       INT8_C(22)
 #define PROM_SEQ        "0101011001110010010110"
 
@@ -0,0 +1,180 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_motif_scanner.h>
+#include <ae_string.h>
+
+
+
+
+//##############################################################################
+//                                                                             #
+//                            Class ae_motif_scanner                           #
+//                                                                             #
+//##############################################################################
+
+// =================================================================
+//                    Definition of static attributes
+// =================================================================
+
+// =================================================================
+//                             Constructors
+// =================================================================
+ae_motif_scanner::ae_motif_scanner( const ae_string* seq )
+{
+  static_assert( PROM_SIZE >= TERM_SIZE, "terminators must fit in the margin of the extended sequence" );
+  
+  _length = seq->get_length();
+  
+  // The extended sequence holds PROM_SIZE bases before and after the sequence
+  // itself (for the lagging and leading strand respectively) plus a full
+  // block of slack so that the last block of candidates can be read as is
+  _nb_words = ( _length + 2 * PROM_SIZE + 64 ) / 64 + 2;
+  _bits = new uint64_t[_nb_words];
+  
+  for ( int32_t w = 0 ; w < _nb_words ; w++ )
+  {
+    _bits[w] = seq->get_circular_bits( 64 * w - PROM_SIZE, 64 );
+  }
+}
+
+// =================================================================
+//                             Destructors
+// =================================================================
+ae_motif_scanner::~ae_motif_scanner( void )
+{
+  delete [] _bits;
+}
+
+// =================================================================
+//                            Public Methods
+// =================================================================
+/*!
+  Look for promoters at positions [first, first + 64[ on the given strand.
+  
+  Bit j of the returned mask is set when there is a promoter at position
+  first + j, in which case dist[j] holds its hamming distance from the
+  consensus. Positions beyond the end of the sequence are never reported.
+*/
+uint64_t ae_motif_scanner::scan_promoters( ae_strand strand, int32_t first, int8_t* dist ) const
+{
+  static_assert( PROM_MAX_DIFF == 4, "the mismatch threshold is hardcoded for PROM_MAX_DIFF = 4" );
+  
+  uint64_t outside = 0;
+  if ( _length - first < 64 )
+  {
+    outside = ~UINT64_C(0) << ( _length - first );
+  }
+  
+  // Bit-sliced mismatch counters: the count at position first + j is made of
+  // bit j of c0 (units), c1 (twos), c2 (fours), c3 (eights) and c4 (16 and more)
+  uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0, c4 = 0;
+  uint64_t carry, mismatch, consensus;
+  
+  for ( int8_t i = 0 ; i < PROM_SIZE ; i++ )
+  {
+    consensus = ( PROM_SEQ[i] == '1' ) ? ~UINT64_C(0) : 0;
+    
+    if ( strand == LEADING )
+    {
+      mismatch = get_window( first + i + PROM_SIZE ) ^ consensus;
+    }
+    else // ( strand == LAGGING )
+    {
+      // Same as the leading strand with the complementary base
+      mismatch = ~( get_window( first - i + PROM_SIZE ) ^ consensus );
+    }
+    
+    carry = c0 & mismatch;  c0 ^= mismatch;
+    mismatch = carry;
+    carry = c1 & mismatch;  c1 ^= mismatch;
+    mismatch = carry;
+    carry = c2 & mismatch;  c2 ^= mismatch;
+    mismatch = carry;
+    carry = c3 & mismatch;  c3 ^= mismatch;
+    c4 |= carry;
+    
+    // Give up as soon as no position can be a promoter any longer
+    // (5 = 101b mismatches or more is too many)
+    if ( ( c4 | c3 | ( c2 & ( c1 | c0 ) ) | outside ) == ~UINT64_C(0) )
+    {
+      return 0;
+    }
+  }
+  
+  uint64_t found = ~( c4 | c3 | ( c2 & ( c1 | c0 ) ) | outside );
+  
+  for ( uint64_t remaining = found ; remaining != 0 ; remaining &= remaining - 1 )
+  {
+    int8_t j = __builtin_ctzll( remaining );
+    dist[j] = ( ( c0 >> j ) & 1 ) + 2 * ( ( c1 >> j ) & 1 ) + 4 * ( ( c2 >> j ) & 1 );
+  }
+  
+  return found;
+}
+
+/*!
+  Look for terminators at positions [first, first + 64[ on the leading strand.
+  
+  Bit j of the returned mask is set when there is a terminator at position
+  first + j. Positions beyond the end of the sequence are never reported.
+*/
+uint64_t ae_motif_scanner::scan_terminators( int32_t first ) const
+{
+  uint64_t found = ~UINT64_C(0);
+  if ( _length - first < 64 )
+  {
+    found = ~( ~UINT64_C(0) << ( _length - first ) );
+  }
+  
+  // Each base of the stem must differ from the base it pairs with
+  for ( int8_t i = 0 ; i < TERM_STEM_SIZE && found != 0 ; i++ )
+  {
+    found &= get_window( first + i + PROM_SIZE ) ^ get_window( first + (TERM_SIZE - 1) - i + PROM_SIZE );
+  }
+  
+  return found;
+}
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+
+// =================================================================
+//                          Non inherited methods
+// =================================================================
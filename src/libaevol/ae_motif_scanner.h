@@ -0,0 +1,183 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+/*!
+  \class ae_motif_scanner
+  
+  \brief Word-parallel search for promoters and terminators on a circular sequence
+  
+  The sequence is stored as one bit per base (in an extended copy that makes
+  the origin wrap-around transparent, read 64 bases at a time from the packed
+  copy that ae_string maintains) so that a single 64-bit operation
+  compares one base of a motif at 64 consecutive candidate positions.
+  
+  scan_promoters( strand, first, dist ) returns a mask whose bit j is set when
+  there is a promoter at position first + j on the given strand, the
+  corresponding hamming distance from the consensus being stored in dist[j].
+  The number of mismatches at each position is accumulated in bit-sliced
+  counters and a block of positions is abandoned as soon as all of them
+  exceed PROM_MAX_DIFF.
+  
+  scan_terminators( first ) does the same for terminators on the leading
+  strand. Since a terminator is its own reverse complement, there is a
+  terminator at pos on the leading strand if and only if there is one at
+  pos + TERM_SIZE - 1 on the lagging strand.
+  
+  The results are exactly those of ae_genetic_unit::is_promoter and
+  ae_genetic_unit::is_terminator.
+*/
+
+
+#ifndef __AE_MOTIF_SCANNER_H__
+#define __AE_MOTIF_SCANNER_H__
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_enums.h>
+#include <ae_macros.h>
+
+
+
+
+// =================================================================
+//                          Class declarations
+// =================================================================
+class ae_string;
+
+
+
+
+
+
+class ae_motif_scanner
+{
+  public :
+  
+    // =================================================================
+    //                             Constructors
+    // =================================================================
+    ae_motif_scanner( const ae_string* seq );
+  
+    // =================================================================
+    //                             Destructors
+    // =================================================================
+    virtual ~ae_motif_scanner( void );
+  
+    // =================================================================
+    //                              Accessors
+    // =================================================================
+    inline int32_t get_length( void ) const;
+  
+    // =================================================================
+    //                            Public Methods
+    // =================================================================
+    uint64_t scan_promoters( ae_strand strand, int32_t first, int8_t* dist ) const;
+    uint64_t scan_terminators( int32_t first ) const;
+  
+    // =================================================================
+    //                           Public Attributes
+    // =================================================================
+  
+  
+  
+  
+  
+  protected :
+  
+    // =================================================================
+    //                         Forbidden Constructors
+    // =================================================================
+    ae_motif_scanner( void )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+    ae_motif_scanner( const ae_motif_scanner &model )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+  
+    // =================================================================
+    //                           Protected Methods
+    // =================================================================
+    inline uint64_t get_window( int32_t offset ) const;
+  
+    // =================================================================
+    //                          Protected Attributes
+    // =================================================================
+    int32_t   _length;
+    uint64_t* _bits;      // Bit k holds base (k - PROM_SIZE) mod _length
+                          // (PROM_SIZE >= TERM_SIZE so that terminators fit in the margin)
+    int32_t   _nb_words;
+};
+
+
+// =====================================================================
+//                           Getters' definitions
+// =====================================================================
+inline int32_t ae_motif_scanner::get_length( void ) const
+{
+  return _length;
+}
+
+// =====================================================================
+//                           Setters' definitions
+// =====================================================================
+
+// =====================================================================
+//                          Operators' definitions
+// =====================================================================
+
+// =====================================================================
+//                       Inline functions' definition
+// =====================================================================
+/*!
+  Return the 64 bits starting at bit <offset> of the extended sequence
+*/
+inline uint64_t ae_motif_scanner::get_window( int32_t offset ) const
+{
+  int32_t word  = offset >> 6;
+  int8_t  shift = offset & 63;
+  
+  if ( shift == 0 ) return _bits[word];
+  return ( _bits[word] >> shift ) | ( _bits[word + 1] << ( 64 - shift ) );
+}
+
+
+#endif // __AE_MOTIF_SCANNER_H__
@@ -0,0 +1,193 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+//
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//*****************************************************************************
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <math.h>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_mut_sampler.h>
+
+
+
+
+//##############################################################################
+//                                                                             #
+//                             Class ae_mut_sampler                            #
+//                                                                             #
+//##############################################################################
+
+// =================================================================
+//                    Definition of static attributes
+// =================================================================
+
+// =================================================================
+//                             Constructors
+// =================================================================
+/*!
+  Draw the number of events of each type undergone by a genome of length <length>,
+  a position undergoing an event of type i with probability rates[i]
+*/
+ae_mut_sampler::ae_mut_sampler( ae_jumping_mt* prng, int32_t length, int8_t nb_types, const double* rates )
+{
+  assert( nb_types > 0 && nb_types <= MUT_SAMPLER_MAX_NB_TYPES );
+  
+  _prng             = prng;
+  _nb_types         = nb_types;
+  _nb_events_total  = 0;
+  _nb_uniforms      = 0;
+  _next_uniform     = 0;
+  
+  // Probability that a position undergoes at least one event
+  // (computed without subtracting from 1 so that it remains accurate for low rates)
+  double prob_event = 0.0;
+  for ( int8_t i = 0 ; i < _nb_types ; i++ )
+  {
+    _nb_events[i] = 0;
+    prob_event += rates[i] * ( 1.0 - prob_event );
+  }
+  
+#ifndef MERGED_MUTATION_SAMPLER
+  // Draw the number of events of each type from its own binomial law, from the
+  // same random numbers as earlier versions
+  draw_nb_events_per_type( length, rates );
+  return;
+#endif
+  
+  if ( prob_event == 0.0 ) return;
+  
+  // Probability that no position at all undergoes an event
+  double prob_no_hit = exp( length * log1p( - prob_event ) );
+  
+  if ( prob_event * length < MUT_SAMPLER_MAX_NB_HITS && prob_no_hit > 0.0 )
+  {
+    // Draw the number of positions undergoing at least one event, which follows the
+    // binomial law B(length, prob_event), by inversion: P(nb_hits = h) is accumulated
+    // until it exceeds a uniform number
+    double  odds    = prob_event / ( 1.0 - prob_event );
+    double  prob    = prob_no_hit;
+    double  cumul   = prob_no_hit;
+    double  u       = random( 1.0 + 3.0 * prob_event * length );
+    int32_t nb_hits = 0;
+    while ( u >= cumul && nb_hits < length )
+    {
+      prob  *= odds * ( length - nb_hits ) / ( nb_hits + 1 );
+      cumul += prob;
+      nb_hits++;
+    }
+    
+    // Draw the types of the events at each of these positions
+    int8_t last_type = _nb_types - 1; // Last type whose rate is not zero
+    while ( rates[last_type] == 0.0 ) last_type--;
+    
+    for ( int32_t i = nb_hits ; i >= 1 ; i-- )
+    {
+      add_events( rates, last_type, prob_event, 2.0 * i );
+    }
+  }
+  else
+  {
+    // Many events are expected: drawing the types of as many events would cost more
+    // than drawing the number of events of each type from its binomial law
+    draw_nb_events_per_type( length, rates );
+  }
+}
+
+// =================================================================
+//                             Destructors
+// =================================================================
+ae_mut_sampler::~ae_mut_sampler( void )
+{
+}
+
+// =================================================================
+//                            Public Methods
+// =================================================================
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+/*!
+  Draw the number of events of each type from its binomial law B(<length>, rates[i])
+*/
+void ae_mut_sampler::draw_nb_events_per_type( int32_t length, const double* rates )
+{
+  for ( int8_t i = 0 ; i < _nb_types ; i++ )
+  {
+    _nb_events[i] = _prng->binomial_random( length, rates[i] );
+    _nb_events_total += _nb_events[i];
+  }
+}
+
+/*!
+  Draw the types of the events undergone by a position that undergoes at least one
+  (which happens with probability <prob_event>) and add them to the count
+*/
+void ae_mut_sampler::add_events( const double* rates, int8_t last_type, double prob_event, double nb_expected )
+{
+  // Type of the first event, knowing that there is at least one
+  int8_t type = first_event( rates, 0, random( nb_expected ) * prob_event );
+  if ( type < 0 ) type = last_type; // rounding error
+  
+  // Events of other (later) types
+  while ( type >= 0 )
+  {
+    _nb_events[type]++;
+    _nb_events_total++;
+    
+    type = ( type < last_type ) ? first_event( rates, type + 1, random( nb_expected ) ) : -1;
+  }
+}
+
+/*!
+  Return the first type (from <first_type> on) of the events a position undergoes, or -1
+  if there is none, given a uniform number u in [0, 1)
+
+  The first type is i with probability rates[i] * prod( 1 - rates[j], first_type <= j < i ).
+*/
+int8_t ae_mut_sampler::first_event( const double* rates, int8_t first_type, double u ) const
+{
+  double prob_none_before = 1.0;
+  double threshold        = 0.0;
+  
+  for ( int8_t i = first_type ; i < _nb_types ; i++ )
+  {
+    threshold += prob_none_before * rates[i];
+    if ( u < threshold ) return i;
+    
+    prob_none_before *= 1.0 - rates[i];
+  }
+  
+  return -1;
+}
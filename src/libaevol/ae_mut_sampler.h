@@ -0,0 +1,257 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+//
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//*****************************************************************************
+
+
+
+/*!
+  \class ae_mut_sampler
+
+  \brief Draws the mutational events (of several types) a genome undergoes
+
+  Each position of a genome of length L undergoes an event of type i with
+  probability rates[i], independently of the other positions and of the
+  other types, so that the number of events of type i follows a binomial
+  law B(L, rates[i]).
+
+  By default, each of these numbers is drawn from its binomial law
+  (ae_jumping_mt::binomial_random) and the events are handed out from an urn
+  drawing from the generator directly, which consumes the random numbers
+  exactly as earlier versions did.
+
+  With MERGED_MUTATION_SAMPLER (--enable-merged-mutation-sampler), the events
+  of all the types are instead considered as a single (merged) process: the
+  number of positions undergoing at least one event is drawn first, by
+  inversion of its binomial law, then the types of the events at each of
+  these positions, given that there is at least one. This costs a single exponential and a few uniform
+  numbers per event, whatever the number of types. When many events are
+  expected (MUT_SAMPLER_MAX_NB_HITS), drawing the number of events of each
+  type from its binomial law (ae_jumping_mt::binomial_random) costs less and
+  is done instead.
+
+  The events are then handed out in a random order by draw_event, as if
+  drawn without replacement from an urn. Where each event takes place is
+  left to the caller since it depends on the events performed before.
+
+  The uniform numbers are drawn from the generator in batches (see
+  ae_jumping_mt::random_array), the unused ones being discarded when the
+  sampler is destroyed.
+
+  The random numbers are hence not consumed as they are by default, and runs
+  do not reproduce the trajectories of earlier versions.
+*/
+
+
+#ifndef __AE_MUT_SAMPLER_H__
+#define __AE_MUT_SAMPLER_H__
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_object.h>
+#include <ae_jumping_mt.h>
+
+
+
+
+// =================================================================
+//                          Class declarations
+// =================================================================
+
+
+
+
+#define MUT_SAMPLER_MAX_NB_TYPES  8
+#define MUT_SAMPLER_BATCH_SIZE    64
+#define MUT_SAMPLER_MAX_NB_HITS   20.0
+
+
+
+class ae_mut_sampler : public ae_object
+{
+  public :
+
+    // =================================================================
+    //                             Constructors
+    // =================================================================
+    ae_mut_sampler( ae_jumping_mt* prng, int32_t length, int8_t nb_types, const double* rates );
+
+    // =================================================================
+    //                             Destructors
+    // =================================================================
+    virtual ~ae_mut_sampler( void );
+
+    // =================================================================
+    //                              Accessors
+    // =================================================================
+    inline int32_t get_nb_events( void ) const;
+    inline int32_t get_nb_events( int8_t type ) const;
+
+    // =================================================================
+    //                            Public Methods
+    // =================================================================
+    inline int8_t draw_event( void );
+
+    // =================================================================
+    //                           Public Attributes
+    // =================================================================
+
+
+
+
+
+  protected :
+
+    // =================================================================
+    //                         Forbidden Constructors
+    // =================================================================
+    ae_mut_sampler( void )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+    ae_mut_sampler( const ae_mut_sampler &model )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+
+    // =================================================================
+    //                           Protected Methods
+    // =================================================================
+    inline double random( double nb_expected );
+    void   draw_nb_events_per_type( int32_t length, const double* rates );
+    void   add_events( const double* rates, int8_t last_type, double prob_event, double nb_expected );
+    int8_t first_event( const double* rates, int8_t first_type, double u ) const;
+
+    // =================================================================
+    //                          Protected Attributes
+    // =================================================================
+    ae_jumping_mt* _prng;
+
+    int8_t  _nb_types;
+    int32_t _nb_events[MUT_SAMPLER_MAX_NB_TYPES]; // Events of each type not handed out yet
+    int32_t _nb_events_total;
+
+    // Batch of uniform numbers drawn from _prng
+    double  _uniforms[MUT_SAMPLER_BATCH_SIZE];
+    int32_t _nb_uniforms;
+    int32_t _next_uniform;
+};
+
+
+// =====================================================================
+//                           Getters' definitions
+// =====================================================================
+/*!
+  Number of events (of all types) that have not been handed out yet
+*/
+inline int32_t ae_mut_sampler::get_nb_events( void ) const
+{
+  return _nb_events_total;
+}
+
+/*!
+  Number of events of type <type> that have not been handed out yet
+*/
+inline int32_t ae_mut_sampler::get_nb_events( int8_t type ) const
+{
+  assert( type >= 0 && type < _nb_types );
+  return _nb_events[type];
+}
+
+// =====================================================================
+//                           Setters' definitions
+// =====================================================================
+
+// =====================================================================
+//                          Operators' definitions
+// =====================================================================
+
+// =====================================================================
+//                       Inline functions' definition
+// =====================================================================
+/*!
+  Draw the type of the next event, as a random draw without replacement from an urn
+  containing the events not handed out yet
+*/
+inline int8_t ae_mut_sampler::draw_event( void )
+{
+  assert( _nb_events_total > 0 );
+  
+#ifndef MERGED_MUTATION_SAMPLER
+  int32_t random_value = _prng->random( _nb_events_total );
+#else
+  int32_t random_value = (int32_t) ( _nb_events_total * random( _nb_events_total ) );
+#endif
+  
+  int8_t type = 0;
+  while ( random_value >= _nb_events[type] )
+  {
+    random_value -= _nb_events[type];
+    type++;
+  }
+  
+  _nb_events[type]--;
+  _nb_events_total--;
+  
+  return type;
+}
+
+/*!
+  Next uniform number in [0, 1) of the batch
+
+  When the batch is exhausted, it is refilled with as many numbers as are
+  expected to be needed from now on (<nb_expected>, within the limits of the
+  batch).
+*/
+inline double ae_mut_sampler::random( double nb_expected )
+{
+  if ( _next_uniform == _nb_uniforms )
+  {
+    if ( nb_expected < 1.0 )                         _nb_uniforms = 1;
+    else if ( nb_expected > MUT_SAMPLER_BATCH_SIZE ) _nb_uniforms = MUT_SAMPLER_BATCH_SIZE;
+    else                                             _nb_uniforms = (int32_t) ceil( nb_expected );
+    
+    _prng->random_array( _uniforms, _nb_uniforms );
+    _next_uniform = 0;
+  }
+  
+  return _uniforms[_next_uniform++];
+}
+
+
+#endif // __AE_MUT_SAMPLER_H__
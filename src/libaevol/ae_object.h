@@ -32,6 +32,8 @@
 #include <stdlib.h>
 #include <assert.h>
 
+#include <ae_pool.h>
+
 
 class ae_object
 {
@@ -39,6 +41,10 @@ class ae_object
     ae_object( void ){};
     virtual ~ae_object( void ){};
     
+    // Objects are allocated in the small object pool (see ae_pool)
+    static void* operator new( size_t size )              { return ae_pool::allocate( size ); };
+    static void  operator delete( void* ptr, size_t size ) { ae_pool::release( ptr, size ); };
+    
   protected :
     ae_object( const ae_object &model )
     {
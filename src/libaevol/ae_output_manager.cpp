@@ -41,6 +41,7 @@
 // =================================================================
 #include <ae_output_manager.h>
 #include <ae_exp_manager.h>
+#include <ae_profiler.h>
 
 
 
@@ -69,6 +70,7 @@ ae_output_manager::ae_output_manager( ae_exp_manager* exp_m )
   _make_dumps = false;
   _dump_step = 0;
   _logs  = new ae_logs();
+  _writer = NULL;
 }
 
 // =================================================================
@@ -80,6 +82,7 @@ ae_output_manager::~ae_output_manager( void )
   delete _tree;
   delete _dump;
   delete _logs;
+  delete _writer; // Waits for the pending files to be written
 }
 
 // =================================================================
@@ -138,6 +141,10 @@ void ae_output_manager::write_setup_file( FILE* setup_file ) const
     {
       fprintf( setup_file, "TREE_MODE NORMAL\n" );
     }
+    else if ( _tree->get_tree_mode() == PRUNED )
+    {
+      fprintf( setup_file, "TREE_MODE PRUNED\n" );
+    }
     else
     {
       fprintf( setup_file, "TREE_MODE UNKNOWN\n" );
@@ -184,7 +191,7 @@ void ae_output_manager::load( gzFile setup_file, bool verbose, bool to_be_run  )
     gzread( setup_file, &tmp_tree_step, sizeof(tmp_tree_step) );
     int8_t tmp_tree_mode;
     gzread( setup_file, &tmp_tree_mode, sizeof(tmp_tree_mode) );
-    if ( (ae_tree_mode)tmp_tree_mode != LIGHT && (ae_tree_mode)tmp_tree_mode != NORMAL)
+    if ( (ae_tree_mode)tmp_tree_mode != LIGHT && (ae_tree_mode)tmp_tree_mode != NORMAL && (ae_tree_mode)tmp_tree_mode != PRUNED )
     {
         printf( "%s:%d: error: invalid tree mode\n", __FILE__, __LINE__ );
         exit( EXIT_FAILURE );
@@ -244,7 +251,7 @@ void ae_output_manager::load( FILE* setup_file, bool verbose, bool to_be_run  )
     fscanf( setup_file, "TREE_STEP %"PRId32"\n", &tmp_tree_step );
     int8_t tmp_tree_mode;
     fscanf( setup_file, "TREE_MODE %"PRId8"\n", &tmp_tree_mode );
-    if ( (ae_tree_mode)tmp_tree_mode != LIGHT && (ae_tree_mode)tmp_tree_mode != NORMAL)
+    if ( (ae_tree_mode)tmp_tree_mode != LIGHT && (ae_tree_mode)tmp_tree_mode != NORMAL && (ae_tree_mode)tmp_tree_mode != PRUNED )
     {
         printf( "%s:%d: error: invalid tree mode\n", __FILE__, __LINE__ );
         assert( false );
@@ -269,14 +276,32 @@ void ae_output_manager::load( FILE* setup_file, bool verbose, bool to_be_run  )
   _logs->load(logs, num_gener);
 }
 
+/*!
+  Have the backups and trees compressed and written by a background thread
+
+  LAST_GENER_FNAME is then only updated once the backups it refers to (and
+  everything written before them) are complete.
+*/
+void ae_output_manager::start_background_writer( void )
+{
+  if ( _writer == NULL )
+  {
+    _writer = new ae_background_writer( _exp_m->get_nb_threads() );
+  }
+}
+
 void ae_output_manager::write_current_generation_outputs( void ) const
 {
   int32_t num_gener = _exp_m->get_num_gener();
   
-  _stats->write_current_generation_statistics();
+  {
+    PROFILE_SCOPE( STATS );
+    _stats->write_current_generation_statistics();
+  }
   
   if ( _record_tree )
   {
+    PROFILE_SCOPE( TREE );
     if ( num_gener > 0 )
     {
       _tree->fill_tree_with_cur_gener(); 
@@ -286,7 +311,8 @@ void ae_output_manager::write_current_generation_outputs( void ) const
   // Write backup and tree
   if ( _record_tree && (num_gener != _exp_m->get_first_gener()) && (num_gener % _tree->get_tree_step() == 0) )    
   {
-    if ( _tree->get_tree_mode() == NORMAL ) 
+    PROFILE_SCOPE( TREE );
+    if ( _tree->get_tree_mode() != LIGHT ) 
     { 
       write_tree();
     }
@@ -294,19 +320,18 @@ void ae_output_manager::write_current_generation_outputs( void ) const
   
   if ( num_gener % _backup_step == 0 )
   {
+    PROFILE_SCOPE( BACKUP );
     _stats->flush();
-    _exp_m->save();
+    _exp_m->save( _writer );
     
-    // Update the LAST_GENER file
-    FILE* last_gener_file = fopen( LAST_GENER_FNAME, "w" );
-    if ( last_gener_file != NULL )
+    // Update the LAST_GENER file (once the backups are written)
+    if ( _writer != NULL )
     {
-      fprintf( last_gener_file, "%"PRId32"\n", num_gener );
-      fclose( last_gener_file );
+      _writer->commit( num_gener );
     }
     else
     {
-      printf( "Error : could not open file "LAST_GENER_FNAME"\n" );
+      ae_background_writer::write_last_gener_file( num_gener );
     }
     
     #ifdef __IN2P3
@@ -347,12 +372,18 @@ void ae_output_manager::write_tree( void ) const
   sprintf( tree_file_name, "tree/tree_%06"PRId32".ae", _exp_m->get_num_gener() );
 #endif
   
-  gzFile tree_file = gzopen( tree_file_name, "w" );
+  // Tree files written in the background are indexed (see ae_tree)
+  gzFile tree_file = ( _writer != NULL ) ? _writer->open( tree_file_name, true ) : gzopen( tree_file_name, "w" );
   
   // Write phylogenetic data (tree)
-  _tree->write_to_tree_file( tree_file );
+  _tree->write_to_tree_file( tree_file, ( _writer != NULL ) ? _writer->get_entry_starts( tree_file ) : NULL );
   
   gzclose( tree_file );
+  
+  if ( _writer != NULL )
+  {
+    _writer->commit();
+  }
 }
 
 // =================================================================
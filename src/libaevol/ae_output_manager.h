@@ -45,6 +45,7 @@
 #include <ae_tree.h>
 #include <ae_dump.h>
 #include <ae_logs.h>
+#include <ae_background_writer.h>
 
 
 
@@ -114,6 +115,7 @@ class ae_output_manager
     void write_setup_file( FILE* setup_file ) const;
     void load( gzFile file, bool verbose, bool to_be_run  );
     void load( FILE* file, bool verbose, bool to_be_run );
+    void start_background_writer( void );
     void write_current_generation_outputs( void ) const;
     inline void flush( void );
 
@@ -171,6 +173,9 @@ class ae_output_manager
     
     // Logs
     ae_logs*  _logs;
+    
+    // Compresses and writes backups and trees while the simulation goes on (if not NULL)
+    ae_background_writer* _writer;
 };
 
 
@@ -272,6 +277,11 @@ inline void ae_output_manager::set_logs (int8_t logs)
 inline void ae_output_manager::flush( void )
 {
   _stats->flush();
+  
+  if ( _writer != NULL )
+  {
+    _writer->wait();
+  }
 }
 
 #endif // __AE_OUPUT_MANAGER_H__
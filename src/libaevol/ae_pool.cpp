@@ -0,0 +1,121 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_pool.h>
+
+
+
+
+//##############################################################################
+//                                                                             #
+//                                Class ae_pool                                #
+//                                                                             #
+//##############################################################################
+
+// =================================================================
+//                    Definition of static attributes
+// =================================================================
+thread_local ae_pool::ae_thread_cache ae_pool::_cache;
+
+std::mutex              ae_pool::_depot_mutex;
+ae_pool::ae_free_block* ae_pool::_depot[POOL_NB_CLASSES];
+void*                   ae_pool::_slabs = NULL;
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+/*!
+  Return a block of the given size class after refilling the calling thread's
+  free list, from the depot if it has a batch of such blocks, from a new slab
+  otherwise
+*/
+void* ae_pool::refill( int16_t size_class )
+{
+  std::lock_guard<std::mutex> lock( _depot_mutex );
+  
+  ae_free_block* block = _depot[size_class];
+  if ( block != NULL )
+  {
+    _depot[size_class] = block->next_batch;
+    _cache.free_blocks[size_class]    = block->next;
+    _cache.nb_free_blocks[size_class] = POOL_BATCH_SIZE - 1;
+    return block;
+  }
+  
+  // Carve a new slab. Its first block-aligned bytes are used to chain the
+  // slabs together, which keeps them reachable for leak checkers
+  char* slab = (char*) ::operator new( POOL_SLAB_SIZE );
+  *(void**) slab = _slabs;
+  _slabs = slab;
+  
+  size_t  block_size  = ( size_class + 1 ) * POOL_GRANULARITY;
+  int32_t nb_blocks   = ( POOL_SLAB_SIZE - POOL_GRANULARITY ) / block_size;
+  char*   first       = slab + POOL_GRANULARITY;
+  
+  for ( int32_t i = 1 ; i < nb_blocks - 1 ; i++ )
+  {
+    ((ae_free_block*) ( first + i * block_size ))->next = (ae_free_block*) ( first + ( i + 1 ) * block_size );
+  }
+  ((ae_free_block*) ( first + ( nb_blocks - 1 ) * block_size ))->next = NULL;
+  
+  _cache.free_blocks[size_class]    = ( nb_blocks > 1 ) ? (ae_free_block*) ( first + block_size ) : NULL;
+  _cache.nb_free_blocks[size_class] = nb_blocks - 1;
+  return first;
+}
+
+/*!
+  Hand a batch of POOL_BATCH_SIZE blocks of the given size class over from the
+  calling thread's free list to the depot
+*/
+void ae_pool::flush( int16_t size_class )
+{
+  ae_free_block* first = _cache.free_blocks[size_class];
+  ae_free_block* last  = first;
+  for ( int32_t i = 1 ; i < POOL_BATCH_SIZE ; i++ )
+  {
+    last = last->next;
+  }
+  
+  _cache.free_blocks[size_class] = last->next;
+  _cache.nb_free_blocks[size_class] -= POOL_BATCH_SIZE;
+  last->next = NULL;
+  
+  std::lock_guard<std::mutex> lock( _depot_mutex );
+  first->next_batch   = _depot[size_class];
+  _depot[size_class]  = first;
+}
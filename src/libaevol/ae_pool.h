@@ -0,0 +1,208 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+/*!
+  \class ae_pool
+  
+  \brief Recycling allocator for the small objects that live for about one generation
+  
+  Each generation builds a new individual per offspring, along with its
+  genetic units, RNAs, proteins, phenotype points and list nodes, and deletes
+  those of the previous generation. ae_object, ae_list and ae_list_node route
+  their operator new and delete through this pool. Memory freed by a
+  generation is then reused by the next one instead of going through the
+  system allocator.
+  
+  Sizes are rounded up to a multiple of POOL_GRANULARITY bytes. Each thread
+  has its own free list per size class, refilled from slabs of POOL_SLAB_SIZE
+  bytes. When a thread frees more blocks than it allocates, it hands batches
+  of POOL_BATCH_SIZE blocks over to a shared depot. This typically happens to
+  the thread deleting the previous generation while the thread pool builds
+  the new one. Other threads take blocks from the depot before carving new
+  slabs. The footprint is hence bounded by the largest number of objects
+  alive at once (about two generations). Slabs are never given back to the
+  system.
+  
+  Objects larger than POOL_MAX_SIZE bytes go to ::operator new. Configuring
+  with --disable-pools turns the pool off altogether (e.g. for memory
+  checkers).
+*/
+
+
+#ifndef __AE_POOL_H__
+#define __AE_POOL_H__
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <mutex>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_macros.h>
+
+
+
+
+// =================================================================
+//                          Class declarations
+// =================================================================
+
+
+
+
+
+
+class ae_pool
+{
+  public :
+    // =================================================================
+    //                            Public Methods
+    // =================================================================
+    static inline void* allocate( size_t size );
+    static inline void  release( void* ptr, size_t size );
+
+    // =================================================================
+    //                           Public Attributes
+    // =================================================================
+
+
+
+
+
+  protected :
+
+    // =================================================================
+    //                         Forbidden Constructors
+    // =================================================================
+    ae_pool( void )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+    
+    // A free block is linked to the following blocks of its batch and, if it
+    // is the first block of a batch stored in the depot, to the next batch
+    struct ae_free_block
+    {
+      ae_free_block* next;
+      ae_free_block* next_batch;
+    };
+    
+    struct ae_thread_cache
+    {
+      ae_free_block*  free_blocks[POOL_NB_CLASSES];
+      int32_t         nb_free_blocks[POOL_NB_CLASSES];
+    };
+
+    // =================================================================
+    //                           Protected Methods
+    // =================================================================
+    static inline int16_t get_size_class( size_t size );
+    
+    static void* refill( int16_t size_class );
+    static void  flush( int16_t size_class );
+
+    // =================================================================
+    //                          Protected Attributes
+    // =================================================================
+    static thread_local ae_thread_cache _cache;
+    
+    static std::mutex     _depot_mutex;
+    static ae_free_block* _depot[POOL_NB_CLASSES];  // Batches of POOL_BATCH_SIZE blocks
+    static void*          _slabs;                   // Each slab begins with a pointer to the previous one
+};
+
+
+// =====================================================================
+//                           Getters' definitions
+// =====================================================================
+
+// =====================================================================
+//                           Setters' definitions
+// =====================================================================
+
+// =====================================================================
+//                          Operators' definitions
+// =====================================================================
+
+// =====================================================================
+//                       Inline functions' definition
+// =====================================================================
+inline void* ae_pool::allocate( size_t size )
+{
+  #ifdef __NO_POOLS
+    return ::operator new( size );
+  #else
+    if ( size > POOL_MAX_SIZE ) return ::operator new( size );
+    
+    int16_t size_class = get_size_class( size );
+    ae_free_block* block = _cache.free_blocks[size_class];
+    if ( block == NULL ) return refill( size_class );
+    
+    _cache.free_blocks[size_class] = block->next;
+    _cache.nb_free_blocks[size_class]--;
+    return block;
+  #endif
+}
+
+inline void ae_pool::release( void* ptr, size_t size )
+{
+  #ifdef __NO_POOLS
+    ::operator delete( ptr );
+  #else
+    if ( ptr == NULL ) return;
+    if ( size > POOL_MAX_SIZE )
+    {
+      ::operator delete( ptr );
+      return;
+    }
+    
+    int16_t size_class = get_size_class( size );
+    ae_free_block* block = (ae_free_block*) ptr;
+    block->next = _cache.free_blocks[size_class];
+    _cache.free_blocks[size_class] = block;
+    
+    if ( ++_cache.nb_free_blocks[size_class] > 2 * POOL_BATCH_SIZE ) flush( size_class );
+  #endif
+}
+
+inline int16_t ae_pool::get_size_class( size_t size )
+{
+  return ( size <= POOL_GRANULARITY ) ? 0 : ( size - 1 ) / POOL_GRANULARITY;
+}
+
+
+#endif // __AE_POOL_H__
@@ -42,6 +42,7 @@
 #include <ae_exp_manager.h>
 #include <ae_exp_setup.h>
 #include <ae_individual.h>
+#include <ae_thread_pool.h>
 
 #ifdef __NO_X
   #ifndef __REGUL
@@ -77,9 +78,9 @@ ae_population::ae_population( ae_exp_manager* exp_m )
 {
   _exp_m = exp_m;
   
+  _mut_prng   = NULL;
+  _stoch_prng = NULL;
   #ifndef DISTRIBUTED_PRNG
-    _mut_prng       = NULL;
-    _stoch_prng     = NULL;
     _stoch_prng_bak = NULL;
   #endif
   
@@ -95,9 +96,9 @@ ae_population::ae_population( ae_exp_manager* exp_m )
 // =================================================================
 ae_population::~ae_population( void )
 {
+  delete _mut_prng;
+  delete _stoch_prng;
   #ifndef DISTRIBUTED_PRNG
-    delete _mut_prng;
-    delete _stoch_prng;
     delete _stoch_prng_bak;
   #endif
   
@@ -147,18 +148,22 @@ void ae_population::replace_population( ae_list<ae_individual*>* new_indivs )
   _nb_indivs = _indivs->get_nb_elts();
 }
 
-void ae_population::save( gzFile backup_file ) const
+/*!
+  Write the population into backup_file
+
+  If indiv_starts is provided, the position (in the uncompressed content) at
+  which each individual starts is appended to it (see ae_block_backup).
+*/
+void ae_population::save( gzFile backup_file, std::vector<int64_t>* indiv_starts /*= NULL*/ ) const
 {
   // Write population intrinsic data
-  #ifndef DISTRIBUTED_PRNG
-    _mut_prng->save( backup_file );
-    int8_t tmp_with_stoch = _stoch_prng == NULL ? 0 : 1;
-    gzwrite( backup_file, &tmp_with_stoch, sizeof(tmp_with_stoch) );
-    if ( tmp_with_stoch )
-    {
-      _stoch_prng->save( backup_file );
-    }
-  #endif
+  _mut_prng->save( backup_file );
+  int8_t tmp_with_stoch = _stoch_prng == NULL ? 0 : 1;
+  gzwrite( backup_file, &tmp_with_stoch, sizeof(tmp_with_stoch) );
+  if ( tmp_with_stoch )
+  {
+    _stoch_prng->save( backup_file );
+  }
   gzwrite( backup_file, &_nb_indivs, sizeof(_nb_indivs) );
   
   // Write individuals
@@ -166,29 +171,76 @@ void ae_population::save( gzFile backup_file ) const
   ae_individual*  indiv;
   for ( int32_t i = 0 ; i < _nb_indivs ; i++ )
   {
+    if ( indiv_starts != NULL )
+    {
+      indiv_starts->push_back( gztell( backup_file ) );
+    }
+    
     indiv = indiv_node->get_obj();
     indiv->save( backup_file );
     indiv_node = indiv_node->get_next();
   }
 }
 
-void ae_population::load( gzFile backup_file, bool verbose )
+/*!
+  Load the population from backup_file
+
+  If backup_file is a block backup, its index can be provided for the
+  individuals to be loaded concurrently (on the experiment's thread pool).
+*/
+void ae_population::load( gzFile backup_file, bool verbose, ae_block_backup const * index /*= NULL*/ )
 {
   // --------------------------------------- Retreive population intrinsic data
-  #ifndef DISTRIBUTED_PRNG
-    _mut_prng   = new ae_jumping_mt( backup_file );
-    int8_t tmp_with_stoch;
-    gzread( backup_file, &tmp_with_stoch, sizeof(tmp_with_stoch) );
-    if ( tmp_with_stoch )
-    {
-      _stoch_prng = new ae_jumping_mt( backup_file );
-    }
-  #endif
+  _mut_prng   = new ae_jumping_mt( backup_file );
+  int8_t tmp_with_stoch;
+  gzread( backup_file, &tmp_with_stoch, sizeof(tmp_with_stoch) );
+  if ( tmp_with_stoch )
+  {
+    _stoch_prng = new ae_jumping_mt( backup_file );
+  }
   gzread( backup_file, &_nb_indivs, sizeof(_nb_indivs) );
 
   // ----------------------------------------------------- Retreive individuals
+  if ( index != NULL && index->get_nb_entries() == _nb_indivs )
+  {
+    // Each task reads a slice of the individuals from a file of its own
+    ae_thread_pool* thread_pool = _exp_m->get_thread_pool();
+    int32_t nb_slices = ( thread_pool != NULL ) ? thread_pool->get_nb_threads() : 1;
+    ae_individual** indivs = new ae_individual* [_nb_indivs];
+    
+    auto load_slice = [&]( int32_t slice )
+    {
+      int32_t first = (int64_t) _nb_indivs * slice / nb_slices;
+      int32_t last  = (int64_t) _nb_indivs * ( slice + 1 ) / nb_slices;
+      if ( first == last ) return;
+      
+      gzFile slice_file = index->open_entry( first );
+      for ( int32_t i = first ; i < last ; i++ )
+      {
+        indivs[i] = create_individual_from_backup( slice_file );
+      }
+      gzclose( slice_file );
+    };
+    
+    if ( thread_pool != NULL )
+    {
+      thread_pool->run( nb_slices, load_slice );
+    }
+    else
+    {
+      load_slice( 0 );
+    }
+    
+    for ( int32_t i = 0 ; i < _nb_indivs ; i++ )
+    {
+      _indivs->add( indivs[i] );
+    }
+    delete [] indivs;
+    
+    return;
+  }
+  
   if ( verbose ) printf( "  Loading individuals " );
-  ae_individual* indiv = NULL;
   for ( int32_t i = 0 ; i < _nb_indivs ; i++ )
   {
     if ( verbose && i && i % 100 == 0 )
@@ -197,24 +249,25 @@ void ae_population::load( gzFile backup_file, bool verbose )
       fflush( stdout );
     }
     
-    #ifdef __NO_X
-      #ifndef __REGUL
-        indiv = new ae_individual( _exp_m, backup_file );
-      #else
-        indiv = new ae_individual_R( _exp_m, backup_file );
-      #endif
-    #elif defined __X11
-      #ifndef __REGUL
-        indiv = new ae_individual_X11( _exp_m, backup_file );
-      #else
-        indiv = new ae_individual_R_X11( _exp_m, backup_file );
-      #endif
-    #endif
-    
-    _indivs->add( indiv );
+    _indivs->add( create_individual_from_backup( backup_file ) );
   }
   if ( verbose ) putchar( '\n' );
 }
+
+/*!
+  Load the i-th individual of a block backup, without reading the others
+
+  The population's PRNGs are not read, the individual shares those of the
+  population (unless it has its own, with DISTRIBUTED_PRNG).
+*/
+ae_individual* ae_population::load_indiv( ae_block_backup const * index, int32_t i )
+{
+  gzFile indiv_file = index->open_entry( i );
+  ae_individual* indiv = create_individual_from_backup( indiv_file );
+  gzclose( indiv_file );
+  
+  return indiv;
+}
   
 #ifndef DISTRIBUTED_PRNG
   void ae_population::backup_stoch_prng( void )
@@ -339,6 +392,23 @@ ae_individual* ae_population::create_clone( ae_individual* dolly, int32_t id )
   return indiv;
 }
 
+ae_individual* ae_population::create_individual_from_backup( gzFile backup_file )
+{
+  #ifdef __NO_X
+    #ifndef __REGUL
+      return new ae_individual( _exp_m, backup_file );
+    #else
+      return new ae_individual_R( _exp_m, backup_file );
+    #endif
+  #elif defined __X11
+    #ifndef __REGUL
+      return new ae_individual_X11( _exp_m, backup_file );
+    #else
+      return new ae_individual_R_X11( _exp_m, backup_file );
+    #endif
+  #endif
+}
+
 
 // Break linkage between genetic units 0 and 1: the genetic unit 1 will be pooled, mixed, and randomly reassigned to individuals
 // This function is intended to be used when the two genetic units are representing linked loci that do not 'interact', and not transferable elements
@@ -35,6 +35,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <zlib.h>
+#include <vector>
 
 
 
@@ -44,6 +45,7 @@
 #include <ae_list.h>
 #include <ae_individual.h>
 #include <ae_jumping_mt.h>
+#include <ae_block_backup.h>
 
 
 
@@ -132,11 +134,14 @@ class ae_population : public ae_object
     ae_individual*  calculate_GU_transfer ( int16_t x, int16_t y );
     void            do_random_migrations ( void );
     inline void     evaluate_individuals( ae_environment* envir );
+    inline ae_jumping_mt* new_mut_prng_stream( void );
+    inline ae_jumping_mt* new_stoch_prng_stream( void );
     void            sort_individuals( void );
     void            update_best( void );
 
-    void save( gzFile backup_file ) const;
-    void load( gzFile backup_file, bool verbose );
+    void save( gzFile backup_file, std::vector<int64_t>* indiv_starts = NULL ) const;
+    void load( gzFile backup_file, bool verbose, ae_block_backup const * index = NULL );
+    ae_individual* load_indiv( ae_block_backup const * index, int32_t i );
     
     #ifndef DISTRIBUTED_PRNG
       void backup_stoch_prng( void );
@@ -178,15 +183,18 @@ class ae_population : public ae_object
     ae_individual* create_random_individual_with_good_gene( int32_t id );
     ae_individual* create_clone( ae_individual* dolly, int32_t id );
     ae_individual* create_individual_from_file( char* organism_file_name, int32_t id );
+    ae_individual* create_individual_from_backup( gzFile backup_file );
   
     // =================================================================
     //                          Protected Attributes
     // =================================================================
     ae_exp_manager* _exp_m;
     
+    // PRNGs (with DISTRIBUTED_PRNG, these are only used to derive the
+    // individuals' own PRNGs, see new_mut_prng_stream)
+    ae_jumping_mt* _mut_prng;
+    ae_jumping_mt* _stoch_prng;
     #ifndef DISTRIBUTED_PRNG
-      ae_jumping_mt* _mut_prng;
-      ae_jumping_mt* _stoch_prng;
       ae_jumping_mt* _stoch_prng_bak;
     #endif
     
@@ -261,6 +269,8 @@ inline void ae_population::add_indiv( ae_individual* indiv )
 inline void ae_population::set_mut_prng( ae_jumping_mt* prng )
 {
   _mut_prng = prng;
+  
+  #ifndef DISTRIBUTED_PRNG
   ae_list_node<ae_individual*>* indiv_node = _indivs->get_first();
   ae_individual*  indiv;
   for ( int32_t i = 0 ; i < _nb_indivs ; i++ )
@@ -269,11 +279,14 @@ inline void ae_population::set_mut_prng( ae_jumping_mt* prng )
     indiv->set_mut_prng( _mut_prng );
     indiv_node = indiv_node->get_next();
   }
+  #endif
 }
 
 inline void ae_population::set_stoch_prng( ae_jumping_mt* prng )
 {
   _stoch_prng = prng;
+  
+  #ifndef DISTRIBUTED_PRNG
   ae_list_node<ae_individual*>* indiv_node = _indivs->get_first();
   ae_individual*  indiv;
   for ( int32_t i = 0 ; i < _nb_indivs ; i++ )
@@ -282,6 +295,7 @@ inline void ae_population::set_stoch_prng( ae_jumping_mt* prng )
     indiv->set_stoch_prng( _stoch_prng );
     indiv_node = indiv_node->get_next();
   }
+  #endif
 }
 
 
@@ -484,4 +498,35 @@ inline void ae_population::evaluate_individuals( ae_environment* envir )
   }
 }
 
+/*!
+  Create a new mutation PRNG stream, e.g. for a new individual.
+
+  The stream is a copy of the population's mutation PRNG, which then jumps
+  ahead so that the streams it gives do not overlap. The stream given to the
+  i-th new individual of a generation hence only depends on the generation
+  and on i, not on the order in which the individuals are actually created.
+*/
+inline ae_jumping_mt* ae_population::new_mut_prng_stream( void )
+{
+  ae_jumping_mt* stream = new ae_jumping_mt( *_mut_prng );
+  _mut_prng->jump();
+  
+  return stream;
+}
+
+/*!
+  Create a new stochasticity PRNG stream (see new_mut_prng_stream).
+  
+  Returns NULL if the population has no stochasticity PRNG.
+*/
+inline ae_jumping_mt* ae_population::new_stoch_prng_stream( void )
+{
+  if ( _stoch_prng == NULL ) return NULL;
+  
+  ae_jumping_mt* stream = new ae_jumping_mt( *_stoch_prng );
+  _stoch_prng->jump();
+  
+  return stream;
+}
+
 #endif // __AE_POPULATION_H__
@@ -0,0 +1,253 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_profiler.h>
+#include <ae_macros.h>
+
+
+
+
+//##############################################################################
+//                                                                             #
+//                              Class ae_profiler                              #
+//                                                                             #
+//##############################################################################
+
+// =================================================================
+//                    Definition of static attributes
+// =================================================================
+thread_local ae_profiler::thread_buffer ae_profiler::_buffer;
+
+std::mutex                          ae_profiler::_mutex;
+std::vector<ae_profiler::thread_buffer*> ae_profiler::_buffers;
+int64_t ae_profiler::_retired_times[NB_PHASES]    = { 0 };
+int64_t ae_profiler::_retired_counts[NB_COUNTERS] = { 0 };
+
+FILE* ae_profiler::_file = NULL;
+std::chrono::steady_clock::time_point ae_profiler::_last_write = std::chrono::steady_clock::now();
+
+static const char* phase_names[ae_profiler::NB_PHASES] =
+{
+  "Copy of the parents",
+  "Mutations (including alignments)",
+  "Alignment search",
+  "Transcription",
+  "Translation",
+  "Folding, phenotype and fitness",
+  "Selection",
+  "Statistics",
+  "Tree",
+  "Backup",
+};
+
+static const char* counter_names[ae_profiler::NB_COUNTERS] =
+{
+  "Number of alignments attempted",
+  "Number of alignments found",
+  "Number of positions scanned for a promoter",
+  "Number of proteins built",
+};
+
+// =================================================================
+//                             Constructors
+// =================================================================
+ae_profiler::thread_buffer::thread_buffer( void )
+{
+  for ( int8_t i = 0 ; i < NB_PHASES ; i++ )    times[i]  = 0;
+  for ( int8_t i = 0 ; i < NB_COUNTERS ; i++ )  counts[i] = 0;
+  
+  std::lock_guard<std::mutex> lock( _mutex );
+  _buffers.push_back( this );
+}
+
+// =================================================================
+//                             Destructors
+// =================================================================
+ae_profiler::thread_buffer::~thread_buffer( void )
+{
+  // Keep what this thread recorded until the next call to write_generation
+  std::lock_guard<std::mutex> lock( _mutex );
+  collect( *this, _retired_times, _retired_counts );
+  
+  for ( size_t i = 0 ; i < _buffers.size() ; i++ )
+  {
+    if ( _buffers[i] == this )
+    {
+      _buffers.erase( _buffers.begin() + i );
+      break;
+    }
+  }
+}
+
+// =================================================================
+//                            Public Methods
+// =================================================================
+void ae_profiler::write_generation( int32_t num_gener )
+{
+  int64_t times[NB_PHASES];
+  int64_t counts[NB_COUNTERS];
+  
+  {
+    std::lock_guard<std::mutex> lock( _mutex );
+    
+    for ( int8_t i = 0 ; i < NB_PHASES ; i++ )
+    {
+      times[i] = _retired_times[i];
+      _retired_times[i] = 0;
+    }
+    for ( int8_t i = 0 ; i < NB_COUNTERS ; i++ )
+    {
+      counts[i] = _retired_counts[i];
+      _retired_counts[i] = 0;
+    }
+    
+    for ( size_t i = 0 ; i < _buffers.size() ; i++ )
+    {
+      collect( *_buffers[i], times, counts );
+    }
+  }
+  
+  // Wall-clock time elapsed since the previous call (or the start of the program)
+  std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  int64_t wall_time = std::chrono::duration_cast<std::chrono::nanoseconds>( now - _last_write ).count();
+  _last_write = now;
+  
+  if ( _file == NULL )
+  {
+    open_file( num_gener );
+  }
+  
+  fprintf( _file, "%"PRId32" %.6f", num_gener, wall_time * 1e-9 );
+  for ( int8_t i = 0 ; i < NB_PHASES ; i++ )
+  {
+    fprintf( _file, " %.6f", times[i] * 1e-9 );
+  }
+  for ( int8_t i = 0 ; i < NB_COUNTERS ; i++ )
+  {
+    fprintf( _file, " %"PRId64, counts[i] );
+  }
+  fprintf( _file, "\n" );
+}
+
+void ae_profiler::close( void )
+{
+  if ( _file != NULL )
+  {
+    fclose( _file );
+    _file = NULL;
+  }
+}
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+/*!
+  Open PROFILE_FNAME, the first generation to be written being first_gener
+
+  As with the stat files, what a previous run (resumed at first_gener) wrote
+  is kept up to the generation before first_gener: the lines of the
+  generations it ran past the backup are dropped.
+*/
+void ae_profiler::open_file( int32_t first_gener )
+{
+  char  old_file_name[255];
+  char  line[1000];
+  FILE* old_file = NULL;
+  
+  sprintf( old_file_name, "%s.old", PROFILE_FNAME );
+  if ( rename( PROFILE_FNAME, old_file_name ) == 0 )
+  {
+    old_file = fopen( old_file_name, "r" );
+  }
+  
+  _file = fopen( PROFILE_FNAME, "w" );
+  if ( _file == NULL )
+  {
+    printf( "%s:%d: error: could not open file %s.\n", __FILE__, __LINE__, PROFILE_FNAME );
+    exit( EXIT_FAILURE );
+  }
+  
+  if ( old_file != NULL )
+  {
+    // Copy the header and the lines of the generations before first_gener
+    while ( fgets( line, sizeof(line), old_file ) != NULL )
+    {
+      if ( line[0] != '#' && (int32_t) atol( line ) >= first_gener ) break;
+      fputs( line, _file );
+    }
+    
+    fclose( old_file );
+    remove( old_file_name );
+  }
+  
+  if ( ftell( _file ) == 0 )
+  {
+    fprintf( _file, "# ----------------------------------------------------\n" );
+    fprintf( _file, "#  Wall-clock time of the generation and time spent in\n" );
+    fprintf( _file, "#  each of its phases (in s), and number of events\n" );
+    fprintf( _file, "#  (phases and events summed over all the threads)\n" );
+    fprintf( _file, "# ----------------------------------------------------\n" );
+    fprintf( _file, "# \n" );
+    fprintf( _file, "#  1. Generation\n" );
+    fprintf( _file, "#  2. Wall-clock time\n" );
+    for ( int8_t i = 0 ; i < NB_PHASES ; i++ )
+    {
+      fprintf( _file, "# %2"PRId8". %s\n", i + 3, phase_names[i] );
+    }
+    for ( int8_t i = 0 ; i < NB_COUNTERS ; i++ )
+    {
+      fprintf( _file, "# %2"PRId8". %s\n", NB_PHASES + i + 3, counter_names[i] );
+    }
+    fprintf( _file, "# \n" );
+  }
+}
+
+/*!
+  Add the times and counts of buffer to times and counts and reset them
+*/
+void ae_profiler::collect( thread_buffer& buffer, int64_t* times, int64_t* counts )
+{
+  for ( int8_t i = 0 ; i < NB_PHASES ; i++ )
+  {
+    times[i] += buffer.times[i].exchange( 0, std::memory_order_relaxed );
+  }
+  for ( int8_t i = 0 ; i < NB_COUNTERS ; i++ )
+  {
+    counts[i] += buffer.counts[i].exchange( 0, std::memory_order_relaxed );
+  }
+}
@@ -0,0 +1,218 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+/*!
+  \class ae_profiler
+  
+  \brief Per-phase timers and event counters of the evolutionary loop
+  
+  Only compiled in with --enable-profiling (which defines PROFILING). The
+  PROFILE_SCOPE( phase ) and PROFILE_COUNT( counter, n ) macros expand to
+  nothing otherwise, so that the instrumented code costs nothing by default.
+  
+  PROFILE_SCOPE( phase ) adds the time spent until the end of the enclosing
+  block to the phase. Phases may nest (e.g. ALIGNMENTS is part of MUTATIONS),
+  in which case the time is counted in both. Times and counts are kept by
+  each thread in a buffer of its own, so that they can be recorded without
+  any synchronization: the time of a phase run on the thread pool is hence
+  summed over all the threads (CPU time rather than wall-clock time).
+  
+  write_generation( num_gener ) adds a line to PROFILE_FNAME with the
+  wall-clock time elapsed since the previous call, then the times (in seconds)
+  and counts gathered since then, and resets them. It must be called while no
+  other thread is recording anything. When a run is resumed, the lines the
+  previous run wrote from the resumed generation on are dropped first.
+*/
+
+
+#ifndef __AE_PROFILER_H__
+#define __AE_PROFILER_H__
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+
+
+
+
+// =================================================================
+//                          Class declarations
+// =================================================================
+
+
+
+
+
+
+#ifdef PROFILING
+  #define PROFILE_CONCAT_( a, b ) a##b
+  #define PROFILE_CONCAT( a, b )  PROFILE_CONCAT_( a, b )
+  #define PROFILE_SCOPE( phase )        ae_profiler::scoped_timer PROFILE_CONCAT( _profile_timer_, __LINE__ )( ae_profiler::phase )
+  #define PROFILE_COUNT( counter, n )   ae_profiler::count( ae_profiler::counter, n )
+#else
+  #define PROFILE_SCOPE( phase )
+  #define PROFILE_COUNT( counter, n )
+#endif
+
+
+class ae_profiler
+{
+  public :
+    enum phase
+    {
+      COPY = 0,
+      MUTATIONS,
+      ALIGNMENTS,
+      TRANSCRIPTION,
+      TRANSLATION,
+      PHENOTYPE,
+      SELECTION,
+      STATS,
+      TREE,
+      BACKUP,
+      NB_PHASES
+    };
+    
+    enum counter
+    {
+      ALIGNMENTS_ATTEMPTED = 0,
+      ALIGNMENTS_FOUND,
+      PROMOTERS_SCANNED,
+      PROTEINS_BUILT,
+      NB_COUNTERS
+    };
+    
+    // Adds the time elapsed between its construction and its destruction to a phase
+    class scoped_timer
+    {
+      public :
+        inline scoped_timer( phase p );
+        inline ~scoped_timer( void );
+      
+      protected :
+        phase _phase;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    // =================================================================
+    //                            Public Methods
+    // =================================================================
+    static inline void add_time( phase p, int64_t nanoseconds );
+    static inline void count( counter c, int64_t n = 1 );
+    
+    static void write_generation( int32_t num_gener );
+    static void close( void );
+
+
+
+
+
+  protected :
+
+    // =================================================================
+    //                         Forbidden Constructors
+    // =================================================================
+    ae_profiler( void )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+    
+    // The times and counts recorded by one thread. Only this thread writes to
+    // them, the atomics merely make them readable from write_generation.
+    struct thread_buffer
+    {
+      thread_buffer( void );
+      ~thread_buffer( void );
+      
+      std::atomic<int64_t> times[NB_PHASES];
+      std::atomic<int64_t> counts[NB_COUNTERS];
+    };
+
+    // =================================================================
+    //                           Protected Methods
+    // =================================================================
+    static void collect( thread_buffer& buffer, int64_t* times, int64_t* counts );
+    static void open_file( int32_t first_gener );
+
+    // =================================================================
+    //                          Protected Attributes
+    // =================================================================
+    static thread_local thread_buffer _buffer;
+    
+    static std::mutex                   _mutex;    // Protects _buffers and _retired
+    static std::vector<thread_buffer*>  _buffers;  // Those of all the living threads
+    static int64_t  _retired_times[NB_PHASES];     // Left by the threads that ended
+    static int64_t  _retired_counts[NB_COUNTERS];
+    
+    static FILE*    _file;
+    static std::chrono::steady_clock::time_point _last_write; // Of the previous line (or start of the program)
+};
+
+
+// =====================================================================
+//                       Inline functions' definition
+// =====================================================================
+inline void ae_profiler::add_time( phase p, int64_t nanoseconds )
+{
+  std::atomic<int64_t>& time = _buffer.times[p];
+  time.store( time.load( std::memory_order_relaxed ) + nanoseconds, std::memory_order_relaxed );
+}
+
+inline void ae_profiler::count( counter c, int64_t n /*= 1*/ )
+{
+  std::atomic<int64_t>& cnt = _buffer.counts[c];
+  cnt.store( cnt.load( std::memory_order_relaxed ) + n, std::memory_order_relaxed );
+}
+
+inline ae_profiler::scoped_timer::scoped_timer( phase p )
+{
+  _phase = p;
+  _start = std::chrono::steady_clock::now();
+}
+
+inline ae_profiler::scoped_timer::~scoped_timer( void )
+{
+  add_time( _phase, std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - _start ).count() );
+}
+
+
+#endif // __AE_PROFILER_H__
@@ -0,0 +1,224 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+//
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//*****************************************************************************
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <string.h>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_promoter_list.h>
+#include <ae_rna.h>
+
+
+
+
+//##############################################################################
+//                                                                             #
+//                            Class ae_promoter_list                           #
+//                                                                             #
+//##############################################################################
+
+// =================================================================
+//                    Definition of static attributes
+// =================================================================
+
+// =================================================================
+//                             Constructors
+// =================================================================
+ae_promoter_list::ae_promoter_list( int32_t capacity /*= 16*/ )
+{
+  _nb_elts  = 0;
+  _capacity = ( capacity > 0 ) ? capacity : 1;
+  _rnas     = new ae_rna*[_capacity];
+  _pos      = new int32_t[_capacity];
+}
+
+// =================================================================
+//                             Destructors
+// =================================================================
+ae_promoter_list::~ae_promoter_list( void )
+{
+  delete [] _rnas;
+  delete [] _pos;
+}
+
+// =================================================================
+//                            Public Methods
+// =================================================================
+/*!
+  Replace the i-th RNA by rna, which must start at a position compatible with the order of the list
+*/
+void ae_promoter_list::set_rna( int32_t i, ae_rna* rna )
+{
+  assert( i >= 0 && i < _nb_elts );
+  _rnas[i]  = rna;
+  _pos[i]   = rna->get_promoter_pos();
+}
+
+void ae_promoter_list::set_promoter_pos( int32_t i, int32_t pos )
+{
+  assert( i >= 0 && i < _nb_elts );
+  _rnas[i]->set_promoter_pos( pos );
+  _pos[i] = pos;
+}
+
+/*!
+  Add rna at the end of the list
+*/
+void ae_promoter_list::add( ae_rna* rna )
+{
+  make_room( _nb_elts, 1 );
+  _rnas[_nb_elts - 1] = rna;
+  _pos[_nb_elts - 1]  = rna->get_promoter_pos();
+}
+
+/*!
+  Insert rna so that it becomes the i-th RNA of the list
+*/
+void ae_promoter_list::insert( int32_t i, ae_rna* rna )
+{
+  make_room( i, 1 );
+  _rnas[i]  = rna;
+  _pos[i]   = rna->get_promoter_pos();
+}
+
+/*!
+  Insert all the RNAs of rnas (in the same order) so that the first of them becomes the i-th RNA of the list
+
+  rnas is left untouched.
+*/
+void ae_promoter_list::insert( int32_t i, const ae_promoter_list* rnas )
+{
+  int32_t nb_inserted = rnas->_nb_elts;
+  if ( nb_inserted == 0 ) return;
+
+  make_room( i, nb_inserted );
+  memcpy( &_rnas[i], rnas->_rnas, nb_inserted * sizeof(*_rnas) );
+  memcpy( &_pos[i],  rnas->_pos,  nb_inserted * sizeof(*_pos) );
+}
+
+/*!
+  Remove the RNAs whose indices lie in [first ; last[ (and delete them if delete_rnas is true)
+*/
+void ae_promoter_list::remove( int32_t first, int32_t last, bool delete_rnas )
+{
+  assert( first >= 0 && first <= last && last <= _nb_elts );
+  if ( first == last ) return;
+
+  if ( delete_rnas )
+  {
+    for ( int32_t i = first ; i < last ; i++ )
+    {
+      delete _rnas[i];
+    }
+  }
+
+  memmove( &_rnas[first], &_rnas[last], ( _nb_elts - last ) * sizeof(*_rnas) );
+  memmove( &_pos[first],  &_pos[last],  ( _nb_elts - last ) * sizeof(*_pos) );
+  _nb_elts -= last - first;
+}
+
+/*!
+  Move the RNAs whose indices lie in [first ; last[ to the end of the list extracted
+*/
+void ae_promoter_list::extract( int32_t first, int32_t last, ae_promoter_list* extracted )
+{
+  assert( first >= 0 && first <= last && last <= _nb_elts );
+  if ( first == last ) return;
+
+  int32_t old_nb_elts = extracted->_nb_elts;
+  extracted->make_room( old_nb_elts, last - first );
+  memcpy( &extracted->_rnas[old_nb_elts], &_rnas[first], ( last - first ) * sizeof(*_rnas) );
+  memcpy( &extracted->_pos[old_nb_elts],  &_pos[first],  ( last - first ) * sizeof(*_pos) );
+
+  remove( first, last, false );
+}
+
+/*!
+  Shift by delta_pos (modulo seq_length) the RNAs whose indices lie in [first ; last[
+*/
+void ae_promoter_list::shift( int32_t first, int32_t last, int32_t delta_pos, int32_t seq_length )
+{
+  assert( first >= 0 && first <= last && last <= _nb_elts );
+
+  for ( int32_t i = first ; i < last ; i++ )
+  {
+    _rnas[i]->shift_position( delta_pos, seq_length );
+    _pos[i] = _rnas[i]->get_promoter_pos();
+  }
+}
+
+/*!
+  Empty the list (and delete the RNAs if delete_rnas is true)
+*/
+void ae_promoter_list::erase( bool delete_rnas )
+{
+  remove( 0, _nb_elts, delete_rnas );
+}
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+/*!
+  Open a gap of nb_elts free slots before the i-th RNA (reallocating if necessary)
+*/
+void ae_promoter_list::make_room( int32_t i, int32_t nb_elts )
+{
+  assert( i >= 0 && i <= _nb_elts );
+
+  if ( _nb_elts + nb_elts > _capacity )
+  {
+    while ( _nb_elts + nb_elts > _capacity ) _capacity *= 2;
+
+    ae_rna**  new_rnas  = new ae_rna*[_capacity];
+    int32_t*  new_pos   = new int32_t[_capacity];
+
+    memcpy( new_rnas, _rnas, i * sizeof(*_rnas) );
+    memcpy( new_pos,  _pos,  i * sizeof(*_pos) );
+    memcpy( &new_rnas[i + nb_elts], &_rnas[i], ( _nb_elts - i ) * sizeof(*_rnas) );
+    memcpy( &new_pos[i + nb_elts],  &_pos[i],  ( _nb_elts - i ) * sizeof(*_pos) );
+
+    delete [] _rnas;
+    delete [] _pos;
+    _rnas = new_rnas;
+    _pos  = new_pos;
+  }
+  else
+  {
+    memmove( &_rnas[i + nb_elts], &_rnas[i], ( _nb_elts - i ) * sizeof(*_rnas) );
+    memmove( &_pos[i + nb_elts],  &_pos[i],  ( _nb_elts - i ) * sizeof(*_pos) );
+  }
+
+  _nb_elts += nb_elts;
+}
@@ -0,0 +1,222 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+//
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//*****************************************************************************
+
+
+/*!
+  \class ae_promoter_list
+
+  \brief Sorted array of the RNAs (promoters) borne by one strand of a genetic unit
+
+  The RNAs are kept in the order they are met when reading the strand, i.e. in
+  increasing order of promoter position on the LEADING strand and in decreasing
+  order on the LAGGING strand. The promoter positions are mirrored in a
+  contiguous array so that range queries are binary searches that never
+  dereference an RNA.
+
+  get_boundary( strand, pos ) is the index of the first RNA of the list that
+  does not start before pos when reading the strand. Hence, the RNAs starting
+  in [pos_1 ; pos_2[ are those in [get_boundary( pos_1 ) ; get_boundary( pos_2 )[
+  on the LEADING strand and in [get_boundary( pos_2 ) ; get_boundary( pos_1 )[
+  on the LAGGING strand.
+
+  The mirror is only valid as long as promoter positions are changed through
+  the list (set_rna, set_promoter_pos, shift), never directly on the RNAs.
+  The RNAs are not owned by the list: they are only deleted when explicitly
+  asked for (erase( true ), remove( ..., true )).
+*/
+
+
+#ifndef __AE_PROMOTER_LIST_H__
+#define __AE_PROMOTER_LIST_H__
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_enums.h>
+#include <ae_object.h>
+
+
+
+
+// =================================================================
+//                          Class declarations
+// =================================================================
+class ae_rna;
+
+
+
+
+
+
+class ae_promoter_list : public ae_object
+{
+  public :
+
+    // =================================================================
+    //                             Constructors
+    // =================================================================
+    ae_promoter_list( int32_t capacity = 16 );
+
+    // =================================================================
+    //                             Destructors
+    // =================================================================
+    virtual ~ae_promoter_list( void );
+
+    // =================================================================
+    //                              Accessors
+    // =================================================================
+    inline int32_t  get_nb_elts( void ) const;
+    inline bool     is_empty( void ) const;
+    inline ae_rna*  get_rna( int32_t i ) const;
+    inline int32_t  get_promoter_pos( int32_t i ) const;
+
+    void set_rna( int32_t i, ae_rna* rna );
+    void set_promoter_pos( int32_t i, int32_t pos );
+
+    // =================================================================
+    //                            Public Methods
+    // =================================================================
+    inline int32_t get_boundary( ae_strand strand, int32_t pos ) const;
+
+    void add( ae_rna* rna );
+    void insert( int32_t i, ae_rna* rna );
+    void insert( int32_t i, const ae_promoter_list* rnas );
+    void remove( int32_t first, int32_t last, bool delete_rnas );
+    void extract( int32_t first, int32_t last, ae_promoter_list* extracted );
+    void shift( int32_t first, int32_t last, int32_t delta_pos, int32_t seq_length );
+    void erase( bool delete_rnas );
+
+    // =================================================================
+    //                           Public Attributes
+    // =================================================================
+
+
+
+
+
+  protected :
+
+    // =================================================================
+    //                         Forbidden Constructors
+    // =================================================================
+    ae_promoter_list( const ae_promoter_list &model )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+
+    // =================================================================
+    //                           Protected Methods
+    // =================================================================
+    void make_room( int32_t i, int32_t nb_elts );
+
+    // =================================================================
+    //                          Protected Attributes
+    // =================================================================
+    int32_t   _nb_elts;
+    int32_t   _capacity;
+    ae_rna**  _rnas;
+    int32_t*  _pos;   // _pos[i] == _rnas[i]->get_promoter_pos()
+};
+
+
+// =====================================================================
+//                           Getters' definitions
+// =====================================================================
+inline int32_t ae_promoter_list::get_nb_elts( void ) const
+{
+  return _nb_elts;
+}
+
+inline bool ae_promoter_list::is_empty( void ) const
+{
+  return ( _nb_elts == 0 );
+}
+
+inline ae_rna* ae_promoter_list::get_rna( int32_t i ) const
+{
+  assert( i >= 0 && i < _nb_elts );
+  return _rnas[i];
+}
+
+inline int32_t ae_promoter_list::get_promoter_pos( int32_t i ) const
+{
+  assert( i >= 0 && i < _nb_elts );
+  return _pos[i];
+}
+
+// =====================================================================
+//                           Setters' definitions
+// =====================================================================
+
+// =====================================================================
+//                          Operators' definitions
+// =====================================================================
+
+// =====================================================================
+//                       Inline functions' definition
+// =====================================================================
+/*!
+  Return the number of RNAs that start before pos when reading the strand,
+  i.e. those whose promoter position is < pos on the LEADING strand and
+  >= pos on the LAGGING strand.
+*/
+inline int32_t ae_promoter_list::get_boundary( ae_strand strand, int32_t pos ) const
+{
+  int32_t first = 0;
+  int32_t count = _nb_elts;
+
+  while ( count > 0 )
+  {
+    int32_t half = count >> 1;
+    bool before = ( strand == LEADING ) ? ( _pos[first + half] < pos ) : ( _pos[first + half] >= pos );
+    if ( before )
+    {
+      first += half + 1;
+      count -= half + 1;
+    }
+    else
+    {
+      count = half;
+    }
+  }
+
+  return first;
+}
+
+
+#endif // __AE_PROMOTER_LIST_H__
@@ -31,6 +31,7 @@
 //                              Libraries
 // =================================================================
 #include <math.h>
+#include <string.h>
 
 
 
@@ -39,7 +40,6 @@
 // =================================================================
 #include <ae_protein.h>
 
-#include <ae_codon.h>
 #include <ae_individual.h>
 #include <ae_genetic_unit.h>
 #include <ae_rna.h>
@@ -80,21 +80,9 @@ ae_protein::ae_protein( ae_genetic_unit* gen_unit, const ae_protein &model )
   
   _rna_list = new ae_list<ae_rna*>();
   
-  // Copy the list of amino-acids
-  _AA_list  = new ae_list<ae_codon*>();
-  
-  ae_list_node<ae_codon*>* AA_node = model._AA_list->get_first();
-  ae_codon* AA = NULL;
-
-  
-  while ( AA_node != NULL )
-  {
-    AA = AA_node->get_obj();
-    
-    _AA_list->add( new ae_codon( *AA ) );
-    
-    AA_node = AA_node->get_next();
-  }
+  // Copy the amino-acid sequence
+  _AA_seq = new int8_t[_length];
+  memcpy( _AA_seq, model._AA_seq, _length * sizeof(*_AA_seq) );
   
   // Copy triangle parameters
   _mean   = model._mean;
@@ -102,15 +90,41 @@ ae_protein::ae_protein( ae_genetic_unit* gen_unit, const ae_protein &model )
   _height = model._height;
 }
 
-ae_protein::ae_protein( ae_genetic_unit* gen_unit, ae_list<ae_codon*>* codon_list, ae_strand strand, int32_t shine_dal_pos, ae_rna* rna )
+/*!
+  Copy <model> as if it had just been translated from <rna> (see ae_genetic_unit::inherit_expression)
+
+  The CDS must be the same in <gen_unit> as in <model>'s genetic unit: the amino-acid
+  sequence and the triangle parameters are copied rather than decoded again.
+*/
+ae_protein::ae_protein( ae_genetic_unit* gen_unit, const ae_protein &model, ae_rna* rna ) :
+    ae_protein( gen_unit, model )
+{
+  // Same as a newly translated protein
+  #ifndef __REGUL
+    _concentration = rna->get_basal_level();
+  #else
+    _concentration = ae_common::with_heredity ? 0 : rna->get_basal_level();
+  #endif
+  
+  _rna_list->add( rna );
+}
+
+/*!
+  Translate the <length> codons following the START codon of the CDS whose Shine-Dalgarno
+  sequence lies at <shine_dal_pos> (the STOP codon must have been found by the caller)
+
+  The codons are decoded straight from <gen_unit>'s sequence.
+*/
+ae_protein::ae_protein( ae_genetic_unit* gen_unit, int32_t length, ae_strand strand, int32_t shine_dal_pos, ae_rna* rna )
 {
   assert( shine_dal_pos >= 0 );
   assert( shine_dal_pos < gen_unit->get_seq_length() );
+  assert( length > 0 );
 
   _gen_unit       = gen_unit;
   _strand         = strand;
   _shine_dal_pos  = shine_dal_pos;
-  _length         = codon_list->get_nb_elts();
+  _length         = length;
   
   #ifndef __REGUL
     // In Aevol the concentration of a new protein is set at the basal level
@@ -129,27 +143,28 @@ ae_protein::ae_protein( ae_genetic_unit* gen_unit, ae_list<ae_codon*>* codon_lis
     }
   #endif
   
-  // TODO : make this cleaner...
-  _AA_list = codon_list;
-  
   _rna_list = new ae_list<ae_rna*>();
   _rna_list->add( rna );
 
+  int32_t genome_length = _gen_unit->get_dna()->get_length();
+  int32_t step;
   if ( _strand == LEADING )
   {
-    _first_translated_pos = ae_utils::mod( _shine_dal_pos + (SHINE_DAL_SIZE + SHINE_START_SPACER + CODON_SIZE), _gen_unit->get_dna()->get_length() );
-    _last_translated_pos  = ae_utils::mod( _first_translated_pos + (_length * CODON_SIZE - 1), _gen_unit->get_dna()->get_length() );
+    _first_translated_pos = ae_utils::mod( _shine_dal_pos + (SHINE_DAL_SIZE + SHINE_START_SPACER + CODON_SIZE), genome_length );
+    _last_translated_pos  = ae_utils::mod( _first_translated_pos + (_length * CODON_SIZE - 1), genome_length );
+    step = CODON_SIZE;
   }
   else
   {
-    _first_translated_pos = ae_utils::mod( _shine_dal_pos - (SHINE_DAL_SIZE + SHINE_START_SPACER + CODON_SIZE), _gen_unit->get_dna()->get_length() );
-    _last_translated_pos = ae_utils::mod( _first_translated_pos - (_length * CODON_SIZE - 1), _gen_unit->get_dna()->get_length() );
+    _first_translated_pos = ae_utils::mod( _shine_dal_pos - (SHINE_DAL_SIZE + SHINE_START_SPACER + CODON_SIZE), genome_length );
+    _last_translated_pos = ae_utils::mod( _first_translated_pos - (_length * CODON_SIZE - 1), genome_length );
+    step = - CODON_SIZE;
   }
 
 
 
   // ============================================================================
-  // Folding process (compute phenotypic contribution parameters from codon list)
+  // Folding process (compute phenotypic contribution parameters from the codons)
   // ============================================================================
   //  1) Compute values for M, W and H
   //  2) Normalize M, W and H values according to number of codons of each kind
@@ -159,134 +174,58 @@ ae_protein::ae_protein( ae_genetic_unit* gen_unit, ae_list<ae_codon*>* codon_lis
   //  --------------------------------
   //  1) Compute values for M, W and H
   //  --------------------------------
-  long double M = 0.0;
-  long double W = 0.0;
-  long double H = 0.0;
-
-  int32_t nb_m = 0;
-  int32_t nb_w = 0;
-  int32_t nb_h = 0;
-
-  bool bin_m = false; // Initializing to false will yield a conservation of the high weight bit
-  bool bin_w = false; // when applying the XOR operator for the Gray to standard conversion
-  bool bin_h = false;
-
-  ae_list_node<ae_codon*>* node = codon_list->get_first();
-  ae_codon* codon = NULL;
-
-
-  while ( node != NULL )
+  // Each M, W or H codon is a bit of the Gray code of M, W or H respectively.
+  // Values are accumulated as integers as long as they fit in 64 bits (i.e. exactly),
+  // longer values are then carried on in long double arithmetic.
+  enum { M = 0, W = 1, H = 2 };
+  uint64_t    bits[3]   = { 0, 0, 0 };
+  long double values[3] = { 0.0, 0.0, 0.0 };
+  int32_t     nb[3]     = { 0, 0, 0 };
+  bool        bin[3]    = { false, false, false }; // Initializing to false will yield a conservation of the high weight bit
+                                                   // when applying the XOR operator for the Gray to standard conversion
+  
+  _AA_seq = new int8_t[_length];
+  
+  int32_t pos = _first_translated_pos;
+  for ( int32_t i = 0 ; i < _length ; i++ )
   {
-    codon = node->get_obj();
-
-    switch ( codon->get_value() )
+    int8_t codon = _gen_unit->get_codon( _strand, pos );
+    _AA_seq[i] = codon;
+    pos = ae_utils::mod( pos + step, genome_length );
+    
+    int8_t  kind;
+    bool    bit;
+    switch ( codon )
     {
-      case CODON_M0 :
-      {
-        // M codon found
-        nb_m++;
-
-        // Convert Gray code to "standard" binary code
-        bin_m ^= false; // as bin_m was initialized to false, the XOR will have no effect on the high weight bit
-
-        // A lower-than-the-previous-lowest weight bit was found, make a left bitwise shift
-        //~ M <<= 1;
-        M *= 2;
-
-        // Add this nucleotide's contribution to M
-        if ( bin_m ) M += 1;
-
-        break;
-      }
-      case CODON_M1 :
-      {
-        // M codon found
-        nb_m++;
-
-        // Convert Gray code to "standard" binary code
-        bin_m ^= true; // as bin_m was initialized to false, the XOR will have no effect on the high weight bit
-
-        // A lower-than-the-previous-lowest bit was found, make a left bitwise shift
-        //~ M <<= 1;
-        M *= 2;
-
-        // Add this nucleotide's contribution to M
-        if ( bin_m ) M += 1;
-
-        break;
-      }
-      case CODON_W0 :
-      {
-        // W codon found
-        nb_w++;
-
-        // Convert Gray code to "standard" binary code
-        bin_w ^= false; // as bin_m was initialized to false, the XOR will have no effect on the high weight bit
-
-        // A lower-than-the-previous-lowest weight bit was found, make a left bitwise shift
-        //~ W <<= 1;
-        W *= 2;
-
-        // Add this nucleotide's contribution to W
-        if ( bin_w ) W += 1;
-
-        break;
-      }
-      case CODON_W1 :
-      {
-        // W codon found
-        nb_w++;
-
-        // Convert Gray code to "standard" binary code
-        bin_w ^= true; // as bin_m was initialized to false, the XOR will have no effect on the high weight bit
-
-        // A lower-than-the-previous-lowest weight bit was found, make a left bitwise shift
-        //~ W <<= 1;
-        W *= 2;
-
-        // Add this nucleotide's contribution to W
-        if ( bin_w ) W += 1;
-
-        break;
-      }
+      case CODON_M0 :     kind = M; bit = false; break;
+      case CODON_M1 :     kind = M; bit = true;  break;
+      case CODON_W0 :     kind = W; bit = false; break;
+      case CODON_W1 :     kind = W; bit = true;  break;
       case CODON_H0 :
-      case CODON_START : // Start codon codes for the same amino-acid as H0 codon
-      {
-        // H codon found
-        nb_h++;
-
-        // Convert Gray code to "standard" binary code
-        bin_h ^= false; // as bin_m was initialized to false, the XOR will have no effect on the high weight bit
-
-        // A lower-than-the-previous-lowest weight bit was found, make a left bitwise shift
-        //~ H <<= 1;
-        H *= 2;
-
-        // Add this nucleotide's contribution to H
-        if ( bin_h ) H += 1;
-
-        break;
-      }
-      case CODON_H1 :
-      {
-        // H codon found
-        nb_h++;
-
-        // Convert Gray code to "standard" binary code
-        bin_h ^= true; // as bin_m was initialized to false, the XOR will have no effect on the high weight bit
-
-        // A lower-than-the-previous-lowest weight bit was found, make a left bitwise shift
-        //~ H <<= 1;
-        H *= 2;
-
-        // Add this nucleotide's contribution to H
-        if ( bin_h ) H += 1;
-
-        break;
-      }
+      case CODON_START :  kind = H; bit = false; break; // Start codon codes for the same amino-acid as H0 codon
+      case CODON_H1 :     kind = H; bit = true;  break;
+      default :           continue;
     }
-
-    node = node->get_next();
+    
+    // Convert Gray code to "standard" binary code
+    bin[kind] ^= bit;
+    
+    // A lower-than-the-previous-lowest weight bit was found, make a left bitwise shift
+    // and add this codon's contribution
+    if ( ++nb[kind] <= 64 )
+    {
+      bits[kind] = ( bits[kind] << 1 ) | bin[kind];
+    }
+    else
+    {
+      if ( nb[kind] == 65 ) values[kind] = bits[kind];
+      values[kind] = 2 * values[kind] + bin[kind];
+    }
+  }
+  
+  for ( int8_t kind = M ; kind <= H ; kind++ )
+  {
+    if ( nb[kind] <= 64 ) values[kind] = bits[kind];
   }
 
 
@@ -294,11 +233,11 @@ ae_protein::ae_protein( ae_genetic_unit* gen_unit, ae_list<ae_codon*>* codon_lis
   //  ----------------------------------------------------------------------------------
   //  2) Normalize M, W and H values in [0;1] according to number of codons of each kind
   //  ----------------------------------------------------------------------------------
-  if ( nb_m != 0 )  _mean = M / (pow(2, nb_m) - 1);
+  if ( nb[M] != 0 ) _mean = values[M] / (pow(2, nb[M]) - 1);
   else              _mean = 0.5;
-  if ( nb_w != 0 )  _width = W / (pow(2, nb_w) - 1);
+  if ( nb[W] != 0 ) _width = values[W] / (pow(2, nb[W]) - 1);
   else              _width = 0.0;
-  if ( nb_h != 0 )  _height = H / (pow(2, nb_h) - 1);
+  if ( nb[H] != 0 ) _height = values[H] / (pow(2, nb[H]) - 1);
   else              _height = 0.5;
 
   assert( _mean >= 0.0 && _mean <= 1.0 );
@@ -317,7 +256,7 @@ ae_protein::ae_protein( ae_genetic_unit* gen_unit, ae_list<ae_codon*>* codon_lis
   _width  = (get_indiv()->get_w_max() - W_MIN) * _width + W_MIN;
   _height = (H_MAX - H_MIN) * _height + H_MIN;
   
-  if ( nb_m == 0 || nb_w == 0 || nb_h == 0 || _width == 0.0 || _height == 0.0 )
+  if ( nb[M] == 0 || nb[W] == 0 || nb[H] == 0 || _width == 0.0 || _height == 0.0 )
   {
     _is_functional = false;
   }
@@ -366,14 +305,11 @@ ae_protein::ae_protein( gzFile backup_file )
   _rna_list = new ae_list<ae_rna*>();
 
   // Retreive the AA
-  _AA_list = new ae_list<ae_codon*>();
   int16_t nb_AA = 0;
   gzread( backup_file, &nb_AA,  sizeof(nb_AA) );
   
-  for ( int16_t i = 0 ; i < nb_AA ; i++ )
-  {
-    _AA_list->add( new ae_codon( backup_file ) );
-  }
+  _AA_seq = new int8_t[nb_AA];
+  gzread( backup_file, _AA_seq, nb_AA * sizeof(*_AA_seq) );
   
 }
 
@@ -385,8 +321,7 @@ ae_protein::~ae_protein( void )
   _rna_list->erase( false );
   delete _rna_list;
   
-  _AA_list->erase( true );
-  delete _AA_list;
+  delete [] _AA_seq;
 }
 
 // =================================================================
@@ -414,16 +349,12 @@ char* ae_protein::get_AA_sequence( void ) const
 {
   char* seq = new char[3*_length]; // + 1 (for the '\0')  - 1 (_length - 1 spaces)
   
-  ae_list_node<ae_codon*>* codon_node = _AA_list->get_first();
-  
   int32_t i = 0;
-  while ( codon_node != NULL )
+  for ( int32_t j = 0 ; j < _length ; j++ )
   {
-    ae_codon* codon = codon_node->get_obj();
-    
     if ( i != 0 ) seq[i++] = ' ';
     
-    switch ( codon->get_value() )
+    switch ( _AA_seq[j] )
     {
       case CODON_START :
       {
@@ -468,8 +399,6 @@ char* ae_protein::get_AA_sequence( void ) const
         break;
       }
     }
-    
-    codon_node = codon_node->get_next();
   }
   
   seq[3*_length-1] = '\0';
@@ -492,20 +421,9 @@ void ae_protein::save( gzFile backup_file )
   gzwrite( backup_file, &_height,		     	      sizeof(_height)               );
 
   // Write the Acide Amino in the backup file
-  int16_t nb_AA = _AA_list->get_nb_elts();
+  int16_t nb_AA = _length;
   gzwrite( backup_file, &nb_AA,  sizeof(nb_AA) );
-
-  ae_list_node<ae_codon*>* AA_node = _AA_list->get_first();
-  ae_codon* AA;
-
-  for ( int16_t i = 0 ; i < nb_AA ; i++ )
-  {
-  AA = AA_node->get_obj();
-   
-  AA->save( backup_file );
-    
-  AA_node = AA_node->get_next();
-  }
+  gzwrite( backup_file, _AA_seq, nb_AA * sizeof(*_AA_seq) );
 }
 
 // =================================================================
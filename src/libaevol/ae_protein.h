@@ -44,7 +44,6 @@
 #include <ae_object.h>
 #include <ae_macros.h>
 #include <ae_dna.h>
-#include <ae_codon.h>
 
 
 
@@ -67,7 +66,8 @@ class ae_protein : public ae_object
     //                             Constructors
     // =================================================================
     ae_protein( ae_genetic_unit* gen_unit, const ae_protein &model );
-    ae_protein( ae_genetic_unit* gen_unit, ae_list<ae_codon*>* codon_list, ae_strand strand, int32_t shine_dal, ae_rna* rna );
+    ae_protein( ae_genetic_unit* gen_unit, const ae_protein &model, ae_rna* rna );
+    ae_protein( ae_genetic_unit* gen_unit, int32_t length, ae_strand strand, int32_t shine_dal, ae_rna* rna );
     //ae_protein( ae_protein* parent );
     ae_protein( gzFile backup_file );
     // =================================================================
@@ -90,6 +90,7 @@ class ae_protein : public ae_object
     inline int32_t            get_length( void )                const; // Number of Amino-Acids (not including START and STOP)
     inline double             get_concentration( void )         const;
     inline  bool              get_is_functional( void )         const;
+    inline int8_t             get_AA( int32_t i )               const;
     
     ae_individual* get_indiv( void ) const;
 
@@ -141,7 +142,7 @@ class ae_protein : public ae_object
     double            _concentration;
     bool              _is_functional;
     
-    ae_list<ae_codon*>* _AA_list;
+    int8_t*           _AA_seq;                // Codons of the amino-acids (one per byte)
 
     // Phenotypic contribution (triangle) parameters
     double _mean;
@@ -208,6 +209,12 @@ bool ae_protein::get_is_functional( void ) const
   return _is_functional;
 }
 
+int8_t ae_protein::get_AA( int32_t i ) const
+{
+  assert( i >= 0 && i < _length );
+  return _AA_seq[i];
+}
+
 
 // =====================================================================
 //                       Inline functions' definition
@@ -36,7 +36,6 @@
 // =================================================================
 #include <ae_protein_R.h>
 #include <ae_influence_R.h>
-#include <ae_codon.h>
 
 //##############################################################################
 //                                                                             #
@@ -58,9 +57,9 @@ ae_protein_R::ae_protein_R( ae_genetic_unit* gen_unit, const ae_protein_R &model
   _inherited            = false;
 }
 
-ae_protein_R::ae_protein_R( ae_genetic_unit* gen_unit, ae_list* codon_list, ae_strand strand, int32_t shine_dal_pos,
+ae_protein_R::ae_protein_R( ae_genetic_unit* gen_unit, int32_t length, ae_strand strand, int32_t shine_dal_pos,
                             ae_rna* rna )  :
-  ae_protein( gen_unit, codon_list, strand, shine_dal_pos, rna )
+  ae_protein( gen_unit, length, strand, shine_dal_pos, rna )
 {
   _influence_list       = new ae_list();
   _delta_concentration  = 0;
@@ -126,7 +125,7 @@ void ae_protein_R::compute_delta_concentration( void )
 
 int8_t ae_protein_R::get_codon( int32_t index )
 {
-  return dynamic_cast< ae_codon* >( _AA_list->get_object( index ) )->get_value();
+  return get_AA( index );
 }
 
 void ae_protein_R::add_influence( ae_influence_R *influence )
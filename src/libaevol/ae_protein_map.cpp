@@ -0,0 +1,140 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+//
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//*****************************************************************************
+
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <string.h>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_protein_map.h>
+#include <ae_protein.h>
+
+
+
+
+//##############################################################################
+//                                                                             #
+//                             Class ae_protein_map                            #
+//                                                                             #
+//##############################################################################
+
+// =================================================================
+//                    Definition of static attributes
+// =================================================================
+
+// =================================================================
+//                             Constructors
+// =================================================================
+ae_protein_map::ae_protein_map( int8_t log_capacity /*= 5*/ )
+{
+  _nb_elts      = 0;
+  _log_capacity = log_capacity;
+  _keys         = new int32_t[1 << _log_capacity];
+  _proteins     = new ae_protein*[1 << _log_capacity];
+
+  memset( _keys, -1, ( 1 << _log_capacity ) * sizeof(*_keys) );
+  memset( _proteins, 0, ( 1 << _log_capacity ) * sizeof(*_proteins) );
+}
+
+// =================================================================
+//                             Destructors
+// =================================================================
+ae_protein_map::~ae_protein_map( void )
+{
+  delete [] _keys;
+  delete [] _proteins;
+}
+
+// =================================================================
+//                            Public Methods
+// =================================================================
+/*!
+  Add protein to the map (there must not already be a protein at the same position)
+*/
+void ae_protein_map::add( ae_protein* protein )
+{
+  if ( 2 * ( _nb_elts + 1 ) > ( 1 << _log_capacity ) ) grow();
+
+  int32_t slot = get_slot( protein->get_shine_dal_pos() );
+  assert( _keys[slot] == -1 );
+
+  _keys[slot]     = protein->get_shine_dal_pos();
+  _proteins[slot] = protein;
+  _nb_elts++;
+}
+
+/*!
+  Empty the map (the proteins are not deleted)
+*/
+void ae_protein_map::erase( void )
+{
+  if ( _nb_elts == 0 ) return;
+
+  memset( _keys, -1, ( 1 << _log_capacity ) * sizeof(*_keys) );
+  memset( _proteins, 0, ( 1 << _log_capacity ) * sizeof(*_proteins) );
+  _nb_elts = 0;
+}
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+/*!
+  Double the capacity of the map and re-hash its content
+*/
+void ae_protein_map::grow( void )
+{
+  int32_t       old_capacity  = 1 << _log_capacity;
+  int32_t*      old_keys      = _keys;
+  ae_protein**  old_proteins  = _proteins;
+
+  _log_capacity++;
+  _keys     = new int32_t[1 << _log_capacity];
+  _proteins = new ae_protein*[1 << _log_capacity];
+  memset( _keys, -1, ( 1 << _log_capacity ) * sizeof(*_keys) );
+  memset( _proteins, 0, ( 1 << _log_capacity ) * sizeof(*_proteins) );
+
+  for ( int32_t i = 0 ; i < old_capacity ; i++ )
+  {
+    if ( old_keys[i] != -1 )
+    {
+      int32_t slot = get_slot( old_keys[i] );
+      _keys[slot]     = old_keys[i];
+      _proteins[slot] = old_proteins[i];
+    }
+  }
+
+  delete [] old_keys;
+  delete [] old_proteins;
+}
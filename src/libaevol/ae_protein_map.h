@@ -0,0 +1,181 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+//
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+//*****************************************************************************
+
+
+
+/*!
+  \class ae_protein_map
+
+  \brief Index of the proteins borne by one strand of a genetic unit, keyed by Shine-Dalgarno position
+
+  Open-addressing hash table (linear probing) whose capacity is a power of 2,
+  kept at most half full. It is filled during translation to find out in
+  constant time whether a CDS has already been translated from another RNA.
+  The proteins are not owned by the map.
+*/
+
+
+#ifndef __AE_PROTEIN_MAP_H__
+#define __AE_PROTEIN_MAP_H__
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_object.h>
+
+
+
+
+// =================================================================
+//                          Class declarations
+// =================================================================
+class ae_protein;
+
+
+
+
+
+
+class ae_protein_map : public ae_object
+{
+  public :
+
+    // =================================================================
+    //                             Constructors
+    // =================================================================
+    ae_protein_map( int8_t log_capacity = 5 );
+
+    // =================================================================
+    //                             Destructors
+    // =================================================================
+    virtual ~ae_protein_map( void );
+
+    // =================================================================
+    //                              Accessors
+    // =================================================================
+    inline int32_t get_nb_elts( void ) const;
+
+    // =================================================================
+    //                            Public Methods
+    // =================================================================
+    inline ae_protein* get( int32_t shine_dal_pos ) const;
+
+    void add( ae_protein* protein );
+    void erase( void );
+
+    // =================================================================
+    //                           Public Attributes
+    // =================================================================
+
+
+
+
+
+  protected :
+
+    // =================================================================
+    //                         Forbidden Constructors
+    // =================================================================
+    ae_protein_map( const ae_protein_map &model )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+
+    // =================================================================
+    //                           Protected Methods
+    // =================================================================
+    inline int32_t get_slot( int32_t shine_dal_pos ) const;
+    void grow( void );
+
+    // =================================================================
+    //                          Protected Attributes
+    // =================================================================
+    int32_t       _nb_elts;
+    int8_t        _log_capacity;
+    int32_t*      _keys;      // Shine-Dalgarno position of the protein in each slot (-1 if empty)
+    ae_protein**  _proteins;
+};
+
+
+// =====================================================================
+//                           Getters' definitions
+// =====================================================================
+inline int32_t ae_protein_map::get_nb_elts( void ) const
+{
+  return _nb_elts;
+}
+
+// =====================================================================
+//                           Setters' definitions
+// =====================================================================
+
+// =====================================================================
+//                          Operators' definitions
+// =====================================================================
+
+// =====================================================================
+//                       Inline functions' definition
+// =====================================================================
+/*!
+  Return the protein whose Shine-Dalgarno sequence lies at shine_dal_pos (NULL if there is none)
+*/
+inline ae_protein* ae_protein_map::get( int32_t shine_dal_pos ) const
+{
+  return _proteins[get_slot( shine_dal_pos )];
+}
+
+/*!
+  Return the slot holding the protein at shine_dal_pos or, if there is none, the empty slot where it would be added
+*/
+inline int32_t ae_protein_map::get_slot( int32_t shine_dal_pos ) const
+{
+  assert( shine_dal_pos >= 0 );
+
+  int32_t mask = ( 1 << _log_capacity ) - 1;
+  int32_t slot = ( (uint32_t) shine_dal_pos * UINT32_C(2654435769) ) >> ( 32 - _log_capacity );
+
+  while ( _keys[slot] != -1 && _keys[slot] != shine_dal_pos )
+  {
+    slot = ( slot + 1 ) & mask;
+  }
+
+  return slot;
+}
+
+
+#endif // __AE_PROTEIN_MAP_H__
@@ -39,6 +39,7 @@
 #include <ae_selection.h>
 #include <ae_exp_manager.h>
 #include <ae_vis_a_vis.h>
+#include <ae_profiler.h>
 
 #ifdef __NO_X
   #ifndef __REGUL
@@ -136,10 +137,12 @@ void ae_selection::step_to_next_generation( void )
   }
   
   
+  #ifndef DISTRIBUTED_PRNG
   if ( _exp_m->get_pop()->get_indiv_by_id( 0 )->get_with_stochasticity() )
   {
     _exp_m->get_pop()->backup_stoch_prng();
   }
+  #endif
 
 
   // -------------------------------------------------------------------------------
@@ -160,7 +163,10 @@ void ae_selection::step_to_next_generation( void )
   // --------------------------------------------------------------------------------------------------------
   int32_t  nb_indivs = _exp_m->get_pop()->get_nb_indivs();
   int32_t* nb_offsprings = new int32_t[nb_indivs];
-  _prng->multinomial_drawing( nb_offsprings, _prob_reprod, nb_indivs, nb_indivs );
+  {
+    PROFILE_SCOPE( SELECTION );
+    _prng->multinomial_drawing( nb_offsprings, _prob_reprod, nb_indivs, nb_indivs );
+  }
 
   // ------------------------------------------------------------------------------
   // 3) Make the selected individuals "reproduce", thus creating the new generation
@@ -172,39 +178,73 @@ void ae_selection::step_to_next_generation( void )
   ae_individual*  indiv           = NULL;
   int32_t         index_new_indiv = 0;
 
-  for ( int32_t i = 0 ; i < nb_indivs ; i++ )
+  if ( _exp_m->get_thread_pool() != NULL )
   {
-    // Make indiv i reproduce (nb_offsprings[i] offsprings)
-    indiv = indiv_node->get_obj();
+    // Assign its parent to each new individual (in the order of the
+    // sequential version below) and have them all created at once
+    ae_individual** parents   = new ae_individual* [nb_indivs];
+    ae_individual** offspring = new ae_individual* [nb_indivs];
     
-    next_indiv_node = indiv_node->get_next();
-    
-    for ( int32_t j = 0 ; j < nb_offsprings[i] ; j++ )
+    for ( int32_t i = 0 ; i < nb_indivs ; i++ )
     {
-      #ifdef DISTRIBUTED_PRNG
-        #error Not implemented yet !
-        // For all but the first time, Take a jump in the PRNG
-        if ( j > 0 ) indiv->do_prng_jump();
-      #endif
+      for ( int32_t j = 0 ; j < nb_offsprings[i] ; j++ )
+      {
+        parents[index_new_indiv++] = indiv_node->get_obj();
+      }
       
-      // Create a new individual (evaluated at the end of do_replication)
-      new_generation->add( do_replication( indiv, index_new_indiv++ ) );
+      indiv_node = indiv_node->get_next();
     }
     
-    // All the offsprings of this individual have been generated, if there is no transfer,
-    // the indiv will not be used any more and can hence be deleted
-    if ( (not _exp_m->get_with_HT()) and (not _exp_m->get_with_plasmids()) )
+    do_replications( nb_indivs, parents, offspring );
+    
+    for ( int32_t i = 0 ; i < nb_indivs ; i++ )
     {
-      old_generation->remove( indiv_node, true, true );
+      new_generation->add( offspring[i] );
     }
-        
-    indiv_node = next_indiv_node;
+    
+    // The parents are not needed any more
+    old_generation->erase( true );
+    
+    delete [] parents;
+    delete [] offspring;
   }
-  
-  if ( _exp_m->get_with_HT() or _exp_m->get_with_plasmids() )
+  else
   {
-    // The individuals have not yet been deleted, do it now.
-    old_generation->erase( true );
+    for ( int32_t i = 0 ; i < nb_indivs ; i++ )
+    {
+      // Make indiv i reproduce (nb_offsprings[i] offsprings)
+      indiv = indiv_node->get_obj();
+      
+      next_indiv_node = indiv_node->get_next();
+      
+      for ( int32_t j = 0 ; j < nb_offsprings[i] ; j++ )
+      {
+        // Create a new individual (evaluated at the end of do_replication)
+        #ifdef DISTRIBUTED_PRNG
+          // Give it PRNGs of its own (see ae_population::new_mut_prng_stream)
+          new_generation->add( do_replication( indiv, index_new_indiv++, -1, -1,
+                                               _exp_m->get_pop()->new_mut_prng_stream(),
+                                               _exp_m->get_pop()->new_stoch_prng_stream() ) );
+        #else
+          new_generation->add( do_replication( indiv, index_new_indiv++ ) );
+        #endif
+      }
+      
+      // All the offsprings of this individual have been generated, if there is no transfer,
+      // the indiv will not be used any more and can hence be deleted
+      if ( (not _exp_m->get_with_HT()) and (not _exp_m->get_with_plasmids()) )
+      {
+        old_generation->remove( indiv_node, true, true );
+      }
+          
+      indiv_node = next_indiv_node;
+    }
+    
+    if ( _exp_m->get_with_HT() or _exp_m->get_with_plasmids() )
+    {
+      // The individuals have not yet been deleted, do it now.
+      old_generation->erase( true );
+    }
   }
   
 
@@ -256,6 +296,8 @@ void ae_selection::step_to_next_generation_grid( void )
   
   ae_grid_cell*** pop_grid = _exp_m->get_pop_grid();
   
+  ae_thread_pool* thread_pool = _exp_m->get_thread_pool();
+  
   // create a temporary grid to store new individuals
   ae_individual*** new_indiv_grid = new ae_individual** [grid_width];
   for ( int16_t i = 0 ; i < grid_width ; i++ )
@@ -264,12 +306,25 @@ void ae_selection::step_to_next_generation_grid( void )
   }
   
   
-  // Do local competitions
-  for ( int16_t x = 0 ; x < grid_width ; x++ )
+  // Do local competitions (with DISTRIBUTED_PRNG, always by tile so that the
+  // outcome does not depend on whether the run is parallelised)
+  #ifdef DISTRIBUTED_PRNG
+    bool by_tile = true;
+  #else
+    bool by_tile = ( thread_pool != NULL );
+  #endif
+  if ( by_tile )
+  {
+    do_local_competitions_by_tile( new_indiv_grid );
+  }
+  else
   {
-    for ( int16_t y = 0 ; y < grid_height ; y++ )
+    for ( int16_t x = 0 ; x < grid_width ; x++ )
     {
-      new_indiv_grid[x][y] = calculate_local_competition( x, y );
+      for ( int16_t y = 0 ; y < grid_height ; y++ )
+      {
+        new_indiv_grid[x][y] = calculate_local_competition( x, y );
+      }
     }
   }
   
@@ -277,34 +332,83 @@ void ae_selection::step_to_next_generation_grid( void )
   // Add the compound secreted by the individuals
   if ( _exp_m->get_with_secretion() )
   {
-    double tmp_secretion; 
-    for ( int16_t x = 0 ; x < grid_width ; x++ )
+    auto secrete = [&]( int32_t x )
     {
+      double tmp_secretion; 
       for ( int16_t y = 0 ; y < grid_height ; y++ )
       {
         tmp_secretion = pop_grid[x][y]->get_compound_amount() + pop_grid[x][y]->get_individual()->get_fitness_by_feature(SECRETION);        
         pop_grid[x][y]->set_compound_amount( tmp_secretion );
       }
+    };
+    
+    if ( thread_pool != NULL )
+    {
+      thread_pool->run( grid_width, secrete );
+    }
+    else
+    {
+      for ( int16_t x = 0 ; x < grid_width ; x++ ) secrete( x );
     }
     
     // Diffusion and degradation of compound in the environment
-    sp_struct->update_secretion_grid();
+    sp_struct->update_secretion_grid( thread_pool );
   }
   
   
   // Create the new generation
   ae_list<ae_individual*>* new_generation = new ae_list<ae_individual*>();
   int32_t index_new_indiv = 0;
-  for ( int16_t x = 0 ; x < grid_width ; x++ )
+  if ( thread_pool != NULL )
   {
-    for ( int16_t y = 0 ; y < grid_height ; y++ )
+    // Have all the new individuals created at once, in the order of the
+    // sequential version below
+    int32_t         nb_indivs = grid_width * grid_height;
+    ae_individual** parents   = new ae_individual* [nb_indivs];
+    ae_individual** offspring = new ae_individual* [nb_indivs];
+    int16_t*        xs        = new int16_t [nb_indivs];
+    int16_t*        ys        = new int16_t [nb_indivs];
+    
+    for ( int16_t x = 0 ; x < grid_width ; x++ )
     {
-      pop_grid[x][y]->set_individual( do_replication( new_indiv_grid[x][y], index_new_indiv++, x, y ) );
-      #ifdef DISTRIBUTED_PRNG
-        #error Not implemented yet !
-        new_indiv_grid[x][y]->do_prng_jump();
-      #endif
-      new_generation->add( pop_grid[x][y]->get_individual() );
+      for ( int16_t y = 0 ; y < grid_height ; y++ )
+      {
+        parents[index_new_indiv]  = new_indiv_grid[x][y];
+        xs[index_new_indiv]       = x;
+        ys[index_new_indiv]       = y;
+        index_new_indiv++;
+      }
+    }
+    
+    do_replications( nb_indivs, parents, offspring, xs, ys );
+    
+    for ( int32_t i = 0 ; i < nb_indivs ; i++ )
+    {
+      pop_grid[xs[i]][ys[i]]->set_individual( offspring[i] );
+      new_generation->add( offspring[i] );
+    }
+    
+    delete [] parents;
+    delete [] offspring;
+    delete [] xs;
+    delete [] ys;
+  }
+  else
+  {
+    for ( int16_t x = 0 ; x < grid_width ; x++ )
+    {
+      for ( int16_t y = 0 ; y < grid_height ; y++ )
+      {
+        #ifdef DISTRIBUTED_PRNG
+          // Give the new individual PRNGs of its own (see ae_population::new_mut_prng_stream)
+          pop_grid[x][y]->set_individual( do_replication( new_indiv_grid[x][y], index_new_indiv++, x, y,
+                                                          _exp_m->get_pop()->new_mut_prng_stream(),
+                                                          _exp_m->get_pop()->new_stoch_prng_stream() ) );
+        #else
+          pop_grid[x][y]->set_individual( do_replication( new_indiv_grid[x][y], index_new_indiv++, x, y ) );
+        #endif
+        new_generation->add( pop_grid[x][y]->get_individual() );
+      }
     }
   }
   
@@ -487,6 +591,8 @@ void ae_selection::load( FILE*& exp_setup_file,
 // =================================================================
 void ae_selection::compute_prob_reprod( void )
 {
+  PROFILE_SCOPE( SELECTION );
+  
   if ( _prob_reprod != NULL )
   {
     delete [] _prob_reprod;
@@ -590,6 +696,8 @@ void ae_selection::compute_prob_reprod( void )
 
 void ae_selection::compute_local_prob_reprod( void )
 {
+  PROFILE_SCOPE( SELECTION );
+  
   int16_t neighborhood_size = 9;
   
   if ( _prob_reprod != NULL )
@@ -641,26 +749,55 @@ void ae_selection::compute_local_prob_reprod( void )
   }
 }
 
-ae_individual* ae_selection::do_replication( ae_individual* parent, int32_t index, int16_t x /*= -1 */, int16_t y /*= -1 */ )
+/*!
+  Create the offspring <index> of <parent>, mutate and evaluate it.
+
+  Unless a mutation PRNG is provided, the mutations are drawn from the parent's
+  mutation PRNG and the other random events (plasmid order, binary secretion)
+  from the selection PRNG. When <mut_prng> is provided, it is used for all of
+  these instead.
+
+  With DISTRIBUTED_PRNG, the new individual owns its PRNGs: it takes the ones
+  provided or, if none are, copies of its parent's (the parent's PRNGs then
+  jump ahead so that its next offspring will not draw the same numbers).
+*/
+ae_individual* ae_selection::do_replication( ae_individual* parent, int32_t index, int16_t x /*= -1 */, int16_t y /*= -1 */,
+                                             ae_jumping_mt* mut_prng /*= NULL */, ae_jumping_mt* stoch_prng /*= NULL */ )
 {
   ae_individual* new_indiv = NULL;
+  ae_jumping_mt* sel_prng  = ( mut_prng != NULL ) ? mut_prng : _prng;
+  
+  #ifdef DISTRIBUTED_PRNG
+    if ( mut_prng == NULL )
+    {
+      mut_prng    = new ae_jumping_mt( *(parent->get_mut_prng()) );
+      stoch_prng  = ( parent->get_stoch_prng() == NULL ) ? NULL : new ae_jumping_mt( *(parent->get_stoch_prng()) );
+      parent->do_prng_jump();
+    }
+  #else
+    if ( mut_prng == NULL )   mut_prng    = parent->get_mut_prng();
+    if ( stoch_prng == NULL ) stoch_prng  = parent->get_stoch_prng();
+  #endif
 
   // ===========================================================================
   //  1) Copy parent
   // ===========================================================================
-  #ifdef __NO_X
-    #ifndef __REGUL
-      new_indiv = new ae_individual( parent, index, parent->get_mut_prng(), parent->get_stoch_prng() );
-    #else
-      new_indiv = new ae_individual_R( dynamic_cast<ae_individual_R*>(parent), index, parent->get_mut_prng(), parent->get_stoch_prng() );
-    #endif
-  #elif defined __X11
-    #ifndef __REGUL
-      new_indiv = new ae_individual_X11( dynamic_cast<ae_individual_X11*>(parent), index, parent->get_mut_prng(), parent->get_stoch_prng() );
-    #else
-      new_indiv = new ae_individual_R_X11( dynamic_cast<ae_individual_R_X11*>(parent), index, parent->get_mut_prng(), parent->get_stoch_prng() );
+  {
+    PROFILE_SCOPE( COPY );
+    #ifdef __NO_X
+      #ifndef __REGUL
+        new_indiv = new ae_individual( parent, index, mut_prng, stoch_prng );
+      #else
+        new_indiv = new ae_individual_R( dynamic_cast<ae_individual_R*>(parent), index, mut_prng, stoch_prng );
+      #endif
+    #elif defined __X11
+      #ifndef __REGUL
+        new_indiv = new ae_individual_X11( dynamic_cast<ae_individual_X11*>(parent), index, mut_prng, stoch_prng );
+      #else
+        new_indiv = new ae_individual_R_X11( dynamic_cast<ae_individual_R_X11*>(parent), index, mut_prng, stoch_prng );
+      #endif
     #endif
-  #endif
+  }
   
   
   // ===========================================================================
@@ -693,7 +830,7 @@ ae_individual* ae_selection::do_replication( ae_individual* parent, int32_t inde
     ae_genetic_unit* gen_unit = NULL;
     
     // Randomly determine the order in which the GUs will undergo mutations
-    bool inverse_order = (_prng->random((int32_t) 2) < 0.5);
+    bool inverse_order = (sel_prng->random((int32_t) 2) < 0.5);
     
     if ( ! inverse_order )
     // Apply mutations in normal GU order
@@ -739,11 +876,11 @@ ae_individual* ae_selection::do_replication( ae_individual* parent, int32_t inde
   if (_exp_m->get_with_secretion())
   {
     int32_t oldsecretion = new_indiv->get_int_probes()[0];
-    if ((oldsecretion==1) && (get_prng()->random()<_mutcd))
+    if ((oldsecretion==1) && (sel_prng->random()<_mutcd))
     {
       new_indiv->get_int_probes()[0] = 0;
     }
-    if ((oldsecretion==0) && (get_prng()->random()<_mutdc))
+    if ((oldsecretion==0) && (sel_prng->random()<_mutdc))
     {
       new_indiv->get_int_probes()[0] = 1;
     }
@@ -753,7 +890,17 @@ ae_individual* ae_selection::do_replication( ae_individual* parent, int32_t inde
   
   // ===========================================================================
   //  4) Evaluate new individual
+  //     (an individual that underwent no mutation at all takes its parent's
+  //     evaluation over, otherwise the genetic units that underwent no
+  //     mutation express as the parent's and those that only underwent
+  //     switches only recompute the RNAs and proteins they affect)
   // ===========================================================================
+  #ifndef __REGUL
+    if ( ! new_indiv->inherit_evaluation( parent ) )
+    {
+      new_indiv->inherit_expression( parent );
+    }
+  #endif
   new_indiv->evaluate();
   
   
@@ -772,10 +919,147 @@ ae_individual* ae_selection::do_replication( ae_individual* parent, int32_t inde
   return new_indiv;
 }
 
-ae_individual* ae_selection::calculate_local_competition ( int16_t x, int16_t y )
+/*!
+  Create nb_offspring new individuals, offspring[i] being a child of parents[i]
+  (located at x[i], y[i] if the population is spatially structured).
+
+  Each offspring draws its random events from a stream of its own (see
+  ae_population::new_mut_prng_stream), the streams being created in the order
+  of the offspring. The outcome of the replications hence does not depend on
+  the order in which they are actually performed, which allows them to be
+  distributed over the threads of the experiment's thread pool.
+  
+  With DISTRIBUTED_PRNG, the offspring keep their streams. Otherwise, the
+  streams only last for the replication.
+*/
+void ae_selection::do_replications( int32_t nb_offspring, ae_individual** parents, ae_individual** offspring,
+                                    int16_t* x /*= NULL*/, int16_t* y /*= NULL*/ )
+{
+  ae_population*  pop         = _exp_m->get_pop();
+  ae_jumping_mt** mut_prngs   = new ae_jumping_mt* [nb_offspring];
+  ae_jumping_mt** stoch_prngs = new ae_jumping_mt* [nb_offspring];
+  
+  for ( int32_t i = 0 ; i < nb_offspring ; i++ )
+  {
+    mut_prngs[i] = pop->new_mut_prng_stream();
+    #ifdef DISTRIBUTED_PRNG
+      stoch_prngs[i] = pop->new_stoch_prng_stream();
+    #else
+      stoch_prngs[i] = NULL;
+    #endif
+  }
+  
+  auto replicate = [&]( int32_t i )
+  {
+    offspring[i] = do_replication( parents[i], i,
+                                   ( x != NULL ) ? x[i] : -1,
+                                   ( y != NULL ) ? y[i] : -1,
+                                   mut_prngs[i], stoch_prngs[i] );
+  };
+  
+  if ( replications_are_independent() )
+  {
+    _exp_m->get_thread_pool()->run( nb_offspring, replicate );
+  }
+  else
+  {
+    for ( int32_t i = 0 ; i < nb_offspring ; i++ ) replicate( i );
+  }
+  
+  #ifndef DISTRIBUTED_PRNG
+    // The streams were only meant to last for the replication
+    for ( int32_t i = 0 ; i < nb_offspring ; i++ )
+    {
+      offspring[i]->set_mut_prng( pop->get_mut_prng() );
+      delete mut_prngs[i];
+    }
+  #endif
+  delete [] mut_prngs;
+  delete [] stoch_prngs;
+}
+
+/*!
+  Whether the replications can safely be performed concurrently.
+
+  This is not the case when the mutations rely on shared resources: transfer
+  draws from the selection PRNG (and reads the whole population) and logged
+  events must be written in order.
+*/
+bool ae_selection::replications_are_independent( void ) const
+{
+  return  ( ! _exp_m->get_with_HT() ) &&
+          ( ! _exp_m->get_output_m()->is_logged( LOG_TRANSFER ) ) &&
+          ( ! _exp_m->get_output_m()->is_logged( LOG_REAR ) ) &&
+          ( ! _exp_m->get_output_m()->is_logged( LOG_BARRIER ) );
+}
+
+/*!
+  Do the local competitions of the whole grid on the experiment's thread pool
+  (or tile after tile if there is none)
+
+  The grid is divided into square tiles of GRID_TILE_SIZE cells. The
+  competitions of each tile draw from a PRNG of their own (a copy of the
+  selection PRNG, which jumps once per tile), in the order of the cells. Since
+  a competition only reads the fitness of the (old) individuals in its 3x3
+  neighbourhood, the tiles can be processed concurrently and the outcome does
+  not depend on the number of threads.
+*/
+void ae_selection::do_local_competitions_by_tile( ae_individual*** new_indiv_grid )
+{
+  int16_t grid_width  = _exp_m->get_grid_width();
+  int16_t grid_height = _exp_m->get_grid_height();
+  int16_t nb_tiles_x  = ( grid_width  + GRID_TILE_SIZE - 1 ) / GRID_TILE_SIZE;
+  int16_t nb_tiles_y  = ( grid_height + GRID_TILE_SIZE - 1 ) / GRID_TILE_SIZE;
+  int32_t nb_tiles    = nb_tiles_x * nb_tiles_y;
+  
+  ae_jumping_mt** prngs = new ae_jumping_mt* [nb_tiles];
+  for ( int32_t i = 0 ; i < nb_tiles ; i++ )
+  {
+    prngs[i] = new ae_jumping_mt( *_prng );
+    _prng->jump();
+  }
+  
+  auto compete = [&]( int32_t tile )
+  {
+    int16_t x_min = ( tile / nb_tiles_y ) * GRID_TILE_SIZE;
+    int16_t y_min = ( tile % nb_tiles_y ) * GRID_TILE_SIZE;
+    int16_t x_max = ( x_min + GRID_TILE_SIZE < grid_width )  ? x_min + GRID_TILE_SIZE : grid_width;
+    int16_t y_max = ( y_min + GRID_TILE_SIZE < grid_height ) ? y_min + GRID_TILE_SIZE : grid_height;
+    
+    for ( int16_t x = x_min ; x < x_max ; x++ )
+    {
+      for ( int16_t y = y_min ; y < y_max ; y++ )
+      {
+        new_indiv_grid[x][y] = calculate_local_competition( x, y, prngs[tile] );
+      }
+    }
+  };
+  
+  ae_thread_pool* thread_pool = _exp_m->get_thread_pool();
+  if ( thread_pool != NULL )
+  {
+    thread_pool->run( nb_tiles, compete );
+  }
+  else
+  {
+    for ( int32_t tile = 0 ; tile < nb_tiles ; tile++ ) compete( tile );
+  }
+  
+  for ( int32_t i = 0 ; i < nb_tiles ; i++ )
+  {
+    delete prngs[i];
+  }
+  delete [] prngs;
+}
+
+ae_individual* ae_selection::calculate_local_competition ( int16_t x, int16_t y, ae_jumping_mt* prng /*= NULL*/ )
 {
+  PROFILE_SCOPE( SELECTION );
+  
   // This function uses the array _prob_reprod when selection scheme is RANK_LINEAR, RANK_EXPONENTIAL, or FITTEST. For these selection schemes, the function compute_local_prob_reprod (creating the array _prob_reprod) must have been called before.
   // When selection scheme is FITNESS_PROPORTIONATE, this function only uses the fitness values
+  // The roulette is drawn from prng if provided, from the selection PRNG otherwise
+  if ( prng == NULL ) prng = _prng;
   
   ae_spatial_structure* sp_struct = _exp_m->get_spatial_structure();
   
@@ -878,7 +1162,7 @@ ae_individual* ae_selection::calculate_local_competition ( int16_t x, int16_t y
   
   
   // pick one organism to reproduce, based on probs[] calculated above, using roulette selection
-  int8_t found_org = _prng->roulette_random( probs, 9 );
+  int8_t found_org = prng->roulette_random( probs, 9 );
   
   int16_t x_offset = ( found_org / 3 ) - 1;
   int16_t y_offset = ( found_org % 3 ) - 1;
@@ -108,7 +108,9 @@ class ae_selection : public ae_object
     ae_individual* do_replication( ae_individual* parent,
                                    int32_t index,
                                    int16_t x = -1,
-                                   int16_t y = -1 );
+                                   int16_t y = -1,
+                                   ae_jumping_mt* mut_prng = NULL,
+                                   ae_jumping_mt* stoch_prng = NULL );
     void compute_prob_reprod( void );
     // =================================================================
     //                           Public Attributes
@@ -141,7 +143,11 @@ class ae_selection : public ae_object
     //void compute_prob_reprod( void );
     void compute_local_prob_reprod( void );
     //ae_individual* do_replication( ae_individual* parent, int32_t index, int16_t x = -1, int16_t y = -1 );
-    ae_individual* calculate_local_competition ( int16_t x, int16_t y );
+    ae_individual* calculate_local_competition ( int16_t x, int16_t y, ae_jumping_mt* prng = NULL );
+    void do_local_competitions_by_tile( ae_individual*** new_indiv_grid );
+    void do_replications( int32_t nb_offspring, ae_individual** parents, ae_individual** offspring,
+                          int16_t* x = NULL, int16_t* y = NULL );
+    bool replications_are_independent( void ) const;
 
     // =======================================================================
     //                             Protected Attributes
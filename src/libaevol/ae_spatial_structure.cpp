@@ -107,24 +107,29 @@ ae_spatial_structure::~ae_spatial_structure( void )
 // =================================================================
 //                            Public Methods
 // =================================================================
-void ae_spatial_structure::update_secretion_grid ( void )
+/*!
+  Diffuse and degrade the compound secreted in the grid
+
+  Each cell only depends on the previous amounts in its neighbourhood, the
+  columns of the grid are hence updated independently (on the threads of
+  thread_pool if provided). The result is the same in both cases.
+*/
+void ae_spatial_structure::update_secretion_grid ( ae_thread_pool* thread_pool /*= NULL*/ )
 {
-  int16_t cur_x, cur_y; 
-  
   double ** new_secretion = new double*[_grid_width];
   for ( int16_t x = 0 ; x < _grid_width ; x++ )
   {
     new_secretion[x] = new double[_grid_height];
-    for ( int16_t y = 0 ; y < _grid_height ; y++ )
-    {
-      new_secretion[x][y] = _pop_grid[x][y]->get_compound_amount();
-    }
   }
-
-  for ( int16_t x = 0 ; x < _grid_width ; x++ )
+  
+  auto diffuse = [&]( int32_t x )
   {
+    int16_t cur_x, cur_y; 
+    
     for ( int16_t y = 0 ; y < _grid_height ; y++ )
     {
+      new_secretion[x][y] = _pop_grid[x][y]->get_compound_amount();
+      
       // look at the entire neighborhood
       for ( int8_t i = -1 ; i < 2 ; i++ )
       {
@@ -138,10 +143,10 @@ void ae_spatial_structure::update_secretion_grid ( void )
         }
       }
     }
-  }
+  };
   
   // substract what has diffused from each cell, and calculate the compound degradation
-  for ( int16_t x = 0 ; x < _grid_width ; x++ )
+  auto degrade = [&]( int32_t x )
   {
     for ( int16_t y = 0 ; y < _grid_height ; y++ )
     {
@@ -150,7 +155,19 @@ void ae_spatial_structure::update_secretion_grid ( void )
       _pop_grid[x][y]->set_compound_amount(   _pop_grid[x][y]->get_compound_amount()
                                             * (1 - _secretion_degradation_prop) );
     }
+  };
+  
+  if ( thread_pool != NULL )
+  {
+    thread_pool->run( _grid_width, diffuse );
+    thread_pool->run( _grid_width, degrade );
+  }
+  else
+  {
+    for ( int16_t x = 0 ; x < _grid_width ; x++ ) diffuse( x );
+    for ( int16_t x = 0 ; x < _grid_width ; x++ ) degrade( x );
   }
+  
   for ( int16_t x = 0 ; x < _grid_width ; x++ )
   {
     delete [] new_secretion[x];
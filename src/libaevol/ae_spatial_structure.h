@@ -41,6 +41,7 @@
 // =================================================================
 #include <ae_object.h>
 #include <ae_grid_cell.h>
+#include <ae_thread_pool.h>
 
 
 
@@ -100,7 +101,7 @@ class ae_spatial_structure : public ae_object
     // =================================================================
     //                            Public Methods
     // =================================================================
-    void update_secretion_grid( void ); 
+    void update_secretion_grid( ae_thread_pool* thread_pool = NULL );
     void do_random_migrations ( void );
     void save( gzFile backup_file ) const;
 
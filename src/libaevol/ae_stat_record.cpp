@@ -30,6 +30,7 @@
 // =================================================================
 //                              Libraries
 // =================================================================
+#include <math.h>
 
 
 
@@ -46,6 +47,7 @@
 #include <ae_genetic_unit.h>
 #include <ae_replication_report.h>
 #include <ae_dna_replic_report.h>
+#include <ae_thread_pool.h>
 
 
 
@@ -60,6 +62,65 @@
 // =================================================================
 //                    Definition of static attributes
 // =================================================================
+double ae_stat_record::* const ae_stat_record::_pop_data[] =
+{
+  &ae_stat_record::_fitness,
+  
+  &ae_stat_record::_metabolic_error,
+  &ae_stat_record::_parent_metabolic_error,
+  &ae_stat_record::_metabolic_fitness,
+  
+  &ae_stat_record::_secretion_error,
+  &ae_stat_record::_parent_secretion_error,
+  &ae_stat_record::_secretion_fitness,
+  &ae_stat_record::_compound_amount,
+  
+  &ae_stat_record::_amount_of_dna,
+  &ae_stat_record::_nb_coding_rnas,
+  &ae_stat_record::_nb_non_coding_rnas,
+  &ae_stat_record::_av_size_coding_rnas,
+  &ae_stat_record::_av_size_non_coding_rnas,
+  &ae_stat_record::_nb_functional_genes,
+  &ae_stat_record::_nb_non_functional_genes,
+  &ae_stat_record::_av_size_functional_gene,
+  &ae_stat_record::_av_size_non_functional_gene,
+  
+  &ae_stat_record::_nb_mut,
+  &ae_stat_record::_nb_rear,
+  &ae_stat_record::_nb_switch,
+  &ae_stat_record::_nb_indels,
+  &ae_stat_record::_nb_dupl,
+  &ae_stat_record::_nb_del,
+  &ae_stat_record::_nb_trans,
+  &ae_stat_record::_nb_inv,
+  
+  &ae_stat_record::_dupl_rate,
+  &ae_stat_record::_del_rate,
+  &ae_stat_record::_trans_rate,
+  &ae_stat_record::_inv_rate,
+  &ae_stat_record::_mean_align_score,
+  
+  &ae_stat_record::_nb_bases_in_0_CDS,
+  &ae_stat_record::_nb_bases_in_0_functional_CDS,
+  &ae_stat_record::_nb_bases_in_0_non_functional_CDS,
+  &ae_stat_record::_nb_bases_in_0_RNA,
+  &ae_stat_record::_nb_bases_in_0_coding_RNA,
+  &ae_stat_record::_nb_bases_in_0_non_coding_RNA,
+  
+  &ae_stat_record::_nb_bases_non_essential,
+  &ae_stat_record::_nb_bases_non_essential_including_nf_genes,
+  
+  #ifdef __REGUL
+    &ae_stat_record::_nb_influences,
+    &ae_stat_record::_nb_enhancing_influences,
+    &ae_stat_record::_nb_operating_influences,
+    &ae_stat_record::_av_value_influences,
+    &ae_stat_record::_av_value_enhancing_influences,
+    &ae_stat_record::_av_value_operating_influences,
+  #endif
+};
+
+const int8_t ae_stat_record::_nb_pop_data = sizeof( ae_stat_record::_pop_data ) / sizeof( ae_stat_record::_pop_data[0] );
 
 // =================================================================
 //                             Constructors
@@ -1046,7 +1107,133 @@ void ae_stat_record::substract_power( ae_stat_record const * means, ae_stat_reco
   #endif
 }
 
+/*!
+  Compute the mean, standard deviation and skewness records of the population in a single pass
+
+  The statistics of each individual are computed only once and folded into
+  running moments (Welford's update of the mean and of the sum of squared
+  deviations, extended to the sum of cubed deviations). The population is cut
+  into chunks of STAT_CHUNK_SIZE individuals that are processed concurrently
+  on the experiment's thread pool (if any) and merged in the order of the
+  chunks, which makes the result independent of the number of threads.
+
+  The records hold the values the POP, STDEVS and SKEWNESS constructors would
+  compute, i.e. for each attribute:
+    means  : sum( x ) / N
+    stdevs : sum( (x - mean)^2 ) / sqrt( N - 1 )
+    skews  : sum( (x - mean)^3 ) / N, divided by the stdev when it is not null
+*/
+void ae_stat_record::compute_pop_stats( ae_exp_manager* exp_m, ae_population const * pop, chrom_or_gen_unit chrom_or_gu,
+                                        ae_stat_record* means, ae_stat_record* stdevs, ae_stat_record* skews )
+{
+  int32_t nb_indivs = pop->get_nb_indivs();
+  int32_t nb_chunks = ( nb_indivs + STAT_CHUNK_SIZE - 1 ) / STAT_CHUNK_SIZE;
+  
+  ae_individual** indivs = new ae_individual* [nb_indivs];
+  ae_list_node<ae_individual*>* indiv_node = pop->get_indivs()->get_first();
+  for ( int32_t i = 0 ; i < nb_indivs ; i++ )
+  {
+    indivs[i]   = indiv_node->get_obj();
+    indiv_node  = indiv_node->get_next();
+  }
+  
+  // Moments of each chunk (the first chunk accumulates in the output records)
+  ae_stat_record** chunk_means  = new ae_stat_record* [nb_chunks];
+  ae_stat_record** chunk_m2     = new ae_stat_record* [nb_chunks];
+  ae_stat_record** chunk_m3     = new ae_stat_record* [nb_chunks];
+  
+  for ( int32_t chunk = 0 ; chunk < nb_chunks ; chunk++ )
+  {
+    chunk_means[chunk]  = ( chunk == 0 ) ? means  : new ae_stat_record( exp_m );
+    chunk_m2[chunk]     = ( chunk == 0 ) ? stdevs : new ae_stat_record( exp_m );
+    chunk_m3[chunk]     = ( chunk == 0 ) ? skews  : new ae_stat_record( exp_m );
+    chunk_means[chunk]->initialize_data();
+    chunk_m2[chunk]->initialize_data();
+    chunk_m3[chunk]->initialize_data();
+  }
+  
+  auto compute_chunk = [&]( int32_t chunk )
+  {
+    int32_t first = chunk * STAT_CHUNK_SIZE;
+    int32_t last  = ( first + STAT_CHUNK_SIZE < nb_indivs ) ? first + STAT_CHUNK_SIZE : nb_indivs;
+    
+    for ( int32_t i = first ; i < last ; i++ )
+    {
+      ae_stat_record indiv_stat_record( exp_m, indivs[i], chrom_or_gu, false );
+      merge_moments(  chunk_means[chunk], chunk_m2[chunk], chunk_m3[chunk], i - first,
+                      &indiv_stat_record, NULL, NULL, 1 );
+    }
+  };
+  
+  if ( exp_m->get_thread_pool() != NULL )
+  {
+    exp_m->get_thread_pool()->run( nb_chunks, compute_chunk );
+  }
+  else
+  {
+    for ( int32_t chunk = 0 ; chunk < nb_chunks ; chunk++ ) compute_chunk( chunk );
+  }
+  
+  for ( int32_t chunk = 1 ; chunk < nb_chunks ; chunk++ )
+  {
+    merge_moments(  means, stdevs, skews, chunk * STAT_CHUNK_SIZE,
+                    chunk_means[chunk], chunk_m2[chunk], chunk_m3[chunk],
+                    ( chunk < nb_chunks - 1 ) ? STAT_CHUNK_SIZE : nb_indivs - chunk * STAT_CHUNK_SIZE );
+    
+    delete chunk_means[chunk];
+    delete chunk_m2[chunk];
+    delete chunk_m3[chunk];
+  }
+  
+  delete [] chunk_means;
+  delete [] chunk_m2;
+  delete [] chunk_m3;
+  delete [] indivs;
+  
+  // ---------------------------------------------
+  // Turn the central moments into the statistics
+  // ---------------------------------------------
+  stdevs->divide( sqrt( nb_indivs - 1.0 ) );
+  skews->divide( nb_indivs );
+  skews->divide_record( stdevs, 1 );
+  
+  means->_record_type   = POP;
+  stdevs->_record_type  = STDEVS;
+  skews->_record_type   = SKEWNESS;
+  
+  means->_num_gener = stdevs->_num_gener = skews->_num_gener = (double) exp_m->get_num_gener();
+  means->_pop_size  = stdevs->_pop_size  = skews->_pop_size  = (double) nb_indivs;
+}
+
 
 // =================================================================
 //                           Protected Methods
 // =================================================================
+/*!
+  Merge the moments of a set of other_nb values into those of a set of nb values
+
+  m2 and m3 are the sums of the squared and cubed deviations from the mean.
+  other_m2 and other_m3 may be NULL when other_nb is 1.
+*/
+void ae_stat_record::merge_moments( ae_stat_record* means, ae_stat_record* m2, ae_stat_record* m3, int32_t nb,
+                                    ae_stat_record const * other_means, ae_stat_record const * other_m2,
+                                    ae_stat_record const * other_m3, int32_t other_nb )
+{
+  double n_a  = nb;
+  double n_b  = other_nb;
+  double n    = n_a + n_b;
+  
+  for ( int8_t i = 0 ; i < _nb_pop_data ; i++ )
+  {
+    double ae_stat_record::* data = _pop_data[i];
+    
+    double delta  = other_means->*data - means->*data;
+    double m2_a   = m2->*data;
+    double m2_b   = ( other_m2 != NULL ) ? other_m2->*data : 0.0;
+    double m3_b   = ( other_m3 != NULL ) ? other_m3->*data : 0.0;
+    
+    m3->*data     += m3_b + delta * delta * delta * n_a * n_b * ( n_a - n_b ) / ( n * n ) + 3.0 * delta * ( n_a * m2_b - n_b * m2_a ) / n;
+    m2->*data     += m2_b + delta * delta * n_a * n_b / n;
+    means->*data  += delta * n_b / n;
+  }
+}
@@ -129,6 +129,9 @@ class ae_stat_record : public ae_object
     void add( ae_stat_record* to_add, int32_t index );
     void substract_power( ae_stat_record const * means, ae_stat_record const * to_substract, double power );
     
+    static void compute_pop_stats( ae_exp_manager* exp_m, ae_population const * pop, chrom_or_gen_unit chrom_or_gu,
+                                   ae_stat_record* means, ae_stat_record* stdevs, ae_stat_record* skews );
+    
     // =================================================================
     //                           Public Attributes
     // =================================================================
@@ -157,6 +160,9 @@ class ae_stat_record : public ae_object
     // =================================================================
     //                           Protected Methods
     // =================================================================
+    static void merge_moments(  ae_stat_record* means, ae_stat_record* m2, ae_stat_record* m3, int32_t nb,
+                                ae_stat_record const * other_means, ae_stat_record const * other_m2,
+                                ae_stat_record const * other_m3, int32_t other_nb );
 
     // =================================================================
     //                          Protected Attributes
@@ -225,6 +231,10 @@ class ae_stat_record : public ae_object
       double  _av_value_enhancing_influences;
       double  _av_value_operating_influences;
     #endif
+    
+    // Pointers to the attributes that are averaged over the population
+    static double ae_stat_record::* const _pop_data[];
+    static const int8_t                   _nb_pop_data;
 };
 
 
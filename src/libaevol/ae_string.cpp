@@ -32,6 +32,7 @@
 // =================================================================
 #include <assert.h>
 #include <string.h>
+#include <new>
 
 
 
@@ -59,19 +60,40 @@
 // =================================================================
 ae_string::ae_string( void )
 {
-  _nb_blocks = 1;
-  _length = 0;
-  _data = new char[_nb_blocks * BLOCK_SIZE * sizeof(char)];
+  allocate( 0 );
+  allocate_bits( 0 );
   _data[_length] = '\0';
+  _modified = false;
+  _switched_only = true;
 }
 
+/*!
+  Creates a new ae_string sharing the sequence of the model (it will be copied only when either of them is modified)
+*/
 ae_string::ae_string( const ae_string &model )
 {
-  _nb_blocks  = model._nb_blocks;
-  _length     = model._length;
-  _data = new char[_nb_blocks * BLOCK_SIZE * sizeof(char)];
-
-  memcpy( _data, model._data, (_length+1) * sizeof(char) );
+  if ( model._nb_refs != NULL )
+  {
+    _buffer   = model._buffer;
+    _nb_refs  = model._nb_refs;
+    _data     = model._data;
+    _length   = model._length;
+    _head     = model._head;
+    _capacity = model._capacity;
+    _bits     = model._bits;
+    _bits_capacity = model._bits_capacity;
+    _nb_refs->fetch_add( 1, std::memory_order_relaxed );
+  }
+  else
+  {
+    allocate( model._length );
+    memcpy( _data, model._data, (_length+1) * sizeof(char) );
+    allocate_bits( _length );
+    memcpy( _bits, model._bits, ( ( _length >> 6 ) + 1 ) * sizeof(uint64_t) );
+  }
+  
+  _modified = false;
+  _switched_only = true;
 }
 
 /*!
@@ -79,9 +101,10 @@ ae_string::ae_string( const ae_string &model )
 */
 ae_string::ae_string( int32_t length )
 {
-  _nb_blocks = nb_blocks( length );
-  _length = length;
-  _data = new char[_nb_blocks * BLOCK_SIZE];
+  allocate( length );
+  allocate_bits( length );
+  _modified = false;
+  _switched_only = true;
 
   // Generate a random genome
   /*for ( int32_t i = 0 ; i < _length ; i++ )
@@ -96,10 +119,12 @@ ae_string::ae_string( int32_t length )
  */
 ae_string::ae_string( const char* seq, int32_t length )
 {
-  _length = length;
-  _nb_blocks = nb_blocks( length );
-  _data = new char[_nb_blocks * BLOCK_SIZE];
+  allocate( length );
   memcpy( _data, seq, (length+1) * sizeof(char) );
+  allocate_bits( length );
+  pack( 0, length );
+  _modified = false;
+  _switched_only = true;
 }
 
 /**
@@ -110,24 +135,39 @@ ae_string::ae_string( char* seq, int32_t length, bool use_seq )
 {
   assert( use_seq );
   
-  _length = length;
-  _nb_blocks = nb_blocks( length );
-  _data = seq;
+  _buffer   = seq;
+  _nb_refs  = NULL;
+  _data     = seq;
+  _length   = length;
+  _head     = 0;
+  _capacity = length + 1;
+  _modified = false;
+  _switched_only = true;
+  
+  allocate_bits( length );
+  pack( 0, length );
 }
 
 ae_string::ae_string( gzFile backup_file )
 {
-  gzread( backup_file, &_nb_blocks,  sizeof(_nb_blocks) );
-  //~ printf( "read %d bytes (_nb_blocks : %ld)\n", sizeof(_nb_blocks), _nb_blocks );
-  _data = new char[_nb_blocks * BLOCK_SIZE];
+  int32_t nb_blocks_in_file; // Only kept for compatibility
+  gzread( backup_file, &nb_blocks_in_file,  sizeof(nb_blocks_in_file) );
   gzread( backup_file, &_length,     sizeof(_length) );
   //~ printf( "read %d bytes (_length : %ld)\n", sizeof(_length), _length );
+  allocate( _length );
   gzread( backup_file, _data,        (_length + 1) * sizeof(*_data) );
   //~ printf( "read %ld bytes (_data : %s)\n", (_length + 1) * sizeof(*_data), _data );
+  allocate_bits( _length );
+  pack( 0, _length );
+  _modified = false;
+  _switched_only = true;
 }
 
 ae_string::ae_string( char* organism_file_name )
 {
+  _modified = false;
+  _switched_only = true;
+  
   FILE* org_file = fopen( organism_file_name, "r" );
   int length; 
   
@@ -138,9 +178,7 @@ ae_string::ae_string( char* organism_file_name )
     length = ftell (org_file);
     rewind (org_file);
     
-    _nb_blocks = nb_blocks( length );
-    _length = length;
-    _data = new char[_nb_blocks * BLOCK_SIZE];
+    allocate( length );
     for ( int32_t i = 0 ; i < _length -1 ; i++ )
     {
       _data[i] = fgetc (org_file);
@@ -148,6 +186,8 @@ ae_string::ae_string( char* organism_file_name )
     }
     
     _data[_length] = '\0';
+    allocate_bits( _length );
+    pack( 0, _length );
   }
   
   fclose ( org_file ); 
@@ -158,7 +198,7 @@ ae_string::ae_string( char* organism_file_name )
 // =================================================================
 ae_string::~ae_string( void )
 {
-  delete [] _data;
+  release( _buffer, _nb_refs, _bits );
 }
 
 // =================================================================
@@ -168,26 +208,27 @@ void ae_string::remove( int32_t pos_1, int32_t pos_2 )
 // Remove the sequence between positions 'first' and 'last'
 {
   assert( pos_1 >= 0 && pos_2 >= pos_1 && pos_2 <= _length );
-
-  // Compute size of new genome
-  int32_t new_length    = _length - (pos_2 - pos_1);
-  int32_t new_nb_blocks = nb_blocks( new_length );
-  char*   new_genome    = new char[new_nb_blocks * BLOCK_SIZE];
-
-  // Copy the remaining of the genome in tmp (preceeding and following parts)
-  memcpy( new_genome, _data, pos_1 * sizeof(char) );
-  memcpy( &new_genome[pos_1], &_data[pos_2], (new_length - pos_1) * sizeof(char) );
-  new_genome[new_length] = '\0';
-
-  // Replace previous genome with the new one
-  //~ printf( "genome before - after delete_block( %ld, %ld ) : \n  %s\n  %s\n\n", pos_1, pos_2, _data, new_genome );
-  //~ getchar();
-  delete [] _data;
-  _data = new_genome;
-
-  // Update length data
-  _length     = new_length ;
-  _nb_blocks  = new_nb_blocks;
+  
+  unshare();
+  
+  int32_t nb_removed = pos_2 - pos_1;
+  
+  // Close the gap by moving the shorter of the preceeding and following parts
+  if ( pos_1 < _length - pos_2 )
+  {
+    memmove( &_data[nb_removed], _data, pos_1 * sizeof(char) );
+    _data += nb_removed;
+    _head += nb_removed;
+  }
+  else
+  {
+    memmove( &_data[pos_1], &_data[pos_2], (_length - pos_2 + 1) * sizeof(char) ); // Including '\0'
+  }
+  
+  move_bits( pos_1, pos_2, _length - pos_2 );
+  _length   -= nb_removed;
+  _modified = true;
+  _switched_only = false;
 }
 
 void ae_string::insert( int32_t pos, const char* seq, int32_t seq_length )
@@ -200,25 +241,13 @@ void ae_string::insert( int32_t pos, const char* seq, int32_t seq_length )
   {
     seq_length = strlen( seq );
   }
-
-  // Compute size of new genome
-  int32_t new_length    = _length + seq_length;
-  int32_t new_nb_blocks = nb_blocks( new_length );
-  char*   new_genome    = new char[new_nb_blocks * BLOCK_SIZE];
-
-  // Build new genome from previous genome and sequence to insert
-  memcpy( new_genome,                   _data,        pos             * sizeof(char) );
-  memcpy( &new_genome[pos],             seq,          seq_length      * sizeof(char) );
-  memcpy( &new_genome[pos+seq_length],  &_data[pos],  (_length - pos) * sizeof(char) );
-  new_genome[new_length] = '\0';
-
-  // Replace the previous genome with the new one
-  delete [] _data;
-  _data = new_genome;
-
-  // Update length-related data
-  _length     = new_length;
-  _nb_blocks  = new_nb_blocks;
+  
+  // NB : seq must not be part of this sequence since the latter may be moved
+  make_room( pos, seq_length );
+  memcpy( &_data[pos], seq, seq_length * sizeof(char) );
+  pack( pos, pos + seq_length );
+  _modified = true;
+  _switched_only = false;
 }
 
 void ae_string::replace( int32_t pos, char* seq, int32_t seq_length )
@@ -237,13 +266,89 @@ void ae_string::replace( int32_t pos, char* seq, int32_t seq_length )
   assert( pos + seq_length <= _length );
 
   // Perform the replacement
+  unshare();
   memcpy( &_data[pos], seq, seq_length * sizeof(char) );
+  pack( pos, pos + seq_length );
+  _modified = true;
+  _switched_only = false;
+}
+
+/*!
+  Exchange segments [first ; middle[ and [middle ; last[ (ABC => ACB, B being [first ; middle[)
+*/
+void ae_string::exchange( int32_t first, int32_t middle, int32_t last )
+{
+  assert( first >= 0 && first <= middle && middle <= last && last <= _length );
+  
+  int32_t len_B = middle - first;
+  int32_t len_C = last - middle;
+  if ( len_B == 0 || len_C == 0 ) return;
+  
+  unshare();
+  
+  // Set the shorter segment aside and move the longer one
+  if ( len_B <= len_C )
+  {
+    char* tmp = new char[len_B];
+    memcpy( tmp, &_data[first], len_B * sizeof(char) );
+    memmove( &_data[first], &_data[middle], len_C * sizeof(char) );
+    memcpy( &_data[first + len_C], tmp, len_B * sizeof(char) );
+    delete [] tmp;
+  }
+  else
+  {
+    char* tmp = new char[len_C];
+    memcpy( tmp, &_data[middle], len_C * sizeof(char) );
+    memmove( &_data[first + len_C], &_data[first], len_B * sizeof(char) );
+    memcpy( &_data[first], tmp, len_C * sizeof(char) );
+    delete [] tmp;
+  }
+  
+  pack( first, last );
+  _modified = true;
+  _switched_only = false;
+}
+
+/*!
+  Replace segment [first ; last[ by its reverse complement
+*/
+void ae_string::invert( int32_t first, int32_t last )
+{
+  assert( first >= 0 && first <= last && last <= _length );
+  
+  unshare();
+  
+  for ( int32_t i = first, j = last - 1 ; i <= j ; i++, j-- )
+  {
+    char base_i = _data[i];
+    _data[i] = ( _data[j] == '0' ) ? '1' : '0';
+    _data[j] = ( base_i   == '0' ) ? '1' : '0';
+  }
+  
+  pack( first, last );
+  _modified = true;
+  _switched_only = false;
+}
+
+/*!
+  Replace the base at position pos by its complement
+*/
+void ae_string::switch_base( int32_t pos )
+{
+  assert( pos >= 0 && pos < _length );
+  
+  unshare();
+  
+  _data[pos] = ( _data[pos] == '0' ) ? '1' : '0';
+  _bits[pos >> 6] ^= UINT64_C(1) << ( pos & 63 );
+  
+  _modified = true;
 }
 
 void ae_string::save( gzFile backup_file )
 {
-  gzwrite( backup_file, &_nb_blocks,  sizeof(_nb_blocks) );
-  //~ printf( "write %d bytes (_nb_blocks : %ld)\n", sizeof(_nb_blocks), _nb_blocks );
+  int32_t nb_blocks_in_file = nb_blocks( _length );
+  gzwrite( backup_file, &nb_blocks_in_file,  sizeof(nb_blocks_in_file) );
   gzwrite( backup_file, &_length,     sizeof(_length) );
   //~ printf( "write %d bytes (_length : %ld)\n", sizeof(_length), _length );
   gzwrite( backup_file, &_data[0],    (_length + 1) * sizeof(_data[0]) );
@@ -254,3 +359,161 @@ void ae_string::save( gzFile backup_file )
 // =================================================================
 //                           Protected Methods
 // =================================================================
+/*!
+  Allocate storage for a sequence of the given length, with free room on both sides
+  
+  The sequence itself (including the terminal '\0') is left uninitialized.
+*/
+void ae_string::allocate( int32_t length )
+{
+  int32_t room = BLOCK_SIZE + ( length >> STRING_ROOM_SHIFT );
+  
+  _capacity = length + 1 + room;
+  _head     = room / 2;
+  _buffer   = new char[STRING_HEADER_SIZE + _capacity];
+  _nb_refs  = new ( _buffer ) std::atomic<int32_t>( 1 );
+  _data     = _buffer + STRING_HEADER_SIZE + _head;
+  _length   = length;
+}
+
+/*!
+  Allocate storage for the packed copy of a sequence of the given length,
+  with the same proportion of free room as the chars
+  
+  The bits are cleared, pack sets them.
+*/
+void ae_string::allocate_bits( int32_t length )
+{
+  // One more word than needed so that any 64 bits can be read from two consecutive words
+  _bits_capacity = ( length + BLOCK_SIZE + ( length >> STRING_ROOM_SHIFT ) ) / 64 + 2;
+  _bits          = new uint64_t[_bits_capacity]();
+}
+
+/*!
+  Make sure the packed copy has room for a sequence of the given length
+  
+  The storage must not be shared.
+*/
+void ae_string::grow_bits( int32_t length )
+{
+  if ( ( length >> 6 ) + 2 <= _bits_capacity ) return;
+  
+  uint64_t* old_bits     = _bits;
+  int32_t   old_capacity = _bits_capacity;
+  
+  allocate_bits( length );
+  memcpy( _bits, old_bits, old_capacity * sizeof(uint64_t) );
+  
+  delete [] old_bits;
+}
+
+/*!
+  Pack bases [first, last[ (after they have been written in _data)
+*/
+void ae_string::pack( int32_t first, int32_t last )
+{
+  for ( int32_t pos = first ; pos < last ; pos += 64 )
+  {
+    int8_t   nb   = ( last - pos < 64 ) ? last - pos : 64;
+    uint64_t bits = 0;
+    for ( int8_t i = 0 ; i < nb ; i++ )
+    {
+      bits |= (uint64_t) ( _data[pos + i] == '1' ) << i;
+    }
+    put_bits( pos, nb, bits );
+  }
+}
+
+/*!
+  Move the nb packed bases starting at position src to position dest (the segments may overlap)
+  
+  Unlike get_bits, this may read bits beyond the end of the sequence, as long
+  as they are within _bits (e.g. while the sequence is being lengthened).
+*/
+void ae_string::move_bits( int32_t dest, int32_t src, int32_t nb )
+{
+  if ( dest == src ) return;
+  
+  // Copy 64 bits at a time, in the order that never overwrites bits before they have been read
+  int32_t step;
+  for ( int32_t done = 0 ; done < nb ; done += step )
+  {
+    step = ( nb - done < 64 ) ? nb - done : 64;
+    int32_t offset = ( dest < src ) ? done : nb - done - step;
+    
+    int32_t  word  = ( src + offset ) >> 6;
+    int8_t   shift = ( src + offset ) & 63;
+    uint64_t bits  = _bits[word] >> shift;
+    if ( shift + step > 64 )
+    {
+      bits |= _bits[word + 1] << ( 64 - shift );
+    }
+    
+    put_bits( dest + offset, step, bits );
+  }
+}
+
+/*!
+  Give up the shared storage for a copy of the sequence of our own
+*/
+void ae_string::detach( void )
+{
+  char*                 old_buffer  = _buffer;
+  std::atomic<int32_t>* old_nb_refs = _nb_refs;
+  const char*           old_data    = _data;
+  
+  uint64_t*             old_bits    = _bits;
+  
+  allocate( _length );
+  memcpy( _data, old_data, (_length + 1) * sizeof(char) );
+  allocate_bits( _length );
+  memcpy( _bits, old_bits, ( ( _length >> 6 ) + 1 ) * sizeof(uint64_t) );
+  
+  release( old_buffer, old_nb_refs, old_bits );
+}
+
+/*!
+  Open a gap of nb_bases (uninitialized) chars before position pos
+  
+  Only the shorter of the parts preceeding and following pos is moved, if
+  there is enough free room on that side, otherwise the storage is reallocated.
+  The packed bases that follow pos are shifted in any case.
+*/
+void ae_string::make_room( int32_t pos, int32_t nb_bases )
+{
+  assert( pos >= 0 && pos <= _length );
+  
+  unshare();
+  
+  grow_bits( _length + nb_bases );
+  move_bits( pos + nb_bases, pos, _length - pos );
+  
+  int32_t tail_room = _capacity - _head - _length - 1;
+  bool    move_head = ( pos < _length - pos ) ? ( _head >= nb_bases ) : ( tail_room < nb_bases );
+  
+  if ( move_head && _head >= nb_bases )
+  {
+    memmove( &_data[-nb_bases], _data, pos * sizeof(char) );
+    _data -= nb_bases;
+    _head -= nb_bases;
+    _length += nb_bases;
+  }
+  else if ( tail_room >= nb_bases )
+  {
+    memmove( &_data[pos + nb_bases], &_data[pos], (_length - pos + 1) * sizeof(char) ); // Including '\0'
+    _length += nb_bases;
+  }
+  else
+  {
+    char*                 old_buffer  = _buffer;
+    std::atomic<int32_t>* old_nb_refs = _nb_refs;
+    char*                 old_data    = _data;
+    int32_t               old_length  = _length;
+    
+    allocate( old_length + nb_bases );
+    memcpy( _data, old_data, pos * sizeof(char) );
+    memcpy( &_data[pos + nb_bases], &old_data[pos], (old_length - pos + 1) * sizeof(char) );
+    
+    release( old_buffer, old_nb_refs, NULL ); // The packed bits are kept
+  }
+}
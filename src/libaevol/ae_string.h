@@ -33,8 +33,10 @@
 //                              Libraries
 // =================================================================
 #include <inttypes.h>
+#include <assert.h>
 #include <zlib.h>
 #include <string.h>
+#include <atomic>
 
 
 
@@ -58,7 +60,33 @@
 
 
 #define BLOCK_SIZE INT32_C(1024)
- 
+#define STRING_ROOM_SHIFT 4 // Allocations leave BLOCK_SIZE + length / 2^STRING_ROOM_SHIFT free chars around the sequence
+#define STRING_HEADER_SIZE 16 // Room for the reference count at the beginning of shareable storage
+
+/*!
+  \class ae_string
+  
+  \brief Null-terminated sequence of chars, stored contiguously with free room on both sides
+  
+  Insertions and deletions only move the part of the sequence that lies on
+  the shorter side of the modified position (using the free room on that side)
+  and the storage is only reallocated when there is not enough room left.
+  exchange and invert work in place, at a cost that only depends on the
+  length of the segments involved.
+  
+  Copies share the storage of their model (which is reference counted) until
+  either of them is modified (copy-on-write). Hence every method that writes
+  the sequence must call unshare() first. Sequences handed over by the caller
+  (set_data and ae_string( seq, length, true )) are not shareable and are
+  deep-copied until they get reallocated.
+  
+  A packed copy of the sequence (one bit per base, set for '1') is kept in
+  sync by every method that writes the sequence, so that motifs can be read
+  64 bases at a time (see get_bits). It is shared along with the chars and
+  costs an eighth of their size. Bases are always packed at their position in
+  the sequence: insertions and deletions shift the bits that follow them,
+  which only takes one word operation per 64 bases.
+*/
 class ae_string : public ae_object
 {  
   public :
@@ -85,6 +113,10 @@ class ae_string : public ae_object
     inline const char*   get_data( void ) const;
     inline       void    set_data( char* data, int32_t length = -1 );
     inline       int32_t get_length( void ) const;
+    inline       bool    is_modified( void ) const;
+    inline       bool    is_switched_only( void ) const;
+    inline       uint64_t get_bits( int32_t first, int8_t nb ) const;
+    inline       uint64_t get_circular_bits( int32_t first, int8_t nb ) const;
   
     // =================================================================
     //                            Public Methods
@@ -92,6 +124,9 @@ class ae_string : public ae_object
     void remove( int32_t first, int32_t last );
     void insert( int32_t pos, const char* seq, int32_t seq_length = -1 );
     void replace( int32_t pos, char* seq, int32_t seq_length = -1 );
+    void exchange( int32_t first, int32_t middle, int32_t last );
+    void invert( int32_t first, int32_t last );
+    void switch_base( int32_t pos );
     
     void save( gzFile backup_file );
   
@@ -124,13 +159,33 @@ class ae_string : public ae_object
     //                           Protected Methods
     // =================================================================
     static inline int32_t nb_blocks( int32_t length );
+    
+    void allocate( int32_t length );
+    void allocate_bits( int32_t length );
+    void grow_bits( int32_t length );
+    void make_room( int32_t pos, int32_t nb_bases );
+    
+    inline void put_bits( int32_t first, int8_t nb, uint64_t bits );
+    void pack( int32_t first, int32_t last );
+    void move_bits( int32_t dest, int32_t src, int32_t nb );
+    
+    inline void unshare( void );
+    void detach( void );
+    static inline void release( char* buffer, std::atomic<int32_t>* nb_refs, uint64_t* bits );
   
     // =================================================================
     //                          Protected Attributes
     // =================================================================
+    char*   _buffer;    // Allocated storage, _data lies somewhere inside
+    std::atomic<int32_t>* _nb_refs; // Number of ae_string sharing _buffer (stored in it), NULL if not shareable
     char*   _data;
     int32_t _length;
-    int32_t _nb_blocks;
+    int32_t _head;      // Number of free chars before _data
+    int32_t _capacity;  // Number of chars from the first free char before _data to the end of _buffer
+    uint64_t* _bits;    // Packed sequence: bit (i % 64) of _bits[i / 64] is set when _data[i] is '1'
+    int32_t _bits_capacity; // Number of words in _bits
+    bool    _modified;  // Whether the sequence has changed since this object was created
+    bool    _switched_only; // Whether switch_base is all that changed it (every base is then where it was)
 };
 
 
@@ -142,17 +197,25 @@ inline const char* ae_string::get_data( void ) const
   return _data;
 }
 
+/*!
+  Replace the sequence by data (of length length), which will be used directly
+  (and deleted with this object). data must have been allocated with new char[].
+*/
 inline void ae_string::set_data( char* data, int32_t length /* = -1 */ )
 {
-  if ( _data != NULL )
-  {
-    delete [] _data;
-    _data = NULL;
-  }
+  release( _buffer, _nb_refs, _bits );
   
+  _buffer     = data;
+  _nb_refs    = NULL;
   _data       = data;
   _length     = ( length != -1 ) ? length : strlen( _data );
-  _nb_blocks  = nb_blocks( _length );
+  _head       = 0;
+  _capacity   = _length + 1;
+  _modified   = true;
+  _switched_only = false;
+  
+  allocate_bits( _length );
+  pack( 0, _length );
 }
 
 inline int32_t ae_string::get_length( void ) const
@@ -160,6 +223,60 @@ inline int32_t ae_string::get_length( void ) const
   return _length;
 }
 
+inline bool ae_string::is_modified( void ) const
+{
+  return _modified;
+}
+
+inline bool ae_string::is_switched_only( void ) const
+{
+  return _switched_only;
+}
+
+/*!
+  Get the <nb> (at most 64) bases starting at position <first> as bits:
+  bit i is set when base first + i is '1'. The segment must lie within the
+  sequence (see ae_dna::get_circular_bits for a circular version).
+*/
+inline uint64_t ae_string::get_bits( int32_t first, int8_t nb ) const
+{
+  assert( first >= 0 && nb > 0 && nb <= 64 && first + nb <= _length );
+  
+  int32_t word  = first >> 6;
+  int8_t  shift = first & 63;
+  
+  uint64_t bits = _bits[word] >> shift;
+  if ( shift + nb > 64 )
+  {
+    bits |= _bits[word + 1] << ( 64 - shift );
+  }
+  
+  return ( nb == 64 ) ? bits : bits & ( ( UINT64_C(1) << nb ) - 1 );
+}
+
+/*!
+  Same as get_bits, the sequence being read as circular: <first> may be any position
+  and the <nb> (at most 64) bases may wrap around the origin, several times
+  if the sequence is shorter than nb.
+*/
+inline uint64_t ae_string::get_circular_bits( int32_t first, int8_t nb ) const
+{
+  if ( first >= 0 && first + nb <= _length ) return get_bits( first, nb );
+  
+  first = ae_utils::mod( first, _length );
+  
+  uint64_t bits = 0;
+  int8_t   nb_read, done;
+  for ( done = 0 ; done < nb ; done += nb_read )
+  {
+    nb_read = ae_utils::min( nb - done, _length - first );
+    bits   |= get_bits( first, nb_read ) << done;
+    first   = 0;
+  }
+  
+  return bits;
+}
+
 // =====================================================================
 //                       Inline functions' definition
 // =====================================================================
@@ -168,5 +285,45 @@ int32_t ae_string::nb_blocks( int32_t length )
   return length/BLOCK_SIZE + 1;
 }
 
+/*!
+  Overwrite the packed bases [first, first + nb[ (nb <= 64) with the <nb> lowest bits of <bits>
+*/
+inline void ae_string::put_bits( int32_t first, int8_t nb, uint64_t bits )
+{
+  int32_t  word  = first >> 6;
+  int8_t   shift = first & 63;
+  uint64_t mask  = ( nb == 64 ) ? ~UINT64_C(0) : ( UINT64_C(1) << nb ) - 1;
+  
+  bits &= mask;
+  _bits[word] = ( _bits[word] & ~( mask << shift ) ) | ( bits << shift );
+  if ( shift + nb > 64 )
+  {
+    _bits[word + 1] = ( _bits[word + 1] & ~( mask >> ( 64 - shift ) ) ) | ( bits >> ( 64 - shift ) );
+  }
+}
+
+/*!
+  Make sure the storage is not shared with any other ae_string before the sequence is modified
+*/
+inline void ae_string::unshare( void )
+{
+  if ( _nb_refs != NULL && _nb_refs->load( std::memory_order_acquire ) > 1 )
+  {
+    detach();
+  }
+}
+
+/*!
+  Give up a reference to buffer (and the packed bits that go with it), deleting them if it was the last one
+*/
+inline void ae_string::release( char* buffer, std::atomic<int32_t>* nb_refs, uint64_t* bits )
+{
+  if ( nb_refs == NULL || nb_refs->fetch_sub( 1, std::memory_order_acq_rel ) == 1 )
+  {
+    delete [] buffer;
+    delete [] bits;
+  }
+}
+
 
 #endif // __AE_STRING_H__
@@ -0,0 +1,170 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_thread_pool.h>
+
+
+
+
+//##############################################################################
+//                                                                             #
+//                            Class ae_thread_pool                             #
+//                                                                             #
+//##############################################################################
+
+// =================================================================
+//                    Definition of static attributes
+// =================================================================
+
+// =================================================================
+//                             Constructors
+// =================================================================
+ae_thread_pool::ae_thread_pool( int16_t nb_threads )
+{
+  if ( nb_threads < 1 )
+  {
+    printf( "%s:%d: error: invalid number of threads (%" PRId16 ").\n", __FILE__, __LINE__, nb_threads );
+    exit( EXIT_FAILURE );
+  }
+  
+  _nb_threads       = nb_threads;
+  _task             = NULL;
+  _nb_tasks         = 0;
+  _next_task        = 0;
+  _nb_busy_workers  = 0;
+  _batch_id         = 0;
+  _stop             = false;
+  
+  for ( int16_t i = 1 ; i < _nb_threads ; i++ )
+  {
+    _workers.push_back( std::thread( &ae_thread_pool::work, this ) );
+  }
+}
+
+// =================================================================
+//                             Destructors
+// =================================================================
+ae_thread_pool::~ae_thread_pool( void )
+{
+  {
+    std::unique_lock<std::mutex> lock( _mutex );
+    _stop = true;
+  }
+  _work_available.notify_all();
+  
+  for ( size_t i = 0 ; i < _workers.size() ; i++ )
+  {
+    _workers[i].join();
+  }
+}
+
+// =================================================================
+//                            Public Methods
+// =================================================================
+/*!
+  Call task( i ) for each i in [0, nb_tasks[ and wait for all of them to be done
+ */
+void ae_thread_pool::run( int32_t nb_tasks, const std::function<void( int32_t )>& task )
+{
+  if ( nb_tasks <= 0 ) return;
+  
+  {
+    std::unique_lock<std::mutex> lock( _mutex );
+    _task             = &task;
+    _nb_tasks         = nb_tasks;
+    _next_task        = 0;
+    _nb_busy_workers  = (int16_t) _workers.size();
+    _batch_id++;
+  }
+  _work_available.notify_all();
+  
+  // Take part in the work
+  do_tasks();
+  
+  // Wait for the workers to be done with the current batch
+  std::unique_lock<std::mutex> lock( _mutex );
+  while ( _nb_busy_workers > 0 )
+  {
+    _work_done.wait( lock );
+  }
+  _task = NULL;
+}
+
+// =================================================================
+//                           Protected Methods
+// =================================================================
+void ae_thread_pool::work( void )
+{
+  uint32_t last_batch_id = 0;
+  
+  while ( true )
+  {
+    {
+      std::unique_lock<std::mutex> lock( _mutex );
+      while ( ! _stop && _batch_id == last_batch_id )
+      {
+        _work_available.wait( lock );
+      }
+      if ( _stop ) return;
+      last_batch_id = _batch_id;
+    }
+    
+    do_tasks();
+    
+    {
+      std::unique_lock<std::mutex> lock( _mutex );
+      if ( --_nb_busy_workers == 0 )
+      {
+        _work_done.notify_one();
+      }
+    }
+  }
+}
+
+void ae_thread_pool::do_tasks( void )
+{
+  int32_t task_id;
+  while ( ( task_id = _next_task++ ) < _nb_tasks )
+  {
+    (*_task)( task_id );
+  }
+}
+
+// =================================================================
+//                          Non inline accessors
+// =================================================================
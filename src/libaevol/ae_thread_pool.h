@@ -0,0 +1,180 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+/*!
+  \class ae_thread_pool
+  
+  \brief A fixed set of worker threads sharing indexed tasks
+  
+  run( nb_tasks, task ) calls task( i ) once for each i in [0, nb_tasks[ and
+  returns when all of them are done. The calling thread takes part in the work,
+  hence a pool of 1 thread simply runs the tasks in sequence.
+  
+  Tasks are handed out dynamically, which means the order in which they are
+  executed is not specified: a task must only write to data that belongs to
+  its own index for the result not to depend on the number of threads.
+*/
+
+
+#ifndef __AE_THREAD_POOL_H__
+#define __AE_THREAD_POOL_H__
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_object.h>
+
+
+
+
+// =================================================================
+//                          Class declarations
+// =================================================================
+
+
+
+
+
+
+class ae_thread_pool : public ae_object
+{
+  public :
+    // =================================================================
+    //                             Constructors
+    // =================================================================
+    ae_thread_pool( int16_t nb_threads );
+
+    // =================================================================
+    //                             Destructors
+    // =================================================================
+    virtual ~ae_thread_pool( void );
+
+    // =================================================================
+    //                        Accessors: getters
+    // =================================================================
+    inline int16_t get_nb_threads( void ) const;
+
+    // =================================================================
+    //                        Accessors: setters
+    // =================================================================
+
+    // =================================================================
+    //                              Operators
+    // =================================================================
+
+    // =================================================================
+    //                            Public Methods
+    // =================================================================
+    void run( int32_t nb_tasks, const std::function<void( int32_t )>& task );
+
+    // =================================================================
+    //                           Public Attributes
+    // =================================================================
+
+
+
+
+
+  protected :
+
+    // =================================================================
+    //                         Forbidden Constructors
+    // =================================================================
+    ae_thread_pool( void )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+    ae_thread_pool( const ae_thread_pool &model )
+    {
+      printf( "%s:%d: error: call to forbidden constructor.\n", __FILE__, __LINE__ );
+      exit( EXIT_FAILURE );
+    };
+
+
+    // =================================================================
+    //                           Protected Methods
+    // =================================================================
+    void work( void );
+    void do_tasks( void );
+
+    // =================================================================
+    //                          Protected Attributes
+    // =================================================================
+    int16_t _nb_threads;
+    std::vector<std::thread> _workers; // The calling thread is the _nb_threads-th one
+    
+    std::mutex              _mutex;
+    std::condition_variable _work_available;
+    std::condition_variable _work_done;
+    
+    // Current batch of tasks
+    const std::function<void( int32_t )>* _task;
+    int32_t               _nb_tasks;
+    std::atomic<int32_t>  _next_task;
+    int16_t               _nb_busy_workers;
+    uint32_t              _batch_id;
+    bool                  _stop;
+};
+
+
+// =====================================================================
+//                           Getters' definitions
+// =====================================================================
+inline int16_t ae_thread_pool::get_nb_threads( void ) const
+{
+  return _nb_threads;
+}
+
+// =====================================================================
+//                           Setters' definitions
+// =====================================================================
+
+// =====================================================================
+//                          Operators' definitions
+// =====================================================================
+
+// =====================================================================
+//                       Inline functions' definition
+// =====================================================================
+
+
+#endif // __AE_THREAD_POOL_H__
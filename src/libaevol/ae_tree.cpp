@@ -68,10 +68,16 @@ ae_tree::ae_tree( ae_exp_manager* exp_m, ae_tree_mode tree_mode, int32_t tree_st
     
   _tree_mode = tree_mode;
   _tree_step = tree_step;
+  
+  _nb_children  = NULL;
+  _nb_reports   = NULL;
+  _index        = NULL;
+  _first_entry  = NULL;
 
   switch ( _tree_mode )
   {
     case NORMAL :
+    case PRUNED :
     {
       _nb_indivs    = new int32_t [_tree_step];
       _replics      = new ae_replication_report** [_tree_step];
@@ -84,6 +90,15 @@ ae_tree::ae_tree( ae_exp_manager* exp_m, ae_tree_mode tree_mode, int32_t tree_st
         _replics[i] = NULL;
       }
       
+      if ( _tree_mode == PRUNED )
+      {
+        _nb_children = new int32_t* [_tree_step];
+        for ( int32_t i = 0 ; i < tree_step ; i++ )
+        {
+          _nb_children[i] = NULL;
+        }
+      }
+      
       break;
     }
     case LIGHT :
@@ -116,9 +131,16 @@ ae_tree::ae_tree( ae_exp_manager* exp_m, char* tree_file_name )
 
   _tree_mode = _exp_m->get_tree_mode();
   _tree_step = _exp_m->get_tree_step();
+  
+  _nb_children  = NULL;
+  _nb_reports   = NULL;
+  _index        = NULL;
+  _first_entry  = NULL;
+  
   switch ( _tree_mode )
   {
     case NORMAL :
+    case PRUNED :
     {
       gzFile tree_file = gzopen( tree_file_name, "r" );
       if ( tree_file == Z_NULL )
@@ -127,24 +149,55 @@ ae_tree::ae_tree( ae_exp_manager* exp_m, char* tree_file_name )
         exit( EXIT_FAILURE );
       }
       
-      ae_replication_report * replic_report = NULL;
-            
       _nb_indivs    = new int32_t[_tree_step];
+      _nb_reports   = new int32_t[_tree_step];
       _replics      = new ae_replication_report**[_tree_step];      
       
       gzread( tree_file, _nb_indivs, _tree_step * sizeof(_nb_indivs[0]) );
-
+      
+      // In PRUNED mode, only the reports of the surviving lineages were written
+      if ( _tree_mode == PRUNED )
+      {
+        gzread( tree_file, _nb_reports, _tree_step * sizeof(_nb_reports[0]) );
+      }
+      else
+      {
+        memcpy( _nb_reports, _nb_indivs, _tree_step * sizeof(_nb_reports[0]) );
+      }
+      
       for ( int32_t gener_i = 0 ; gener_i < _tree_step ; gener_i++ )
       {
         _replics[gener_i] = new ae_replication_report*[_nb_indivs[gener_i]];
-        for ( int32_t indiv_i = 0 ; indiv_i < _nb_indivs[gener_i] ; indiv_i++ )
+        memset( _replics[gener_i], 0, _nb_indivs[gener_i] * sizeof( *_replics[gener_i] ) );
+      }
+      
+      // If the file is indexed, the reports will only be read when asked for
+      _index = new ae_block_backup( tree_file_name );
+      if ( _index->is_indexed() )
+      {
+        _first_entry = new int32_t[_tree_step];
+        int32_t nb_entries = 0;
+        for ( int32_t gener_i = 0 ; gener_i < _tree_step ; gener_i++ )
+        {
+          _first_entry[gener_i] = nb_entries;
+          nb_entries += _nb_indivs[gener_i];
+        }
+        
+        if ( nb_entries != _index->get_nb_entries() )
         {
-          // Retreive a replication report
-          replic_report = new ae_replication_report( tree_file, NULL );
-          
-          // Put it at its rightful position
-          _replics[gener_i][replic_report->get_id()] = replic_report;
+          printf( "ERROR : Inconsistent index in tree file %s\n", tree_file_name );
+          exit( EXIT_FAILURE );
         }
+        
+        gzclose( tree_file );
+        break;
+      }
+      delete _index;
+      _index = NULL;
+      
+      for ( int32_t gener_i = 0 ; gener_i < _tree_step ; gener_i++ )
+      {
+        read_reports( tree_file, gener_i );
       }
       gzclose( tree_file );
        
@@ -169,6 +222,7 @@ ae_tree::~ae_tree( void )
   switch ( _tree_mode )
   {
     case NORMAL :
+    case PRUNED :
     {
       if ( _replics != NULL )
       {
@@ -186,6 +240,15 @@ ae_tree::~ae_tree( void )
         }
         delete [] _replics;
       }
+      
+      if ( _nb_children != NULL )
+      {
+        for ( int32_t i = 0 ; i < _tree_step ; i++ )
+        {
+          delete [] _nb_children[i];
+        }
+        delete [] _nb_children;
+      }
 
       break;
     }
@@ -203,6 +266,9 @@ ae_tree::~ae_tree( void )
   }
 
   delete [] _nb_indivs;
+  delete [] _nb_reports;
+  delete [] _first_entry;
+  delete _index;
 }
 
 // =================================================================
@@ -219,21 +285,57 @@ int32_t ae_tree::get_nb_indivs( int32_t generation ) const
 
 ae_replication_report * ae_tree::get_report_by_index( int32_t generation, int32_t index ) const
 {
-  assert( _tree_mode == NORMAL );
+  assert( _tree_mode == NORMAL || _tree_mode == PRUNED );
+  int32_t gener_i = ae_utils::mod( generation - 1, _tree_step );
+  
+  // Read this report only. In PRUNED mode, the entry of a pruned report is empty
+  if ( _index != NULL && _replics[gener_i][index] == NULL &&
+       _index->get_entry_size( _first_entry[gener_i] + index ) > 0 )
+  {
+    gzFile tree_file = _index->open_entry( _first_entry[gener_i] + index );
+    _replics[gener_i][index] = new ae_replication_report( tree_file, NULL );
+    gzclose( tree_file );
+  }
   
-  return _replics[ae_utils::mod(generation - 1, _tree_step)][index];
+  return _replics[gener_i][index];
 }
 
 
 ae_replication_report * ae_tree::get_report_by_rank( int32_t generation, int32_t rank ) const
 {
-  assert( _tree_mode == NORMAL );
+  assert( _tree_mode == NORMAL || _tree_mode == PRUNED );
   int32_t nb_indivs = get_nb_indivs( generation );
   assert( rank <= nb_indivs );
   
+  if ( _index != NULL )
+  {
+    // Read all the reports of the generation (unless they already were)
+    int32_t gener_i = ae_utils::mod( generation - 1, _tree_step );
+    int32_t nb_read = 0;
+    for ( int32_t i = 0 ; i < nb_indivs ; i++ )
+    {
+      if ( _replics[gener_i][i] != NULL ) nb_read++;
+    }
+    
+    if ( nb_read < _nb_reports[gener_i] )
+    {
+      for ( int32_t i = 0 ; i < nb_indivs ; i++ )
+      {
+        delete _replics[gener_i][i];
+        _replics[gener_i][i] = NULL;
+      }
+      
+      gzFile tree_file = _index->open_entry( _first_entry[gener_i] );
+      read_reports( tree_file, gener_i );
+      gzclose( tree_file );
+    }
+  }
+  
   for ( int32_t i = 0 ; i < nb_indivs ; i++ )
   {
-    if ( _replics[ae_utils::mod(generation - 1, _tree_step)][i]->get_rank() == rank )
+    // In PRUNED mode, extinct lineages have no report
+    if ( _replics[ae_utils::mod(generation - 1, _tree_step)][i] != NULL &&
+         _replics[ae_utils::mod(generation - 1, _tree_step)][i]->get_rank() == rank )
     {
       return _replics[ae_utils::mod(generation - 1, _tree_step)][i];
     }
@@ -267,21 +369,62 @@ void ae_tree::fill_tree_with_cur_gener( void )
       _replics[gener_i]   = new ae_replication_report* [_nb_indivs[gener_i]];
       
       
+      // Reports are stored by id, the order in which they are written (and
+      // in which they are indexed)
       ae_list_node<ae_individual*>* indiv_node = _exp_m->get_indivs()->get_first();
-      ae_individual*  indiv       = NULL;
-      int32_t         num_indiv   = 0;
+      ae_replication_report* report = NULL;
       
       while ( indiv_node != NULL )
       {
-        indiv = indiv_node->get_obj();
-        
-        _replics[gener_i][num_indiv++] = indiv->get_replic_report();
+        report = indiv_node->get_obj()->get_replic_report();
+        _replics[gener_i][report->get_id()] = report;
 
         indiv_node = indiv_node->get_next();
       }
       
       break;
     }
+    case PRUNED :
+    {
+      int32_t gener_i     = ae_utils::mod( _exp_m->get_num_gener() - 1, _tree_step );
+      _nb_indivs[gener_i] = _exp_m->get_pop()->get_nb_indivs();
+      _replics[gener_i]   = new ae_replication_report* [_nb_indivs[gener_i]];
+      _nb_children[gener_i] = new int32_t [_nb_indivs[gener_i]];
+      memset( _nb_children[gener_i], 0, _nb_indivs[gener_i] * sizeof( *_nb_children[gener_i] ) );
+      
+      // Reports are stored by id (see NORMAL mode), the parent ids of the next
+      // generation hence index them
+      ae_list_node<ae_individual*>* indiv_node = _exp_m->get_indivs()->get_first();
+      ae_replication_report* report = NULL;
+      
+      while ( indiv_node != NULL )
+      {
+        report = indiv_node->get_obj()->get_replic_report();
+        _replics[gener_i][report->get_id()] = report;
+        
+        indiv_node = indiv_node->get_next();
+      }
+      
+      // The parents (if they are in the tree) are now known, count their children
+      // and prune the lineages of those that have none
+      if ( gener_i > 0 && _replics[gener_i - 1] != NULL )
+      {
+        for ( int32_t indiv_i = 0 ; indiv_i < _nb_indivs[gener_i] ; indiv_i++ )
+        {
+          _nb_children[gener_i - 1][_replics[gener_i][indiv_i]->get_parent_id()]++;
+        }
+        
+        for ( int32_t indiv_i = 0 ; indiv_i < _nb_indivs[gener_i - 1] ; indiv_i++ )
+        {
+          if ( _replics[gener_i - 1][indiv_i] != NULL && _nb_children[gener_i - 1][indiv_i] == 0 )
+          {
+            prune_lineage( gener_i - 1, indiv_i );
+          }
+        }
+      }
+      
+      break;
+    }
     case LIGHT :
     {
 
@@ -310,7 +453,14 @@ void ae_tree::fill_tree_with_cur_gener( void )
   }
 }
 
-void ae_tree::write_to_tree_file( gzFile tree_file )
+/*!
+  Write the tree into tree_file and empty it
+
+  If report_starts is provided, the position at which the report of each
+  individual (or, in PRUNED mode, the one of the next surviving individual)
+  starts in the uncompressed content is appended to it (see ae_block_backup).
+*/
+void ae_tree::write_to_tree_file( gzFile tree_file, std::vector<int64_t>* report_starts /*= NULL*/ )
 {
   switch ( _tree_mode )
   {
@@ -323,6 +473,7 @@ void ae_tree::write_to_tree_file( gzFile tree_file )
       {
         for ( int32_t indiv_i = 0 ; indiv_i < _nb_indivs[gener_i] ; indiv_i++ )
         {
+          if ( report_starts != NULL ) report_starts->push_back( gztell( tree_file ) );
           _replics[gener_i][indiv_i]->write_to_tree_file( tree_file );
         }
       }
@@ -342,6 +493,57 @@ void ae_tree::write_to_tree_file( gzFile tree_file )
       
       break;
     }
+    case PRUNED :
+    {
+      // Write the tree in the backup: the number of individuals of each
+      // generation, the number of (surviving) reports and the reports
+      int32_t* nb_reports = new int32_t[_tree_step];
+      for ( int32_t gener_i = 0 ; gener_i < _tree_step ; gener_i++ )
+      {
+        nb_reports[gener_i] = 0;
+        for ( int32_t indiv_i = 0 ; indiv_i < _nb_indivs[gener_i] ; indiv_i++ )
+        {
+          if ( _replics[gener_i][indiv_i] != NULL ) nb_reports[gener_i]++;
+        }
+      }
+      
+      gzwrite( tree_file, &_nb_indivs[0], _tree_step * sizeof(_nb_indivs[0]) );
+      gzwrite( tree_file, &nb_reports[0], _tree_step * sizeof(nb_reports[0]) );
+      delete [] nb_reports;
+      
+      for ( int32_t gener_i = 0 ; gener_i < _tree_step ; gener_i++ )
+      {
+        for ( int32_t indiv_i = 0 ; indiv_i < _nb_indivs[gener_i] ; indiv_i++ )
+        {
+          if ( report_starts != NULL ) report_starts->push_back( gztell( tree_file ) );
+          if ( _replics[gener_i][indiv_i] != NULL )
+          {
+            _replics[gener_i][indiv_i]->write_to_tree_file( tree_file );
+          }
+        }
+      }
+      
+      // Reinitialize the tree
+      for ( int32_t gener_i = 0 ; gener_i < _tree_step ; gener_i++ )
+      {
+        for ( int32_t indiv_i = 0 ; indiv_i < _nb_indivs[gener_i] ; indiv_i++ )
+        {
+          delete _replics[gener_i][indiv_i];
+        }
+      
+        delete [] _replics[gener_i];
+        _replics[gener_i] = NULL;
+        
+        // There are no children counts when the tree was read from a file
+        if ( _nb_children != NULL )
+        {
+          delete [] _nb_children[gener_i];
+          _nb_children[gener_i] = NULL;
+        }
+      }
+      
+      break;
+    }
     case LIGHT :
     {
       // TODO : ?
@@ -380,3 +582,44 @@ void ae_tree::set_replic_report( int32_t id, ae_replication_report* replic_repor
 // =================================================================
 //                           Protected Methods
 // =================================================================
+/*!
+  Read the reports of the gener_i-th generation of the tree from tree_file and
+  put them at their rightful position
+*/
+void ae_tree::read_reports( gzFile tree_file, int32_t gener_i ) const
+{
+  ae_replication_report * replic_report = NULL;
+  
+  for ( int32_t indiv_i = 0 ; indiv_i < _nb_reports[gener_i] ; indiv_i++ )
+  {
+    // Retreive a replication report
+    replic_report = new ae_replication_report( tree_file, NULL );
+    
+    // Put it at its rightful position
+    _replics[gener_i][replic_report->get_id()] = replic_report;
+  }
+}
+
+/*!
+  Delete the report of the indiv_i-th individual of generation gener_i, who
+  has no living descendant, and those of its ancestors that are left without
+  any living descendant either
+*/
+void ae_tree::prune_lineage( int32_t gener_i, int32_t indiv_i )
+{
+  assert( _tree_mode == PRUNED );
+  
+  while ( true )
+  {
+    int32_t parent_id = _replics[gener_i][indiv_i]->get_parent_id();
+    delete _replics[gener_i][indiv_i];
+    _replics[gener_i][indiv_i] = NULL;
+    
+    // Stop at the first generation of the tree (the parent is not in it)
+    if ( gener_i == 0 || _replics[gener_i - 1] == NULL ) return;
+    
+    gener_i--;
+    indiv_i = parent_id;
+    if ( --_nb_children[gener_i][indiv_i] > 0 ) return;
+  }
+}
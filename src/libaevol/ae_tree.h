@@ -33,6 +33,8 @@
 //                              Libraries
 // =================================================================
 #include <inttypes.h>
+#include <zlib.h>
+#include <vector>
 
 
 
@@ -42,6 +44,7 @@
 #include <ae_object.h>
 #include <ae_replication_report.h>
 #include <ae_enums.h>
+#include <ae_block_backup.h>
 
 
 
@@ -64,6 +67,8 @@ class ae_tree : public ae_object
     ae_tree( ae_exp_manager* exp_m, char* tree_file_name ); 
     // To be used when we want to INSPECT a tree, 
     // not when we want to run a simulation.
+    // If the tree file is indexed (see ae_block_backup), the reports are
+    // only read when they are asked for.
     
     // =================================================================
     //                             Destructors
@@ -96,7 +101,7 @@ class ae_tree : public ae_object
     //                            Public Methods
     // =================================================================
     void fill_tree_with_cur_gener( void );
-    void write_to_tree_file( gzFile tree_file );
+    void write_to_tree_file( gzFile tree_file, std::vector<int64_t>* report_starts = NULL );
     
     inline int32_t get_LCA( int32_t num_gener, int32_t a, int32_t b, int32_t *j );
     // Returns the generation of the last common ancestor of individuals number a and b
@@ -131,6 +136,8 @@ class ae_tree : public ae_object
     // =================================================================
     //                           Protected Methods
     // =================================================================
+    void prune_lineage( int32_t gener_i, int32_t indiv_i );
+    void read_reports( gzFile tree_file, int32_t gener_i ) const;
     
     // =================================================================
     //                          Protected Attributes
@@ -149,6 +156,19 @@ class ae_tree : public ae_object
     // !!!!! WARNING !!!!!
     // The report at line l, column c is for the
     // replication that created the indiv with index c of generation l+1
+    //
+    // In PRUNED mode, the reports of the individuals that no longer have
+    // any living descendant are deleted (and set to NULL) as soon as their
+    // lineage dies out, only the surviving ancestry is written to the file
+    
+    int32_t** _nb_children;
+    // PRUNED mode: number of children (with a report) of each individual
+    // of the previous generations of _replics
+    
+    // Tree inspection only
+    int32_t*          _nb_reports;  // Number of reports written for each generation
+    ae_block_backup*  _index;       // NULL unless the tree file is indexed
+    int32_t*          _first_entry; // Index entry of the first report of each generation
     
     // light tree representation
     int32_t** _parent;
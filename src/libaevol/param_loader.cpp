@@ -407,9 +407,13 @@ void param_loader::interpret_line( f_line* line, int32_t cur_line )
     {
       _tree_mode = NORMAL;
     }       
+    else if ( strcmp( line->words[1], "pruned" ) == 0 )
+    {
+      _tree_mode = PRUNED;
+    }
     else
     {
-      printf( "ERROR in param file \"%s\" on line %"PRId32" : unknown tree mode option (use normal/light).\n",
+      printf( "ERROR in param file \"%s\" on line %"PRId32" : unknown tree mode option (use normal/pruned/light).\n",
               _param_file_name, cur_line );
       exit( EXIT_FAILURE );
     }
@@ -1297,9 +1301,17 @@ void param_loader::load( ae_exp_manager* exp_m, bool verbose, std::function<std:
       char* chromosome = new char[lchromosome+1];
       strncpy(chromosome, chr, lchromosome+1);
 
+      #ifdef DISTRIBUTED_PRNG
+        // The individual owns its PRNGs (see ae_population::new_mut_prng_stream)
+        ae_jumping_mt* mut_prng   = exp_m->get_pop()->new_mut_prng_stream();
+        ae_jumping_mt* stoch_prng = exp_m->get_pop()->new_stoch_prng_stream();
+      #else
+        ae_jumping_mt* mut_prng   = _prng;
+        ae_jumping_mt* stoch_prng = _prng;
+      #endif
       ae_individual* indiv = new ae_individual( exp_m,
-                                               _prng,
-                                               _prng,
+                                               mut_prng,
+                                               stoch_prng,
                                                param_mut,
                                                _w_max,
                                                _min_genome_length,
@@ -1345,9 +1357,17 @@ void param_loader::load( ae_exp_manager* exp_m, bool verbose, std::function<std:
   {
     int32_t        id_new_indiv = 0;
 
+    #ifdef DISTRIBUTED_PRNG
+      // The individual owns its PRNGs (see ae_population::new_mut_prng_stream)
+      ae_jumping_mt* mut_prng   = exp_m->get_pop()->new_mut_prng_stream();
+      ae_jumping_mt* stoch_prng = exp_m->get_pop()->new_stoch_prng_stream();
+    #else
+      ae_jumping_mt* mut_prng   = _prng;
+      ae_jumping_mt* stoch_prng = _prng;
+    #endif
     ae_individual* indiv = new ae_individual( exp_m,
-                                             _prng,
-                                             _prng,
+                                             mut_prng,
+                                             stoch_prng,
                                              param_mut,
                                              _w_max,
                                              _min_genome_length,
@@ -1416,11 +1436,6 @@ void param_loader::load( ae_exp_manager* exp_m, bool verbose, std::function<std:
         // Create a clone, setting its id
         clone = create_clone( indiv, id_new_indiv++ );
         
-        #ifdef DISTRIBUTED_PRNG
-          #error Not implemented yet !
-          indiv->do_prng_jump();
-        #endif
-        
         // Add it to the list
         pop->add_indiv( clone );
       }
@@ -1474,11 +1489,6 @@ void param_loader::load( ae_exp_manager* exp_m, bool verbose, std::function<std:
         // Create a clone, setting its id
         clone = create_clone( indiv, id_new_indiv++ );
 
-        #ifdef DISTRIBUTED_PRNG
-          #error Not implemented yet !
-          indiv->do_prng_jump();
-        #endif
-        
         // Add it to the list
         pop->add_indiv( clone );
       }
@@ -1660,11 +1670,16 @@ ae_individual* param_loader::create_random_individual( ae_exp_manager* exp_m, ae
   // ------------------------------------------------------- Global constraints
   // Create an individual with this genome and set its id
   #ifdef DISTRIBUTED_PRNG
-    #error Not implemented yet !
+    // The individual owns its PRNGs (see ae_population::new_mut_prng_stream)
+    ae_jumping_mt* mut_prng   = exp_m->get_pop()->new_mut_prng_stream();
+    ae_jumping_mt* stoch_prng = exp_m->get_pop()->new_stoch_prng_stream();
+  #else
+    ae_jumping_mt* mut_prng   = _prng;
+    ae_jumping_mt* stoch_prng = _prng;
   #endif
   ae_individual* indiv = new ae_individual( exp_m,
-                                            _prng,
-                                            _prng,
+                                            mut_prng,
+                                            stoch_prng,
                                             param_mut,
                                             _w_max,
                                             _min_genome_length,
@@ -1882,7 +1897,12 @@ ae_individual* param_loader::create_clone( ae_individual* dolly, int32_t id ) co
   ae_individual* indiv;
   
   indiv = new ae_individual( *dolly );
-
+  
+  #ifdef DISTRIBUTED_PRNG
+    // Do not let the clone draw the same numbers as its model
+    indiv->set_mut_prng( dolly->get_exp_m()->get_pop()->new_mut_prng_stream() );
+    indiv->set_stoch_prng( dolly->get_exp_m()->get_pop()->new_stoch_prng_stream() );
+  #endif
   
   //~ #ifdef __X11
     //~ indiv = new ae_individual_X11( *(dynamic_cast<ae_individual_X11*>(dolly)) );
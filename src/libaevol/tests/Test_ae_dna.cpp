@@ -44,6 +44,7 @@
 #include <ae_protein.h>
 #include <ae_params_mut.h>
 #include <ae_individual.h>
+#include <ae_string.h>
 
 
 
@@ -142,6 +143,49 @@ void Test_ae_dna::test1( void )
   
 }
 
+/*!
+  Check that the packed copy of a sequence follows every kind of modification,
+  including those of a copy sharing its storage
+*/
+void Test_ae_dna::test_packed_bits( void )
+{
+  ae_string model( dna1->get_data(), dna1->get_length() );
+  ae_string seq( model );
+  
+  seq.switch_base( 70 );
+  seq.remove( 10, 150 );          // Moves the head
+  seq.remove( 2000, 2100 );       // Moves the tail
+  seq.insert( 5, "0110100111", 10 );
+  seq.insert( 3000, dna2->get_data(), 2000 ); // Reallocates
+  seq.replace( 60, (char*) "1111000011110000", 16 );
+  seq.exchange( 100, 187, 1500 );
+  seq.invert( 33, 2501 );
+  seq.switch_base( 0 );
+  seq.switch_base( seq.get_length() - 1 );
+  
+  const ae_string* strings[2] = { &model, &seq };
+  for ( int8_t s = 0 ; s < 2 ; s++ )
+  {
+    const char* data = strings[s]->get_data();
+    int32_t     len  = strings[s]->get_length();
+    
+    for ( int32_t pos = 0 ; pos < len ; pos++ )
+    {
+      CPPUNIT_ASSERT_EQUAL( (uint64_t) ( data[pos] == '1' ), strings[s]->get_bits( pos, 1 ) );
+    }
+    
+    // Words read across the origin
+    for ( int32_t first = -64 ; first < 64 ; first += 7 )
+    {
+      uint64_t bits = strings[s]->get_circular_bits( len + first, 64 );
+      for ( int8_t i = 0 ; i < 64 ; i++ )
+      {
+        CPPUNIT_ASSERT_EQUAL( (uint64_t) ( data[ae_utils::mod( len + first + i, len )] == '1' ), ( bits >> i ) & 1 );
+      }
+    }
+  }
+}
+
 // ===========================================================================
 //                                Protected Methods
 // ===========================================================================
@@ -62,6 +62,7 @@ class Test_ae_dna : public TestFixture
 {
   CPPUNIT_TEST_SUITE( Test_ae_dna );
   CPPUNIT_TEST( test1 );
+  CPPUNIT_TEST( test_packed_bits );
   CPPUNIT_TEST_SUITE_END();
   
   
@@ -99,6 +100,7 @@ class Test_ae_dna : public TestFixture
     void setUp( void );
     void tearDown( void );
     void test1( void );
+    void test_packed_bits( void );
 
     // =======================================================================
     //                             Public Attributes
@@ -30,6 +30,9 @@
 // =================================================================
 //                              Libraries
 // =================================================================
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
 
 
 
@@ -113,6 +116,105 @@ void Test_ae_jumping_mt::test2( void )
   CPPUNIT_ASSERT( true );
 }
 
+void Test_ae_jumping_mt::test3( void )
+{
+  // random_array must return the very numbers successive calls to random() would,
+  // whether or not the generator is at the beginning of a block, and leave the
+  // generator in the same state (same backup)
+  double uniforms[4 * SFMT_N32 + 1000];
+  int32_t sizes[7] = { 1, 3, SFMT_N32, SFMT_N32 + 5, 4 * SFMT_N32 + 2, 2 * SFMT_N32 + 4, 1000 };
+  char backup_name[2][31] = { "/tmp/Test_ae_jumping_mt_XXXXXX", "/tmp/Test_ae_jumping_mt_XXXXXX" };
+  close( mkstemp( backup_name[0] ) );
+  close( mkstemp( backup_name[1] ) );
+  
+  for ( int8_t k = 0 ; k < 7 ; k++ )
+  {
+    obj1->random_array( uniforms, sizes[k] );
+    for ( int32_t i = 0 ; i < sizes[k] ; i++ )
+    {
+      CPPUNIT_ASSERT( uniforms[i] == obj2->random() );
+    }
+    
+    char backup[2][2 * SFMT_N * sizeof( w128_t )];
+    int32_t backup_size[2];
+    for ( int8_t b = 0 ; b < 2 ; b++ )
+    {
+      gzFile backup_file = gzopen( backup_name[b], "w" );
+      ( b == 0 ? obj1 : obj2 )->save( backup_file );
+      gzclose( backup_file );
+      
+      backup_file = gzopen( backup_name[b], "r" );
+      backup_size[b] = gzread( backup_file, backup[b], sizeof( backup[b] ) );
+      gzclose( backup_file );
+    }
+    CPPUNIT_ASSERT( backup_size[0] == backup_size[1] && memcmp( backup[0], backup[1], backup_size[0] ) == 0 );
+  }
+  
+  CPPUNIT_ASSERT( obj1->random() == obj2->random() );
+  
+  remove( backup_name[0] );
+  remove( backup_name[1] );
+}
+
+void Test_ae_jumping_mt::test4( void )
+{
+  // Wherever the generator is (within a block, at the end of one, or within a
+  // refilled buffer with BUFFERED_PRNG), a backup must hold the plain SFMT
+  // state at that position, and both the reloaded generator and the original
+  // one must then jump to the same place
+  int32_t nb_draws[7] = { 0, 1, SFMT_N32 - 1, SFMT_N32, SFMT_N32 + 1, 3 * SFMT_N32, 2500 };
+  char backup_name[] = "/tmp/Test_ae_jumping_mt_XXXXXX";
+  close( mkstemp( backup_name ) );
+  
+  for ( int8_t k = 0 ; k < 7 ; k++ )
+  {
+    for ( int32_t i = 0 ; i < nb_draws[k] ; i++ )
+    {
+      obj1->random();
+      obj2->random();
+    }
+    
+    gzFile backup_file = gzopen( backup_name, "w" );
+    obj1->save( backup_file );
+    gzclose( backup_file );
+    
+    backup_file = gzopen( backup_name, "r" );
+    ae_jumping_mt* reloaded = new ae_jumping_mt( backup_file );
+    gzclose( backup_file );
+    
+    backup_file = gzopen( backup_name, "r" );
+    sfmt_t sfmt;
+    gzread( backup_file, sfmt.state, SFMT_N * sizeof( sfmt.state[0] ) );
+    gzread( backup_file, &(sfmt.idx), sizeof( sfmt.idx ) );
+    gzclose( backup_file );
+    
+    for ( int32_t i = 0 ; i < 2 * SFMT_N32 + 3 ; i++ )
+    {
+      double number = obj2->random();
+      CPPUNIT_ASSERT( sfmt_genrand_real2( &sfmt ) == number );
+      CPPUNIT_ASSERT( reloaded->random() == number );
+    }
+    
+    for ( int32_t i = 0 ; i < 2 * SFMT_N32 + 3 ; i++ )
+    {
+      obj1->random();
+    }
+    obj1->jump();
+    obj2->jump();
+    reloaded->jump();
+    for ( int32_t i = 0 ; i < 2 * SFMT_N32 + 3 ; i++ )
+    {
+      double number = obj1->random();
+      CPPUNIT_ASSERT( obj2->random() == number );
+      CPPUNIT_ASSERT( reloaded->random() == number );
+    }
+    
+    delete reloaded;
+  }
+  
+  remove( backup_name );
+}
+
 // ===========================================================================
 //                                Protected Methods
 // ===========================================================================
@@ -63,6 +63,8 @@ class Test_ae_jumping_mt : public TestFixture
   CPPUNIT_TEST_SUITE( Test_ae_jumping_mt );
   CPPUNIT_TEST( test1 );
   CPPUNIT_TEST( test2 );
+  CPPUNIT_TEST( test3 );
+  CPPUNIT_TEST( test4 );
   CPPUNIT_TEST_SUITE_END();
   
   
@@ -101,6 +103,8 @@ class Test_ae_jumping_mt : public TestFixture
     void tearDown( void );
     void test1( void );
     void test2( void );
+    void test3( void );
+    void test4( void );
 
     // =======================================================================
     //                             Public Attributes
@@ -0,0 +1,355 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <math.h>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include "Test_ae_mut_sampler.h"
+
+
+
+// ===========================================================================
+//                             Declare Used Namespaces
+// ===========================================================================
+
+
+
+
+//############################################################################
+//                                                                           #
+//                         Class Test_ae_mut_sampler                         #
+//                                                                           #
+//############################################################################
+CPPUNIT_TEST_SUITE_REGISTRATION( Test_ae_mut_sampler );
+
+// ===========================================================================
+//                               Static attributes
+// ===========================================================================
+
+// ===========================================================================
+//                                  Constructors
+// ===========================================================================
+Test_ae_mut_sampler::Test_ae_mut_sampler( void )
+{
+}
+
+// ===========================================================================
+//                                  Destructors
+// ===========================================================================
+Test_ae_mut_sampler::~Test_ae_mut_sampler( void )
+{
+}
+
+// ===========================================================================
+//                                   Operators
+// ===========================================================================
+
+// ===========================================================================
+//                                 Public Methods
+// ===========================================================================
+void Test_ae_mut_sampler::setUp( void )
+{
+  sampler_prng    = new ae_jumping_mt( 2718 );
+  reference_prng  = new ae_jumping_mt( 3141 );
+}
+
+void Test_ae_mut_sampler::tearDown( void )
+{
+  delete sampler_prng;
+  delete reference_prng;
+}
+
+/*!
+  The number of events of each type must follow the same distribution as the
+  binomial drawings (binomial_random) the sampler replaces, and must not depend
+  on the number of events of the other types.
+
+  The cases below cover the 3 methods used by binomial_random (direct, Poisson
+  and rejection), a type with a zero rate and a genome long enough for the
+  sampler to draw binomials itself.
+*/
+void Test_ae_mut_sampler::test_nb_events( void )
+{
+  const int32_t nb_samples = 20000;
+  const int8_t  nb_types   = 4;
+  
+  int32_t lengths[4]          = { 5000, 50000, 20, 1000000 };
+  double  rates[4][nb_types]  = { { 1e-5, 1e-5, 1e-5, 0.0 },
+                                  { 1e-4, 5e-5, 2e-4, 0.0 },
+                                  { 0.1,  0.3,  0.05, 0.2 },
+                                  { 1e-5, 1e-5, 1e-5, 1e-5 } };
+  
+  int32_t* nb_sampled   = new int32_t[nb_types * nb_samples];
+  int32_t* nb_reference = new int32_t[nb_types * nb_samples];
+  
+  for ( int8_t c = 0 ; c < 4 ; c++ )
+  {
+    for ( int32_t s = 0 ; s < nb_samples ; s++ )
+    {
+      ae_mut_sampler sampler( sampler_prng, lengths[c], nb_types, rates[c] );
+      
+      for ( int8_t t = 0 ; t < nb_types ; t++ )
+      {
+        nb_sampled[t * nb_samples + s]    = sampler.get_nb_events( t );
+        nb_reference[t * nb_samples + s]  = reference_prng->binomial_random( lengths[c], rates[c][t] );
+      }
+    }
+    
+    for ( int8_t t = 0 ; t < nb_types ; t++ )
+    {
+      CPPUNIT_ASSERT( same_distribution( &nb_sampled[t * nb_samples], &nb_reference[t * nb_samples], nb_samples ) );
+      
+      // The mean must be within 5 standard errors of n.p
+      double mean = 0.0;
+      for ( int32_t s = 0 ; s < nb_samples ; s++ ) mean += nb_sampled[t * nb_samples + s];
+      mean /= nb_samples;
+      
+      double expected_mean  = lengths[c] * rates[c][t];
+      double std_error      = sqrt( expected_mean * ( 1.0 - rates[c][t] ) / nb_samples );
+      CPPUNIT_ASSERT( fabs( mean - expected_mean ) <= 5.0 * std_error );
+    }
+    
+    // The numbers of events of the first and third types must be uncorrelated
+    double mean_0 = 0.0, mean_2 = 0.0, cov = 0.0, var_0 = 0.0, var_2 = 0.0;
+    for ( int32_t s = 0 ; s < nb_samples ; s++ )
+    {
+      mean_0 += nb_sampled[s];
+      mean_2 += nb_sampled[2 * nb_samples + s];
+    }
+    mean_0 /= nb_samples;
+    mean_2 /= nb_samples;
+    for ( int32_t s = 0 ; s < nb_samples ; s++ )
+    {
+      cov   += ( nb_sampled[s] - mean_0 ) * ( nb_sampled[2 * nb_samples + s] - mean_2 );
+      var_0 += ( nb_sampled[s] - mean_0 ) * ( nb_sampled[s] - mean_0 );
+      var_2 += ( nb_sampled[2 * nb_samples + s] - mean_2 ) * ( nb_sampled[2 * nb_samples + s] - mean_2 );
+    }
+    CPPUNIT_ASSERT( fabs( cov ) <= 5.0 * sqrt( var_0 * var_2 / nb_samples ) );
+  }
+  
+  delete [] nb_sampled;
+  delete [] nb_reference;
+}
+
+/*!
+  All the events must be handed out, in the same random order as drawing them
+  without replacement from an urn (which is tested on the type of the first event)
+*/
+void Test_ae_mut_sampler::test_event_order( void )
+{
+  const int32_t nb_samples  = 20000;
+  const int8_t  nb_types    = 3;
+  const int32_t length      = 20;
+  double rates[nb_types]    = { 0.1, 0.3, 0.05 };
+  
+  // Type of the first event (nb_types if there is none)
+  int32_t* first_sampled    = new int32_t[nb_samples];
+  int32_t* first_reference  = new int32_t[nb_samples];
+  
+  for ( int32_t s = 0 ; s < nb_samples ; s++ )
+  {
+    // Sampler
+    ae_mut_sampler sampler( sampler_prng, length, nb_types, rates );
+    
+    int32_t nb_events[nb_types];
+    for ( int8_t t = 0 ; t < nb_types ; t++ ) nb_events[t] = sampler.get_nb_events( t );
+    
+    first_sampled[s] = nb_types;
+    for ( int32_t i = sampler.get_nb_events() ; i >= 1 ; i-- )
+    {
+      int8_t event = sampler.draw_event();
+      if ( first_sampled[s] == nb_types ) first_sampled[s] = event;
+      nb_events[event]--;
+    }
+    
+    CPPUNIT_ASSERT( sampler.get_nb_events() == 0 );
+    for ( int8_t t = 0 ; t < nb_types ; t++ ) CPPUNIT_ASSERT( nb_events[t] == 0 );
+    
+    // Reference: binomial drawings and urn
+    int32_t nb_reference[nb_types];
+    int32_t nb_reference_total = 0;
+    for ( int8_t t = 0 ; t < nb_types ; t++ )
+    {
+      nb_reference[t] = reference_prng->binomial_random( length, rates[t] );
+      nb_reference_total += nb_reference[t];
+    }
+    
+    first_reference[s] = nb_types;
+    if ( nb_reference_total > 0 )
+    {
+      int32_t random_value = reference_prng->random( nb_reference_total );
+      first_reference[s] = 0;
+      while ( random_value >= nb_reference[first_reference[s]] )
+      {
+        random_value -= nb_reference[first_reference[s]];
+        first_reference[s]++;
+      }
+    }
+  }
+  
+  CPPUNIT_ASSERT( same_distribution( first_sampled, first_reference, nb_samples ) );
+  
+  delete [] first_sampled;
+  delete [] first_reference;
+}
+
+/*!
+  Without MERGED_MUTATION_SAMPLER, the sampler must draw exactly the same events
+  as the binomial drawings and urn of earlier versions, from the same random numbers
+*/
+void Test_ae_mut_sampler::test_per_type_draws( void )
+{
+  const int32_t nb_samples  = 2000;
+  const int8_t  nb_types    = 4;
+  const int32_t length      = 5000;
+  double rates[nb_types]    = { 1e-4, 5e-4, 0.0, 1e-3 };
+  
+  ae_jumping_mt* prng       = new ae_jumping_mt( 2718 );
+  ae_jumping_mt* old_prng   = new ae_jumping_mt( 2718 );
+  
+  for ( int32_t s = 0 ; s < nb_samples ; s++ )
+  {
+    ae_mut_sampler sampler( prng, length, nb_types, rates );
+    
+    // Binomial drawings and urn, as before 4.3
+    int32_t nb_reference[nb_types];
+    int32_t nb_reference_total = 0;
+    for ( int8_t t = 0 ; t < nb_types ; t++ )
+    {
+      nb_reference[t] = old_prng->binomial_random( length, rates[t] );
+      nb_reference_total += nb_reference[t];
+      CPPUNIT_ASSERT( sampler.get_nb_events( t ) == nb_reference[t] );
+    }
+    CPPUNIT_ASSERT( sampler.get_nb_events() == nb_reference_total );
+    
+    for ( int32_t i = nb_reference_total ; i >= 1 ; i-- )
+    {
+      int32_t random_value = old_prng->random( i );
+      int8_t  type = 0;
+      while ( random_value >= nb_reference[type] )
+      {
+        random_value -= nb_reference[type];
+        type++;
+      }
+      nb_reference[type]--;
+      
+      CPPUNIT_ASSERT( sampler.draw_event() == type );
+    }
+  }
+  
+  CPPUNIT_ASSERT( prng->random() == old_prng->random() );
+  
+  delete prng;
+  delete old_prng;
+}
+
+// ===========================================================================
+//                                Protected Methods
+// ===========================================================================
+/*!
+  Two-sample chi-square test on samples of non-negative integers of the same size
+
+  Consecutive values are pooled into classes of at least 10 observations (both
+  samples together). The test fails when the statistic exceeds its quantile of
+  order 1 - 1e-6 (Wilson-Hilferty approximation), so that it only fails on an
+  actual difference between the distributions.
+*/
+bool Test_ae_mut_sampler::same_distribution( const int32_t* sample_1, const int32_t* sample_2, int32_t nb_values )
+{
+  int32_t max_value = 0;
+  for ( int32_t i = 0 ; i < nb_values ; i++ )
+  {
+    if ( sample_1[i] > max_value ) max_value = sample_1[i];
+    if ( sample_2[i] > max_value ) max_value = sample_2[i];
+  }
+  
+  int32_t* counts_1 = new int32_t[max_value + 1];
+  int32_t* counts_2 = new int32_t[max_value + 1];
+  for ( int32_t v = 0 ; v <= max_value ; v++ )
+  {
+    counts_1[v] = 0;
+    counts_2[v] = 0;
+  }
+  for ( int32_t i = 0 ; i < nb_values ; i++ )
+  {
+    counts_1[sample_1[i]]++;
+    counts_2[sample_2[i]]++;
+  }
+  
+  double  chi2        = 0.0;
+  int32_t nb_classes  = 0;
+  int32_t class_1     = 0, class_2      = 0;  // Class being filled
+  int32_t last_1      = 0, last_2       = 0;  // Last class closed
+  for ( int32_t v = 0 ; v <= max_value ; v++ )
+  {
+    class_1 += counts_1[v];
+    class_2 += counts_2[v];
+    
+    if ( class_1 + class_2 >= 10 )
+    {
+      chi2 += (double) ( class_1 - class_2 ) * ( class_1 - class_2 ) / ( class_1 + class_2 );
+      nb_classes++;
+      last_1  = class_1;
+      last_2  = class_2;
+      class_1 = 0;
+      class_2 = 0;
+    }
+  }
+  
+  // What is left is pooled with the last class
+  if ( class_1 + class_2 > 0 && nb_classes > 0 )
+  {
+    chi2 -= (double) ( last_1 - last_2 ) * ( last_1 - last_2 ) / ( last_1 + last_2 );
+    last_1 += class_1;
+    last_2 += class_2;
+    chi2 += (double) ( last_1 - last_2 ) * ( last_1 - last_2 ) / ( last_1 + last_2 );
+  }
+  
+  delete [] counts_1;
+  delete [] counts_2;
+  
+  if ( nb_classes < 2 ) return true;
+  
+  double df   = nb_classes - 1;
+  double z    = 4.75; // Quantile of order 1 - 1e-6 of the standard normal law
+  double crit = df * pow( 1.0 - 2.0 / ( 9.0 * df ) + z * sqrt( 2.0 / ( 9.0 * df ) ), 3 );
+  
+  return chi2 < crit;
+}
+
+// ===========================================================================
+//                              Non inline accessors
+// ===========================================================================
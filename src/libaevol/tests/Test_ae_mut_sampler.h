@@ -0,0 +1,152 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+#ifndef TEST_AE_MUT_SAMPLER
+#define TEST_AE_MUT_SAMPLER
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <cstdio>
+#include <cstdlib>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_jumping_mt.h>
+#include <ae_mut_sampler.h>
+
+
+
+
+// ===========================================================================
+//                             Declare Used Namespaces
+// ===========================================================================
+using namespace CppUnit;
+using namespace std;
+
+
+
+
+
+
+class Test_ae_mut_sampler : public TestFixture
+{
+  CPPUNIT_TEST_SUITE( Test_ae_mut_sampler );
+  CPPUNIT_TEST( test_nb_events );
+  CPPUNIT_TEST( test_event_order );
+#ifndef MERGED_MUTATION_SAMPLER
+  CPPUNIT_TEST( test_per_type_draws );
+#endif
+  CPPUNIT_TEST_SUITE_END();
+  
+  
+  public :
+    
+    // =======================================================================
+    //                                 Enums
+    // =======================================================================
+    
+    // =======================================================================
+    //                               Constructors
+    // =======================================================================
+    Test_ae_mut_sampler( void );
+
+    // =======================================================================
+    //                               Destructors
+    // =======================================================================
+    virtual ~Test_ae_mut_sampler( void );
+
+    // =======================================================================
+    //                            Accessors: getters
+    // =======================================================================
+
+    // =======================================================================
+    //                            Accessors: setters
+    // =======================================================================
+
+    // =======================================================================
+    //                                Operators
+    // =======================================================================
+
+    // =======================================================================
+    //                              Public Methods
+    // =======================================================================
+    void setUp( void );
+    void tearDown( void );
+    void test_nb_events( void );
+    void test_event_order( void );
+    void test_per_type_draws( void );
+
+    // =======================================================================
+    //                             Public Attributes
+    // =======================================================================
+
+
+
+  protected :
+
+    // =======================================================================
+    //                            Forbidden Constructors
+    // =======================================================================
+
+    // =======================================================================
+    //                              Protected Methods
+    // =======================================================================
+    static bool same_distribution( const int32_t* sample_1, const int32_t* sample_2, int32_t nb_values );
+
+    // =======================================================================
+    //                             Protected Attributes
+    // =======================================================================
+    ae_jumping_mt* sampler_prng;
+    ae_jumping_mt* reference_prng;
+};
+
+
+// ===========================================================================
+//                              Getters' definitions
+// ===========================================================================
+
+// ===========================================================================
+//                              Setters' definitions
+// ===========================================================================
+
+// ===========================================================================
+//                          Inline Operators' definitions
+// ===========================================================================
+
+// ===========================================================================
+//                          Inline functions' definition
+// ===========================================================================
+
+
+#endif // TEST_AE_MUT_SAMPLER
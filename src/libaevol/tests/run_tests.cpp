@@ -41,6 +41,7 @@
 //                            Project Files
 // =================================================================
 #include "Test_ae_jumping_mt.h"
+#include "Test_ae_mut_sampler.h"
 #include "Test_ae_individual.h"
 #include "Test_ae_dna.h"
 
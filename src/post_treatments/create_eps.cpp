@@ -614,13 +614,11 @@ void draw_pos_neg_profiles( ae_individual * indiv, ae_environment* env, char * d
   fprintf( drawingfile, "0.002 setlinewidth\n" );
   fprintf( drawingfile, "%lf %lf moveto\n", margin, 0.5);
 
-  ae_list_node<ae_point_2d*>* node = indiv->get_phenotype_activ()->get_points()->get_first();
-  ae_point_2d* pt = NULL;
-  while (node != NULL)
+  ae_fuzzy_set* fs = indiv->get_phenotype_activ();
+  for ( int32_t i = 0 ; i < fs->get_nb_points() ; i++ )
   {
-    pt = node->get_obj();
-    fprintf( drawingfile, "%lf %lf lineto\n", margin + scale*pt->x, 0.5 + scale*pt->y);
-    node = node->get_next();
+    const ae_point_2d& pt = fs->get_point( i );
+    fprintf( drawingfile, "%lf %lf lineto\n", margin + scale*pt.x, 0.5 + scale*pt.y);
   }
   fprintf( drawingfile, "stroke\n" );
     
@@ -633,13 +631,11 @@ void draw_pos_neg_profiles( ae_individual * indiv, ae_environment* env, char * d
   fprintf( drawingfile, "0.002 setlinewidth\n" );
   fprintf( drawingfile, "%lf %lf moveto\n", margin, 0.5);
     
-  node = ((indiv->get_phenotype_inhib())->get_points())->get_first();
-  pt = NULL;
-  while (node != NULL)
+  fs = indiv->get_phenotype_inhib();
+  for ( int32_t i = 0 ; i < fs->get_nb_points() ; i++ )
   {
-    pt = (ae_point_2d *) node->get_obj();
-    fprintf( drawingfile, "%lf %lf lineto\n", margin + scale*pt->x, 0.5 + scale*pt->y);
-    node = node->get_next();
+    const ae_point_2d& pt = fs->get_point( i );
+    fprintf( drawingfile, "%lf %lf lineto\n", margin + scale*pt.x, 0.5 + scale*pt.y);
   }
   fprintf( drawingfile, "stroke\n" );
 
@@ -746,13 +742,11 @@ void draw_phenotype( ae_individual* indiv, ae_environment* env, char* directoryN
   fprintf( drawingfile,"[ ] 0 setdash\n" );
   fprintf( drawingfile, "0.002 setlinewidth\n" );
   fprintf( drawingfile, "%lf %lf moveto\n", margin, margin);
-  ae_list_node<ae_point_2d*>* node = indiv->get_phenotype()->get_points()->get_first();
-  ae_point_2d* pt = NULL;
-  while (node != NULL)
+  ae_fuzzy_set* fs = indiv->get_phenotype();
+  for ( int32_t i = 0 ; i < fs->get_nb_points() ; i++ )
     {
-      pt = (ae_point_2d *) node->get_obj();
-      fprintf( drawingfile, "%lf %lf lineto\n", margin + scale*pt->x, margin + scale*pt->y);
-      node = node->get_next();
+      const ae_point_2d& pt = fs->get_point( i );
+      fprintf( drawingfile, "%lf %lf lineto\n", margin + scale*pt.x, margin + scale*pt.y);
     }
   fprintf( drawingfile, "stroke\n" );
 
@@ -763,13 +757,10 @@ void draw_phenotype( ae_individual* indiv, ae_environment* env, char* directoryN
   fprintf( drawingfile,"[ ] 0 setdash\n" );
   fprintf( drawingfile, "0.001 setlinewidth\n" );
   fprintf( drawingfile, "%lf %lf moveto\n", margin, margin);
-  node = (env->get_points())->get_first();
-  pt = NULL;
-  while (node != NULL)
+  for ( int32_t i = 0 ; i < env->get_nb_points() ; i++ )
     {
-      pt = (ae_point_2d *) node->get_obj();
-      fprintf( drawingfile, "%lf %lf lineto\n", margin + scale*pt->x, margin + scale*pt->y);
-      node = node->get_next();
+      const ae_point_2d& pt = env->get_point( i );
+      fprintf( drawingfile, "%lf %lf lineto\n", margin + scale*pt.x, margin + scale*pt.y);
     }
   fprintf( drawingfile, "stroke\n" );
 
@@ -1128,7 +1119,6 @@ void draw_genetic_unit_with_mRNAs( ae_genetic_unit* gen_unit, char * directoryNa
   //  mRNAs
   // -----------
 
-  ae_list_node<ae_rna*>* node  = NULL;
   ae_rna* rna = NULL;
 
   int32_t first;
@@ -1162,10 +1152,9 @@ void draw_genetic_unit_with_mRNAs( ae_genetic_unit* gen_unit, char * directoryNa
 
 
 
-  node = (gen_unit->get_rna_list())[LEADING]->get_first();
-  while (node != NULL)
+  for ( int32_t rna_ind = 0 ; rna_ind < gen_unit->get_rna_list()[LEADING]->get_nb_elts() ; rna_ind++ )
   {
-    rna = (ae_rna *) node->get_obj();
+    rna = gen_unit->get_rna_list()[LEADING]->get_rna( rna_ind );
     first = rna->get_first_transcribed_pos();
     last = rna->get_last_transcribed_pos();
     
@@ -1257,16 +1246,13 @@ void draw_genetic_unit_with_mRNAs( ae_genetic_unit* gen_unit, char * directoryNa
       fprintf( drawingfile, "%lf %lf %lf %d %d arc\n", 0.5, 0.5, r + layer*0.02, theta_last, theta_first);
       fprintf( drawingfile, "stroke\n" );
     }
-        
-    node = node->get_next();
   }
   
 
 
-  node = (gen_unit->get_rna_list())[LAGGING]->get_first();
-  while (node != NULL)
+  for ( int32_t rna_ind = 0 ; rna_ind < gen_unit->get_rna_list()[LAGGING]->get_nb_elts() ; rna_ind++ )
   {
-    rna = (ae_rna *) node->get_obj();
+    rna = gen_unit->get_rna_list()[LAGGING]->get_rna( rna_ind );
     first = rna->get_first_transcribed_pos();
     last = rna->get_last_transcribed_pos();
 
@@ -1356,8 +1342,6 @@ void draw_genetic_unit_with_mRNAs( ae_genetic_unit* gen_unit, char * directoryNa
       fprintf( drawingfile, "%lf %lf %lf %d %d arc\n", 0.5, 0.5, r - layer*0.02, theta_first, theta_last);
       fprintf( drawingfile, "stroke\n" );
     }
-        
-    node = node->get_next();
   }
 
 
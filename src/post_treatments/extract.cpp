@@ -208,14 +208,23 @@ int main( int argc, char* argv[] )
     // Load the simulation from population file
     pop = new ae_population(exp_manager);
     
-    gzFile pop_file = gzopen( pop_file_name, "r" );
-    if ( pop_file == Z_NULL )
+    // In a block backup, the best individual (the last one) can be loaded alone
+    ae_block_backup pop_index( pop_file_name );
+    if ( best_only && pop_index.is_indexed() )
     {
-      printf( "%s:%d: error: could not open backup file %s\n", __FILE__, __LINE__, pop_file_name );
-      exit( EXIT_FAILURE );
+      pop->get_indivs()->add( pop->load_indiv( &pop_index, pop_index.get_nb_entries() - 1 ) );
+    }
+    else
+    {
+      gzFile pop_file = gzopen( pop_file_name, "r" );
+      if ( pop_file == Z_NULL )
+      {
+        printf( "%s:%d: error: could not open backup file %s\n", __FILE__, __LINE__, pop_file_name );
+        exit( EXIT_FAILURE );
+      }
+      pop->load( pop_file, false );
+      gzclose( pop_file );    
     }
-    pop->load( pop_file, false );
-    gzclose( pop_file );    
   }
 
   // The best individual is already known because it is the last in the list
@@ -329,21 +338,16 @@ inline void analyse_indiv( ae_individual* indiv, FILE* triangles_file, FILE* seq
 // Parsing a GU
 inline void analyse_gu( ae_genetic_unit* gen_unit, int32_t gen_unit_number, FILE* triangles_file, ae_environment* env )
 {  
-  // Construct the list of all rnas
-  ae_list<ae_rna*>** llrnas = gen_unit->get_rna_list();
-  ae_list<ae_rna*>* lrnas = new ae_list<ae_rna*>();
-  lrnas->add_list(llrnas[LEADING]);
-  lrnas->add_list(llrnas[LAGGING]);
-  
-  // Parse this list
-  ae_list_node<ae_rna*>* rna_node = lrnas->get_first();;
+  // Parse the rnas of both strands
+  ae_promoter_list** llrnas = gen_unit->get_rna_list();
   
   ae_rna* rna = NULL;
   int rna_nb = 0;
   
-  while( rna_node != NULL )
+  for ( int8_t strand = LEADING ; strand <= LAGGING ; strand++ )
+  for ( int32_t rna_ind = 0 ; rna_ind < llrnas[strand]->get_nb_elts() ; rna_ind++ )
   {
-    rna = (ae_rna *) rna_node->get_obj();
+    rna = llrnas[strand]->get_rna( rna_ind );
       
     ae_list<ae_protein*>* lprot = rna->get_transcribed_proteins();
     ae_list_node<ae_protein*>* prot_node = lprot->get_first();
@@ -379,11 +383,8 @@ inline void analyse_gu( ae_genetic_unit* gen_unit, int32_t gen_unit_number, FILE
       prot_node = prot_node->get_next();
     }
       
-    rna_node = rna_node->get_next();
     rna_nb++;
   }
-  
-  delete lrnas;
 }
 
 
@@ -0,0 +1,199 @@
+// ****************************************************************************
+//
+//          Aevol - An in silico experimental evolution platform
+//
+// ****************************************************************************
+// 
+// Copyright: See the AUTHORS file provided with the package or <www.aevol.fr>
+// Web: http://www.aevol.fr/
+// E-mail: See <http://www.aevol.fr/contact/>
+// Original Authors : Guillaume Beslon, Carole Knibbe, David Parsons
+// 
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+// 
+//*****************************************************************************
+
+
+// This program converts tree files into indexed tree files (see ae_tree), in
+// which the replication report of any individual can be read without reading
+// (and decompressing) the rest of the file.
+
+
+// =================================================================
+//                              Libraries
+// =================================================================
+#include <inttypes.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+
+
+
+
+// =================================================================
+//                            Project Files
+// =================================================================
+#include <ae_macros.h>
+#include <ae_exp_manager.h>
+#include <ae_tree.h>
+#include <ae_block_backup.h>
+#include <ae_background_writer.h>
+
+
+
+
+void print_help( char* prog_name );
+void index_tree_file( ae_exp_manager* exp_manager, ae_background_writer* writer, char* tree_file_name, bool verbose );
+
+
+int main( int argc, char* argv[] )
+{
+  // Initialize command-line option variables with default values
+  int32_t num_gener = -1;
+  bool    verbose   = false;
+  
+  // Define allowed options
+  const char * options_list = "hvr:";
+  static struct option long_options_list[] = {
+    { "help",     0, NULL, 'h' },
+    { "verbose",  0, NULL, 'v' },
+    { "resume",   1, NULL, 'r' },
+    { 0, 0, 0, 0 }
+  };
+
+  // Get actual values of the command-line options
+  int option;
+  while ( ( option = getopt_long(argc, argv, options_list, long_options_list, NULL) ) != -1 ) 
+  {
+    switch ( option )
+    {
+      case 'h' :
+        print_help( argv[0] );
+        exit( EXIT_SUCCESS );
+        break;
+      case 'v' :
+        verbose = true;
+        break;
+      case 'r' :
+        num_gener = atol( optarg );
+        break;
+    }
+  }
+  
+  // The tree mode and step are those of the experiment
+  if ( num_gener == -1 )
+  {
+    printf( "You must specify a generation number\n" );
+    exit( EXIT_FAILURE );
+  }
+  ae_exp_manager* exp_manager = new ae_exp_manager();
+  exp_manager->load( num_gener, false, false, false );
+  
+  if ( ! exp_manager->get_record_tree() || exp_manager->get_tree_mode() == LIGHT )
+  {
+    printf( "%s: error: The experiment has no tree to index\n", argv[0] );
+    exit( EXIT_FAILURE );
+  }
+  
+  ae_background_writer writer;
+  char tree_file_name[50];
+  
+  if ( optind < argc )
+  {
+    // Convert the provided tree files
+    for ( int i = optind ; i < argc ; i++ )
+    {
+      index_tree_file( exp_manager, &writer, argv[i], verbose );
+    }
+  }
+  else
+  {
+    // Convert all the tree files up to num_gener
+    int32_t tree_step = exp_manager->get_tree_step();
+    for ( int32_t gener = tree_step ; gener <= num_gener ; gener += tree_step )
+    {
+      #ifdef __REGUL
+        sprintf( tree_file_name, "tree/tree_%06"PRId32".rae", gener );
+      #else
+        sprintf( tree_file_name, "tree/tree_%06"PRId32".ae", gener );
+      #endif
+      
+      FILE* tree_file = fopen( tree_file_name, "r" );
+      if ( tree_file == NULL ) continue;
+      fclose( tree_file );
+      
+      index_tree_file( exp_manager, &writer, tree_file_name, verbose );
+    }
+  }
+  
+  delete exp_manager;
+  
+  return EXIT_SUCCESS;
+}
+
+
+/*!
+  Rewrite the tree file as an indexed tree file (unless it already is one)
+
+  The new file is written aside and then renamed.
+*/
+void index_tree_file( ae_exp_manager* exp_manager, ae_background_writer* writer, char* tree_file_name, bool verbose )
+{
+  ae_block_backup index( tree_file_name );
+  if ( index.is_indexed() )
+  {
+    if ( verbose ) printf( "%s is already indexed\n", tree_file_name );
+    return;
+  }
+  
+  if ( verbose ) printf( "Indexing %s... ", tree_file_name );
+  fflush( stdout );
+  
+  ae_tree* tree = new ae_tree( exp_manager, tree_file_name );
+  
+  char tmp_file_name[255];
+  sprintf( tmp_file_name, "%s.tmp", tree_file_name );
+  gzFile tree_file = writer->open( tmp_file_name, true );
+  tree->write_to_tree_file( tree_file, writer->get_entry_starts( tree_file ) );
+  gzclose( tree_file );
+  delete tree;
+  
+  writer->commit();
+  writer->wait();
+  
+  if ( rename( tmp_file_name, tree_file_name ) != 0 )
+  {
+    printf( "ERROR : Could not rename %s into %s\n", tmp_file_name, tree_file_name );
+    exit( EXIT_FAILURE );
+  }
+  
+  if ( verbose ) printf( "OK\n" );
+}
+
+
+void print_help( char* prog_name ) 
+{
+  printf( "\n" );
+  printf( "Convert tree files into indexed tree files, in which the replication report\n" );
+  printf( "of any individual can be read without decompressing the rest of the file\n" );
+  printf( "(lineage then only reads the reports of the ancestors).\n" );
+  printf( "Usage : %s -h\n", prog_name );
+  printf( "or :    %s [-v] -r ng [tree_file ...]\n", prog_name );
+  printf( "\t-h : display this screen\n" );
+  printf( "\t-v : be verbose\n" );
+  printf( "\t-r ng : read the tree setup from the backup of generation ng\n" );
+  printf( "\t        (and convert the tree files up to ng if none is provided)\n" );
+}